@@ -72,6 +72,9 @@ private:
 class sandbox : public game
 {
 private:
+    // Declared first so it outlives every object allocated from it
+    memory::arena m_scene_arena{};
+
     game_object m_root{};
     game_object m_cube{};
     game_object m_cube2{};
@@ -81,8 +84,9 @@ private:
     game_object m_plane{};
     game_object m_cam{};
 
-    game_object m_lights{};
-    game_object m_light_sphere{};
+    game_object  m_lights{};
+    game_object  m_light_sphere{};
+    game_object* m_light_grid{}; // Allocated from m_scene_arena along with everything below it
 
     //gfx::bitmap_font m_font{ };
     gfx::text_string       m_text{};
@@ -125,19 +129,19 @@ public:
         bricks.normal = assets::load_texture("./assets/textures/bricks_normal.tga")->texture_view();
 
         //m_cube.add(new model_component{ gfx::geometry::create_box(3.f, 3.f, 1.f) })->set_material(dirty_bricks);
-        m_cube.add(new model_component{"./assets/models/cube.txt"})->set_material(dirty_stone);
+        m_cube.add<model_component>("./assets/models/cube.txt")->set_material(dirty_stone);
         m_cube.set_scale(3.f, 3.f, 1.f);
         m_cube.set_position(73.f, 6.f, 73.f);
         //m_cube.rotate(180.f, axis::z);
 
         game_object* sphere = new game_object{};
-        sphere->add(new model_component{"./assets/models/sphere.txt"})->set_material(dirty_bricks);
+        sphere->add<model_component>("./assets/models/sphere.txt")->set_material(dirty_bricks);
         sphere->set_position(3.f, 9.f, 6.f);
         m_root.add(sphere);
 
         //m_cube2.add(new model_component{ gfx::geometry::create_box(1.f, 1.f, 1.f) });
-        m_cube2.add(new model_component{ "./assets/models/cube.txt" });
-        m_ball1.add(new model_component{ gfx::geometry::create_sphere(1.5f, 36, 36) });
+        m_cube2.add<model_component>("./assets/models/cube.txt");
+        m_ball1.add<model_component>(gfx::geometry::create_sphere(1.5f, 36, 36));
         m_ball1.add(m_cube2);
         m_cube2.set_position(3.f, 1.f, 0.f);
         m_cube2.rotate(45.f, axis::x);
@@ -147,26 +151,25 @@ public:
         m_ball1.set_position(-3.f, 5.f, -3.f);
 
         //m_plane.add(new texture_component{"./assets/textures/stone01.tga"})->add(new model_component{gfx::geometry::create_plane(32, 32)});
-        m_plane.add(new model_component{ "./assets/models/plane2.txt" })->set_material(dirty_stone);
+        m_plane.add<model_component>("./assets/models/plane2.txt")->set_material(dirty_stone);
         //m_plane.rotate(90.f, axis::x);
         m_plane.set_position(0.f, -1.f, 0.f);
         m_plane.set_scale(100.f, 100.f, 100.f);
 
-        m_light_sphere.add(new pointlight_component{
-            {0.f, 1.f, 0.f},
-            10.f, 5.f, 4.f
-        });
+        m_light_sphere.add<pointlight_component>(math::vec3{ 0.f, 1.f, 0.f }, 10.f, 5.f, 4.f);
         m_light_sphere.set_position(3.f, 10.f, 3.f);
         m_lights.add(m_light_sphere);
 
         auto* light2 = new game_object{};
-        light2->add(new pointlight_component{
-            {1.f, 0.f, 0.f},
-            10.f, 5.f, 4.f
-        });
+        light2->add<pointlight_component>(math::vec3{ 1.f, 0.f, 0.f }, 10.f, 5.f, 4.f);
         light2->set_position(-5.f, 2.f, 0.f);
         m_lights.add(light2);
 
+        // The light grid lives exactly as long as the scene, see shutdown
+        memory::arena_scope arena_scope{ m_scene_arena };
+        m_light_grid = new game_object{};
+        m_lights.add(m_light_grid);
+
         std::random_device                  rd{};
         std::mt19937                        gen(rd());
         std::uniform_real_distribution<f32> dist(0.2f, 1.0f);
@@ -180,12 +183,9 @@ public:
                 f32   r         = dist(gen);
                 f32   g         = dist(gen);
                 f32   b         = dist(gen);
-                new_light->add(new pointlight_component{
-                    {r, g, b},
-                    30.f, 25.5f, 22.f
-                });
+                new_light->add<pointlight_component>(math::vec3{ r, g, b }, 30.f, 25.5f, 22.f);
                 new_light->set_position((f32) x, 1.f, (f32) z);
-                m_lights.add(new_light);
+                m_light_grid->add(new_light);
             }
         }
 
@@ -244,6 +244,15 @@ public:
         if (input::key_released('B'))
         {
             LOG_DEBUG("Frame time: {}", delta);
+
+            const memory::allocation_stats stats = memory::stats();
+            LOG_DEBUG("Allocations: {} (frees {}), pool chunks: {}, arena blocks: {}, heap: {}, in use: {} bytes",
+                      stats.allocations, stats.frees, stats.pool_chunks, stats.arena_blocks, stats.heap_allocations,
+                      stats.bytes_in_use);
+
+            const frame_timings timings = app::timings();
+            LOG_DEBUG("Extraction: {:.3f} ms, waiting for the render thread: {:.3f} ms, render: {:.3f} ms", timings.extract_ms,
+                      timings.wait_ms, timings.render_ms);
         }
         const f32 rotation = -15.f * delta;
 
@@ -252,7 +261,9 @@ public:
 
         //m_quad.rotate(rotation, axis::z);
 
-        m_root.update(delta);
+        // Everything the sandbox updates hangs off m_root, registry components tick along with it
+        game_object* const roots[]{ &m_root };
+        scene::tick(delta, roots);
         //m_quad.update(delta);
         //m_lights.update(delta);
     }
@@ -275,7 +286,14 @@ public:
     }
 
 
-    void shutdown() override {}
+    void shutdown() override
+    {
+        // Deleting the grid's root runs the destructors of everything below it, but arena memory only goes back on
+        // reset, which must come after every object allocated from the arena is gone
+        delete m_light_grid;
+        m_light_grid = nullptr;
+        m_scene_arena.reset();
+    }
 };
 
 
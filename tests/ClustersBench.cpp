@@ -0,0 +1,100 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: ClustersBench.cpp
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+
+// Light cluster build time on the engine's 16x9x24 grid, build_scalar against the batched parallel build, for a few
+// light counts scattered in front of the camera. Pass a worker count as the first argument, all cores by default
+
+#include "Yae/Core/Jobs.h"
+#include "Yae/Graphics/LightClusters.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace yae;
+using namespace yae::gfx;
+
+namespace
+{
+
+using clock_type = std::chrono::steady_clock;
+
+template<typename Func>
+f64 best_of(u32 runs, Func&& func)
+{
+    f64 best = 1e30;
+    for (u32 i = 0; i < runs; ++i)
+    {
+        const auto start = clock_type::now();
+        func();
+        best = std::min(best, std::chrono::duration<f64>(clock_type::now() - start).count());
+    }
+    return best;
+}
+
+void bench(u32 count)
+{
+    std::mt19937                        rng{ count };
+    std::uniform_real_distribution<f32> spread{ -100.f, 100.f };
+    std::uniform_real_distribution<f32> depth{ 0.f, 300.f };
+    std::uniform_real_distribution<f32> radius{ 2.f, 15.f };
+
+    std::vector<packed_pointlight> lights(count);
+    for (packed_pointlight& light : lights)
+    {
+        light.position = { spread(rng), spread(rng), depth(rng) };
+        light.radius   = radius(rng);
+    }
+
+    const math::matrix view = XMMatrixLookAtLH(XMVectorSet(0.f, 0.f, 0.f, 1.f), XMVectorSet(0.f, 0.f, 1.f, 1.f),
+                                               XMVectorSet(0.f, 1.f, 0.f, 0.f));
+    const math::matrix projection = XMMatrixPerspectiveFovLH(math::pi / 3.f, 16.f / 9.f, .3f, 1000.f);
+
+    light_clusters clusters{};
+    const u32      runs    = 30;
+    const f64      scalar  = best_of(runs, [&] { clusters.build_scalar(view, projection, lights.data(), count); });
+    const f64      batched = best_of(runs, [&] { clusters.build(view, projection, lights.data(), count); });
+
+    printf("%6u lights: scalar %8.3f ms, batched %8.3f ms, %5.2fx, %u visible, %u indices\n", count, scalar * 1e3,
+           batched * 1e3, scalar / batched, clusters.visible_count(), (u32) clusters.indices().size());
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+    const u32 workers = argc > 1 ? (u32) strtoul(argv[1], nullptr, 10) : 0;
+    jobs::init(workers);
+    printf("Light cluster benchmark, %u workers\n", jobs::worker_count());
+
+    for (const u32 count : { 64u, 256u, 1'024u, 4'096u, 16'384u })
+    {
+        bench(count);
+    }
+
+    jobs::shutdown();
+    return 0;
+}
@@ -0,0 +1,260 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: ClustersTest.cpp
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+
+// Checks the batched, parallel light cluster build against build_scalar on randomized lights, cameras and cluster
+// grids. Grids whose tile count isn't a multiple of 4 cover the padded SIMD lanes. Every range and index must match
+// exactly, and a light must at least land in the cluster holding its center. Returns non-zero if any scene mismatches
+
+#include "Yae/Core/Jobs.h"
+#include "Yae/Graphics/LightClusters.h"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace yae;
+using namespace yae::gfx;
+
+namespace
+{
+
+u32 failures = 0;
+
+void check(bool condition, const char* what, u32 scene)
+{
+    if (!condition)
+    {
+        fprintf(stderr, "FAILED in scene %u: %s\n", scene, what);
+        ++failures;
+    }
+}
+
+f32 uniform(std::mt19937& rng, f32 lo, f32 hi)
+{
+    return std::uniform_real_distribution<f32>{ lo, hi }(rng);
+}
+
+math::vector random_point(std::mt19937& rng, f32 range)
+{
+    return XMVectorSet(uniform(rng, -range, range), uniform(rng, -range, range), uniform(rng, -range, range), 1.f);
+}
+
+std::vector<packed_pointlight> random_lights(std::mt19937& rng, u32 count)
+{
+    std::vector<packed_pointlight> lights(count);
+    for (packed_pointlight& light : lights)
+    {
+        XMStoreFloat3(&light.position, random_point(rng, 150.f));
+
+        // Mostly small lights, a few tiny ones and a few covering most of the view
+        const f32 kind  = uniform(rng, 0.f, 1.f);
+        light.radius    = kind < .05f ? uniform(rng, 0.f, .05f) : uniform(rng, .5f, 20.f);
+        light.radius    = kind < .95f ? light.radius : uniform(rng, 50.f, 300.f);
+        light.color     = { 1.f, 1.f, 1.f };
+        light.intensity = 1.f;
+    }
+    return lights;
+}
+
+struct camera
+{
+    math::matrix view{};
+    math::matrix projection{};
+};
+
+camera random_camera(std::mt19937& rng)
+{
+    const math::vector eye    = random_point(rng, 50.f);
+    const math::vector at     = XMVectorAdd(eye, random_point(rng, 10.f));
+    const f32          fov    = uniform(rng, .4f, 2.f);
+    const f32          aspect = uniform(rng, .5f, 2.5f);
+    const f32          near_z = uniform(rng, .05f, 2.f);
+
+    camera c{};
+    c.view       = XMMatrixLookAtLH(eye, at, XMVectorSet(0.f, 1.f, 0.f, 0.f));
+    c.projection = XMMatrixPerspectiveFovLH(fov, aspect, near_z, uniform(rng, 50.f, 1000.f));
+    return c;
+}
+
+// The cluster a world space point falls in, false if it is outside the frustum
+bool cluster_of(const light_clusters& clusters, const camera& c, const math::vec3& position, u32& cluster)
+{
+    math::vec3 v{};
+    XMStoreFloat3(&v, XMVector3TransformCoord(XMLoadFloat3(&position), c.view));
+
+    const f32 a      = XMVectorGetZ(c.projection.r[2]);
+    const f32 b      = XMVectorGetZ(c.projection.r[3]);
+    const f32 near_z = -b / a;
+    const f32 far_z  = b / (1.f - a);
+    if (v.z <= near_z || v.z >= far_z)
+    {
+        return false;
+    }
+
+    const f32 ndc_x = v.x * XMVectorGetX(c.projection.r[0]) / v.z;
+    const f32 ndc_y = v.y * XMVectorGetY(c.projection.r[1]) / v.z;
+    if (ndc_x <= -1.f || ndc_x >= 1.f || ndc_y <= -1.f || ndc_y >= 1.f)
+    {
+        return false;
+    }
+
+    const u32 x = (u32) ((ndc_x + 1.f) * .5f * (f32) clusters.tiles_x());
+    const u32 y = (u32) ((1.f - ndc_y) * .5f * (f32) clusters.tiles_y());
+    cluster     = clusters.cluster_index(x, y, clusters.slice(v.z));
+    return true;
+}
+
+bool contains(const light_clusters& clusters, u32 cluster, u32 light)
+{
+    const cluster_range& range = clusters.ranges()[cluster];
+    for (u32 i = range.offset; i < range.offset + range.count; ++i)
+    {
+        if (clusters.indices()[i] == light)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void random_scene(u32 scene, u32 tiles_x, u32 tiles_y, u32 slices, u32 count)
+{
+    std::mt19937 rng{ scene };
+
+    light_clusters scalar{ tiles_x, tiles_y, slices };
+    light_clusters batched{ tiles_x, tiles_y, slices };
+
+    // Two cameras per scene, so the second build also checks the cluster volumes follow a new projection
+    for (u32 frame = 0; frame < 2; ++frame)
+    {
+        const std::vector<packed_pointlight> lights = random_lights(rng, count);
+        const camera                         c      = random_camera(rng);
+
+        scalar.build_scalar(c.view, c.projection, lights.data(), count);
+        batched.build(c.view, c.projection, lights.data(), count);
+
+        check(scalar.indices() == batched.indices(), "light indices differ", scene);
+        check(scalar.visible_count() == batched.visible_count(), "visible light counts differ", scene);
+
+        bool ranges_match = true;
+        bool ascending    = true;
+        for (u32 i = 0; i < scalar.cluster_count(); ++i)
+        {
+            const cluster_range& a = scalar.ranges()[i];
+            const cluster_range& b = batched.ranges()[i];
+            ranges_match           = ranges_match && a.offset == b.offset && a.count == b.count;
+
+            for (u32 j = a.offset + 1; j < a.offset + a.count; ++j)
+            {
+                ascending = ascending && scalar.indices()[j - 1] < scalar.indices()[j];
+            }
+        }
+        check(ranges_match, "cluster ranges differ", scene);
+        check(ascending, "a cluster's lights are in ascending order", scene);
+
+        for (u32 l = 0; l < count; ++l)
+        {
+            u32 cluster{};
+            if (lights[l].radius > .01f && cluster_of(scalar, c, lights[l].position, cluster))
+            {
+                check(contains(scalar, cluster, l), "a light is in the cluster holding its center", scene);
+            }
+        }
+    }
+}
+
+// A light straight ahead and one behind the camera
+void known_lights()
+{
+    const math::matrix view = XMMatrixLookAtLH(XMVectorSet(0.f, 0.f, 0.f, 1.f), XMVectorSet(0.f, 0.f, 1.f, 1.f),
+                                               XMVectorSet(0.f, 1.f, 0.f, 0.f));
+    const math::matrix projection = XMMatrixPerspectiveFovLH(math::pi / 2.f, 1.f, .1f, 100.f);
+
+    packed_pointlight lights[2]{};
+    lights[0].position = { 0.f, 0.f, 10.f };
+    lights[0].radius   = 1.f;
+    lights[1].position = { 0.f, 0.f, -10.f };
+    lights[1].radius   = 1.f;
+
+    light_clusters clusters{ 4, 4, 8 };
+    clusters.build(view, projection, lights, 2);
+
+    check(clusters.visible_count() == 1, "only the light ahead is visible", 0);
+    check(!clusters.indices().empty(), "the light ahead is in some cluster", 0);
+
+    // The center sits on the corner of the four middle tiles
+    const u32 slice = clusters.slice(10.f);
+    for (const u32 x : { 1u, 2u })
+    {
+        for (const u32 y : { 1u, 2u })
+        {
+            check(contains(clusters, clusters.cluster_index(x, y, slice), 0), "the middle tiles hold the light ahead", 0);
+        }
+    }
+    check(!contains(clusters, clusters.cluster_index(0, 0, slice), 0), "a corner tile doesn't", 0);
+
+    bool behind_anywhere = false;
+    for (const u32 index : clusters.indices())
+    {
+        behind_anywhere = behind_anywhere || index == 1;
+    }
+    check(!behind_anywhere, "the light behind the camera is in no cluster", 0);
+}
+
+} // anonymous namespace
+
+int main()
+{
+    // More workers than slices in the small grids, fewer than in the engine's
+    jobs::init(4);
+
+    known_lights();
+
+    struct grid
+    {
+        u32 tiles_x, tiles_y, slices;
+    };
+
+    // The engine's grid, a single cluster, and grids whose tile count leaves 1, 2 and 3 padding lanes
+    u32 scene = 1;
+    for (const grid g : { grid{ 16, 9, 24 }, grid{ 1, 1, 1 }, grid{ 5, 3, 7 }, grid{ 7, 5, 16 }, grid{ 3, 2, 4 } })
+    {
+        for (const u32 count : { 0u, 1u, 3u, 17u, 100u, 1'000u })
+        {
+            for (u32 i = 0; i < 4; ++i)
+            {
+                random_scene(scene++, g.tiles_x, g.tiles_y, g.slices, count);
+            }
+        }
+    }
+
+    jobs::shutdown();
+
+    if (failures)
+    {
+        fprintf(stderr, "%u checks failed\n", failures);
+        return 1;
+    }
+    printf("Light cluster test passed, %u scenes\n", scene - 1);
+    return 0;
+}
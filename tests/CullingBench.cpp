@@ -0,0 +1,110 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: CullingBench.cpp
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+
+// Frustum culling cost per box, cull_scalar against the batched cull (8 wide with YAE_AVX2, otherwise 4), on random
+// scenes of a few sizes. Pass a box count as the first argument to time only that size
+
+#include "Yae/Graphics/Culling.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace yae;
+using namespace yae::gfx;
+
+namespace
+{
+
+using clock_type = std::chrono::steady_clock;
+
+template<typename Func>
+f64 best_of(u32 runs, Func&& func)
+{
+    f64 best = 1e30;
+    for (u32 i = 0; i < runs; ++i)
+    {
+        const auto start = clock_type::now();
+        func();
+        best = std::min(best, std::chrono::duration<f64>(clock_type::now() - start).count());
+    }
+    return best;
+}
+
+void bench(u32 count)
+{
+    std::mt19937                        rng{ count };
+    std::uniform_real_distribution<f32> position{ -200.f, 200.f };
+    std::uniform_real_distribution<f32> size{ .1f, 5.f };
+
+    std::vector<culling::cull_handle> handles{};
+    for (u32 i = 0; i < count; ++i)
+    {
+        const math::vec3 center{ position(rng), position(rng), position(rng) };
+        handles.push_back(culling::add(math::aabb::from_center(center, { size(rng), size(rng), size(rng) })));
+    }
+
+    // Looking down +z from the middle of the scene, about a quarter of the boxes are visible
+    const math::matrix view =
+        XMMatrixLookAtLH(XMVectorSet(0.f, 0.f, 0.f, 1.f), XMVectorSet(0.f, 0.f, 1.f, 1.f), XMVectorSet(0.f, 1.f, 0.f, 0.f));
+    const math::matrix  proj    = XMMatrixPerspectiveFovLH(math::pi / 2.f, 16.f / 9.f, .1f, 300.f);
+    const math::frustum frustum = math::frustum::from_matrix(XMMatrixMultiply(view, proj));
+
+    const u32 runs    = std::max(5u, 20'000'000u / std::max(count, 1u) / 10);
+    const f64 scalar  = best_of(runs, [&] { culling::cull_scalar(frustum); });
+    const f64 batched = best_of(runs, [&] { culling::cull(frustum); });
+
+    printf("%9u boxes: scalar %7.2f ns/box, batched %7.2f ns/box, %5.2fx, %u visible\n", count, scalar / count * 1e9,
+           batched / count * 1e9, scalar / batched, (u32) culling::visible().size());
+
+    for (const culling::cull_handle h : handles)
+    {
+        culling::remove(h);
+    }
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+#if defined(__AVX2__)
+    printf("Culling benchmark, AVX2\n");
+#else
+    printf("Culling benchmark, SSE\n");
+#endif
+
+    if (argc > 1)
+    {
+        bench((u32) strtoul(argv[1], nullptr, 10));
+        return 0;
+    }
+
+    for (const u32 count : { 1'000u, 10'000u, 100'000u, 1'000'000u })
+    {
+        bench(count);
+    }
+    return 0;
+}
@@ -0,0 +1,198 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: CullingTest.cpp
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+
+// Checks the batched frustum culler against cull_scalar on randomized scenes. Box counts cover every SIMD tail, boxes
+// range from points to ones larger than the frustum and cameras look in random directions. Removing and moving boxes
+// in between checks the SoA arrays stay in step with their handles. Returns non-zero if any scene mismatches
+
+#include "Yae/Graphics/Culling.h"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace yae;
+using namespace yae::gfx;
+
+namespace
+{
+
+u32 failures = 0;
+
+void check(bool condition, const char* what, u32 scene)
+{
+    if (!condition)
+    {
+        fprintf(stderr, "FAILED in scene %u: %s\n", scene, what);
+        ++failures;
+    }
+}
+
+f32 uniform(std::mt19937& rng, f32 lo, f32 hi)
+{
+    return std::uniform_real_distribution<f32>{ lo, hi }(rng);
+}
+
+math::aabb random_box(std::mt19937& rng)
+{
+    const math::vec3 center{ uniform(rng, -200.f, 200.f), uniform(rng, -200.f, 200.f), uniform(rng, -200.f, 200.f) };
+
+    // Mostly small boxes, some points and a few spanning most of the scene
+    const f32 kind = uniform(rng, 0.f, 1.f);
+    const f32 size = kind < .1f ? 0.f : kind < .95f ? uniform(rng, .1f, 10.f) : uniform(rng, 50.f, 400.f);
+    return math::aabb::from_center(center, { size * uniform(rng, 0.f, 1.f), size * uniform(rng, 0.f, 1.f),
+                                             size * uniform(rng, 0.f, 1.f) });
+}
+
+math::vector random_point(std::mt19937& rng, f32 range)
+{
+    return XMVectorSet(uniform(rng, -range, range), uniform(rng, -range, range), uniform(rng, -range, range), 1.f);
+}
+
+math::frustum random_frustum(std::mt19937& rng)
+{
+    const f32 fov    = uniform(rng, .3f, 2.f);
+    const f32 aspect = uniform(rng, .5f, 2.5f);
+    const f32 far_z  = uniform(rng, 20.f, 500.f);
+
+    const math::vector eye = random_point(rng, 50.f);
+    const math::vector at  = random_point(rng, 100.f);
+
+    const math::matrix view = XMMatrixLookAtLH(eye, at, XMVectorSet(0.f, 1.f, 0.f, 0.f));
+    const math::matrix proj = XMMatrixPerspectiveFovLH(fov, aspect, .1f, far_z);
+    return math::frustum::from_matrix(XMMatrixMultiply(view, proj));
+}
+
+// Runs both cullers on the registered boxes and compares the visible lists and every handle's flag
+void compare(const math::frustum& frustum, const std::vector<culling::cull_handle>& handles, u32 scene)
+{
+    culling::cull_scalar(frustum);
+    const std::vector<u32> expected = culling::visible();
+    std::vector<u8>        expected_flags{};
+    for (const culling::cull_handle h : handles)
+    {
+        expected_flags.push_back(culling::is_visible(h));
+    }
+
+    culling::cull(frustum);
+    check(culling::visible() == expected, "visible lists differ", scene);
+
+    bool flags_match = true;
+    for (u32 i = 0; i < handles.size(); ++i)
+    {
+        flags_match = flags_match && culling::is_visible(handles[i]) == (bool) expected_flags[i];
+    }
+    check(flags_match, "visible flags differ", scene);
+}
+
+void random_scene(u32 scene, u32 count)
+{
+    std::mt19937 rng{ scene };
+
+    std::vector<culling::cull_handle> handles{};
+    for (u32 i = 0; i < count; ++i)
+    {
+        handles.push_back(culling::add(random_box(rng)));
+    }
+    check(culling::count() == count, "every box is registered", scene);
+
+    const math::frustum frustum = random_frustum(rng);
+    compare(frustum, handles, scene);
+
+    // Removing swaps the last box into the hole, moving rewrites one slot
+    for (u32 i = 0; i < count / 3; ++i)
+    {
+        const u32 index = std::uniform_int_distribution<u32>{ 0, (u32) handles.size() - 1 }(rng);
+        culling::remove(handles[index]);
+        handles[index] = handles.back();
+        handles.pop_back();
+    }
+    for (u32 i = 0; i < handles.size(); i += 2)
+    {
+        culling::update(handles[i], random_box(rng));
+    }
+    compare(frustum, handles, scene);
+    compare(random_frustum(rng), handles, scene);
+
+    for (const culling::cull_handle h : handles)
+    {
+        culling::remove(h);
+    }
+    check(culling::count() == 0, "every box is removed", scene);
+}
+
+// Boxes whose answer doesn't depend on rounding
+void known_boxes()
+{
+    const math::matrix view =
+        XMMatrixLookAtLH(XMVectorSet(0.f, 0.f, 0.f, 1.f), XMVectorSet(0.f, 0.f, 1.f, 1.f), XMVectorSet(0.f, 1.f, 0.f, 0.f));
+    const math::matrix  proj    = XMMatrixPerspectiveFovLH(math::pi / 2.f, 1.f, .1f, 100.f);
+    const math::frustum frustum = math::frustum::from_matrix(XMMatrixMultiply(view, proj));
+
+    const culling::cull_handle ahead  = culling::add(math::aabb::from_center({ 0.f, 0.f, 10.f }, { 1.f, 1.f, 1.f }));
+    const culling::cull_handle behind = culling::add(math::aabb::from_center({ 0.f, 0.f, -10.f }, { 1.f, 1.f, 1.f }));
+    const culling::cull_handle beyond = culling::add(math::aabb::from_center({ 0.f, 0.f, 150.f }, { 1.f, 1.f, 1.f }));
+    const culling::cull_handle left   = culling::add(math::aabb::from_center({ -30.f, 0.f, 10.f }, { 1.f, 1.f, 1.f }));
+    const culling::cull_handle across = culling::add(math::aabb::from_center({ 0.f, 0.f, 0.f }, { 500.f, 500.f, 500.f }));
+
+    culling::cull(frustum);
+    check(culling::is_visible(ahead), "a box in front of the camera is visible", 0);
+    check(!culling::is_visible(behind), "a box behind the camera is culled", 0);
+    check(!culling::is_visible(beyond), "a box beyond the far plane is culled", 0);
+    check(!culling::is_visible(left), "a box outside the left plane is culled", 0);
+    check(culling::is_visible(across), "a box containing the frustum is visible", 0);
+
+    for (const culling::cull_handle h : { ahead, behind, beyond, left, across })
+    {
+        culling::remove(h);
+    }
+}
+
+} // anonymous namespace
+
+int main()
+{
+    known_boxes();
+
+    // Every remainder of 8 and 4, then larger scenes
+    u32 scene = 1;
+    for (u32 count = 0; count <= 33; ++count)
+    {
+        random_scene(scene++, count);
+    }
+    for (const u32 count : { 100u, 1'000u, 4'097u, 20'000u })
+    {
+        for (u32 i = 0; i < 8; ++i)
+        {
+            random_scene(scene++, count);
+        }
+    }
+
+    if (failures)
+    {
+        fprintf(stderr, "%u checks failed\n", failures);
+        return 1;
+    }
+    printf("Culling test passed, %u scenes\n", scene - 1);
+    return 0;
+}
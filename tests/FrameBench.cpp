@@ -0,0 +1,480 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: FrameBench.cpp
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+
+// CPU cost of a frame's geometry pass on the null backend: cull, queue, sort, the instance upload, and the draws
+// recorded through command recorders in parallel and executed in order. application::frame can't run here, the
+// renderer and the models it draws need the D3D11 core and the shader compiler, so the scene is synthetic: meshes,
+// material blocks and shaders are null backend objects, bound and drawn the way draw_geometry in Renderer.cpp does.
+// Prints the best time of each phase and the backend's counters for one frame. Pass a worker count as the first
+// argument and a command list count as the second
+
+#include "Yae/Core/Jobs.h"
+#include "Yae/Graphics/CommandRecorder.h"
+#include "Yae/Graphics/Culling.h"
+#include "Yae/Graphics/NullBackend.h"
+#include "Yae/Graphics/RenderQueue.h"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace yae;
+using namespace yae::gfx;
+
+namespace
+{
+
+using clock_type = std::chrono::steady_clock;
+
+constexpr u32 mesh_count     = 64;
+constexpr u32 block_count    = 48;
+constexpr u32 material_count = 192; // Four tints per block
+constexpr u32 shader_count   = 4;
+constexpr u32 frame_count    = 20;
+
+// Matches the renderer's per instance stream
+struct instance_data
+{
+    math::mat4 world{};
+    math::vec4 tint{};
+};
+
+struct mesh_data
+{
+    ID3D11Buffer* vertices{};
+    ID3D11Buffer* indices{};
+    u32           index_count{};
+};
+
+// What materials::bind binds for a block
+struct block_data
+{
+    ID3D11PixelShader*        ps{};
+    ID3D11ShaderResourceView* views[3]{};
+    ID3D11SamplerState*       sampler{};
+    u32                       shader{};
+};
+
+struct object
+{
+    culling::cull_handle cull{};
+    math::mat4           world{};
+    u32                  mesh{};
+    material_id          mat{};
+};
+
+// The queue only compares model pointers, so meshes are stand-in pointers that encode their index
+class mesh_ids
+{
+public:
+    ref<const model> mesh(u32 i) const { return { m_owner, (const model*) (m_base + (i + 1) * 64) }; }
+    u32              index(const model* mesh) const { return (u32) (((uintptr_t) mesh - m_base) / 64 - 1); }
+
+private:
+    ref<u8[]> m_owner{ new u8[1]{} };
+    uintptr_t m_base{ 0x10000 };
+};
+
+struct phase_times
+{
+    f64 cull{ 1e30 };
+    f64 queue{ 1e30 };
+    f64 sort{ 1e30 };
+    f64 upload{ 1e30 };
+    f64 record{ 1e30 };
+    f64 execute{ 1e30 };
+};
+
+f64 seconds_since(clock_type::time_point& start)
+{
+    const clock_type::time_point now = clock_type::now();
+    const f64                    s   = std::chrono::duration<f64>(now - start).count();
+    start                            = now;
+    return s;
+}
+
+ID3D11Buffer* create_buffer(render_backend& backend, u32 bytes, u32 bind, D3D11_USAGE usage = D3D11_USAGE_DEFAULT)
+{
+    D3D11_BUFFER_DESC desc{};
+    desc.ByteWidth      = bytes;
+    desc.Usage          = usage;
+    desc.BindFlags      = bind;
+    desc.CPUAccessFlags = usage == D3D11_USAGE_DYNAMIC ? D3D11_CPU_ACCESS_WRITE : 0;
+
+    ID3D11Buffer* buffer{};
+    backend.create_buffer(&desc, nullptr, &buffer);
+    return buffer;
+}
+
+ID3D11ShaderResourceView* create_texture_view(render_backend& backend, u32 size)
+{
+    D3D11_TEXTURE2D_DESC desc{};
+    desc.Width            = size;
+    desc.Height           = size;
+    desc.MipLevels        = 1;
+    desc.ArraySize        = 1;
+    desc.Format           = DXGI_FORMAT_R8G8B8A8_UNORM;
+    desc.SampleDesc.Count = 1;
+    desc.BindFlags        = D3D11_BIND_SHADER_RESOURCE;
+
+    ID3D11Texture2D*          texture{};
+    ID3D11ShaderResourceView* view{};
+    backend.create_texture2d(&desc, nullptr, &texture);
+    backend.create_shader_resource_view(texture, nullptr, &view);
+    texture->Release();
+    return view;
+}
+
+class frame_bench
+{
+public:
+    frame_bench(u32 object_count, u32 list_count) : m_backend{ 1920, 1080 }
+    {
+        std::mt19937                        rng{ object_count };
+        std::uniform_real_distribution<f32> position{ -200.f, 200.f };
+        std::uniform_int_distribution<u32>  pick_mesh{ 0, mesh_count - 1 };
+        std::uniform_int_distribution<u32>  pick_material{ 0, material_count - 1 };
+
+        const u8 bytecode[16]{};
+        m_backend.create_vertex_shader(bytecode, sizeof(bytecode), &m_vs);
+        m_frame_constants = create_buffer(m_backend, 256, D3D11_BIND_CONSTANT_BUFFER);
+
+        for (u32 i = 0; i < mesh_count; ++i)
+        {
+            mesh_data& mesh  = m_meshes.emplace_back();
+            mesh.index_count = 36 * (1 + i % 8);
+            mesh.vertices    = create_buffer(m_backend, 32 * mesh.index_count, D3D11_BIND_VERTEX_BUFFER);
+            mesh.indices     = create_buffer(m_backend, 4 * mesh.index_count, D3D11_BIND_INDEX_BUFFER);
+        }
+
+        D3D11_SAMPLER_DESC sampler_desc{};
+        m_backend.create_sampler_state(&sampler_desc, &m_sampler);
+        for (u32 i = 0; i < block_count; ++i)
+        {
+            block_data& block = m_blocks.emplace_back();
+            block.shader      = i % shader_count;
+            block.sampler     = m_sampler;
+            m_backend.create_pixel_shader(bytecode, sizeof(bytecode), &block.ps);
+            for (ID3D11ShaderResourceView*& view : block.views)
+            {
+                view = create_texture_view(m_backend, 64);
+            }
+        }
+
+        for (u32 i = 0; i < object_count; ++i)
+        {
+            object&          o = m_objects.emplace_back();
+            const math::vec3 center{ position(rng), position(rng), position(rng) };
+            XMStoreFloat4x4(&o.world, XMMatrixTranslation(center.x, center.y, center.z));
+            o.mesh = pick_mesh(rng);
+            o.mat  = pick_material(rng);
+            o.cull = culling::add(math::aabb::from_center(center, { 1.f, 1.f, 1.f }));
+        }
+
+        for (u32 i = 0; i < list_count; ++i)
+        {
+            m_recorders.push_back(m_backend.create_recorder());
+        }
+        m_lists.resize(list_count);
+    }
+
+    ~frame_bench()
+    {
+        for (const object& o : m_objects)
+        {
+            culling::remove(o.cull);
+        }
+        for (render_backend* recorder : m_recorders)
+        {
+            delete recorder;
+        }
+        for (const mesh_data& mesh : m_meshes)
+        {
+            mesh.vertices->Release();
+            mesh.indices->Release();
+        }
+        for (const block_data& block : m_blocks)
+        {
+            block.ps->Release();
+            for (ID3D11ShaderResourceView* view : block.views)
+            {
+                view->Release();
+            }
+        }
+        if (m_instances)
+        {
+            m_instances->Release();
+        }
+        m_sampler->Release();
+        m_frame_constants->Release();
+        m_vs->Release();
+    }
+
+    DISABLE_COPY_AND_MOVE(frame_bench);
+
+    void run(phase_times& best)
+    {
+        // Looking down +z from the middle of the scene, about a quarter of the objects are visible
+        const math::matrix view = XMMatrixLookAtLH(XMVectorSet(0.f, 0.f, 0.f, 1.f), XMVectorSet(0.f, 0.f, 1.f, 1.f),
+                                                   XMVectorSet(0.f, 1.f, 0.f, 0.f));
+        const math::matrix projection = XMMatrixPerspectiveFovLH(math::pi / 2.f, 16.f / 9.f, .1f, 300.f);
+        const math::frustum frustum   = math::frustum::from_matrix(XMMatrixMultiply(view, projection));
+
+        m_recorded_bytes             = 0;
+        clock_type::time_point start = clock_type::now();
+
+        culling::cull(frustum);
+        best.cull = std::min(best.cull, seconds_since(start));
+
+        // Materials are resolved by the caller, as Renderer::render3d does with the registry
+        m_queue.begin(view);
+        for (const u32 index : culling::visible())
+        {
+            const object& o     = m_objects[index];
+            const u32     block = o.mat % block_count;
+            m_queue.submit(m_ids.mesh(o.mesh), XMLoadFloat4x4(&o.world), o.mat, block, m_blocks[block].shader);
+        }
+        best.queue = std::min(best.queue, seconds_since(start));
+
+        m_queue.sort();
+        const std::span<const u32> order = m_queue.sorted(render_pass::geometry);
+        best.sort                        = std::min(best.sort, seconds_since(start));
+
+        upload_instances(order);
+        best.upload = std::min(best.upload, seconds_since(start));
+
+        record(order);
+        best.record = std::min(best.record, seconds_since(start));
+
+        for (ID3D11CommandList*& list : m_lists)
+        {
+            if (list)
+            {
+                m_recorded_bytes += static_cast<recorded_command_list*>(list)->recorded_bytes();
+                m_backend.execute_command_list(list);
+                list->Release();
+                list = nullptr;
+            }
+        }
+        m_backend.present(false);
+        best.execute = std::min(best.execute, seconds_since(start));
+
+        m_queue.clear(render_pass::geometry);
+    }
+
+    const null_backend& backend() const { return m_backend; }
+    u64                 instance_bytes() const { return m_written_bytes; }
+    u64                 recorded_bytes() const { return m_recorded_bytes; }
+    u32                 visible() const { return (u32) culling::visible().size(); }
+
+private:
+    u32 block_of(u32 packet) const
+    {
+        return (u32) (m_queue.key(packet) >> render_queue::material_shift) & ((1u << render_queue::material_bits) - 1);
+    }
+
+    bool same_run(std::span<const u32> order, u32 a, u32 b) const
+    {
+        return m_queue.packet(order[a]).mesh == m_queue.packet(order[b]).mesh && block_of(order[a]) == block_of(order[b]);
+    }
+
+    // One map for the whole pass, as flush_queue does
+    void upload_instances(std::span<const u32> order)
+    {
+        const u32 bytes = std::max((u32) order.size(), 1u) * (u32) sizeof(instance_data);
+        if (!m_instances || bytes > m_instance_bytes)
+        {
+            if (m_instances)
+            {
+                m_instances->Release();
+            }
+            m_instance_bytes = std::bit_ceil(bytes);
+            m_instances = create_buffer(m_backend, m_instance_bytes, D3D11_BIND_VERTEX_BUFFER, D3D11_USAGE_DYNAMIC);
+        }
+
+        D3D11_MAPPED_SUBRESOURCE mapped{};
+        if (FAILED(m_backend.map(m_instances, 0, D3D11_MAP_WRITE_DISCARD, &mapped)))
+        {
+            return;
+        }
+
+        instance_data* instances = (instance_data*) mapped.pData;
+        for (const u32 index : order)
+        {
+            const draw_packet& packet = m_queue.packet(index);
+            const f32          shade  = .25f * (f32) (1 + packet.mat / block_count);
+            *instances++              = { packet.world, { shade, shade, shade, 1.f } };
+        }
+        m_backend.unmap(m_instances, 0);
+        m_written_bytes = (u64) order.size() * sizeof(instance_data);
+    }
+
+    // Chunks of whole runs, each recorded by a job into its own list like draw_geometry_recorded
+    void record(std::span<const u32> order)
+    {
+        const u32 count       = (u32) order.size();
+        const u32 chunk_count = (u32) m_recorders.size();
+
+        m_bounds.clear();
+        m_bounds.push_back(0);
+        for (u32 i = 1; i < chunk_count; ++i)
+        {
+            u32 bound = std::max((u32) ((u64) count * i / chunk_count), m_bounds.back());
+            while (bound > 0 && bound < count && same_run(order, bound - 1, bound))
+            {
+                ++bound;
+            }
+            m_bounds.push_back(bound);
+        }
+        m_bounds.push_back(count);
+
+        jobs::parallel_for(0, chunk_count, 1, [this, order](u32 begin, u32 end) {
+            for (u32 chunk = begin; chunk < end; ++chunk)
+            {
+                record_chunk(chunk, order);
+            }
+        });
+    }
+
+    void record_chunk(u32 chunk, std::span<const u32> order)
+    {
+        render_backend& target = *m_recorders[chunk];
+
+        // A list starts from the default state, everything the pass relies on is bound again
+        const u32 instance_stride = sizeof(instance_data);
+        const u32 zero            = 0;
+        target.set_topology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+        target.set_vertex_shader(m_vs);
+        target.set_constant_buffers(shader_stage::vertex, 0, 1, &m_frame_constants);
+        target.set_constant_buffers(shader_stage::pixel, 0, 1, &m_frame_constants);
+        target.set_vertex_buffers(1, 1, &m_instances, &instance_stride, &zero);
+
+        const mesh_data*  bound_mesh{};
+        const block_data* bound_block{};
+        for (u32 first = m_bounds[chunk]; first < m_bounds[chunk + 1];)
+        {
+            u32 last = first + 1;
+            while (last < m_bounds[chunk + 1] && same_run(order, first, last))
+            {
+                ++last;
+            }
+
+            const block_data& block = m_blocks[block_of(order[first])];
+            if (&block != bound_block)
+            {
+                if (!bound_block || block.ps != bound_block->ps)
+                {
+                    target.set_pixel_shader(block.ps);
+                }
+                target.set_shader_resources(shader_stage::pixel, 0, 3, block.views);
+                target.set_samplers(shader_stage::pixel, 0, 1, &block.sampler);
+                bound_block = &block;
+            }
+
+            const mesh_data& mesh = m_meshes[m_ids.index(m_queue.packet(order[first]).mesh.get())];
+            if (&mesh != bound_mesh)
+            {
+                const u32 stride = 32;
+                target.set_vertex_buffers(0, 1, &mesh.vertices, &stride, &zero);
+                target.set_index_buffer(mesh.indices, DXGI_FORMAT_R32_UINT, 0);
+                bound_mesh = &mesh;
+            }
+
+            target.draw_indexed_instanced(mesh.index_count, last - first, 0, 0, first);
+            first = last;
+        }
+
+        if (FAILED(target.finish_command_list(&m_lists[chunk])))
+        {
+            fprintf(stderr, "Failed to finish command list %u\n", chunk);
+            m_lists[chunk] = nullptr;
+        }
+    }
+
+    null_backend m_backend;
+    render_queue m_queue{};
+    mesh_ids     m_ids{};
+
+    std::vector<mesh_data>  m_meshes{};
+    std::vector<block_data> m_blocks{};
+    std::vector<object>     m_objects{};
+
+    ID3D11VertexShader* m_vs{};
+    ID3D11Buffer*       m_frame_constants{};
+    ID3D11SamplerState* m_sampler{};
+    ID3D11Buffer*       m_instances{};
+    u32                 m_instance_bytes{};
+    u64                 m_written_bytes{};  // Instances written through the last frame's map
+    u64                 m_recorded_bytes{}; // Of the lists executed in the last frame
+
+    std::vector<render_backend*>    m_recorders{};
+    std::vector<ID3D11CommandList*> m_lists{};
+    std::vector<u32>                m_bounds{}; // Chunk i covers [m_bounds[i], m_bounds[i + 1]) of the order
+};
+
+void bench(u32 object_count, u32 list_count)
+{
+    frame_bench frame{ object_count, list_count };
+    phase_times best{};
+
+    // The first frame also counts the scene's creation, the rest are steady state
+    for (u32 i = 0; i < frame_count; ++i)
+    {
+        frame.run(best);
+    }
+
+    const f64 total = best.cull + best.queue + best.sort + best.upload + best.record + best.execute;
+    printf("%7u objects, %5u visible: cull %6.3f, queue %6.3f, sort %6.3f, upload %6.3f, record %6.3f, execute %6.3f, "
+           "total %7.3f ms\n",
+           object_count, frame.visible(), best.cull * 1e3, best.queue * 1e3, best.sort * 1e3, best.upload * 1e3,
+           best.record * 1e3, best.execute * 1e3, total * 1e3);
+
+    const null_frame_stats& stats = frame.backend().last_frame();
+    printf("%30s calls %u, binds %u, draws %u, maps %u, vertices %llu, instance bytes %llu, list bytes %llu\n", "",
+           stats.calls, stats.binds, stats.draws, stats.maps, (unsigned long long) stats.vertices,
+           (unsigned long long) frame.instance_bytes(), (unsigned long long) frame.recorded_bytes());
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+    const u32 workers = argc > 1 ? (u32) strtoul(argv[1], nullptr, 10) : 0;
+    jobs::init(workers);
+
+    const u32 list_count = argc > 2 ? std::max((u32) strtoul(argv[2], nullptr, 10), 1u) : jobs::worker_count() + 1;
+    printf("Frame benchmark, %u workers, %u command lists\n", jobs::worker_count(), list_count);
+
+    for (const u32 count : { 1'000u, 10'000u, 100'000u })
+    {
+        bench(count, list_count);
+    }
+
+    jobs::shutdown();
+    return 0;
+}
@@ -0,0 +1,311 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: FrameGraphTest.cpp
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+
+// Compiles frame graphs without a device and checks the result: passes whose writes nobody reads are culled while
+// imported and kept ones survive, readers run after their writers, cycles and broken declarations are rejected, and
+// transients share a physical slot exactly when their descriptions match and their lifetimes don't overlap.
+// Returns non-zero if any check fails
+
+#include "Yae/Graphics/FrameGraph.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace yae;
+using namespace yae::gfx;
+
+namespace
+{
+
+u32 failures = 0;
+
+void check(bool condition, const char* what, const char* test)
+{
+    if (!condition)
+    {
+        fprintf(stderr, "FAILED in %s: %s\n", test, what);
+        ++failures;
+    }
+}
+
+constexpr transient_desc color{ 64, 64, DXGI_FORMAT_R16G16B16A16_FLOAT, false };
+constexpr transient_desc other_color{ 64, 64, DXGI_FORMAT_R8G8B8A8_UNORM, false };
+constexpr transient_desc smaller_color{ 32, 32, DXGI_FORMAT_R16G16B16A16_FLOAT, false };
+
+// Position of a pass in the compiled order, invalid_u32 if it doesn't run
+u32 position(const frame_graph& graph, u32 pass)
+{
+    const auto order = graph.order();
+    for (u32 i = 0; i < (u32) order.size(); ++i)
+    {
+        if (order[i] == pass)
+        {
+            return i;
+        }
+    }
+    return invalid_u32;
+}
+
+void culling()
+{
+    constexpr const char* test = "culling";
+
+    frame_graph graph{};
+    graph.import("back_buffer", {});
+
+    // scene -> lighting -> back_buffer survives
+    const u32 scene = graph.add_pass("scene", {});
+    graph.create(scene, "hdr", color);
+    const u32 lighting = graph.add_pass("lighting", {});
+    graph.read(lighting, "hdr");
+    graph.write(lighting, "back_buffer");
+
+    // A debug view nobody reads, and a chain whose end nobody reads, are culled entirely
+    const u32 debug = graph.add_pass("debug", {});
+    graph.read(debug, "hdr");
+    graph.create(debug, "debug_view", color);
+    const u32 blur_x = graph.add_pass("blur_x", {});
+    graph.create(blur_x, "blur_half", color);
+    const u32 blur_y = graph.add_pass("blur_y", {});
+    graph.read(blur_y, "blur_half");
+    graph.create(blur_y, "blur", color);
+
+    // Kept although its output stays unread, and what it reads stays alive with it
+    const u32 probe_source = graph.add_pass("probe_source", {});
+    graph.create(probe_source, "probe_input", other_color);
+    const u32 capture = graph.add_pass("capture", {});
+    graph.read(capture, "probe_input");
+    graph.create(capture, "probe", other_color);
+    graph.keep(capture);
+
+    check(graph.compile(), "the graph compiles", test);
+    check(!graph.culled(scene) && !graph.culled(lighting), "the chain into the back buffer runs", test);
+    check(graph.culled(debug), "a pass whose output nobody reads is culled", test);
+    check(graph.culled(blur_x) && graph.culled(blur_y), "a chain whose end nobody reads is culled", test);
+    check(!graph.culled(capture), "a kept pass runs", test);
+    check(!graph.culled(probe_source), "what a kept pass reads is produced", test);
+    check(graph.order().size() == 4, "only the surviving passes are ordered", test);
+    check(position(graph, debug) == invalid_u32, "culled passes aren't ordered", test);
+    check(graph.physical_slot("debug_view") == invalid_u32 && graph.physical_slot("blur") == invalid_u32,
+          "resources of culled passes get no texture", test);
+    check(graph.physical_slot("back_buffer") == invalid_u32, "imported resources get no texture", test);
+}
+
+void ordering()
+{
+    constexpr const char* test = "ordering";
+
+    frame_graph graph{};
+    graph.import("back_buffer", {});
+
+    // Declared reader first: it still runs after the pass creating what it reads
+    const u32 composite = graph.add_pass("composite", {});
+    graph.read(composite, "bloom");
+    graph.read(composite, "hdr");
+    graph.write(composite, "back_buffer");
+    const u32 bloom = graph.add_pass("bloom", {});
+    graph.read(bloom, "hdr");
+    graph.create(bloom, "bloom", color);
+    const u32 scene = graph.add_pass("scene", {});
+    graph.create(scene, "hdr", color);
+
+    // Both write the back buffer after the composite, they keep their declaration order
+    const u32 overlay = graph.add_pass("overlay", {});
+    graph.write(overlay, "back_buffer");
+    const u32 cursor = graph.add_pass("cursor", {});
+    graph.write(cursor, "back_buffer");
+
+    check(graph.compile(), "the graph compiles", test);
+    check(position(graph, scene) < position(graph, bloom), "hdr is created before bloom reads it", test);
+    check(position(graph, bloom) < position(graph, composite), "bloom is created before the composite reads it", test);
+    check(position(graph, composite) < position(graph, overlay), "writes to the back buffer keep their order", test);
+    check(position(graph, overlay) < position(graph, cursor), "later writes stay later", test);
+
+    // execute runs the passes in that order, after asking for one texture per slot
+    std::vector<u32> ran{};
+    u32              allocations = 0;
+    frame_graph      recorded{};
+    recorded.import("back_buffer", {});
+    const u32 first = recorded.add_pass("first", [&](const frame_graph& g) {
+        ran.push_back(0);
+        check(g.views("target").rtv != nullptr, "a pass sees the views allocated for its resource", test);
+    });
+    recorded.create(first, "target", color);
+    const u32 second = recorded.add_pass("second", [&](const frame_graph&) { ran.push_back(1); });
+    recorded.read(second, "target");
+    recorded.write(second, "back_buffer");
+
+    check(recorded.compile(), "the executed graph compiles", test);
+    recorded.execute([&](const transient_desc&) {
+        ++allocations;
+        return graph_views{ .rtv = (ID3D11RenderTargetView*) 0x10 };
+    });
+    check(allocations == recorded.physical_count(), "one allocation per physical slot", test);
+    check(ran == std::vector<u32>{ 0, 1 }, "passes execute in the compiled order", test);
+}
+
+void rejected()
+{
+    constexpr const char* test = "rejected";
+
+    {
+        // a reads x and writes y, b reads y and writes x, and neither was declared after a writer of what it reads
+        frame_graph graph{};
+        const u32   a = graph.add_pass("a", {});
+        graph.read(a, "x");
+        graph.create(a, "y", color);
+        const u32 b = graph.add_pass("b", {});
+        graph.read(b, "y");
+        graph.create(b, "x", color);
+        graph.keep(a);
+        graph.keep(b);
+        check(!graph.compile(), "a dependency cycle is rejected", test);
+        check(!graph.compiled() && graph.order().empty(), "a rejected graph has no order", test);
+    }
+    {
+        frame_graph graph{};
+        const u32   a = graph.add_pass("a", {});
+        graph.read(a, "never_written");
+        graph.keep(a);
+        check(!graph.compile(), "reading a resource nobody creates is rejected", test);
+    }
+    {
+        frame_graph graph{};
+        const u32   a = graph.add_pass("a", {});
+        graph.create(a, "twice", color);
+        const u32 b = graph.add_pass("b", {});
+        graph.create(b, "twice", color);
+        graph.keep(a);
+        graph.keep(b);
+        check(!graph.compile(), "a resource created twice is rejected", test);
+    }
+    {
+        frame_graph graph{};
+        graph.import("back_buffer", {});
+        const u32 a = graph.add_pass("a", {});
+        graph.create(a, "back_buffer", color);
+        check(!graph.compile(), "creating an imported resource is rejected", test);
+    }
+}
+
+// A chain of passes, each reading the previous resource and creating the next, with the descriptions given
+void chain(frame_graph& graph, const std::vector<transient_desc>& descs)
+{
+    graph.import("back_buffer", {});
+    for (u32 i = 0; i < (u32) descs.size(); ++i)
+    {
+        const u32 pass = graph.add_pass("step" + std::to_string(i), {});
+        if (i > 0)
+        {
+            graph.read(pass, "t" + std::to_string(i - 1));
+        }
+        graph.create(pass, "t" + std::to_string(i), descs[i]);
+    }
+
+    const u32 present = graph.add_pass("present", {});
+    graph.read(present, "t" + std::to_string(descs.size() - 1));
+    graph.write(present, "back_buffer");
+}
+
+void aliasing()
+{
+    constexpr const char* test = "aliasing";
+
+    {
+        // t0 lives in steps 0 and 1, t2 in steps 2 and 3: disjoint, so they share. t1 overlaps both
+        frame_graph graph{};
+        chain(graph, { color, color, color });
+        check(graph.compile(), "the chain compiles", test);
+        check(graph.physical_slot("t0") == graph.physical_slot("t2"), "disjoint lifetimes share a slot", test);
+        check(graph.physical_slot("t0") != graph.physical_slot("t1"), "overlapping lifetimes don't", test);
+        check(graph.physical_count() == 2, "two textures serve three resources", test);
+        check(graph.physical_desc(graph.physical_slot("t2")) == color, "a slot keeps its description", test);
+    }
+    {
+        // Same lifetimes, but the format of t2 differs
+        frame_graph graph{};
+        chain(graph, { color, color, other_color });
+        check(graph.compile(), "the mixed format chain compiles", test);
+        check(graph.physical_slot("t0") != graph.physical_slot("t2"), "different formats don't share", test);
+        check(graph.physical_count() == 3, "every resource gets its own texture", test);
+    }
+    {
+        // And the size
+        frame_graph graph{};
+        chain(graph, { color, color, smaller_color });
+        check(graph.compile(), "the mixed size chain compiles", test);
+        check(graph.physical_slot("t0") != graph.physical_slot("t2"), "different sizes don't share", test);
+    }
+    {
+        // A long chain ping-pongs between two textures
+        frame_graph graph{};
+        chain(graph, std::vector<transient_desc>(8, color));
+        check(graph.compile(), "the long chain compiles", test);
+        check(graph.physical_count() == 2, "a long chain needs two textures", test);
+        for (u32 i = 2; i < 8; ++i)
+        {
+            check(graph.physical_slot("t" + std::to_string(i)) == graph.physical_slot("t" + std::to_string(i - 2)),
+                  "every other resource shares a texture", test);
+        }
+    }
+    {
+        // A resource read by the last pass lives through the whole frame and shares with nothing
+        frame_graph graph{};
+        graph.import("back_buffer", {});
+        const u32 a = graph.add_pass("a", {});
+        graph.create(a, "long", color);
+        graph.create(a, "short", color);
+        const u32 b = graph.add_pass("b", {});
+        graph.read(b, "short");
+        graph.create(b, "next", color);
+        const u32 c = graph.add_pass("c", {});
+        graph.read(c, "long");
+        graph.read(c, "next");
+        graph.write(c, "back_buffer");
+        check(graph.compile(), "the long lived graph compiles", test);
+        check(graph.physical_slot("long") != graph.physical_slot("short") &&
+                  graph.physical_slot("long") != graph.physical_slot("next"),
+              "a resource alive across the frame keeps its own texture", test);
+        check(graph.physical_slot("short") != graph.physical_slot("next"),
+              "a pass's input and the output it creates don't share", test);
+    }
+}
+
+} // anonymous namespace
+
+int main()
+{
+    culling();
+    ordering();
+    rejected();
+    aliasing();
+
+    if (failures)
+    {
+        fprintf(stderr, "%u checks failed\n", failures);
+        return 1;
+    }
+    printf("Frame graph test passed\n");
+    return 0;
+}
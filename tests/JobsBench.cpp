@@ -0,0 +1,126 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: JobsBench.cpp
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+
+// Throughput of the job system: empty jobs queued from one thread, parallel_for over a compute bound array against
+// the same loop on one thread, and the hand-off cost of run_after chains. Pass the worker count as the first argument,
+// otherwise init picks it
+
+#include "Yae/Core/Jobs.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace yae;
+
+namespace
+{
+
+using clock_type = std::chrono::steady_clock;
+
+f64 seconds_since(clock_type::time_point start)
+{
+    return std::chrono::duration<f64>(clock_type::now() - start).count();
+}
+
+// Best of a few runs, the first one also warms up the workers
+template<typename Func>
+f64 best_of(u32 runs, Func&& func)
+{
+    f64 best = 1e30;
+    for (u32 i = 0; i < runs; ++i)
+    {
+        const auto start = clock_type::now();
+        func();
+        best = std::min(best, seconds_since(start));
+    }
+    return best;
+}
+
+void empty_jobs()
+{
+    constexpr u32 count = 200'000;
+
+    const f64 time = best_of(5, [] {
+        jobs::counter ctr{};
+        for (u32 i = 0; i < count; ++i)
+        {
+            jobs::run([] {}, &ctr);
+        }
+        jobs::wait(ctr);
+    });
+    printf("empty jobs:        %8.2f M jobs/s (%.1f ns per job)\n", count / time / 1e6, time / count * 1e9);
+}
+
+void parallel_loop()
+{
+    constexpr u32 count = 1 << 22;
+
+    std::vector<f32> data(count);
+    const auto       body = [&data](u32 begin, u32 end) {
+        for (u32 i = begin; i < end; ++i)
+        {
+            data[i] = std::sqrt((f32) i) * std::sin((f32) i);
+        }
+    };
+
+    const f64 serial   = best_of(5, [&] { body(0, count); });
+    const f64 parallel = best_of(5, [&] { jobs::parallel_for(0, count, 0, body); });
+    printf("parallel_for:      %8.2f ms serial, %.2f ms parallel, %.2fx on %u threads\n", serial * 1e3, parallel * 1e3,
+           serial / parallel, jobs::worker_count() + 1);
+}
+
+void dependency_chain()
+{
+    constexpr u32 length = 20'000;
+
+    const f64 time = best_of(5, [] {
+        std::vector<jobs::counter> links(length);
+        jobs::run([] {}, &links[0]);
+        for (u32 i = 1; i < length; ++i)
+        {
+            jobs::run_after(links[i - 1], [] {}, &links[i]);
+        }
+        jobs::wait(links[length - 1]);
+    });
+    printf("run_after chain:   %8.2f us per link\n", time / length * 1e6);
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+    const u32 workers = argc > 1 ? (u32) strtoul(argv[1], nullptr, 10) : 0;
+    jobs::init(workers);
+    printf("Job system benchmark, %u workers\n", jobs::worker_count());
+
+    empty_jobs();
+    parallel_loop();
+    dependency_chain();
+
+    jobs::shutdown();
+    return 0;
+}
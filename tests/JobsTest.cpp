@@ -0,0 +1,206 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: JobsTest.cpp
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+
+// Stress test of the job system: nested parallel_for, run_after chains, waiting inside jobs and shutdown draining
+// whatever is still queued or parked. Returns non-zero if any check fails
+
+#include "Yae/Core/Jobs.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace yae;
+
+namespace
+{
+
+u32 failures = 0;
+
+void check(bool condition, const char* what, u32 workers)
+{
+    if (!condition)
+    {
+        fprintf(stderr, "FAILED with %u workers: %s\n", workers, what);
+        ++failures;
+    }
+}
+
+// Every (outer, inner) pair is visited exactly once when parallel_for nests inside its own chunks
+void nested_parallel_for(u32 workers)
+{
+    constexpr u32 outer = 64;
+    constexpr u32 inner = 512;
+
+    std::vector<std::atomic<u32>> visits(outer * inner);
+    jobs::parallel_for(0, outer, 1, [&](u32 begin, u32 end) {
+        for (u32 i = begin; i < end; ++i)
+        {
+            jobs::parallel_for(0, inner, 16, [&, i](u32 first, u32 last) {
+                for (u32 j = first; j < last; ++j)
+                {
+                    visits[i * inner + j].fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+        }
+    });
+
+    bool once = true;
+    for (const auto& v : visits)
+    {
+        once = once && v.load() == 1;
+    }
+    check(once, "nested parallel_for visits every index once", workers);
+}
+
+// Each link of a chain may only start once the previous one has finished, several chains run side by side
+void run_after_chains(u32 workers)
+{
+    constexpr u32 chains = 16;
+    constexpr u32 length = 200;
+
+    struct chain
+    {
+        std::vector<jobs::counter> links = std::vector<jobs::counter>(length);
+        std::atomic<u32>           step{};
+        std::atomic<u32>           out_of_order{};
+    };
+
+    std::vector<std::unique_ptr<chain>> all{};
+    jobs::counter                       done{};
+    for (u32 c = 0; c < chains; ++c)
+    {
+        chain& ch = *all.emplace_back(std::make_unique<chain>());
+        jobs::run([&ch] { ch.step.fetch_add(1); }, &ch.links[0]);
+        for (u32 i = 1; i < length; ++i)
+        {
+            jobs::run_after(
+                ch.links[i - 1],
+                [&ch, i] {
+                    if (ch.step.fetch_add(1) != i)
+                    {
+                        ch.out_of_order.fetch_add(1);
+                    }
+                },
+                i + 1 < length ? &ch.links[i] : &done);
+        }
+    }
+    jobs::wait(done);
+
+    bool in_order = true;
+    for (const auto& ch : all)
+    {
+        in_order = in_order && ch->step.load() == length && ch->out_of_order.load() == 0;
+    }
+    check(in_order, "run_after chains run every link after the previous one", workers);
+
+    // A dependency that is already done doesn't park the job
+    jobs::counter    finished{};
+    jobs::counter    after{};
+    std::atomic<u32> ran{};
+    jobs::run_after(finished, [&ran] { ran.fetch_add(1); }, &after);
+    jobs::wait(after);
+    check(ran.load() == 1, "run_after on a finished counter runs the job", workers);
+}
+
+// Jobs that wait on jobs they queued themselves keep the workers busy instead of deadlocking them
+void wait_inside_jobs(u32 workers)
+{
+    constexpr u32 outer = 64;
+
+    std::atomic<u32> leaves{};
+    jobs::counter    ctr{};
+    for (u32 i = 0; i < outer; ++i)
+    {
+        jobs::run(
+            [&leaves] {
+                jobs::counter inner{};
+                for (u32 j = 0; j < 8; ++j)
+                {
+                    jobs::run([&leaves] { leaves.fetch_add(1); }, &inner);
+                }
+                jobs::wait(inner);
+            },
+            &ctr);
+    }
+    jobs::wait(ctr);
+    check(leaves.load() == outer * 8, "jobs waiting inside jobs complete", workers);
+}
+
+// Shutdown runs what is still queued, including jobs parked on a dependency that only finishes during the drain
+void shutdown_drain(u32 workers)
+{
+    constexpr u32 count = 2000;
+
+    auto ran  = std::make_unique<std::atomic<u32>>(0);
+    auto gate = std::make_unique<jobs::counter>();
+
+    jobs::run([r = ran.get()] { std::this_thread::sleep_for(std::chrono::milliseconds{ 5 }); r->fetch_add(1); },
+              gate.get());
+    for (u32 i = 0; i < count; ++i)
+    {
+        if (i % 2)
+        {
+            jobs::run_after(*gate, [r = ran.get()] { r->fetch_add(1); });
+        } else
+        {
+            jobs::run([r = ran.get()] { r->fetch_add(1); });
+        }
+    }
+
+    jobs::shutdown();
+    check(ran->load() == count + 1, "shutdown drains queued and parked jobs", workers);
+}
+
+} // anonymous namespace
+
+int main()
+{
+    // init(0) picks the worker count itself, so the smallest pool asked for is a single worker
+    const u32 hw = std::max(std::thread::hardware_concurrency(), 2u);
+
+    for (const u32 workers : { 1u, 3u, hw - 1, hw * 2 })
+    {
+        for (u32 round = 0; round < 20; ++round)
+        {
+            jobs::init(workers);
+            check(jobs::worker_count() == workers, "init starts the requested workers", workers);
+
+            nested_parallel_for(workers);
+            run_after_chains(workers);
+            wait_inside_jobs(workers);
+            shutdown_drain(workers);
+        }
+    }
+
+    if (failures)
+    {
+        fprintf(stderr, "%u checks failed\n", failures);
+        return 1;
+    }
+    printf("Job system stress test passed\n");
+    return 0;
+}
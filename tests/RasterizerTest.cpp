@@ -0,0 +1,317 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: RasterizerTest.cpp
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+
+// Rasterizes known triangles through the software tile_rasterizer and checks the pixels they write: the top-left fill
+// rule on edges through pixel centers, meshes that must cover every pixel exactly once across tile boundaries, and
+// the depth test and interpolated depth. Returns non-zero if any pixel differs from what D3D11 would write
+
+#include "Yae/Core/Jobs.h"
+#include "Yae/Graphics/SoftwareRasterizer.h"
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace yae;
+using namespace yae::gfx;
+using namespace yae::gfx::software;
+
+namespace
+{
+
+u32 failures = 0;
+
+void check(bool condition, const char* what, const char* test)
+{
+    if (!condition)
+    {
+        fprintf(stderr, "FAILED in %s: %s\n", test, what);
+        ++failures;
+    }
+}
+
+// Counts how often each pixel is shaded and writes the triangle's id, its only varying, to the color target
+struct coverage
+{
+    u32              width{};
+    std::vector<u32> counts{};
+};
+
+void count_pixel(const void* context, const pixel_input& input, pixel_output& output)
+{
+    const coverage* c = (const coverage*) context;
+    ++const_cast<coverage*>(c)->counts[(u32) input.y * c->width + (u32) input.x];
+    output.color[0] = { input.varyings[0], 0.f, 0.f, 1.f };
+}
+
+// A color and a depth target, with every pixel cleared to id -1 at the far plane
+class target
+{
+public:
+    target(u32 width, u32 height)
+        : m_color((size_t) width * height * 4, -1.f), m_depth((size_t) width * height, 1.f)
+    {
+        m_coverage.width = width;
+        m_coverage.counts.assign((size_t) width * height, 0);
+
+        m_state.width    = width;
+        m_state.height   = height;
+        m_state.viewport = { 0.f, 0.f, (f32) width, (f32) height, 0.f, 1.f };
+        m_state.cull     = D3D11_CULL_NONE;
+
+        m_state.depth       = m_depth.data();
+        m_state.depth_pitch = width;
+
+        m_state.targets[0]                  = { (u8*) m_color.data(), width * 16, DXGI_FORMAT_R32G32B32A32_FLOAT };
+        m_state.target_count                = 1;
+        m_state.blend.RenderTargetWriteMask = D3D11_COLOR_WRITE_ENABLE_ALL;
+
+        m_state.program       = count_pixel;
+        m_state.context       = &m_coverage;
+        m_state.varying_count = 1;
+    }
+
+    raster_state& state() { return m_state; }
+
+    u32 count(u32 x, u32 y) const { return m_coverage.counts[y * m_state.width + x]; }
+    f32 id(u32 x, u32 y) const { return m_color[((size_t) y * m_state.width + x) * 4]; }
+    f32 depth(u32 x, u32 y) const { return m_depth[(size_t) y * m_state.width + x]; }
+
+    // A vertex at a screen position, in pixels from the top left corner
+    shaded_vertex vertex(f32 x, f32 y, f32 z, f32 id) const
+    {
+        shaded_vertex v{};
+        v.position    = { x / (f32) m_state.width * 2.f - 1.f, 1.f - y / (f32) m_state.height * 2.f, z, 1.f };
+        v.varyings[0] = id;
+        return v;
+    }
+
+private:
+    std::vector<f32> m_color;
+    std::vector<f32> m_depth;
+    coverage         m_coverage{};
+    raster_state     m_state{};
+};
+
+// A square whose edges run through pixel centers, split along a diagonal that does too. Centers on the top and left
+// edges are inside, those on the bottom and right edges aren't, and the diagonal's belong to exactly one triangle
+void top_left_rule()
+{
+    tile_rasterizer rasterizer{};
+
+    // Both windings, each triangle's edges are top-left on one side only
+    for (const bool clockwise : { true, false })
+    {
+        target t{ 16, 16 };
+
+        // The upper right triangle is id 0, the lower left one id 1
+        const shaded_vertex v[6]{ t.vertex(2.5f, 2.5f, .5f, 0.f), t.vertex(6.5f, 2.5f, .5f, 0.f),
+                                  t.vertex(6.5f, 6.5f, .5f, 0.f), t.vertex(2.5f, 2.5f, .5f, 1.f),
+                                  t.vertex(6.5f, 6.5f, .5f, 1.f), t.vertex(2.5f, 6.5f, .5f, 1.f) };
+        const std::vector<u32> indices = clockwise ? std::vector<u32>{ 0, 1, 2, 3, 4, 5 } : std::vector<u32>{ 0, 2, 1, 3, 5, 4 };
+        rasterizer.draw(t.state(), v, indices);
+
+        bool exact = true;
+        for (u32 y = 0; y < 16; ++y)
+        {
+            for (u32 x = 0; x < 16; ++x)
+            {
+                const bool inside = x >= 2 && x <= 5 && y >= 2 && y <= 5;
+                exact             = exact && t.count(x, y) == (inside ? 1u : 0u);
+            }
+        }
+        check(exact, "the pixels [2, 5] x [2, 5] are shaded once and nothing else is", "top_left_rule");
+
+        // The diagonal's centers (3.5, 3.5) to (5.5, 5.5) are on the first triangle's left edge
+        check(t.id(3, 3) == 0.f && t.id(5, 5) == 0.f, "the diagonal belongs to the triangle on its left", "top_left_rule");
+        check(t.id(2, 5) == 1.f && t.id(5, 2) == 0.f, "the corners off the diagonal belong to their own triangle",
+              "top_left_rule");
+    }
+
+    // A single pixel center on a triangle's shared vertex goes to exactly one of the triangles around it
+    target t{ 8, 8 };
+    const shaded_vertex center = t.vertex(3.5f, 3.5f, .5f, 0.f);
+    const shaded_vertex ring[4]{ t.vertex(0.f, 0.f, .5f, 0.f), t.vertex(8.f, 0.f, .5f, 0.f), t.vertex(8.f, 8.f, .5f, 0.f),
+                                 t.vertex(0.f, 8.f, .5f, 0.f) };
+    const shaded_vertex    fan[5]{ center, ring[0], ring[1], ring[2], ring[3] };
+    const std::vector<u32> indices{ 0, 1, 2, 0, 2, 3, 0, 3, 4, 0, 4, 1 };
+    rasterizer.draw(t.state(), fan, indices);
+
+    bool once = true;
+    for (u32 y = 0; y < 8; ++y)
+    {
+        for (u32 x = 0; x < 8; ++x)
+        {
+            once = once && t.count(x, y) == 1;
+        }
+    }
+    check(once, "a fan around a pixel center shades every pixel once", "top_left_rule");
+}
+
+// A grid of quads over more than the target, jittered so edges cross tiles at every angle. Every pixel is covered by
+// exactly one triangle, with vertices snapped to pixel centers too so that many centers lie on edges
+void watertight(u32 seed, bool snapped)
+{
+    std::mt19937                        rng{ seed };
+    std::uniform_real_distribution<f32> jitter{ -4.f, 4.f };
+
+    constexpr u32 width  = 200;
+    constexpr u32 height = 150;
+    constexpr u32 cells  = 9;
+
+    target t{ width, height };
+
+    std::vector<shaded_vertex> vertices{};
+    for (u32 j = 0; j <= cells; ++j)
+    {
+        for (u32 i = 0; i <= cells; ++i)
+        {
+            f32 x = -10.f + (f32) i * (width + 20.f) / cells;
+            f32 y = -10.f + (f32) j * (height + 20.f) / cells;
+            if (i > 0 && i < cells && j > 0 && j < cells)
+            {
+                x += jitter(rng);
+                y += jitter(rng);
+            }
+            if (snapped)
+            {
+                x = floorf(x) + .5f;
+                y = floorf(y) + .5f;
+            }
+            vertices.push_back(t.vertex(x, y, .5f, (f32) vertices.size()));
+        }
+    }
+
+    // Alternating diagonals, so both kinds of shared edge occur
+    std::vector<u32> indices{};
+    for (u32 j = 0; j < cells; ++j)
+    {
+        for (u32 i = 0; i < cells; ++i)
+        {
+            const u32 a = j * (cells + 1) + i;
+            const u32 b = a + 1;
+            const u32 c = a + cells + 1;
+            const u32 d = c + 1;
+            if ((i + j) % 2)
+            {
+                indices.insert(indices.end(), { a, b, d, a, d, c });
+            } else
+            {
+                indices.insert(indices.end(), { a, b, c, b, d, c });
+            }
+        }
+    }
+
+    tile_rasterizer rasterizer{};
+    rasterizer.draw(t.state(), vertices, indices);
+
+    u32 holes{};
+    u32 overlaps{};
+    for (u32 y = 0; y < height; ++y)
+    {
+        for (u32 x = 0; x < width; ++x)
+        {
+            holes += t.count(x, y) == 0;
+            overlaps += t.count(x, y) > 1;
+        }
+    }
+    check(holes == 0, snapped ? "no pixel is missed by a snapped mesh" : "no pixel is missed by a jittered mesh", "watertight");
+    check(overlaps == 0, snapped ? "no pixel is shaded twice by a snapped mesh" : "no pixel is shaded twice by a jittered mesh",
+          "watertight");
+    check(rasterizer.current().pixels_covered == (u64) width * height, "the stats count every pixel once", "watertight");
+}
+
+// Overlapping quads at two depths in both orders, and a quad whose depth runs across the screen
+void depth()
+{
+    tile_rasterizer rasterizer{};
+
+    const auto quad = [](const target& t, f32 x0, f32 y0, f32 x1, f32 y1, f32 z0, f32 z1, f32 id) {
+        return std::vector<shaded_vertex>{ t.vertex(x0, y0, z0, id), t.vertex(x1, y0, z1, id), t.vertex(x1, y1, z1, id),
+                                           t.vertex(x0, y1, z0, id) };
+    };
+    const std::vector<u32> indices{ 0, 1, 2, 0, 2, 3 };
+
+    for (const bool near_first : { true, false })
+    {
+        target t{ 96, 80 };
+        t.state().depth_enable = true;
+        t.state().depth_write  = true;
+        t.state().depth_func   = D3D11_COMPARISON_LESS;
+
+        const std::vector<shaded_vertex> near_quad = quad(t, 10.f, 10.f, 70.f, 50.f, .25f, .25f, 1.f);
+        const std::vector<shaded_vertex> far_quad  = quad(t, 30.f, 30.f, 90.f, 75.f, .75f, .75f, 2.f);
+        rasterizer.draw(t.state(), near_first ? near_quad : far_quad, indices);
+        rasterizer.draw(t.state(), near_first ? far_quad : near_quad, indices);
+
+        const char* test = near_first ? "depth, near first" : "depth, far first";
+        check(t.id(40, 40) == 1.f && fabsf(t.depth(40, 40) - .25f) < 1e-6f, "the near quad wins the overlap", test);
+        check(t.id(80, 70) == 2.f && fabsf(t.depth(80, 70) - .75f) < 1e-6f, "the far quad shows outside the overlap", test);
+        check(t.id(5, 5) == -1.f && t.depth(5, 5) == 1.f, "pixels outside both keep the clear values", test);
+        check(t.count(40, 40) == (near_first ? 1u : 2u), "the far quad only shades the overlap when drawn first", test);
+    }
+
+    // Depth from 0 at the left edge to 1 at the right, linear in screen space since w is 1
+    target t{ 128, 16 };
+    t.state().depth_enable = true;
+    t.state().depth_write  = true;
+    t.state().depth_func   = D3D11_COMPARISON_LESS_EQUAL;
+    rasterizer.draw(t.state(), quad(t, 0.f, 0.f, 128.f, 16.f, 0.f, 1.f, 0.f), indices);
+
+    f32 worst{};
+    for (u32 y = 0; y < 16; ++y)
+    {
+        for (u32 x = 0; x < 128; ++x)
+        {
+            worst = std::max(worst, fabsf(t.depth(x, y) - ((f32) x + .5f) / 128.f));
+        }
+    }
+    check(worst < 1e-5f, "depth is interpolated at pixel centers", "depth");
+}
+
+} // anonymous namespace
+
+int main()
+{
+    // Tiles are rasterized by jobs, the result must not depend on which worker takes which
+    jobs::init(3);
+
+    top_left_rule();
+    for (u32 seed = 1; seed <= 8; ++seed)
+    {
+        watertight(seed, false);
+        watertight(seed, true);
+    }
+    depth();
+
+    jobs::shutdown();
+
+    if (failures)
+    {
+        fprintf(stderr, "%u checks failed\n", failures);
+        return 1;
+    }
+    printf("Rasterizer test passed\n");
+    return 0;
+}
@@ -0,0 +1,225 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: RenderQueueTest.cpp
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+
+// Checks the render queue's sort keys and order without a device: the geometry key's fields and their priority, front
+// to back order inside a group and back to front overlays, and that the radix sort matches a stable sort on random
+// queues full of equal keys. Models and textures are stand-in pointers, the queue only hashes and compares them.
+// Returns non-zero if any check fails
+
+#include "Yae/Graphics/RenderQueue.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdio>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace yae;
+using namespace yae::gfx;
+
+namespace
+{
+
+u32 failures = 0;
+
+void check(bool condition, const char* what, u32 seed)
+{
+    if (!condition)
+    {
+        fprintf(stderr, "FAILED with seed %u: %s\n", seed, what);
+        ++failures;
+    }
+}
+
+// Distinct non-null pointers sharing one owner, nothing is ever dereferenced
+class stand_ins
+{
+public:
+    ref<const model> mesh(u32 i) const { return { m_owner, (const model*) (m_base + (i + 1) * 64) }; }
+    ref<const texture> tex(u32 i) const { return { m_owner, (const texture*) (m_base + (i + 1) * 64) }; }
+
+private:
+    ref<u8[]> m_owner{ new u8[1]{} };
+    uintptr_t m_base{ 0x10000 };
+};
+
+math::matrix at(f32 x, f32 y, f32 z)
+{
+    return XMMatrixTranslation(x, y, z);
+}
+
+u64 field(u64 key, u32 shift, u32 bits)
+{
+    return (key >> shift) & ((1ull << bits) - 1);
+}
+
+void key_layout()
+{
+    const stand_ins s{};
+    const model*    mesh = s.mesh(0).get();
+
+    const u64 key = render_queue::geometry_key(5, 1234, mesh, 42.5f);
+    check(field(key, render_queue::pass_shift, 2) == (u64) render_pass::geometry, "the pass is the top 2 bits", 0);
+    check(field(key, render_queue::shader_shift, 6) == 5, "the shader is the next 6 bits", 0);
+    check(field(key, render_queue::material_shift, render_queue::material_bits) == 1234, "the block is the next 24", 0);
+    check(field(key, 0, 16) == std::bit_cast<u32>(42.5f) >> 16, "the depth is the top half of the float's bits", 0);
+
+    const u64 mesh_field = field(key, render_queue::mesh_shift, render_queue::mesh_bits);
+    check(field(render_queue::geometry_key(0, 0, mesh, 1.f), render_queue::mesh_shift, render_queue::mesh_bits) ==
+              mesh_field,
+          "the mesh field depends only on the mesh", 0);
+    check(field(render_queue::geometry_key(0, 0, mesh, -3.f), 0, 16) == 0, "negative depths clamp to 0", 0);
+
+    // Priority: shader over block over mesh over depth
+    check(render_queue::geometry_key(1, 0, mesh, 0.f) > render_queue::geometry_key(0, 0xFF'FFFF, mesh, 1e30f),
+          "the shader outranks the block", 0);
+    check(render_queue::geometry_key(0, 1, nullptr, 0.f) > render_queue::geometry_key(0, 0, mesh, 1e30f),
+          "the block outranks the mesh and depth", 0);
+    check(render_queue::geometry_key(0, 0, mesh, 1.f) < render_queue::geometry_key(0, 0, mesh, 2.f),
+          "nearer sorts first within a mesh", 0);
+    check(render_queue::geometry_key(63, 0xFF'FFFF, mesh, 1e30f) < render_queue::overlay_key(1e30f, 0),
+          "every geometry key comes before every overlay key", 0);
+
+    const u64 overlay = render_queue::overlay_key(3.f, 77);
+    check(field(overlay, render_queue::pass_shift, 2) == (u64) render_pass::overlay, "the overlay pass", 0);
+    check(field(overlay, 0, render_queue::material_bits) == 77, "the texture is the low 24 bits", 0);
+    check(render_queue::overlay_key(3.f, 0) < render_queue::overlay_key(2.f, 0xFF'FFFF), "farther overlays sort first", 0);
+}
+
+void depth_order()
+{
+    const stand_ins s{};
+
+    render_queue queue{};
+    queue.begin(XMMatrixIdentity());
+
+    // One group at shuffled depths, and overlays at shuffled z
+    const f32 depths[] = { 30.f, 5.f, 12.f, 1.f, 100.f, 7.f };
+    for (const f32 d : depths)
+    {
+        queue.submit(s.mesh(0), at(0.f, 0.f, d), 0, 3, 1);
+        queue.submit(s.mesh(1), s.tex(0), at(0.f, 0.f, d));
+    }
+    queue.sort();
+
+    const auto geometry = queue.sorted(render_pass::geometry);
+    const auto overlay  = queue.sorted(render_pass::overlay);
+    check(geometry.size() == 6 && overlay.size() == 6, "each pass gets its own packets", 0);
+
+    bool front_to_back = true;
+    for (u32 i = 1; i < geometry.size(); ++i)
+    {
+        front_to_back = front_to_back &&
+                        queue.packet(geometry[i - 1]).world._43 < queue.packet(geometry[i]).world._43 &&
+                        queue.packet(geometry[i]).pass == render_pass::geometry;
+    }
+    check(front_to_back, "geometry goes front to back within a group", 0);
+
+    bool back_to_front = true;
+    for (u32 i = 1; i < overlay.size(); ++i)
+    {
+        back_to_front = back_to_front && queue.packet(overlay[i - 1]).world._43 > queue.packet(overlay[i]).world._43 &&
+                        queue.packet(overlay[i]).pass == render_pass::overlay;
+    }
+    check(back_to_front, "overlays go back to front", 0);
+
+    // Clearing one pass keeps the other's packets, in submission order
+    queue.clear(render_pass::geometry);
+    check(queue.size() == 6, "clearing geometry keeps the overlays", 0);
+    bool kept_in_order = true;
+    for (u32 i = 0; i < queue.size(); ++i)
+    {
+        kept_in_order = kept_in_order && queue.packet(i).pass == render_pass::overlay && queue.packet(i).world._43 == depths[i];
+    }
+    check(kept_in_order, "the kept packets stay in submission order", 0);
+
+    queue.sort();
+    check(queue.sorted(render_pass::geometry).empty() && queue.sorted(render_pass::overlay).size() == 6,
+          "sorting again after a clear", 0);
+}
+
+// Random queues drawn from few shaders, blocks, meshes and depths so most keys collide. The radix sort must give the
+// same order as a stable sort by key, which keeps equal keys in submission order
+void stable_order(u32 seed, u32 count)
+{
+    const stand_ins s{};
+    std::mt19937    rng{ seed };
+    const auto      pick = [&](u32 n) { return std::uniform_int_distribution<u32>{ 0, n - 1 }(rng); };
+
+    // A random view, so depths aren't just the world z
+    render_queue queue{};
+    queue.begin(XMMatrixLookAtLH(XMVectorSet((f32) pick(20), 5.f, -(f32) pick(20), 1.f), XMVectorSet(0.f, 0.f, 50.f, 1.f),
+                                 XMVectorSet(0.f, 1.f, 0.f, 0.f)));
+
+    for (u32 i = 0; i < count; ++i)
+    {
+        const math::matrix world = at((f32) pick(4) * 10.f, 0.f, (f32) pick(4) * 25.f);
+        if (pick(5) == 0)
+        {
+            queue.submit(s.mesh(pick(3)), s.tex(pick(2)), world);
+        } else
+        {
+            const u32 block = pick(4) * 0x1'0101; // Spreads the blocks over all three bytes of the field
+            queue.submit(s.mesh(pick(3)), world, i, block, pick(3) * 21);
+        }
+    }
+    queue.sort();
+
+    std::vector<u32> expected(count);
+    std::iota(expected.begin(), expected.end(), 0u);
+    std::ranges::stable_sort(expected, [&](u32 a, u32 b) { return queue.key(a) < queue.key(b); });
+
+    std::vector<u32> actual{};
+    for (const render_pass pass : { render_pass::geometry, render_pass::overlay })
+    {
+        const auto order = queue.sorted(pass);
+        actual.insert(actual.end(), order.begin(), order.end());
+    }
+    check(actual == expected, "the radix sort matches a stable sort by key", seed);
+}
+
+} // anonymous namespace
+
+int main()
+{
+    key_layout();
+    depth_order();
+
+    u32 seed = 1;
+    for (const u32 count : { 0u, 1u, 2u, 7u, 64u, 255u, 256u, 257u, 1'000u, 10'000u })
+    {
+        for (u32 i = 0; i < 8; ++i)
+        {
+            stable_order(seed++, count);
+        }
+    }
+
+    if (failures)
+    {
+        fprintf(stderr, "%u checks failed\n", failures);
+        return 1;
+    }
+    printf("Render queue test passed, %u random queues\n", seed - 1);
+    return 0;
+}
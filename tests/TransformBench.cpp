@@ -0,0 +1,217 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: TransformBench.cpp
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+
+// Cost per transform of one frame of world matrix updates, setting the moved positions included:
+// transform_hierarchy::update against the recursive calculate_transformation walk game objects used before, on deep
+// chains, one wide level and a bushy tree. Each shape is timed with every transform moving, with one in a hundred
+// moving and with nothing moving
+
+#include "Yae/Scene/TransformHierarchy.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace yae;
+
+namespace
+{
+
+using clock_type = std::chrono::steady_clock;
+
+template<typename Func>
+f64 best_of(u32 runs, Func&& func)
+{
+    f64 best = 1e30;
+    for (u32 i = 0; i < runs; ++i)
+    {
+        const auto start = clock_type::now();
+        func();
+        best = std::min(best, std::chrono::duration<f64>(clock_type::now() - start).count());
+    }
+    return best;
+}
+
+// Parent of every node, always before it, invalid_u32 for roots
+struct tree_shape
+{
+    const char*      name{};
+    std::vector<u32> parents{};
+};
+
+tree_shape deep_chains(u32 chains, u32 depth)
+{
+    tree_shape shape{ "deep" };
+    for (u32 c = 0; c < chains; ++c)
+    {
+        for (u32 d = 0; d < depth; ++d)
+        {
+            shape.parents.push_back(d == 0 ? invalid_u32 : (u32) shape.parents.size() - 1);
+        }
+    }
+    return shape;
+}
+
+tree_shape wide(u32 children)
+{
+    tree_shape shape{ "wide" };
+    shape.parents.push_back(invalid_u32);
+    shape.parents.insert(shape.parents.end(), children, 0);
+    return shape;
+}
+
+tree_shape bushy(u32 branching, u32 levels)
+{
+    tree_shape shape{ "bushy" };
+    shape.parents.push_back(invalid_u32);
+    u32 level_begin = 0;
+    u32 level_end   = 1;
+    for (u32 l = 1; l < levels; ++l)
+    {
+        for (u32 p = level_begin; p < level_end; ++p)
+        {
+            shape.parents.insert(shape.parents.end(), branching, p);
+        }
+        level_begin = level_end;
+        level_end   = (u32) shape.parents.size();
+    }
+    return shape;
+}
+
+// The same scene twice: attached to a hierarchy, and detached transforms walked recursively like game objects were
+struct scene
+{
+    explicit scene(const tree_shape& shape)
+    {
+        const u32 count = (u32) shape.parents.size();
+        children.resize(count);
+        for (u32 i = 0; i < count; ++i)
+        {
+            attached.push_back(std::make_unique<transform>());
+            detached.push_back(std::make_unique<transform>());
+
+            const u32 parent = shape.parents[i];
+            hierarchy.attach(attached[i].get(), parent == invalid_u32 ? nullptr : attached[parent].get());
+            if (parent == invalid_u32)
+            {
+                roots.push_back(i);
+            } else
+            {
+                children[parent].push_back(i);
+            }
+        }
+    }
+
+    ~scene() { attached.clear(); }
+
+    void move(u32 node, f32 offset)
+    {
+        const math::vec3 position{ offset, (f32) (node % 7), 1.f };
+        attached[node]->set_position(position);
+        detached[node]->set_position(position);
+    }
+
+    void calculate_recursive(u32 node, const transform* parent)
+    {
+        detached[node]->calculate_transformation(parent);
+        for (const u32 child : children[node])
+        {
+            calculate_recursive(child, detached[node].get());
+        }
+    }
+
+    void update_recursive()
+    {
+        for (const u32 root : roots)
+        {
+            calculate_recursive(root, nullptr);
+        }
+    }
+
+    transform_hierarchy                     hierarchy{};
+    std::vector<std::unique_ptr<transform>> attached{};
+    std::vector<std::unique_ptr<transform>> detached{};
+    std::vector<std::vector<u32>>           children{};
+    std::vector<u32>                        roots{};
+};
+
+void bench(const tree_shape& shape)
+{
+    scene     s{ shape };
+    const u32 count = (u32) shape.parents.size();
+    const u32 runs  = 20;
+
+    // Settle both paths first so the static case measures only the checks
+    s.update_recursive();
+    s.hierarchy.update();
+
+    std::mt19937 rng{ count };
+    const auto   frame = [&](u32 stride, f32 offset) {
+        for (u32 i = std::uniform_int_distribution<u32>{ 0, stride - 1 }(rng); i < count; i += stride)
+        {
+            s.move(i, offset);
+        }
+    };
+
+    struct workload
+    {
+        const char* name;
+        u32         stride; // Every stride-th node moves, 0 for none
+    };
+    for (const workload w : { workload{ "all moving", 1 }, workload{ "1% moving", 100 }, workload{ "static", 0 } })
+    {
+        f32       offset    = 0.f;
+        const f64 recursive = best_of(runs, [&] {
+            if (w.stride)
+            {
+                frame(w.stride, offset += 1.f);
+            }
+            s.update_recursive();
+        });
+        const f64 flat = best_of(runs, [&] {
+            if (w.stride)
+            {
+                frame(w.stride, offset += 1.f);
+            }
+            s.hierarchy.update();
+        });
+
+        printf("%-6s %7u nodes, %-10s: recursive %8.2f ns/node, hierarchy %8.2f ns/node, %6.2fx\n", shape.name, count,
+               w.name, recursive / count * 1e9, flat / count * 1e9, recursive / flat);
+    }
+}
+
+} // anonymous namespace
+
+int main()
+{
+    printf("Transform update benchmark, best of 20 frames\n");
+
+    bench(deep_chains(16, 1'024));
+    bench(wide(16'384));
+    bench(bushy(4, 8));
+    return 0;
+}
@@ -0,0 +1,371 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: TransformTest.cpp
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+
+// Checks transform_hierarchy's flat arrays against a plain parent map while transforms are attached, reparented,
+// detached and destroyed at random. After every step each node's parent, subtree range and back pointer must match,
+// and after every update each world matrix must equal the recursive calculate_transformation path on a shadow copy
+// of the scene. Returns non-zero if any check fails
+
+#include "Yae/Scene/TransformHierarchy.h"
+
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace yae;
+
+namespace
+{
+
+u32 failures = 0;
+
+void check(bool condition, const char* what, u32 seed)
+{
+    if (!condition)
+    {
+        fprintf(stderr, "FAILED with seed %u: %s\n", seed, what);
+        ++failures;
+    }
+}
+
+f32 uniform(std::mt19937& rng, f32 lo, f32 hi)
+{
+    return std::uniform_real_distribution<f32>{ lo, hi }(rng);
+}
+
+// A transform in the hierarchy, its detached twin updated by the recursive path and where it should be
+struct entry
+{
+    std::unique_ptr<transform> tfm{ std::make_unique<transform>() };
+    transform                  shadow{};
+    entry*                     parent{};
+    bool                       attached{};
+};
+
+class scene_model
+{
+public:
+    explicit scene_model(u32 seed) : m_rng{ seed }, m_seed{ seed } {}
+
+    ~scene_model()
+    {
+        // Destroy the transforms while the hierarchy they are in still exists
+        m_entries.clear();
+    }
+
+    void attach(entry& e, entry* parent)
+    {
+        m_hierarchy.attach(e.tfm.get(), parent ? parent->tfm.get() : nullptr);
+        e.parent   = parent;
+        e.attached = true;
+    }
+
+    // Detaching or destroying takes the whole subtree out, the children keep their parent pointer in the model
+    // only while they are attached
+    void detach(entry& e, bool destroy)
+    {
+        std::vector<entry*> subtree{};
+        for (const auto& other : m_entries)
+        {
+            if (other->attached && descends_from(*other, e))
+            {
+                subtree.push_back(other.get());
+            }
+        }
+        for (entry* other : subtree)
+        {
+            other->attached = false;
+            other->parent   = nullptr;
+        }
+
+        if (destroy)
+        {
+            // The new transform starts from defaults, give both copies the same values again
+            e.tfm = std::make_unique<transform>();
+            change(e);
+        } else
+        {
+            m_hierarchy.detach(e.tfm.get());
+        }
+    }
+
+    void step()
+    {
+        const u32 op = pick(10);
+        if (op < 3 || attached_count() < 2)
+        {
+            entry* parent = pick_attached();
+            attach(*free_entry(), pick(4) == 0 ? nullptr : parent);
+        } else if (op < 6)
+        {
+            // Reparent under anything outside its own subtree, or make it a root
+            entry& e      = *pick_attached();
+            entry* parent = pick_attached();
+            if (parent && descends_from(*parent, e))
+            {
+                parent = nullptr;
+            }
+            attach(e, parent);
+        } else if (op < 7)
+        {
+            detach(*pick_attached(), pick(2) == 0);
+        } else
+        {
+            for (u32 i = 0, n = pick(8); i < n; ++i)
+            {
+                change(*pick_attached());
+            }
+        }
+
+        check_layout();
+        if (pick(3) == 0)
+        {
+            update();
+        }
+    }
+
+    void update()
+    {
+        m_hierarchy.update();
+
+        const std::vector<u32>& changed = m_hierarchy.changed();
+        for (u32 i = 1; i < changed.size(); ++i)
+        {
+            check(changed[i - 1] < changed[i], "changed nodes are in depth-first order without repeats", m_seed);
+        }
+
+        for (const auto& e : m_entries)
+        {
+            if (e->attached && !e->parent)
+            {
+                calculate_recursive(*e);
+            }
+        }
+
+        for (const auto& e : m_entries)
+        {
+            if (e->attached)
+            {
+                check(math::are_matrices_equal(m_hierarchy.world(e->tfm->node()), e->shadow.transformation()),
+                      "world matrix matches the recursive path", m_seed);
+                check(math::are_matrices_equal(e->tfm->transformation(), e->shadow.transformation()),
+                      "the transform holds its world matrix", m_seed);
+            }
+        }
+    }
+
+    void check_layout()
+    {
+        u32 count{};
+        for (const auto& e : m_entries)
+        {
+            if (!e->attached)
+            {
+                check(e->tfm->hierarchy() == nullptr, "a detached transform has no hierarchy", m_seed);
+                check(e->tfm->node() == invalid_u32, "a detached transform has no node", m_seed);
+                continue;
+            }
+
+            ++count;
+            const u32 node = e->tfm->node();
+            check(e->tfm->hierarchy() == &m_hierarchy, "an attached transform knows its hierarchy", m_seed);
+            if (node >= m_hierarchy.size() || m_hierarchy.get(node) != e->tfm.get())
+            {
+                check(false, "a transform's node points back at it", m_seed);
+                continue;
+            }
+
+            const u32 parent = e->parent ? e->parent->tfm->node() : invalid_u32;
+            check(m_hierarchy.parent(node) == parent, "the parent matches", m_seed);
+            check(parent == invalid_u32 || parent < node, "parents come before their children", m_seed);
+
+            // The subtree is exactly the contiguous range after the node
+            const u32 size = m_hierarchy.subtree_size(node);
+            u32       descendants{};
+            for (const auto& other : m_entries)
+            {
+                if (other->attached && descends_from(*other, *e))
+                {
+                    ++descendants;
+                    const u32 other_node = other->tfm->node();
+                    check(other_node >= node && other_node < node + size, "a descendant lies in the subtree range",
+                          m_seed);
+                }
+            }
+            check(size == descendants, "the subtree size counts the node and its descendants", m_seed);
+        }
+        check(m_hierarchy.size() == count, "the hierarchy holds exactly the attached transforms", m_seed);
+    }
+
+private:
+    u32 pick(u32 n) { return std::uniform_int_distribution<u32>{ 0, n - 1 }(m_rng); }
+
+    // True if e is ancestor or e itself
+    static bool descends_from(const entry& e, const entry& ancestor)
+    {
+        for (const entry* a = &e; a; a = a->parent)
+        {
+            if (a == &ancestor)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    u32 attached_count() const { return m_hierarchy.size(); }
+
+    entry* pick_attached()
+    {
+        if (attached_count() == 0)
+        {
+            return nullptr;
+        }
+
+        const u32 node = pick(attached_count());
+        for (const auto& e : m_entries)
+        {
+            if (e->attached && e->tfm->node() == node)
+            {
+                return e.get();
+            }
+        }
+        return nullptr;
+    }
+
+    // Reuses a detached entry half the time, it comes back as a single node
+    entry* free_entry()
+    {
+        if (pick(2) == 0)
+        {
+            for (const auto& e : m_entries)
+            {
+                if (!e->attached)
+                {
+                    return e.get();
+                }
+            }
+        }
+
+        entry& e = *m_entries.emplace_back(std::make_unique<entry>());
+        change(e);
+        return &e;
+    }
+
+    void change(entry& e)
+    {
+        const math::vec3 position{ uniform(m_rng, -10.f, 10.f), uniform(m_rng, -10.f, 10.f), uniform(m_rng, -10.f, 10.f) };
+        const f32        scale = uniform(m_rng, .5f, 1.5f);
+        const math::vec3 angles{ uniform(m_rng, -3.f, 3.f), uniform(m_rng, -3.f, 3.f), uniform(m_rng, -3.f, 3.f) };
+
+        for (transform* t : { e.tfm.get(), &e.shadow })
+        {
+            t->set_position(position);
+            t->set_scale(scale);
+            t->set_rotation(angles.x, angles.y, angles.z);
+        }
+    }
+
+    void calculate_recursive(entry& e)
+    {
+        e.shadow.calculate_transformation(e.parent ? &e.parent->shadow : nullptr);
+        for (const auto& child : m_entries)
+        {
+            if (child->attached && child->parent == &e)
+            {
+                calculate_recursive(*child);
+            }
+        }
+    }
+
+    transform_hierarchy                 m_hierarchy{};
+    std::vector<std::unique_ptr<entry>> m_entries{};
+    std::mt19937                        m_rng;
+    u32                                 m_seed;
+};
+
+// Moving a subtree forwards, backwards and to the root, with the expected order written out
+void known_moves()
+{
+    transform_hierarchy hierarchy{};
+    transform           a, b, c, d, e;
+
+    hierarchy.attach(&a);
+    hierarchy.attach(&b, &a);
+    hierarchy.attach(&c, &b);
+    hierarchy.attach(&d);
+    hierarchy.attach(&e, &d);
+
+    // a b c d e
+    check(a.node() == 0 && b.node() == 1 && c.node() == 2 && d.node() == 3 && e.node() == 4, "attach appends", 0);
+    check(hierarchy.subtree_size(0) == 3 && hierarchy.subtree_size(3) == 2, "subtree sizes after attach", 0);
+
+    // Forwards past d's subtree: a d e b c
+    hierarchy.attach(&b, &d);
+    check(a.node() == 0 && d.node() == 1 && e.node() == 2 && b.node() == 3 && c.node() == 4, "moving forwards", 0);
+    check(hierarchy.subtree_size(a.node()) == 1 && hierarchy.subtree_size(d.node()) == 4, "sizes moving forwards", 0);
+    check(hierarchy.parent(b.node()) == d.node() && hierarchy.parent(c.node()) == b.node(), "parents moving forwards", 0);
+
+    // Backwards under a: a e d b c
+    hierarchy.attach(&e, &a);
+    check(a.node() == 0 && e.node() == 1 && d.node() == 2 && b.node() == 3 && c.node() == 4, "moving backwards", 0);
+    check(hierarchy.parent(e.node()) == a.node() && hierarchy.subtree_size(d.node()) == 3, "parents moving backwards", 0);
+
+    // To the root: a e d c b
+    hierarchy.attach(&c);
+    check(c.node() == 4 && b.node() == 3 && hierarchy.parent(c.node()) == invalid_u32, "moving to the root", 0);
+    check(hierarchy.subtree_size(d.node()) == 2, "sizes moving to the root", 0);
+
+    // Detaching d takes b along: a e c
+    hierarchy.detach(&d);
+    check(hierarchy.size() == 3 && c.node() == 2 && d.node() == invalid_u32 && b.node() == invalid_u32, "detaching", 0);
+    check(hierarchy.subtree_size(a.node()) == 2, "sizes after detaching", 0);
+}
+
+} // anonymous namespace
+
+int main()
+{
+    known_moves();
+
+    constexpr u32 seeds = 200;
+    constexpr u32 steps = 150;
+    for (u32 seed = 1; seed <= seeds; ++seed)
+    {
+        scene_model model{ seed };
+        for (u32 i = 0; i < steps; ++i)
+        {
+            model.step();
+        }
+        model.update();
+    }
+
+    if (failures)
+    {
+        fprintf(stderr, "%u checks failed\n", failures);
+        return 1;
+    }
+    printf("Transform hierarchy test passed, %u seeds of %u steps\n", seeds, steps);
+    return 0;
+}
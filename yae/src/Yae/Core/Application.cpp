@@ -25,18 +25,42 @@
 
 #include "Input.h"
 #include "Yae/Graphics/D3D11Core.h"
+#include "Yae/Graphics/Culling.h"
 #include "Yae/Graphics/Renderer.h"
+#include "Yae/Graphics/Shaders/ConstantUploads.h"
+#include "Yae/Graphics/StateCache.h"
 #include "Yae/Util/AssetManager.h"
 
 namespace yae
 {
+namespace
+{
+
+constexpr std::string_view gbuffer_names[] = { "gbuffer_position", "gbuffer_normal", "gbuffer_diffuse" };
+
+gfx::core::gbuffer_views gbuffer_from(const gfx::frame_graph& graph)
+{
+    gfx::core::gbuffer_views views{};
+    for (u32 i = 0; i < 3; ++i)
+    {
+        const gfx::graph_views& target = graph.views(gbuffer_names[i]);
+        views.targets[i]               = target.rtv;
+        views.textures[i]              = target.srv;
+    }
+
+    views.depth = graph.views("gbuffer_depth").dsv;
+    return views;
+}
+
+} // anonymous namespace
 
 namespace app
 {
 namespace
 {
-game* game_instance;
-bool  game_initialized{};
+game*                game_instance;
+bool                 game_initialized{};
+const render_thread* pipeline{};
 } // anonymous namespace
 
 void set(game* game)
@@ -54,6 +78,11 @@ game* instance()
     return game_instance;
 }
 
+frame_timings timings()
+{
+    return pipeline ? pipeline->last_frame() : frame_timings{};
+}
+
 } // namespace app
 
 
@@ -81,11 +110,20 @@ bool application::init(i32 width, i32 height, HWND hwnd)
     }
     LOG_INFO("Game initialized");
 
-    m_fps_string.init(gfx::fonts::coolvetica(), "FPS: 0", 10, 10);
-    m_fps_string.set_color(0.f, 1.f, 0.f);
+    m_fps_string = create_ref<gfx::text_string>();
+    m_fps_string->init(gfx::fonts::coolvetica(), "FPS: 0", 10, 10);
 
     m_fps.start();
 
+    if (!build_frame_graph((u32) width, (u32) height))
+    {
+        return false;
+    }
+
+    m_render_thread.start(g_settings->get<u32>("engine", "render_latency"),
+                          [this](gfx::frame_packet& packet) { return render(packet); });
+    app::pipeline = &m_render_thread;
+
     LOG_INFO("Application initialized");
     m_timer.start();
     return true;
@@ -94,6 +132,10 @@ bool application::init(i32 width, i32 height, HWND hwnd)
 void application::shutdown()
 {
     LOG_INFO("Shutting down application");
+    app::pipeline = nullptr;
+    m_render_thread.stop();
+    m_transients.release();
+    m_fps_string.reset();
     gfx::fonts::unload();
     LOG_INFO("Shutting down game");
     assets::destroy();
@@ -115,38 +157,97 @@ bool application::frame()
     m_game->update(m_timer.frame_time());
 
     input::update(m_timer.frame_time());
-    return render();
+
+    gfx::frame_packet& packet = m_render_thread.acquire();
+    if (!extract(packet))
+    {
+        return false;
+    }
+    return m_render_thread.submit(packet);
 }
 
-bool application::render()
+bool application::build_frame_graph(u32 width, u32 height)
 {
-    gfx::core::begin_scene(0.f, 0.f, 0.f, 1.f);
-    gfx::core::clear_first_stage();
+    const gfx::transient_desc color{ width, height, DXGI_FORMAT_R32G32B32A32_FLOAT, false };
+    const gfx::transient_desc depth{ width, height, DXGI_FORMAT_D24_UNORM_S8_UINT, true };
+
+    m_frame_graph.clear();
+    m_frame_graph.import("back_buffer", { .rtv = gfx::core::back_buffer_view() });
+
+    const u32 gbuffer = m_frame_graph.add_pass("gbuffer", [](const gfx::frame_graph& graph) {
+        gfx::core::set_gbuffer(gbuffer_from(graph));
+        gfx::core::clear_first_stage();
+        gfx::flush_queue(gfx::render_pass::geometry);
+    });
+    for (const auto name : gbuffer_names)
+    {
+        m_frame_graph.create(gbuffer, name, color);
+    }
+    m_frame_graph.create(gbuffer, "gbuffer_depth", depth);
+
+    const u32 lighting = m_frame_graph.add_pass("lighting", [](const gfx::frame_graph& graph) {
+        gfx::core::set_gbuffer(gbuffer_from(graph));
+        gfx::core::clear_second_stage();
+        gfx::render_base_to_screen();
+        gfx::render_all_pointlights();
+    });
+    for (const auto name : gbuffer_names)
+    {
+        m_frame_graph.read(lighting, name);
+    }
+    m_frame_graph.read(lighting, "gbuffer_depth");
+    m_frame_graph.write(lighting, "back_buffer");
 
-    if (!m_game->render())
+    const u32 overlay = m_frame_graph.add_pass("overlay", [](const gfx::frame_graph&) {
+        gfx::core::disable_zbuffer();
+        gfx::core::enable_alpha_blending();
+        gfx::flush_queue(gfx::render_pass::overlay);
+    });
+    m_frame_graph.write(overlay, "back_buffer");
+
+    if (!m_frame_graph.compile())
     {
+        LOG_ERROR("Failed to compile the frame graph");
         return false;
     }
+    return true;
+}
 
-    gfx::core::clear_second_stage();
+bool application::extract(gfx::frame_packet& packet)
+{
+    timer extraction{};
+    extraction.start();
 
-    gfx::render_base_to_screen();
+    // Decide what is on screen before anything is submitted
+    const math::matrix view_projection = XMMatrixMultiply(m_camera->view(), gfx::core::get_projection_matrix());
+    gfx::culling::cull(math::frustum::from_matrix(view_projection));
 
-    gfx::render_all_pointlights();
+    gfx::begin_extract(packet, m_camera->view(), m_camera->position());
+    const bool result = m_game->render() && m_game->render2d();
+    gfx::render_text(m_fps_string, std::format("FPS: {}", m_fps.fps()), m_fps_color);
+    gfx::end_extract();
 
+    extraction.frame();
+    packet.extract_ms = extraction.frame_time() * 1000.f;
+    return result;
+}
 
-    gfx::core::disable_zbuffer();
-    gfx::core::enable_alpha_blending();
-    if (!m_game->render2d())
+bool application::render(gfx::frame_packet& packet)
+{
+    gfx::core::begin_scene(0.f, 0.f, 0.f, 1.f);
+
+    if (!gfx::begin_frame(packet))
     {
         return false;
     }
-    const std::string fps = std::format("FPS: {}", m_fps.fps());
-    m_fps_string.draw(fps);
-    //gfx::core::disable_alpha_blending();
-    //gfx::core::enable_zbuffer();
+
+    m_transients.begin_frame();
+    m_frame_graph.execute([this](const gfx::transient_desc& desc) { return m_transients.acquire(desc); });
+    m_transients.end_frame();
 
     gfx::core::end_scene();
+    gfx::constant_uploads::end_frame();
+    gfx::state::end_frame();
 
     return true;
 }
@@ -159,15 +260,15 @@ void application::update_fps()
 
     if (fps >= 60)
     {
-        m_fps_string.set_color(0.f, 1.f, 0.f);
+        m_fps_color = { 0.f, 1.f, 0.f, 1.f };
     }
     if (fps < 60)
     {
-        m_fps_string.set_color(1.f, 1.f, 0.f);
+        m_fps_color = { 1.f, 1.f, 0.f, 1.f };
     }
     if (fps < 30)
     {
-        m_fps_string.set_color(1.f, 0.f, 0.f);
+        m_fps_color = { 1.f, 0.f, 0.f, 1.f };
     }
 }
 
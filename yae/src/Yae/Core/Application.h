@@ -33,8 +33,11 @@
 #include "Yae/Graphics/BitmapFont.h"
 #include "Yae/Graphics/Shaders/Shader.h"
 #include "Yae/Graphics/Camera.h"
+#include "Yae/Graphics/FrameGraph.h"
+#include "Yae/Graphics/TransientPool.h"
 #include "Yae/Util/FpsHelper.h"
 #include "Game.h"
+#include "RenderThread.h"
 #include "Timer.h"
 
 namespace yae
@@ -44,6 +47,9 @@ namespace app
 {
 void  set(game* game);
 game* instance();
+
+// Extraction, waiting and drawing times of the last frame drawn
+frame_timings timings();
 } // namespace app
 
 class application
@@ -57,13 +63,24 @@ public:
     bool frame();
 
 private:
-    bool render();
+    // Declares the deferred passes and the targets they share, compiled once at init
+    bool build_frame_graph(u32 width, u32 height);
+
+    // Simulation side, copies what the frame draws into the packet
+    bool extract(gfx::frame_packet& packet);
+
+    // On the render thread, or on the calling thread without one
+    bool render(gfx::frame_packet& packet);
     void update_fps();
 
-    game*            m_game{};
-    timer            m_timer{};
-    gfx::camera*     m_camera{};
-    fps_counter      m_fps{};
-    gfx::text_string m_fps_string{};
+    game*                 m_game{};
+    timer                 m_timer{};
+    gfx::camera*          m_camera{};
+    fps_counter           m_fps{};
+    ref<gfx::text_string> m_fps_string{};
+    math::vec4            m_fps_color{ 0.f, 1.f, 0.f, 1.f }; // Goes into the packet, the string is read by the renderer
+    gfx::frame_graph      m_frame_graph{};
+    gfx::transient_pool   m_transients{};
+    render_thread         m_render_thread{};
 };
 } // namespace yae
\ No newline at end of file
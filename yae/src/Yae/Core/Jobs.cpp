@@ -0,0 +1,348 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: Jobs.cpp
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+#include "Jobs.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace yae::jobs
+{
+namespace
+{
+
+struct job
+{
+    job_func func{};
+    counter* ctr{};
+    counter* dependency{};
+};
+
+struct job_queue
+{
+    std::mutex      mutex{};
+    std::deque<job> jobs{};
+};
+
+std::vector<std::thread> workers;
+std::vector<job_queue*>  queues;
+
+std::mutex              sleep_mutex;
+std::condition_variable sleep_cv;
+std::atomic<u32>        pending{};     // Jobs sitting in a queue, workers sleep while there are none
+std::atomic<u32>        outstanding{}; // Queued, parked and running jobs, shutdown drains until there are none
+std::atomic<bool>       running{};
+
+// Jobs whose dependency hasn't finished, requeued by the job that brings its counter to zero
+std::mutex                                           parked_mutex;
+std::unordered_map<const counter*, std::vector<job>> parked;
+
+thread_local u32 local_index{};
+
+void enqueue(job&& j)
+{
+    job_queue& queue = *queues[local_index];
+    {
+        std::lock_guard lock{ queue.mutex };
+        queue.jobs.push_back(std::move(j));
+    }
+
+    pending.fetch_add(1, std::memory_order_release);
+    {
+        // Taking the lock orders this with a worker that is between checking pending and going to sleep
+        std::lock_guard lock{ sleep_mutex };
+    }
+    sleep_cv.notify_one();
+}
+
+void push(job&& j)
+{
+    outstanding.fetch_add(1, std::memory_order_relaxed);
+    if (j.ctr)
+    {
+        j.ctr->value.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (j.dependency)
+    {
+        // Checked under the lock finish takes, so a job is either parked before its dependency's last job looks for
+        // it or sees the dependency done
+        std::lock_guard lock{ parked_mutex };
+        if (!j.dependency->done())
+        {
+            parked[j.dependency].push_back(std::move(j));
+            return;
+        }
+    }
+
+    enqueue(std::move(j));
+}
+
+void finish(counter* ctr)
+{
+    if (ctr->value.fetch_sub(1, std::memory_order_acq_rel) != 1)
+    {
+        return;
+    }
+
+    std::vector<job> ready{};
+    {
+        std::lock_guard lock{ parked_mutex };
+        const auto      it = parked.find(ctr);
+        if (it == parked.end())
+        {
+            return;
+        }
+
+        ready = std::move(it->second);
+        parked.erase(it);
+    }
+
+    for (auto& j : ready)
+    {
+        enqueue(std::move(j));
+    }
+}
+
+bool pop(u32 index, job& out)
+{
+    job_queue& queue = *queues[index];
+    std::lock_guard lock{ queue.mutex };
+    if (queue.jobs.empty())
+    {
+        return false;
+    }
+
+    // Owner works LIFO for cache warmth, thieves take the oldest job
+    if (index == local_index)
+    {
+        out = std::move(queue.jobs.back());
+        queue.jobs.pop_back();
+    } else
+    {
+        out = std::move(queue.jobs.front());
+        queue.jobs.pop_front();
+    }
+    return true;
+}
+
+bool try_run_one()
+{
+    const u32 count = (u32) queues.size();
+    job       j{};
+
+    for (u32 i = 0; i < count; ++i)
+    {
+        if (!pop((local_index + i) % count, j))
+        {
+            continue;
+        }
+
+        pending.fetch_sub(1, std::memory_order_relaxed);
+
+        j.func();
+        if (j.ctr)
+        {
+            finish(j.ctr);
+        }
+        outstanding.fetch_sub(1, std::memory_order_release);
+        return true;
+    }
+
+    return false;
+}
+
+void worker_loop(u32 index)
+{
+    local_index = index;
+    while (running.load(std::memory_order_acquire))
+    {
+        if (try_run_one())
+        {
+            continue;
+        }
+
+        std::unique_lock lock{ sleep_mutex };
+        sleep_cv.wait(lock, [] { return pending.load(std::memory_order_acquire) > 0 || !running.load(); });
+    }
+}
+
+} // anonymous namespace
+
+bool init(u32 worker_count)
+{
+    if (running)
+    {
+        LOG_WARN("Job system already initialized");
+        return true;
+    }
+
+    if (worker_count == 0)
+    {
+        const u32 hw = std::thread::hardware_concurrency();
+        worker_count = hw > 1 ? hw - 1 : 0;
+    }
+
+    LOG_INFO("Initializing job system with {} worker threads", worker_count);
+
+    local_index = 0;
+    queues.reserve(worker_count + 1);
+    for (u32 i = 0; i <= worker_count; ++i)
+    {
+        queues.push_back(new job_queue{});
+    }
+
+    running = true;
+    workers.reserve(worker_count);
+    for (u32 i = 1; i <= worker_count; ++i)
+    {
+        workers.emplace_back(worker_loop, i);
+    }
+
+    return true;
+}
+
+void shutdown()
+{
+    if (!running)
+    {
+        return;
+    }
+
+    LOG_INFO("Shutting down job system");
+
+    // Drain whatever is left, parked jobs included, so nobody waits on a counter that never reaches zero. Workers
+    // still running a job may queue more, so this waits for them too
+    while (outstanding.load(std::memory_order_acquire) > 0)
+    {
+        if (!try_run_one())
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    {
+        std::lock_guard lock{ sleep_mutex };
+        running = false;
+    }
+    sleep_cv.notify_all();
+
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+    workers.clear();
+
+    for (auto& queue : queues)
+    {
+        SAFE_DELETE(queue);
+    }
+    queues.clear();
+    parked.clear();
+    pending     = 0;
+    outstanding = 0;
+}
+
+u32 worker_count()
+{
+    return (u32) workers.size();
+}
+
+u32 thread_index()
+{
+    return local_index;
+}
+
+void run(job_func job, counter* ctr)
+{
+    if (workers.empty())
+    {
+        job();
+        return;
+    }
+
+    push({ std::move(job), ctr, nullptr });
+}
+
+void run_after(counter& dependency, job_func job, counter* ctr)
+{
+    if (workers.empty())
+    {
+        wait(dependency);
+        job();
+        return;
+    }
+
+    push({ std::move(job), ctr, &dependency });
+}
+
+void wait(const counter& ctr)
+{
+    while (!ctr.done())
+    {
+        if (!try_run_one())
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void parallel_for(u32 begin, u32 end, u32 grain, const range_func& func)
+{
+    if (begin >= end)
+    {
+        return;
+    }
+
+    const u32 count = end - begin;
+    if (grain == 0)
+    {
+        // A few chunks per thread so stealing can even out uneven work
+        const u32 threads = worker_count() + 1;
+        grain             = std::max(1u, count / (threads * 4));
+    }
+
+    if (workers.empty() || count <= grain)
+    {
+        func(begin, end);
+        return;
+    }
+
+    counter ctr{};
+    u32     first = begin;
+
+    // Keep the first chunk for the calling thread
+    for (first += grain; first < end; first += grain)
+    {
+        const u32 last = std::min(first + grain, end);
+        push({ [&func, first, last] { func(first, last); }, &ctr, nullptr });
+    }
+
+    func(begin, begin + grain);
+    wait(ctr);
+}
+
+} // namespace yae::jobs
@@ -0,0 +1,97 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: Jobs.h
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+
+#pragma once
+
+#include "Yae/Common.h"
+
+#include <atomic>
+#include <functional>
+
+namespace yae::jobs
+{
+
+using job_func   = std::function<void()>;
+using range_func = std::function<void(u32 begin, u32 end)>;
+
+/**
+ * \brief Tracks a group of jobs. Every job run against a counter increments it when queued and decrements it once
+ * finished, so a value of zero means the whole group has completed
+ */
+struct counter
+{
+    std::atomic<u32> value{};
+
+    bool done() const { return value.load(std::memory_order_acquire) == 0; }
+};
+
+/**
+ * \brief Starts the worker threads. Each worker owns a deque it pops from the back of, idle workers steal from the
+ * front of the others
+ * \param worker_count Number of workers to start. 0 picks one less than the number of hardware threads
+ * \return true if the job system is ready. With no workers every job simply runs inline on the calling thread
+ */
+bool init(u32 worker_count = 0);
+
+void shutdown();
+
+// Number of worker threads, not counting the thread that called init
+u32 worker_count();
+
+// Index of the calling thread's queue. 0 for the thread that called init (or any thread that isn't a worker)
+u32 thread_index();
+
+/**
+ * \brief Queues a job on the calling thread's deque
+ * \param job The job to run
+ * \param ctr Optional counter to add the job to
+ */
+void run(job_func job, counter* ctr = nullptr);
+
+/**
+ * \brief Queues a job that will only be started once another group of jobs has completed. Until then it is parked on
+ * the dependency instead of a queue, the job that finishes the group queues it
+ * \param dependency The group that has to finish first
+ * \param job The job to run
+ * \param ctr Optional counter to add the job to
+ */
+void run_after(counter& dependency, job_func job, counter* ctr = nullptr);
+
+/**
+ * \brief Blocks until the counter reaches zero. The waiting thread keeps running queued jobs in the meantime, so
+ * it is safe to wait from inside a job
+ * \param ctr The counter to wait on
+ */
+void wait(const counter& ctr);
+
+/**
+ * \brief Splits [begin, end) into chunks of at most grain indices and runs them across the workers, returning once
+ * every chunk has completed. Small ranges run inline
+ * \param begin First index
+ * \param end One past the last index
+ * \param grain Maximum chunk size, 0 picks one based on the worker count
+ * \param func Called once per chunk with its [begin, end)
+ */
+void parallel_for(u32 begin, u32 end, u32 grain, const range_func& func);
+
+} // namespace yae::jobs
@@ -0,0 +1,163 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: RenderThread.cpp
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+#include "RenderThread.h"
+
+#include "Timer.h"
+#include "Yae/Graphics/D3D11Core.h"
+
+namespace yae
+{
+
+render_thread::~render_thread()
+{
+    stop();
+}
+
+void render_thread::start(u32 latency, render_func render)
+{
+    if (latency > max_latency)
+    {
+        LOG_WARN("Render latency {} is above the maximum of {} frames", latency, max_latency);
+        latency = max_latency;
+    }
+
+    m_latency = latency;
+    m_render  = std::move(render);
+    m_failed  = false;
+
+    for (u32 i = 0; i <= m_latency; ++i)
+    {
+        m_free.push_back(m_packets.emplace_back(std::make_unique<gfx::frame_packet>()).get());
+    }
+
+    if (m_latency > 0)
+    {
+        m_running = true;
+        m_thread  = std::thread{ [this] { run(); } };
+        LOG_INFO("Frames are drawn on a render thread, up to {} frames behind the simulation", m_latency);
+    }
+}
+
+void render_thread::stop()
+{
+    if (m_thread.joinable())
+    {
+        {
+            std::lock_guard lock{ m_mutex };
+            m_running = false;
+        }
+        m_ready_cv.notify_all();
+        m_thread.join();
+        gfx::core::claim_backend();
+    }
+
+    m_free.clear();
+    m_ready.clear();
+    m_packets.clear();
+}
+
+gfx::frame_packet& render_thread::acquire()
+{
+    timer wait{};
+    wait.start();
+
+    std::unique_lock lock{ m_mutex };
+    m_free_cv.wait(lock, [this] { return !m_free.empty(); });
+
+    gfx::frame_packet* packet = m_free.front();
+    m_free.pop_front();
+    packet->frame = m_frame++;
+
+    wait.frame();
+    m_timings.wait_ms = wait.frame_time() * 1000.f;
+    return *packet;
+}
+
+bool render_thread::submit(gfx::frame_packet& packet)
+{
+    if (!m_thread.joinable())
+    {
+        const bool result = draw(packet);
+        std::lock_guard lock{ m_mutex };
+        m_free.push_back(&packet);
+        return result;
+    }
+
+    bool failed{};
+    {
+        std::lock_guard lock{ m_mutex };
+        m_ready.push_back(&packet);
+        failed = m_failed;
+    }
+    m_ready_cv.notify_one();
+    return !failed;
+}
+
+frame_timings render_thread::last_frame() const
+{
+    std::lock_guard lock{ m_mutex };
+    return m_timings;
+}
+
+void render_thread::run()
+{
+    gfx::core::claim_backend();
+
+    while (true)
+    {
+        gfx::frame_packet* packet{};
+        {
+            std::unique_lock lock{ m_mutex };
+            m_ready_cv.wait(lock, [this] { return !m_ready.empty() || !m_running; });
+            if (m_ready.empty())
+            {
+                return;
+            }
+            packet = m_ready.front();
+            m_ready.pop_front();
+        }
+
+        const bool result = draw(*packet);
+        {
+            std::lock_guard lock{ m_mutex };
+            m_failed = m_failed || !result;
+            m_free.push_back(packet);
+        }
+        m_free_cv.notify_one();
+    }
+}
+
+bool render_thread::draw(gfx::frame_packet& packet)
+{
+    timer render{};
+    render.start();
+    const bool result = m_render(packet);
+    render.frame();
+
+    std::lock_guard lock{ m_mutex };
+    m_timings.extract_ms = packet.extract_ms;
+    m_timings.render_ms  = render.frame_time() * 1000.f;
+    return result;
+}
+
+} // namespace yae
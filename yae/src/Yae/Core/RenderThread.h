@@ -0,0 +1,105 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: RenderThread.h
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+
+#pragma once
+
+#include "Yae/Common.h"
+#include "Yae/Graphics/FramePacket.h"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace yae
+{
+
+// Milliseconds spent on the last frame that was drawn
+struct frame_timings
+{
+    f32 extract_ms{}; // Simulation copying the frame into its packet
+    f32 wait_ms{};    // Simulation waiting for a free packet, the render thread was behind
+    f32 render_ms{};  // Drawing the packet and presenting it
+};
+
+/**
+ * \brief Pipelines frames between the simulation and a render thread. The simulation acquires a packet, extracts the
+ * frame into it and submits it. The render thread draws submitted packets in order while the simulation already
+ * updates the next frame.\n\n
+ * With a latency of N there are N + 1 packets and the simulation runs at most N frames ahead of the frame being drawn.
+ * A latency of 0 starts no thread, submit draws the packet on the calling thread. Once the thread is started it is
+ * the only one that may use the immediate backend, it claims it with core::claim_backend and stop hands it back
+ */
+class render_thread
+{
+public:
+    static constexpr u32 max_latency = 2;
+
+    using render_func = std::function<bool(gfx::frame_packet& packet)>;
+
+    render_thread() = default;
+    ~render_thread();
+    DISABLE_COPY_AND_MOVE(render_thread);
+
+    /**
+     * \brief Creates the packets and starts the thread
+     * \param latency Frames the simulation may run ahead, 0 to draw on the calling thread
+     * \param render Draws one packet, false ends the run loop
+     */
+    void start(u32 latency, render_func render);
+
+    // Draws what has already been submitted, then joins the thread
+    void stop();
+
+    // Packet to extract the next frame into. Blocks while every packet is queued or being drawn
+    gfx::frame_packet& acquire();
+
+    // Queues the packet for drawing. False once a frame has failed to draw
+    bool submit(gfx::frame_packet& packet);
+
+    u32           latency() const { return m_latency; }
+    frame_timings last_frame() const;
+
+private:
+    void run();
+    bool draw(gfx::frame_packet& packet);
+
+    std::vector<std::unique_ptr<gfx::frame_packet>> m_packets{};
+    std::deque<gfx::frame_packet*>                  m_free{};
+    std::deque<gfx::frame_packet*>                  m_ready{}; // Submitted, in frame order
+
+    mutable std::mutex      m_mutex{};
+    std::condition_variable m_free_cv{};
+    std::condition_variable m_ready_cv{};
+    std::thread             m_thread{};
+    render_func             m_render{};
+    frame_timings           m_timings{};
+    u64                     m_frame{};
+    u32                     m_latency{};
+    bool                    m_running{};
+    bool                    m_failed{};
+};
+
+} // namespace yae
@@ -79,6 +79,10 @@ void settings::save(bool regenerate)
 void settings::create_default_settings()
 {
     set("display", "vsync", true);
+    set("graphics", "light_volumes", false);
+    set("graphics", "command_lists", 0u); // Geometry pass lists recorded in parallel, 0 or 1 draws it on the immediate context
+    set("engine", "render_latency", 0u); // 1 or 2 draws frames on a render thread that many frames behind the simulation
+    set("engine", "backend", std::string{ "d3d11" }); // "null" runs frames without a GPU, "software" renders them on the CPU
 }
 
 } // namespace yae
\ No newline at end of file
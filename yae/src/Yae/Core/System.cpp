@@ -25,6 +25,7 @@
 #include "Input.h"
 #include "Application.h"
 #include "Event.h"
+#include "Jobs.h"
 
 #include <windowsx.h>
 
@@ -183,6 +184,13 @@ bool init(game* game)
     LOG_INFO("Initializing YAE system");
     bool result{};
 
+    // 0 (or missing) lets the job system size itself to the machine
+    if (!jobs::init(g_settings->get<u32>("engine", "worker_threads")))
+    {
+        LOG_ERROR("Failed to initialize the job system");
+        return false;
+    }
+
     init_windows(screen_width, screen_height);
 
     LOG_INFO("Creating application");
@@ -212,6 +220,7 @@ void shutdown()
 
     gfx::core::shutdown();
     shutdown_windows();
+    jobs::shutdown();
     events::shutdown();
     LOG_INFO("YAE system shutdown");
 }
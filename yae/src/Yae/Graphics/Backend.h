@@ -0,0 +1,177 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: Backend.h
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+
+#pragma once
+
+#include "D3D11Common.h"
+
+namespace yae::gfx
+{
+
+enum class shader_stage : u8
+{
+    vertex,
+    pixel,
+    hull,
+    domain,
+    geometry,
+    compute,
+
+    count
+};
+
+enum class backend_type : u8
+{
+    d3d11,    // Hardware device and swap chain
+    null,     // Accepts every call and renders nothing, for measuring the CPU side of a frame without a GPU
+    software, // Runs the engine's shaders on the CPU, for reference images and machines without a GPU
+};
+
+/**
+ * \brief Everything the engine asks of the GPU. Resources are still the D3D11 interfaces, so existing code only changes
+ * who it calls: a backend creates them, binds them and draws with them.\n\n
+ * The D3D11 backend forwards to a device and its immediate context, the null backend hands out stand-in objects that
+ * only remember their descriptions. Call core::backend() for the active one.\n\n
+ * Draws can also be recorded on other threads: a recorder is a backend whose binds, uploads and draws are kept in a
+ * command list, which the immediate backend later executes in recording order
+ */
+class render_backend
+{
+public:
+    virtual ~render_backend() = default;
+
+    virtual backend_type type() const = 0;
+
+    // Resource creation, same arguments and results as the matching ID3D11Device calls
+
+    virtual HRESULT create_buffer(const D3D11_BUFFER_DESC* desc, const D3D11_SUBRESOURCE_DATA* data, ID3D11Buffer** buffer) = 0;
+    virtual HRESULT create_texture2d(const D3D11_TEXTURE2D_DESC* desc, const D3D11_SUBRESOURCE_DATA* data,
+                                     ID3D11Texture2D** texture)                                                             = 0;
+    virtual HRESULT create_shader_resource_view(ID3D11Resource* resource, const D3D11_SHADER_RESOURCE_VIEW_DESC* desc,
+                                                ID3D11ShaderResourceView** view)                                            = 0;
+    virtual HRESULT create_render_target_view(ID3D11Resource* resource, const D3D11_RENDER_TARGET_VIEW_DESC* desc,
+                                              ID3D11RenderTargetView** view)                                                = 0;
+    virtual HRESULT create_depth_stencil_view(ID3D11Resource* resource, const D3D11_DEPTH_STENCIL_VIEW_DESC* desc,
+                                              ID3D11DepthStencilView** view)                                                = 0;
+
+    virtual HRESULT create_input_layout(const D3D11_INPUT_ELEMENT_DESC* elements, u32 count, const void* bytecode, size_t size,
+                                        ID3D11InputLayout** layout)                                                 = 0;
+    virtual HRESULT create_vertex_shader(const void* bytecode, size_t size, ID3D11VertexShader** shader)            = 0;
+    virtual HRESULT create_pixel_shader(const void* bytecode, size_t size, ID3D11PixelShader** shader)              = 0;
+    virtual HRESULT create_hull_shader(const void* bytecode, size_t size, ID3D11HullShader** shader)                = 0;
+    virtual HRESULT create_domain_shader(const void* bytecode, size_t size, ID3D11DomainShader** shader)            = 0;
+    virtual HRESULT create_geometry_shader(const void* bytecode, size_t size, ID3D11GeometryShader** shader)        = 0;
+    virtual HRESULT create_geometry_shader_with_stream_output(const void* bytecode, size_t size,
+                                                              const D3D11_SO_DECLARATION_ENTRY* entries, u32 entry_count,
+                                                              u32 rasterized_stream, ID3D11GeometryShader** shader) = 0;
+    virtual HRESULT create_compute_shader(const void* bytecode, size_t size, ID3D11ComputeShader** shader)          = 0;
+
+    virtual HRESULT create_sampler_state(const D3D11_SAMPLER_DESC* desc, ID3D11SamplerState** state)                  = 0;
+    virtual HRESULT create_blend_state(const D3D11_BLEND_DESC* desc, ID3D11BlendState** state)                        = 0;
+    virtual HRESULT create_depth_stencil_state(const D3D11_DEPTH_STENCIL_DESC* desc, ID3D11DepthStencilState** state) = 0;
+    virtual HRESULT create_rasterizer_state(const D3D11_RASTERIZER_DESC* desc, ID3D11RasterizerState** state)         = 0;
+
+    // True if constant buffers can be bound by offset and dynamic ones mapped without overwrite, see constant_uploads
+    virtual bool supports_constant_offsets() const = 0;
+
+    // Uploads
+
+    virtual HRESULT map(ID3D11Resource* resource, u32 subresource, D3D11_MAP type, D3D11_MAPPED_SUBRESOURCE* mapped) = 0;
+    virtual void    unmap(ID3D11Resource* resource, u32 subresource)                                                 = 0;
+    virtual void    update_subresource(ID3D11Resource* resource, u32 subresource, const void* data, u32 row_pitch,
+                                       u32 depth_pitch)                                                              = 0;
+    virtual void    generate_mips(ID3D11ShaderResourceView* view)                                                    = 0;
+
+    // Input assembler
+
+    virtual void set_input_layout(ID3D11InputLayout* layout)                            = 0;
+    virtual void set_vertex_buffers(u32 slot, u32 count, ID3D11Buffer* const* buffers, const u32* strides,
+                                    const u32* offsets)                                 = 0;
+    virtual void set_index_buffer(ID3D11Buffer* buffer, DXGI_FORMAT format, u32 offset) = 0;
+    virtual void set_topology(D3D11_PRIMITIVE_TOPOLOGY topology)                        = 0;
+
+    // Shader stages
+
+    virtual void set_vertex_shader(ID3D11VertexShader* shader)     = 0;
+    virtual void set_pixel_shader(ID3D11PixelShader* shader)       = 0;
+    virtual void set_hull_shader(ID3D11HullShader* shader)         = 0;
+    virtual void set_domain_shader(ID3D11DomainShader* shader)     = 0;
+    virtual void set_geometry_shader(ID3D11GeometryShader* shader) = 0;
+    virtual void set_compute_shader(ID3D11ComputeShader* shader)   = 0;
+
+    virtual void set_constant_buffers(shader_stage stage, u32 slot, u32 count, ID3D11Buffer* const* buffers) = 0;
+    // Binds ranges of buffers in 16 byte constants, only valid when supports_constant_offsets is true
+    virtual void set_constant_buffer_ranges(shader_stage stage, u32 slot, u32 count, ID3D11Buffer* const* buffers,
+                                            const u32* first_constants, const u32* constant_counts)                    = 0;
+    virtual void set_shader_resources(shader_stage stage, u32 slot, u32 count, ID3D11ShaderResourceView* const* views) = 0;
+    virtual void set_samplers(shader_stage stage, u32 slot, u32 count, ID3D11SamplerState* const* samplers)            = 0;
+
+    virtual void set_unordered_access_views(u32 slot, u32 count, ID3D11UnorderedAccessView* const* views,
+                                            const u32* initial_counts)                                  = 0;
+    virtual void set_stream_output_targets(u32 count, ID3D11Buffer* const* buffers, const u32* offsets) = 0;
+
+    // Rasterizer and output merger
+
+    virtual void set_rasterizer_state(ID3D11RasterizerState* state)                                                 = 0;
+    virtual void set_viewports(u32 count, const D3D11_VIEWPORT* viewports)                                          = 0;
+    virtual void set_scissor_rects(u32 count, const D3D11_RECT* rects)                                              = 0;
+    virtual void set_blend_state(ID3D11BlendState* state, const f32 factor[4], u32 sample_mask)                     = 0;
+    virtual void set_depth_stencil_state(ID3D11DepthStencilState* state, u32 stencil_ref)                           = 0;
+    virtual void set_render_targets(u32 count, ID3D11RenderTargetView* const* views, ID3D11DepthStencilView* depth) = 0;
+
+    virtual void clear_render_target(ID3D11RenderTargetView* view, const f32 color[4])               = 0;
+    virtual void clear_depth_stencil(ID3D11DepthStencilView* view, u32 flags, f32 depth, u8 stencil) = 0;
+
+    // Draws
+
+    virtual void draw(u32 vertex_count, u32 first_vertex)                        = 0;
+    virtual void draw_indexed(u32 index_count, u32 first_index, i32 base_vertex) = 0;
+    virtual void draw_indexed_instanced(u32 index_count, u32 instance_count, u32 first_index, i32 base_vertex,
+                                        u32 first_instance)                      = 0;
+    virtual void dispatch(u32 groups_x, u32 groups_y, u32 groups_z)              = 0;
+
+    // Swap chain
+
+    virtual HRESULT back_buffer(ID3D11Texture2D** texture) = 0;
+    virtual void    present(bool vsync)                    = 0;
+    virtual void    set_fullscreen(bool fullscreen)        = 0;
+
+    // Command lists
+
+    /**
+     * \brief Creates a recorder, a backend that keeps the calls made on it in a command list instead of running them.
+     * A recorder is used by one thread at a time and every list it records starts from the default pipeline state.
+     * Objects created through it are created on this backend, which is not safe from several threads on every backend,
+     * so create before recording
+     * \return nullptr if the backend can't record. The caller deletes the recorder
+     */
+    virtual render_backend* create_recorder() = 0;
+
+    // Ends the list a recorder has recorded since its last finish. Fails on anything but a recorder
+    virtual HRESULT finish_command_list(ID3D11CommandList** list) = 0;
+
+    // Runs a finished list's calls in the order they were recorded. Pipeline state is back at the defaults afterwards
+    virtual void execute_command_list(ID3D11CommandList* list) = 0;
+};
+
+} // namespace yae::gfx
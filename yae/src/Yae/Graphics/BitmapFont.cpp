@@ -25,6 +25,7 @@
 
 #include "D3D11Core.h"
 #include "Renderer.h"
+#include "StateCache.h"
 #include "Shaders/Shader.h"
 #include "Shaders/ShaderLibrary.h"
 #include "Yae/Core/System.h"
@@ -258,6 +259,8 @@ text_string::~text_string()
 
 bool text_string::init(const bitmap_font& font, const std::string& initial_text, i32 x, i32 y)
 {
+    assert(core::owns_backend());
+
     D3D11_BUFFER_DESC      vtx_desc{};
     D3D11_BUFFER_DESC      idx_desc{};
     D3D11_SUBRESOURCE_DATA vtx_data{};
@@ -282,7 +285,7 @@ bool text_string::init(const bitmap_font& font, const std::string& initial_text,
     vtx_data.SysMemPitch      = 0;
     vtx_data.SysMemSlicePitch = 0;
 
-    DX_CALL(core::get_device()->CreateBuffer(&vtx_desc, &vtx_data, &m_vertex_buffer));
+    DX_CALL(core::backend()->create_buffer(&vtx_desc, &vtx_data, &m_vertex_buffer));
 
     idx_desc.Usage               = D3D11_USAGE_DEFAULT;
     idx_desc.ByteWidth           = sizeof(u32) * (u32) m_indices.size();
@@ -295,13 +298,18 @@ bool text_string::init(const bitmap_font& font, const std::string& initial_text,
     idx_data.SysMemPitch      = 0;
     idx_data.SysMemSlicePitch = 0;
 
-    DX_CALL(core::get_device()->CreateBuffer(&idx_desc, &idx_data, &m_index_buffer));
+    DX_CALL(core::backend()->create_buffer(&idx_desc, &idx_data, &m_index_buffer));
 
     m_font = font;
     return update_text(initial_text, (f32) x, (f32) y);
 }
 
 void text_string::draw() const
+{
+    draw_colored(m_color);
+}
+
+void text_string::draw_colored(const math::vec4& color) const
 {
     vertex_shader* vs = shaders::font()->vs;
     pixel_shader*  ps = shaders::font()->ps;
@@ -316,19 +324,16 @@ void text_string::draw() const
 
     ps->set_shader_resource_view("diffuse", m_font.texture_view());
     ps->set_sampler_state("Sampler", default_sampler_state());
-    ps->set_float4("fontColor", m_color);
+    ps->set_float4("fontColor", color);
 
     ps->copy_all_buffers();
     ps->bind();
 
-    constexpr u32 stride = sizeof(vertex_position_texture);
-    constexpr u32 offset{};
-
-    core::get_device_context()->IASetVertexBuffers(0, 1, &m_vertex_buffer, &stride, &offset);
-    core::get_device_context()->IASetIndexBuffer(m_index_buffer, DXGI_FORMAT_R32_UINT, 0);
-    core::get_device_context()->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    state::set_vertex_buffer(0, m_vertex_buffer, sizeof(vertex_position_texture), 0);
+    state::set_index_buffer(m_index_buffer, DXGI_FORMAT_R32_UINT);
+    state::set_topology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
-    core::get_device_context()->DrawIndexed((u32) m_indices.size(), 0, 0);
+    core::backend()->draw_indexed((u32) m_indices.size(), 0, 0);
 }
 
 void text_string::draw(f32 x, f32 y)
@@ -349,6 +354,12 @@ void text_string::draw(const std::string& text, f32 x, f32 y)
     draw();
 }
 
+void text_string::draw(const std::string& text, const math::vec4& color)
+{
+    update_text(text, m_absolute_x, m_absolute_y);
+    draw_colored(color);
+}
+
 bool text_string::update_text(const std::string& text, f32 x, f32 y)
 {
     if (m_text == text && m_absolute_x == x && m_absolute_y == y)
@@ -367,10 +378,10 @@ bool text_string::update_text(const std::string& text, f32 x, f32 y)
 
     m_font.build_vertex_array(m_vertices, text, m_posx, m_posy);
 
-    DX_CALL(core::get_device_context()->Map(m_vertex_buffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped_res));
+    DX_CALL(core::backend()->map(m_vertex_buffer, 0, D3D11_MAP_WRITE_DISCARD, &mapped_res));
     auto* ptr = (vertex_position_texture*) mapped_res.pData;
     CopyMemory(ptr, m_vertices.data(), sizeof(vertex_position_texture) * m_vertices.size());
-    core::get_device_context()->Unmap(m_vertex_buffer, 0);
+    core::backend()->unmap(m_vertex_buffer, 0);
 
     return true;
 }
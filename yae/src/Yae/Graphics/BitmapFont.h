@@ -91,8 +91,12 @@ public:
     void draw(const std::string& text);
     void draw(const std::string& text, f32 x, f32 y);
 
+    // Draws in the given color instead of the string's own, for callers that can't set it on a shared string
+    void draw(const std::string& text, const math::vec4& color);
+
 private:
     bool update_text(const std::string& text, f32 x, f32 y);
+    void draw_colored(const math::vec4& color) const;
 
     bitmap_font                          m_font{};
     std::string                          m_text{};
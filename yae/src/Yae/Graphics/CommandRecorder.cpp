@@ -0,0 +1,740 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: CommandRecorder.cpp
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+#include "CommandRecorder.h"
+
+#include <algorithm>
+
+namespace yae::gfx
+{
+
+namespace
+{
+
+constexpr u32 batch = 8; // Slots per recorded bind, longer binds are split into several
+
+// Binds that take one object, the member is called on the target as it was on the recorder
+template<typename Object, void (render_backend::*Set)(Object*)>
+struct set_object
+{
+    Object* object;
+
+    void execute(render_backend& target) const { (target.*Set)(object); }
+};
+
+using set_input_layout_command    = set_object<ID3D11InputLayout, &render_backend::set_input_layout>;
+using set_vertex_shader_command   = set_object<ID3D11VertexShader, &render_backend::set_vertex_shader>;
+using set_pixel_shader_command    = set_object<ID3D11PixelShader, &render_backend::set_pixel_shader>;
+using set_hull_shader_command     = set_object<ID3D11HullShader, &render_backend::set_hull_shader>;
+using set_domain_shader_command   = set_object<ID3D11DomainShader, &render_backend::set_domain_shader>;
+using set_geometry_shader_command = set_object<ID3D11GeometryShader, &render_backend::set_geometry_shader>;
+using set_compute_shader_command  = set_object<ID3D11ComputeShader, &render_backend::set_compute_shader>;
+using set_rasterizer_command      = set_object<ID3D11RasterizerState, &render_backend::set_rasterizer_state>;
+using generate_mips_command       = set_object<ID3D11ShaderResourceView, &render_backend::generate_mips>;
+using execute_list_command        = set_object<ID3D11CommandList, &render_backend::execute_command_list>;
+
+struct upload_command
+{
+    ID3D11Resource* resource;
+    u32             subresource;
+    D3D11_MAP       type;
+    const u8*       data;
+    u32             size;
+
+    void execute(render_backend& target) const
+    {
+        D3D11_MAPPED_SUBRESOURCE mapped{};
+        if (SUCCEEDED(target.map(resource, subresource, type, &mapped)))
+        {
+            memcpy(mapped.pData, data, size);
+            target.unmap(resource, subresource);
+        }
+    }
+};
+
+struct update_command
+{
+    ID3D11Resource* resource;
+    u32             subresource;
+    const u8*       data;
+    u32             row_pitch;
+    u32             depth_pitch;
+
+    void execute(render_backend& target) const { target.update_subresource(resource, subresource, data, row_pitch, depth_pitch); }
+};
+
+struct vertex_buffers_command
+{
+    u32           slot;
+    u32           count;
+    ID3D11Buffer* buffers[batch];
+    u32           strides[batch];
+    u32           offsets[batch];
+
+    void execute(render_backend& target) const { target.set_vertex_buffers(slot, count, buffers, strides, offsets); }
+};
+
+struct index_buffer_command
+{
+    ID3D11Buffer* buffer;
+    DXGI_FORMAT   format;
+    u32           offset;
+
+    void execute(render_backend& target) const { target.set_index_buffer(buffer, format, offset); }
+};
+
+struct topology_command
+{
+    D3D11_PRIMITIVE_TOPOLOGY topology;
+
+    void execute(render_backend& target) const { target.set_topology(topology); }
+};
+
+struct constant_buffers_command
+{
+    shader_stage  stage;
+    bool          ranges;
+    u32           slot;
+    u32           count;
+    ID3D11Buffer* buffers[batch];
+    u32           first_constants[batch];
+    u32           constant_counts[batch];
+
+    void execute(render_backend& target) const
+    {
+        if (ranges)
+        {
+            target.set_constant_buffer_ranges(stage, slot, count, buffers, first_constants, constant_counts);
+        } else
+        {
+            target.set_constant_buffers(stage, slot, count, buffers);
+        }
+    }
+};
+
+struct shader_resources_command
+{
+    shader_stage              stage;
+    u32                       slot;
+    u32                       count;
+    ID3D11ShaderResourceView* views[batch];
+
+    void execute(render_backend& target) const { target.set_shader_resources(stage, slot, count, views); }
+};
+
+struct samplers_command
+{
+    shader_stage        stage;
+    u32                 slot;
+    u32                 count;
+    ID3D11SamplerState* samplers[batch];
+
+    void execute(render_backend& target) const { target.set_samplers(stage, slot, count, samplers); }
+};
+
+struct unordered_access_views_command
+{
+    u32                        slot;
+    u32                        count;
+    bool                       has_counts;
+    ID3D11UnorderedAccessView* views[batch];
+    u32                        initial_counts[batch];
+
+    void execute(render_backend& target) const
+    {
+        target.set_unordered_access_views(slot, count, views, has_counts ? initial_counts : nullptr);
+    }
+};
+
+struct stream_output_command
+{
+    u32           count;
+    ID3D11Buffer* buffers[D3D11_SO_BUFFER_SLOT_COUNT];
+    u32           offsets[D3D11_SO_BUFFER_SLOT_COUNT];
+
+    void execute(render_backend& target) const { target.set_stream_output_targets(count, buffers, offsets); }
+};
+
+struct viewports_command
+{
+    u32            count;
+    D3D11_VIEWPORT viewports[D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE];
+
+    void execute(render_backend& target) const { target.set_viewports(count, viewports); }
+};
+
+struct scissor_rects_command
+{
+    u32        count;
+    D3D11_RECT rects[D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE];
+
+    void execute(render_backend& target) const { target.set_scissor_rects(count, rects); }
+};
+
+struct blend_state_command
+{
+    ID3D11BlendState* state;
+    bool              has_factor;
+    f32               factor[4];
+    u32               sample_mask;
+
+    void execute(render_backend& target) const { target.set_blend_state(state, has_factor ? factor : nullptr, sample_mask); }
+};
+
+struct depth_stencil_state_command
+{
+    ID3D11DepthStencilState* state;
+    u32                      stencil_ref;
+
+    void execute(render_backend& target) const { target.set_depth_stencil_state(state, stencil_ref); }
+};
+
+struct render_targets_command
+{
+    u32                     count;
+    ID3D11RenderTargetView* views[D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT];
+    ID3D11DepthStencilView* depth;
+
+    void execute(render_backend& target) const { target.set_render_targets(count, views, depth); }
+};
+
+struct clear_render_target_command
+{
+    ID3D11RenderTargetView* view;
+    f32                     color[4];
+
+    void execute(render_backend& target) const { target.clear_render_target(view, color); }
+};
+
+struct clear_depth_stencil_command
+{
+    ID3D11DepthStencilView* view;
+    u32                     flags;
+    f32                     depth;
+    u8                      stencil;
+
+    void execute(render_backend& target) const { target.clear_depth_stencil(view, flags, depth, stencil); }
+};
+
+struct draw_command
+{
+    u32 vertex_count;
+    u32 first_vertex;
+
+    void execute(render_backend& target) const { target.draw(vertex_count, first_vertex); }
+};
+
+struct draw_indexed_command
+{
+    u32 index_count;
+    u32 first_index;
+    i32 base_vertex;
+
+    void execute(render_backend& target) const { target.draw_indexed(index_count, first_index, base_vertex); }
+};
+
+struct draw_indexed_instanced_command
+{
+    u32 index_count;
+    u32 instance_count;
+    u32 first_index;
+    i32 base_vertex;
+    u32 first_instance;
+
+    void execute(render_backend& target) const
+    {
+        target.draw_indexed_instanced(index_count, instance_count, first_index, base_vertex, first_instance);
+    }
+};
+
+struct dispatch_command
+{
+    u32 groups_x;
+    u32 groups_y;
+    u32 groups_z;
+
+    void execute(render_backend& target) const { target.dispatch(groups_x, groups_y, groups_z); }
+};
+
+// Copies up to count items, nullptr arrays unbind
+template<typename T>
+void copy_slots(T* dst, const T* src, u32 count)
+{
+    if (src)
+    {
+        std::copy_n(src, count, dst);
+    } else
+    {
+        std::fill_n(dst, count, T{});
+    }
+}
+
+} // anonymous namespace
+
+void recorded_command_list::execute(render_backend& target) const
+{
+    for (const command& c : m_commands)
+    {
+        c.execute(target, m_args.data() + c.args);
+    }
+}
+
+command_recorder::command_recorder(render_backend* parent) : m_parent{ parent }, m_list{ new recorded_command_list{} } {}
+
+command_recorder::~command_recorder()
+{
+    m_list->Release();
+}
+
+template<typename Command>
+void command_recorder::record(const Command& command)
+{
+    static_assert(std::is_trivially_copyable_v<Command>);
+
+    const u32 offset = (u32) ((m_list->m_args.size() + alignof(Command) - 1) & ~(alignof(Command) - 1));
+    m_list->m_args.resize(offset + sizeof(Command));
+    memcpy(m_list->m_args.data() + offset, &command, sizeof(Command));
+
+    m_list->m_commands.push_back(
+        { [](render_backend& target, const u8* args) { ((const Command*) args)->execute(target); }, offset });
+}
+
+u8* command_recorder::allocate_upload(u32 size)
+{
+    m_list->m_upload_bytes += size;
+    return m_list->m_uploads.emplace_back(size).data();
+}
+
+HRESULT command_recorder::create_buffer(const D3D11_BUFFER_DESC* desc, const D3D11_SUBRESOURCE_DATA* data, ID3D11Buffer** buffer)
+{
+    return m_parent->create_buffer(desc, data, buffer);
+}
+
+HRESULT command_recorder::create_texture2d(const D3D11_TEXTURE2D_DESC* desc, const D3D11_SUBRESOURCE_DATA* data,
+                                           ID3D11Texture2D** texture)
+{
+    return m_parent->create_texture2d(desc, data, texture);
+}
+
+HRESULT command_recorder::create_shader_resource_view(ID3D11Resource* resource, const D3D11_SHADER_RESOURCE_VIEW_DESC* desc,
+                                                      ID3D11ShaderResourceView** view)
+{
+    return m_parent->create_shader_resource_view(resource, desc, view);
+}
+
+HRESULT command_recorder::create_render_target_view(ID3D11Resource* resource, const D3D11_RENDER_TARGET_VIEW_DESC* desc,
+                                                    ID3D11RenderTargetView** view)
+{
+    return m_parent->create_render_target_view(resource, desc, view);
+}
+
+HRESULT command_recorder::create_depth_stencil_view(ID3D11Resource* resource, const D3D11_DEPTH_STENCIL_VIEW_DESC* desc,
+                                                    ID3D11DepthStencilView** view)
+{
+    return m_parent->create_depth_stencil_view(resource, desc, view);
+}
+
+HRESULT command_recorder::create_input_layout(const D3D11_INPUT_ELEMENT_DESC* elements, u32 count, const void* bytecode,
+                                              size_t size, ID3D11InputLayout** layout)
+{
+    return m_parent->create_input_layout(elements, count, bytecode, size, layout);
+}
+
+HRESULT command_recorder::create_vertex_shader(const void* bytecode, size_t size, ID3D11VertexShader** shader)
+{
+    return m_parent->create_vertex_shader(bytecode, size, shader);
+}
+
+HRESULT command_recorder::create_pixel_shader(const void* bytecode, size_t size, ID3D11PixelShader** shader)
+{
+    return m_parent->create_pixel_shader(bytecode, size, shader);
+}
+
+HRESULT command_recorder::create_hull_shader(const void* bytecode, size_t size, ID3D11HullShader** shader)
+{
+    return m_parent->create_hull_shader(bytecode, size, shader);
+}
+
+HRESULT command_recorder::create_domain_shader(const void* bytecode, size_t size, ID3D11DomainShader** shader)
+{
+    return m_parent->create_domain_shader(bytecode, size, shader);
+}
+
+HRESULT command_recorder::create_geometry_shader(const void* bytecode, size_t size, ID3D11GeometryShader** shader)
+{
+    return m_parent->create_geometry_shader(bytecode, size, shader);
+}
+
+HRESULT command_recorder::create_geometry_shader_with_stream_output(const void* bytecode, size_t size,
+                                                                    const D3D11_SO_DECLARATION_ENTRY* entries, u32 entry_count,
+                                                                    u32 rasterized_stream, ID3D11GeometryShader** shader)
+{
+    return m_parent->create_geometry_shader_with_stream_output(bytecode, size, entries, entry_count, rasterized_stream, shader);
+}
+
+HRESULT command_recorder::create_compute_shader(const void* bytecode, size_t size, ID3D11ComputeShader** shader)
+{
+    return m_parent->create_compute_shader(bytecode, size, shader);
+}
+
+HRESULT command_recorder::create_sampler_state(const D3D11_SAMPLER_DESC* desc, ID3D11SamplerState** state)
+{
+    return m_parent->create_sampler_state(desc, state);
+}
+
+HRESULT command_recorder::create_blend_state(const D3D11_BLEND_DESC* desc, ID3D11BlendState** state)
+{
+    return m_parent->create_blend_state(desc, state);
+}
+
+HRESULT command_recorder::create_depth_stencil_state(const D3D11_DEPTH_STENCIL_DESC* desc, ID3D11DepthStencilState** state)
+{
+    return m_parent->create_depth_stencil_state(desc, state);
+}
+
+HRESULT command_recorder::create_rasterizer_state(const D3D11_RASTERIZER_DESC* desc, ID3D11RasterizerState** state)
+{
+    return m_parent->create_rasterizer_state(desc, state);
+}
+
+HRESULT command_recorder::map(ID3D11Resource* resource, u32 subresource, D3D11_MAP type, D3D11_MAPPED_SUBRESOURCE* mapped)
+{
+    D3D11_RESOURCE_DIMENSION dimension{};
+    resource->GetType(&dimension);
+    if (dimension != D3D11_RESOURCE_DIMENSION_BUFFER || subresource != 0)
+    {
+        return E_INVALIDARG;
+    }
+
+    open_map m{ resource, subresource, type };
+    if (type == D3D11_MAP_WRITE_DISCARD)
+    {
+        D3D11_BUFFER_DESC desc{};
+        static_cast<ID3D11Buffer*>(resource)->GetDesc(&desc);
+        m.size = desc.ByteWidth;
+        m.data = allocate_upload(m.size);
+
+        const auto it = std::find_if(m_discarded.begin(), m_discarded.end(),
+                                     [resource](const open_map& d) { return d.resource == resource; });
+        if (it != m_discarded.end())
+        {
+            *it = m;
+        } else
+        {
+            m_discarded.push_back(m);
+        }
+    } else if (type == D3D11_MAP_WRITE_NO_OVERWRITE)
+    {
+        // What the list wrote since its discard is still there, the whole block is copied again when executed
+        const auto it = std::find_if(m_discarded.begin(), m_discarded.end(),
+                                     [resource](const open_map& d) { return d.resource == resource; });
+        if (it == m_discarded.end())
+        {
+            LOG_ERROR("No-overwrite map of a buffer the command list hasn't discarded");
+            return E_INVALIDARG;
+        }
+        m.data = it->data;
+        m.size = it->size;
+    } else
+    {
+        LOG_ERROR("Only write-discard and write-no-overwrite maps can be recorded");
+        return E_INVALIDARG;
+    }
+
+    m_open.push_back(m);
+    mapped->pData      = m.data;
+    mapped->RowPitch   = m.size;
+    mapped->DepthPitch = m.size;
+    return S_OK;
+}
+
+void command_recorder::unmap(ID3D11Resource* resource, u32 subresource)
+{
+    const auto it = std::find_if(m_open.begin(), m_open.end(), [resource, subresource](const open_map& m) {
+        return m.resource == resource && m.subresource == subresource;
+    });
+    if (it == m_open.end())
+    {
+        return;
+    }
+
+    record(upload_command{ it->resource, it->subresource, it->type, it->data, it->size });
+    m_open.erase(it);
+}
+
+void command_recorder::update_subresource(ID3D11Resource* resource, u32 subresource, const void* data, u32 row_pitch,
+                                          u32 depth_pitch)
+{
+    D3D11_RESOURCE_DIMENSION dimension{};
+    resource->GetType(&dimension);
+
+    u32 size{};
+    if (dimension == D3D11_RESOURCE_DIMENSION_BUFFER)
+    {
+        D3D11_BUFFER_DESC desc{};
+        static_cast<ID3D11Buffer*>(resource)->GetDesc(&desc);
+        size = desc.ByteWidth;
+    } else if (dimension == D3D11_RESOURCE_DIMENSION_TEXTURE2D)
+    {
+        D3D11_TEXTURE2D_DESC desc{};
+        static_cast<ID3D11Texture2D*>(resource)->GetDesc(&desc);
+        const u32 mip = desc.MipLevels ? subresource % desc.MipLevels : subresource;
+        size          = row_pitch * std::max(desc.Height >> mip, 1u);
+    } else
+    {
+        LOG_ERROR("Only buffer and 2D texture updates can be recorded");
+        return;
+    }
+
+    u8* copy = allocate_upload(size);
+    memcpy(copy, data, size);
+    record(update_command{ resource, subresource, copy, row_pitch, depth_pitch });
+}
+
+void command_recorder::generate_mips(ID3D11ShaderResourceView* view)
+{
+    record(generate_mips_command{ view });
+}
+
+void command_recorder::set_input_layout(ID3D11InputLayout* layout)
+{
+    record(set_input_layout_command{ layout });
+}
+
+void command_recorder::set_vertex_buffers(u32 slot, u32 count, ID3D11Buffer* const* buffers, const u32* strides,
+                                          const u32* offsets)
+{
+    for (u32 done = 0; done < count; done += batch)
+    {
+        vertex_buffers_command c{ slot + done, std::min(batch, count - done) };
+        copy_slots(c.buffers, buffers ? buffers + done : nullptr, c.count);
+        copy_slots(c.strides, strides ? strides + done : nullptr, c.count);
+        copy_slots(c.offsets, offsets ? offsets + done : nullptr, c.count);
+        record(c);
+    }
+}
+
+void command_recorder::set_index_buffer(ID3D11Buffer* buffer, DXGI_FORMAT format, u32 offset)
+{
+    record(index_buffer_command{ buffer, format, offset });
+}
+
+void command_recorder::set_topology(D3D11_PRIMITIVE_TOPOLOGY topology)
+{
+    record(topology_command{ topology });
+}
+
+void command_recorder::set_vertex_shader(ID3D11VertexShader* shader)
+{
+    record(set_vertex_shader_command{ shader });
+}
+
+void command_recorder::set_pixel_shader(ID3D11PixelShader* shader)
+{
+    record(set_pixel_shader_command{ shader });
+}
+
+void command_recorder::set_hull_shader(ID3D11HullShader* shader)
+{
+    record(set_hull_shader_command{ shader });
+}
+
+void command_recorder::set_domain_shader(ID3D11DomainShader* shader)
+{
+    record(set_domain_shader_command{ shader });
+}
+
+void command_recorder::set_geometry_shader(ID3D11GeometryShader* shader)
+{
+    record(set_geometry_shader_command{ shader });
+}
+
+void command_recorder::set_compute_shader(ID3D11ComputeShader* shader)
+{
+    record(set_compute_shader_command{ shader });
+}
+
+void command_recorder::set_constant_buffers(shader_stage stage, u32 slot, u32 count, ID3D11Buffer* const* buffers)
+{
+    for (u32 done = 0; done < count; done += batch)
+    {
+        constant_buffers_command c{ stage, false, slot + done, std::min(batch, count - done) };
+        copy_slots(c.buffers, buffers ? buffers + done : nullptr, c.count);
+        record(c);
+    }
+}
+
+void command_recorder::set_constant_buffer_ranges(shader_stage stage, u32 slot, u32 count, ID3D11Buffer* const* buffers,
+                                                  const u32* first_constants, const u32* constant_counts)
+{
+    for (u32 done = 0; done < count; done += batch)
+    {
+        constant_buffers_command c{ stage, true, slot + done, std::min(batch, count - done) };
+        copy_slots(c.buffers, buffers ? buffers + done : nullptr, c.count);
+        copy_slots(c.first_constants, first_constants ? first_constants + done : nullptr, c.count);
+        copy_slots(c.constant_counts, constant_counts ? constant_counts + done : nullptr, c.count);
+        record(c);
+    }
+}
+
+void command_recorder::set_shader_resources(shader_stage stage, u32 slot, u32 count, ID3D11ShaderResourceView* const* views)
+{
+    for (u32 done = 0; done < count; done += batch)
+    {
+        shader_resources_command c{ stage, slot + done, std::min(batch, count - done) };
+        copy_slots(c.views, views ? views + done : nullptr, c.count);
+        record(c);
+    }
+}
+
+void command_recorder::set_samplers(shader_stage stage, u32 slot, u32 count, ID3D11SamplerState* const* samplers)
+{
+    for (u32 done = 0; done < count; done += batch)
+    {
+        samplers_command c{ stage, slot + done, std::min(batch, count - done) };
+        copy_slots(c.samplers, samplers ? samplers + done : nullptr, c.count);
+        record(c);
+    }
+}
+
+void command_recorder::set_unordered_access_views(u32 slot, u32 count, ID3D11UnorderedAccessView* const* views,
+                                                  const u32* initial_counts)
+{
+    for (u32 done = 0; done < count; done += batch)
+    {
+        unordered_access_views_command c{ slot + done, std::min(batch, count - done), initial_counts != nullptr };
+        copy_slots(c.views, views ? views + done : nullptr, c.count);
+        copy_slots(c.initial_counts, initial_counts ? initial_counts + done : nullptr, c.count);
+        record(c);
+    }
+}
+
+void command_recorder::set_stream_output_targets(u32 count, ID3D11Buffer* const* buffers, const u32* offsets)
+{
+    stream_output_command c{ std::min(count, (u32) D3D11_SO_BUFFER_SLOT_COUNT) };
+    copy_slots(c.buffers, buffers, c.count);
+    copy_slots(c.offsets, offsets, c.count);
+    record(c);
+}
+
+void command_recorder::set_rasterizer_state(ID3D11RasterizerState* state)
+{
+    record(set_rasterizer_command{ state });
+}
+
+void command_recorder::set_viewports(u32 count, const D3D11_VIEWPORT* viewports)
+{
+    viewports_command c{ std::min(count, (u32) D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE) };
+    copy_slots(c.viewports, viewports, c.count);
+    record(c);
+}
+
+void command_recorder::set_scissor_rects(u32 count, const D3D11_RECT* rects)
+{
+    scissor_rects_command c{ std::min(count, (u32) D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE) };
+    copy_slots(c.rects, rects, c.count);
+    record(c);
+}
+
+void command_recorder::set_blend_state(ID3D11BlendState* state, const f32 factor[4], u32 sample_mask)
+{
+    blend_state_command c{ state, factor != nullptr };
+    copy_slots(c.factor, factor, 4);
+    c.sample_mask = sample_mask;
+    record(c);
+}
+
+void command_recorder::set_depth_stencil_state(ID3D11DepthStencilState* state, u32 stencil_ref)
+{
+    record(depth_stencil_state_command{ state, stencil_ref });
+}
+
+void command_recorder::set_render_targets(u32 count, ID3D11RenderTargetView* const* views, ID3D11DepthStencilView* depth)
+{
+    render_targets_command c{ std::min(count, (u32) D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT) };
+    copy_slots(c.views, views, c.count);
+    c.depth = depth;
+    record(c);
+}
+
+void command_recorder::clear_render_target(ID3D11RenderTargetView* view, const f32 color[4])
+{
+    clear_render_target_command c{ view };
+    copy_slots(c.color, color, 4);
+    record(c);
+}
+
+void command_recorder::clear_depth_stencil(ID3D11DepthStencilView* view, u32 flags, f32 depth, u8 stencil)
+{
+    record(clear_depth_stencil_command{ view, flags, depth, stencil });
+}
+
+void command_recorder::draw(u32 vertex_count, u32 first_vertex)
+{
+    record(draw_command{ vertex_count, first_vertex });
+}
+
+void command_recorder::draw_indexed(u32 index_count, u32 first_index, i32 base_vertex)
+{
+    record(draw_indexed_command{ index_count, first_index, base_vertex });
+}
+
+void command_recorder::draw_indexed_instanced(u32 index_count, u32 instance_count, u32 first_index, i32 base_vertex,
+                                              u32 first_instance)
+{
+    record(draw_indexed_instanced_command{ index_count, instance_count, first_index, base_vertex, first_instance });
+}
+
+void command_recorder::dispatch(u32 groups_x, u32 groups_y, u32 groups_z)
+{
+    record(dispatch_command{ groups_x, groups_y, groups_z });
+}
+
+HRESULT command_recorder::back_buffer(ID3D11Texture2D**)
+{
+    return DXGI_ERROR_INVALID_CALL;
+}
+
+void command_recorder::present(bool) {}
+
+void command_recorder::set_fullscreen(bool) {}
+
+HRESULT command_recorder::finish_command_list(ID3D11CommandList** list)
+{
+    if (!m_open.empty())
+    {
+        LOG_WARN("Finishing a command list with {} buffers still mapped, their writes are dropped", m_open.size());
+        m_open.clear();
+    }
+
+    *list  = m_list;
+    m_list = new recorded_command_list{};
+    m_discarded.clear();
+    return S_OK;
+}
+
+void command_recorder::execute_command_list(ID3D11CommandList* list)
+{
+    record(execute_list_command{ list });
+}
+
+} // namespace yae::gfx
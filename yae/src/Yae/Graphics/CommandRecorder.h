@@ -0,0 +1,185 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: CommandRecorder.h
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+
+#pragma once
+
+#include "Backend.h"
+#include "NullObjects.h"
+
+namespace yae::gfx
+{
+
+/**
+ * \brief Calls recorded by a command_recorder. Each call is a small struct copied into one byte stream, executing the
+ * list makes the same calls on the target backend in order. Objects are referenced without being AddRef'd, anything
+ * a list uses has to outlive its execution
+ */
+class recorded_command_list final : public null_child<ID3D11CommandList>
+{
+public:
+    UINT STDMETHODCALLTYPE GetContextFlags() override { return 0; }
+
+    void execute(render_backend& target) const;
+
+    u32 command_count() const { return (u32) m_commands.size(); }
+    u64 recorded_bytes() const { return m_args.size() + m_upload_bytes; }
+
+private:
+    friend class command_recorder;
+
+    using execute_func = void (*)(render_backend& target, const u8* args);
+
+    struct command
+    {
+        execute_func execute{};
+        u32          args{}; // Offset into m_args
+    };
+
+    std::vector<command>         m_commands{};
+    std::vector<u8>              m_args{};
+    std::vector<std::vector<u8>> m_uploads{}; // Mapped and updated data, each block keeps its address
+    u64                          m_upload_bytes{};
+};
+
+/**
+ * \brief Recorder of the backends without deferred contexts. Binds, clears and draws are stored in a
+ * recorded_command_list, resources and states are created on the backend that made the recorder.\n\n
+ * Maps of buffers hand out memory owned by the list, which is copied into the buffer when the list executes. As on a
+ * deferred context only <code>D3D11_MAP_WRITE_DISCARD</code> is allowed, or <code>D3D11_MAP_WRITE_NO_OVERWRITE</code>
+ * after a discard of the same buffer in the same list
+ */
+class command_recorder final : public render_backend
+{
+public:
+    explicit command_recorder(render_backend* parent);
+    ~command_recorder() override;
+    DISABLE_COPY_AND_MOVE(command_recorder);
+
+    backend_type type() const override { return m_parent->type(); }
+
+    HRESULT create_buffer(const D3D11_BUFFER_DESC* desc, const D3D11_SUBRESOURCE_DATA* data, ID3D11Buffer** buffer) override;
+    HRESULT create_texture2d(const D3D11_TEXTURE2D_DESC* desc, const D3D11_SUBRESOURCE_DATA* data,
+                             ID3D11Texture2D** texture) override;
+    HRESULT create_shader_resource_view(ID3D11Resource* resource, const D3D11_SHADER_RESOURCE_VIEW_DESC* desc,
+                                        ID3D11ShaderResourceView** view) override;
+    HRESULT create_render_target_view(ID3D11Resource* resource, const D3D11_RENDER_TARGET_VIEW_DESC* desc,
+                                      ID3D11RenderTargetView** view) override;
+    HRESULT create_depth_stencil_view(ID3D11Resource* resource, const D3D11_DEPTH_STENCIL_VIEW_DESC* desc,
+                                      ID3D11DepthStencilView** view) override;
+
+    HRESULT create_input_layout(const D3D11_INPUT_ELEMENT_DESC* elements, u32 count, const void* bytecode, size_t size,
+                                ID3D11InputLayout** layout) override;
+    HRESULT create_vertex_shader(const void* bytecode, size_t size, ID3D11VertexShader** shader) override;
+    HRESULT create_pixel_shader(const void* bytecode, size_t size, ID3D11PixelShader** shader) override;
+    HRESULT create_hull_shader(const void* bytecode, size_t size, ID3D11HullShader** shader) override;
+    HRESULT create_domain_shader(const void* bytecode, size_t size, ID3D11DomainShader** shader) override;
+    HRESULT create_geometry_shader(const void* bytecode, size_t size, ID3D11GeometryShader** shader) override;
+    HRESULT create_geometry_shader_with_stream_output(const void* bytecode, size_t size,
+                                                      const D3D11_SO_DECLARATION_ENTRY* entries, u32 entry_count,
+                                                      u32 rasterized_stream, ID3D11GeometryShader** shader) override;
+    HRESULT create_compute_shader(const void* bytecode, size_t size, ID3D11ComputeShader** shader) override;
+
+    HRESULT create_sampler_state(const D3D11_SAMPLER_DESC* desc, ID3D11SamplerState** state) override;
+    HRESULT create_blend_state(const D3D11_BLEND_DESC* desc, ID3D11BlendState** state) override;
+    HRESULT create_depth_stencil_state(const D3D11_DEPTH_STENCIL_DESC* desc, ID3D11DepthStencilState** state) override;
+    HRESULT create_rasterizer_state(const D3D11_RASTERIZER_DESC* desc, ID3D11RasterizerState** state) override;
+
+    bool supports_constant_offsets() const override { return m_parent->supports_constant_offsets(); }
+
+    HRESULT map(ID3D11Resource* resource, u32 subresource, D3D11_MAP type, D3D11_MAPPED_SUBRESOURCE* mapped) override;
+    void    unmap(ID3D11Resource* resource, u32 subresource) override;
+    void    update_subresource(ID3D11Resource* resource, u32 subresource, const void* data, u32 row_pitch,
+                               u32 depth_pitch) override;
+    void    generate_mips(ID3D11ShaderResourceView* view) override;
+
+    void set_input_layout(ID3D11InputLayout* layout) override;
+    void set_vertex_buffers(u32 slot, u32 count, ID3D11Buffer* const* buffers, const u32* strides, const u32* offsets) override;
+    void set_index_buffer(ID3D11Buffer* buffer, DXGI_FORMAT format, u32 offset) override;
+    void set_topology(D3D11_PRIMITIVE_TOPOLOGY topology) override;
+
+    void set_vertex_shader(ID3D11VertexShader* shader) override;
+    void set_pixel_shader(ID3D11PixelShader* shader) override;
+    void set_hull_shader(ID3D11HullShader* shader) override;
+    void set_domain_shader(ID3D11DomainShader* shader) override;
+    void set_geometry_shader(ID3D11GeometryShader* shader) override;
+    void set_compute_shader(ID3D11ComputeShader* shader) override;
+
+    void set_constant_buffers(shader_stage stage, u32 slot, u32 count, ID3D11Buffer* const* buffers) override;
+    void set_constant_buffer_ranges(shader_stage stage, u32 slot, u32 count, ID3D11Buffer* const* buffers,
+                                    const u32* first_constants, const u32* constant_counts) override;
+    void set_shader_resources(shader_stage stage, u32 slot, u32 count, ID3D11ShaderResourceView* const* views) override;
+    void set_samplers(shader_stage stage, u32 slot, u32 count, ID3D11SamplerState* const* samplers) override;
+
+    void set_unordered_access_views(u32 slot, u32 count, ID3D11UnorderedAccessView* const* views,
+                                    const u32* initial_counts) override;
+    void set_stream_output_targets(u32 count, ID3D11Buffer* const* buffers, const u32* offsets) override;
+
+    void set_rasterizer_state(ID3D11RasterizerState* state) override;
+    void set_viewports(u32 count, const D3D11_VIEWPORT* viewports) override;
+    void set_scissor_rects(u32 count, const D3D11_RECT* rects) override;
+    void set_blend_state(ID3D11BlendState* state, const f32 factor[4], u32 sample_mask) override;
+    void set_depth_stencil_state(ID3D11DepthStencilState* state, u32 stencil_ref) override;
+    void set_render_targets(u32 count, ID3D11RenderTargetView* const* views, ID3D11DepthStencilView* depth) override;
+
+    void clear_render_target(ID3D11RenderTargetView* view, const f32 color[4]) override;
+    void clear_depth_stencil(ID3D11DepthStencilView* view, u32 flags, f32 depth, u8 stencil) override;
+
+    void draw(u32 vertex_count, u32 first_vertex) override;
+    void draw_indexed(u32 index_count, u32 first_index, i32 base_vertex) override;
+    void draw_indexed_instanced(u32 index_count, u32 instance_count, u32 first_index, i32 base_vertex,
+                                u32 first_instance) override;
+    void dispatch(u32 groups_x, u32 groups_y, u32 groups_z) override;
+
+    // A recorder has no swap chain, these fail or do nothing
+    HRESULT back_buffer(ID3D11Texture2D** texture) override;
+    void    present(bool vsync) override;
+    void    set_fullscreen(bool fullscreen) override;
+
+    render_backend* create_recorder() override { return nullptr; }
+    HRESULT         finish_command_list(ID3D11CommandList** list) override;
+    // Nests a finished list, it is executed as part of this one
+    void execute_command_list(ID3D11CommandList* list) override;
+
+private:
+    template<typename Command>
+    void record(const Command& command);
+
+    // Memory owned by the list being recorded, kept until the list is released
+    u8* allocate_upload(u32 size);
+
+    struct open_map
+    {
+        ID3D11Resource* resource{};
+        u32             subresource{};
+        D3D11_MAP       type{};
+        u8*             data{};
+        u32             size{};
+    };
+
+    render_backend*        m_parent{};
+    recorded_command_list* m_list{}; // Being recorded, replaced by a new one on every finish
+    std::vector<open_map>  m_open{};
+    std::vector<open_map>  m_discarded{}; // Last discard of every buffer in this list, no-overwrite maps reuse it
+};
+
+} // namespace yae::gfx
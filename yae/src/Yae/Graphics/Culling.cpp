@@ -0,0 +1,255 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: Culling.cpp
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+#include "Culling.h"
+
+#include <immintrin.h>
+
+namespace yae::gfx::culling
+{
+namespace
+{
+
+// Box storage in SoA form. The slot map keeps its dense order in step with the arrays, both swap the last box in
+// when one is removed
+struct bounds_soa
+{
+    slot_map<u8, cull_tag> slots{};
+
+    std::vector<f32> center_x{};
+    std::vector<f32> center_y{};
+    std::vector<f32> center_z{};
+    std::vector<f32> extent_x{};
+    std::vector<f32> extent_y{};
+    std::vector<f32> extent_z{};
+
+    std::vector<u8>  visible_flags{};
+    std::vector<u32> visible_list{};
+
+    void set(u32 index, const math::aabb& box)
+    {
+        const math::vec3 c = box.center();
+        const math::vec3 e = box.extents();
+        center_x[index]    = c.x;
+        center_y[index]    = c.y;
+        center_z[index]    = c.z;
+        extent_x[index]    = e.x;
+        extent_y[index]    = e.y;
+        extent_z[index]    = e.z;
+    }
+
+    void resize(u32 size)
+    {
+        center_x.resize(size);
+        center_y.resize(size);
+        center_z.resize(size);
+        extent_x.resize(size);
+        extent_y.resize(size);
+        extent_z.resize(size);
+        visible_flags.resize(size, 1);
+    }
+};
+
+bounds_soa bounds;
+
+bool test_box(const math::frustum& frustum, u32 i)
+{
+    for (const auto& p : frustum.planes)
+    {
+        const f32 distance = p.x * bounds.center_x[i] + p.y * bounds.center_y[i] + p.z * bounds.center_z[i] + p.w;
+        const f32 radius =
+            math::abs(p.x) * bounds.extent_x[i] + math::abs(p.y) * bounds.extent_y[i] + math::abs(p.z) * bounds.extent_z[i];
+        if (distance < -radius)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void write_result(u32 i, bool visible)
+{
+    bounds.visible_flags[i] = visible;
+    if (visible)
+    {
+        bounds.visible_list.push_back(i);
+    }
+}
+
+} // anonymous namespace
+
+cull_handle add(const math::aabb& world_bounds)
+{
+    const cull_handle h = bounds.slots.emplace();
+    bounds.resize(bounds.slots.size());
+    bounds.set(bounds.slots.dense_index(h), world_bounds);
+    bounds.visible_flags[bounds.slots.dense_index(h)] = 1;
+    return h;
+}
+
+void remove(cull_handle h)
+{
+    const u32 index = bounds.slots.dense_index(h);
+    if (index == invalid_u32)
+    {
+        return;
+    }
+
+    const u32 last = bounds.slots.size() - 1;
+    if (index != last)
+    {
+        bounds.center_x[index]      = bounds.center_x[last];
+        bounds.center_y[index]      = bounds.center_y[last];
+        bounds.center_z[index]      = bounds.center_z[last];
+        bounds.extent_x[index]      = bounds.extent_x[last];
+        bounds.extent_y[index]      = bounds.extent_y[last];
+        bounds.extent_z[index]      = bounds.extent_z[last];
+        bounds.visible_flags[index] = bounds.visible_flags[last];
+    }
+
+    bounds.slots.remove(h);
+    bounds.resize(bounds.slots.size());
+
+    // The dense indices in the list no longer line up, it is rebuilt on the next cull
+    bounds.visible_list.clear();
+}
+
+void update(cull_handle h, const math::aabb& world_bounds)
+{
+    if (const u32 index = bounds.slots.dense_index(h); index != invalid_u32)
+    {
+        bounds.set(index, world_bounds);
+    }
+}
+
+void cull_scalar(const math::frustum& frustum)
+{
+    bounds.visible_list.clear();
+    const u32 size = bounds.slots.size();
+    for (u32 i = 0; i < size; ++i)
+    {
+        write_result(i, test_box(frustum, i));
+    }
+}
+
+void cull(const math::frustum& frustum)
+{
+    bounds.visible_list.clear();
+    const u32 size = bounds.slots.size();
+    u32       i    = 0;
+
+    // Same math and operation order as test_box, so the batched result matches the scalar one bit for bit:
+    // a box is outside a plane when n.c + d < -(|n|.e)
+    math::vec4 abs_planes[6]{};
+    for (u32 p = 0; p < 6; ++p)
+    {
+        const math::vec4& plane = frustum.planes[p];
+        abs_planes[p]           = { math::abs(plane.x), math::abs(plane.y), math::abs(plane.z), plane.w };
+    }
+
+#if defined(__AVX2__)
+    for (; i + 8 <= size; i += 8)
+    {
+        const __m256 cx = _mm256_loadu_ps(&bounds.center_x[i]);
+        const __m256 cy = _mm256_loadu_ps(&bounds.center_y[i]);
+        const __m256 cz = _mm256_loadu_ps(&bounds.center_z[i]);
+        const __m256 ex = _mm256_loadu_ps(&bounds.extent_x[i]);
+        const __m256 ey = _mm256_loadu_ps(&bounds.extent_y[i]);
+        const __m256 ez = _mm256_loadu_ps(&bounds.extent_z[i]);
+
+        __m256 outside = _mm256_setzero_ps();
+        for (u32 p = 0; p < 6; ++p)
+        {
+            const math::vec4& n = frustum.planes[p];
+            const math::vec4& a = abs_planes[p];
+
+            __m256 distance = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(n.x), cx), _mm256_mul_ps(_mm256_set1_ps(n.y), cy));
+            distance        = _mm256_add_ps(_mm256_add_ps(distance, _mm256_mul_ps(_mm256_set1_ps(n.z), cz)), _mm256_set1_ps(n.w));
+
+            __m256 radius = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(a.x), ex), _mm256_mul_ps(_mm256_set1_ps(a.y), ey));
+            radius        = _mm256_add_ps(radius, _mm256_mul_ps(_mm256_set1_ps(a.z), ez));
+
+            outside = _mm256_or_ps(outside, _mm256_cmp_ps(distance, _mm256_sub_ps(_mm256_setzero_ps(), radius), _CMP_LT_OQ));
+        }
+
+        const u32 mask = ~(u32) _mm256_movemask_ps(outside) & 0xff;
+        for (u32 lane = 0; lane < 8; ++lane)
+        {
+            write_result(i + lane, mask & BIT(lane));
+        }
+    }
+#endif
+
+    for (; i + 4 <= size; i += 4)
+    {
+        const __m128 cx = _mm_loadu_ps(&bounds.center_x[i]);
+        const __m128 cy = _mm_loadu_ps(&bounds.center_y[i]);
+        const __m128 cz = _mm_loadu_ps(&bounds.center_z[i]);
+        const __m128 ex = _mm_loadu_ps(&bounds.extent_x[i]);
+        const __m128 ey = _mm_loadu_ps(&bounds.extent_y[i]);
+        const __m128 ez = _mm_loadu_ps(&bounds.extent_z[i]);
+
+        __m128 outside = _mm_setzero_ps();
+        for (u32 p = 0; p < 6; ++p)
+        {
+            const math::vec4& n = frustum.planes[p];
+            const math::vec4& a = abs_planes[p];
+
+            __m128 distance = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(n.x), cx), _mm_mul_ps(_mm_set1_ps(n.y), cy));
+            distance        = _mm_add_ps(_mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(n.z), cz)), _mm_set1_ps(n.w));
+
+            __m128 radius = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(a.x), ex), _mm_mul_ps(_mm_set1_ps(a.y), ey));
+            radius        = _mm_add_ps(radius, _mm_mul_ps(_mm_set1_ps(a.z), ez));
+
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, _mm_sub_ps(_mm_setzero_ps(), radius)));
+        }
+
+        const u32 mask = ~(u32) _mm_movemask_ps(outside) & 0xf;
+        for (u32 lane = 0; lane < 4; ++lane)
+        {
+            write_result(i + lane, mask & BIT(lane));
+        }
+    }
+
+    for (; i < size; ++i)
+    {
+        write_result(i, test_box(frustum, i));
+    }
+}
+
+bool is_visible(cull_handle h)
+{
+    const u32 index = bounds.slots.dense_index(h);
+    return index != invalid_u32 && bounds.visible_flags[index];
+}
+
+const std::vector<u32>& visible()
+{
+    return bounds.visible_list;
+}
+
+u32 count()
+{
+    return bounds.slots.size();
+}
+
+} // namespace yae::gfx::culling
@@ -0,0 +1,66 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: Culling.h
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+
+#pragma once
+
+#include "Yae/Common.h"
+#include "Yae/Util/Bounds.h"
+#include "Yae/Util/Handle.h"
+
+namespace yae::gfx::culling
+{
+
+struct cull_tag;
+using cull_handle = handle<cull_tag>;
+
+/**
+ * \brief Registers a world space box to be frustum tested every frame. Boxes are stored as separate center and extent
+ * arrays so the culler can test several at once
+ * \param world_bounds Initial world space bounds
+ * \return Handle used to update, remove and query the box
+ */
+cull_handle add(const math::aabb& world_bounds);
+void        remove(cull_handle h);
+void        update(cull_handle h, const math::aabb& world_bounds);
+
+/**
+ * \brief Tests every registered box against the frustum, 8 at a time with AVX2, 4 with SSE. Fills the visible flags
+ * and the compact visible list
+ * \param frustum The view frustum
+ */
+void cull(const math::frustum& frustum);
+
+/**
+ * \brief One box at a time, kept as the reference the batched version must match
+ */
+void cull_scalar(const math::frustum& frustum);
+
+// Result of the last cull. Boxes added since then count as visible
+bool is_visible(cull_handle h);
+
+// Dense indices of the boxes that passed the last cull, in ascending order
+const std::vector<u32>& visible();
+
+u32 count();
+
+} // namespace yae::gfx::culling
@@ -0,0 +1,406 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: D3D11Backend.cpp
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+#include "D3D11Backend.h"
+
+#include "D3D11Core.h"
+
+#include <d3d11_1.h>
+
+namespace yae::gfx
+{
+
+d3d11_backend::d3d11_backend(ID3D11Device* device, ID3D11DeviceContext* context, IDXGISwapChain* swapchain) :
+    m_device{ device }, m_context{ context }, m_swapchain{ swapchain }
+{
+    D3D11_FEATURE_DATA_D3D11_OPTIONS options{};
+    if (FAILED(m_device->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof(options))) ||
+        !options.ConstantBufferOffsetting || !options.MapNoOverwriteOnDynamicConstantBuffer)
+    {
+        return;
+    }
+
+    if (FAILED(m_context->QueryInterface(__uuidof(ID3D11DeviceContext1), (void**) &m_context1)))
+    {
+        m_context1 = nullptr;
+    }
+}
+
+d3d11_backend::~d3d11_backend()
+{
+    core::release(m_context1);
+    core::release(m_context);
+    core::release(m_device);
+    core::release(m_swapchain);
+}
+
+HRESULT d3d11_backend::create_buffer(const D3D11_BUFFER_DESC* desc, const D3D11_SUBRESOURCE_DATA* data, ID3D11Buffer** buffer)
+{
+    return m_device->CreateBuffer(desc, data, buffer);
+}
+
+HRESULT d3d11_backend::create_texture2d(const D3D11_TEXTURE2D_DESC* desc, const D3D11_SUBRESOURCE_DATA* data,
+                                        ID3D11Texture2D** texture)
+{
+    return m_device->CreateTexture2D(desc, data, texture);
+}
+
+HRESULT d3d11_backend::create_shader_resource_view(ID3D11Resource* resource, const D3D11_SHADER_RESOURCE_VIEW_DESC* desc,
+                                                   ID3D11ShaderResourceView** view)
+{
+    return m_device->CreateShaderResourceView(resource, desc, view);
+}
+
+HRESULT d3d11_backend::create_render_target_view(ID3D11Resource* resource, const D3D11_RENDER_TARGET_VIEW_DESC* desc,
+                                                 ID3D11RenderTargetView** view)
+{
+    return m_device->CreateRenderTargetView(resource, desc, view);
+}
+
+HRESULT d3d11_backend::create_depth_stencil_view(ID3D11Resource* resource, const D3D11_DEPTH_STENCIL_VIEW_DESC* desc,
+                                                 ID3D11DepthStencilView** view)
+{
+    return m_device->CreateDepthStencilView(resource, desc, view);
+}
+
+HRESULT d3d11_backend::create_input_layout(const D3D11_INPUT_ELEMENT_DESC* elements, u32 count, const void* bytecode, size_t size,
+                                           ID3D11InputLayout** layout)
+{
+    return m_device->CreateInputLayout(elements, count, bytecode, size, layout);
+}
+
+HRESULT d3d11_backend::create_vertex_shader(const void* bytecode, size_t size, ID3D11VertexShader** shader)
+{
+    return m_device->CreateVertexShader(bytecode, size, nullptr, shader);
+}
+
+HRESULT d3d11_backend::create_pixel_shader(const void* bytecode, size_t size, ID3D11PixelShader** shader)
+{
+    return m_device->CreatePixelShader(bytecode, size, nullptr, shader);
+}
+
+HRESULT d3d11_backend::create_hull_shader(const void* bytecode, size_t size, ID3D11HullShader** shader)
+{
+    return m_device->CreateHullShader(bytecode, size, nullptr, shader);
+}
+
+HRESULT d3d11_backend::create_domain_shader(const void* bytecode, size_t size, ID3D11DomainShader** shader)
+{
+    return m_device->CreateDomainShader(bytecode, size, nullptr, shader);
+}
+
+HRESULT d3d11_backend::create_geometry_shader(const void* bytecode, size_t size, ID3D11GeometryShader** shader)
+{
+    return m_device->CreateGeometryShader(bytecode, size, nullptr, shader);
+}
+
+HRESULT d3d11_backend::create_geometry_shader_with_stream_output(const void* bytecode, size_t size,
+                                                                 const D3D11_SO_DECLARATION_ENTRY* entries, u32 entry_count,
+                                                                 u32 rasterized_stream, ID3D11GeometryShader** shader)
+{
+    return m_device->CreateGeometryShaderWithStreamOutput(bytecode, size, entries, entry_count, nullptr, 0, rasterized_stream,
+                                                          nullptr, shader);
+}
+
+HRESULT d3d11_backend::create_compute_shader(const void* bytecode, size_t size, ID3D11ComputeShader** shader)
+{
+    return m_device->CreateComputeShader(bytecode, size, nullptr, shader);
+}
+
+HRESULT d3d11_backend::create_sampler_state(const D3D11_SAMPLER_DESC* desc, ID3D11SamplerState** state)
+{
+    return m_device->CreateSamplerState(desc, state);
+}
+
+HRESULT d3d11_backend::create_blend_state(const D3D11_BLEND_DESC* desc, ID3D11BlendState** state)
+{
+    return m_device->CreateBlendState(desc, state);
+}
+
+HRESULT d3d11_backend::create_depth_stencil_state(const D3D11_DEPTH_STENCIL_DESC* desc, ID3D11DepthStencilState** state)
+{
+    return m_device->CreateDepthStencilState(desc, state);
+}
+
+HRESULT d3d11_backend::create_rasterizer_state(const D3D11_RASTERIZER_DESC* desc, ID3D11RasterizerState** state)
+{
+    return m_device->CreateRasterizerState(desc, state);
+}
+
+HRESULT d3d11_backend::map(ID3D11Resource* resource, u32 subresource, D3D11_MAP type, D3D11_MAPPED_SUBRESOURCE* mapped)
+{
+    return m_context->Map(resource, subresource, type, 0, mapped);
+}
+
+void d3d11_backend::unmap(ID3D11Resource* resource, u32 subresource)
+{
+    m_context->Unmap(resource, subresource);
+}
+
+void d3d11_backend::update_subresource(ID3D11Resource* resource, u32 subresource, const void* data, u32 row_pitch,
+                                       u32 depth_pitch)
+{
+    m_context->UpdateSubresource(resource, subresource, nullptr, data, row_pitch, depth_pitch);
+}
+
+void d3d11_backend::generate_mips(ID3D11ShaderResourceView* view)
+{
+    m_context->GenerateMips(view);
+}
+
+void d3d11_backend::set_input_layout(ID3D11InputLayout* layout)
+{
+    m_context->IASetInputLayout(layout);
+}
+
+void d3d11_backend::set_vertex_buffers(u32 slot, u32 count, ID3D11Buffer* const* buffers, const u32* strides, const u32* offsets)
+{
+    m_context->IASetVertexBuffers(slot, count, buffers, strides, offsets);
+}
+
+void d3d11_backend::set_index_buffer(ID3D11Buffer* buffer, DXGI_FORMAT format, u32 offset)
+{
+    m_context->IASetIndexBuffer(buffer, format, offset);
+}
+
+void d3d11_backend::set_topology(D3D11_PRIMITIVE_TOPOLOGY topology)
+{
+    m_context->IASetPrimitiveTopology(topology);
+}
+
+void d3d11_backend::set_vertex_shader(ID3D11VertexShader* shader)
+{
+    m_context->VSSetShader(shader, nullptr, 0);
+}
+
+void d3d11_backend::set_pixel_shader(ID3D11PixelShader* shader)
+{
+    m_context->PSSetShader(shader, nullptr, 0);
+}
+
+void d3d11_backend::set_hull_shader(ID3D11HullShader* shader)
+{
+    m_context->HSSetShader(shader, nullptr, 0);
+}
+
+void d3d11_backend::set_domain_shader(ID3D11DomainShader* shader)
+{
+    m_context->DSSetShader(shader, nullptr, 0);
+}
+
+void d3d11_backend::set_geometry_shader(ID3D11GeometryShader* shader)
+{
+    m_context->GSSetShader(shader, nullptr, 0);
+}
+
+void d3d11_backend::set_compute_shader(ID3D11ComputeShader* shader)
+{
+    m_context->CSSetShader(shader, nullptr, 0);
+}
+
+void d3d11_backend::set_constant_buffers(shader_stage stage, u32 slot, u32 count, ID3D11Buffer* const* buffers)
+{
+    switch (stage)
+    {
+    case shader_stage::vertex: m_context->VSSetConstantBuffers(slot, count, buffers); break;
+    case shader_stage::pixel: m_context->PSSetConstantBuffers(slot, count, buffers); break;
+    case shader_stage::hull: m_context->HSSetConstantBuffers(slot, count, buffers); break;
+    case shader_stage::domain: m_context->DSSetConstantBuffers(slot, count, buffers); break;
+    case shader_stage::geometry: m_context->GSSetConstantBuffers(slot, count, buffers); break;
+    case shader_stage::compute: m_context->CSSetConstantBuffers(slot, count, buffers); break;
+    default: break;
+    }
+}
+
+void d3d11_backend::set_constant_buffer_ranges(shader_stage stage, u32 slot, u32 count, ID3D11Buffer* const* buffers,
+                                               const u32* first_constants, const u32* constant_counts)
+{
+    assert(m_context1);
+    switch (stage)
+    {
+    case shader_stage::vertex: m_context1->VSSetConstantBuffers1(slot, count, buffers, first_constants, constant_counts); break;
+    case shader_stage::pixel: m_context1->PSSetConstantBuffers1(slot, count, buffers, first_constants, constant_counts); break;
+    case shader_stage::hull: m_context1->HSSetConstantBuffers1(slot, count, buffers, first_constants, constant_counts); break;
+    case shader_stage::domain: m_context1->DSSetConstantBuffers1(slot, count, buffers, first_constants, constant_counts); break;
+    case shader_stage::geometry: m_context1->GSSetConstantBuffers1(slot, count, buffers, first_constants, constant_counts); break;
+    case shader_stage::compute: m_context1->CSSetConstantBuffers1(slot, count, buffers, first_constants, constant_counts); break;
+    default: break;
+    }
+}
+
+void d3d11_backend::set_shader_resources(shader_stage stage, u32 slot, u32 count, ID3D11ShaderResourceView* const* views)
+{
+    switch (stage)
+    {
+    case shader_stage::vertex: m_context->VSSetShaderResources(slot, count, views); break;
+    case shader_stage::pixel: m_context->PSSetShaderResources(slot, count, views); break;
+    case shader_stage::hull: m_context->HSSetShaderResources(slot, count, views); break;
+    case shader_stage::domain: m_context->DSSetShaderResources(slot, count, views); break;
+    case shader_stage::geometry: m_context->GSSetShaderResources(slot, count, views); break;
+    case shader_stage::compute: m_context->CSSetShaderResources(slot, count, views); break;
+    default: break;
+    }
+}
+
+void d3d11_backend::set_samplers(shader_stage stage, u32 slot, u32 count, ID3D11SamplerState* const* samplers)
+{
+    switch (stage)
+    {
+    case shader_stage::vertex: m_context->VSSetSamplers(slot, count, samplers); break;
+    case shader_stage::pixel: m_context->PSSetSamplers(slot, count, samplers); break;
+    case shader_stage::hull: m_context->HSSetSamplers(slot, count, samplers); break;
+    case shader_stage::domain: m_context->DSSetSamplers(slot, count, samplers); break;
+    case shader_stage::geometry: m_context->GSSetSamplers(slot, count, samplers); break;
+    case shader_stage::compute: m_context->CSSetSamplers(slot, count, samplers); break;
+    default: break;
+    }
+}
+
+void d3d11_backend::set_unordered_access_views(u32 slot, u32 count, ID3D11UnorderedAccessView* const* views,
+                                               const u32* initial_counts)
+{
+    m_context->CSSetUnorderedAccessViews(slot, count, views, initial_counts);
+}
+
+void d3d11_backend::set_stream_output_targets(u32 count, ID3D11Buffer* const* buffers, const u32* offsets)
+{
+    m_context->SOSetTargets(count, buffers, offsets);
+}
+
+void d3d11_backend::set_rasterizer_state(ID3D11RasterizerState* state)
+{
+    m_context->RSSetState(state);
+}
+
+void d3d11_backend::set_viewports(u32 count, const D3D11_VIEWPORT* viewports)
+{
+    m_context->RSSetViewports(count, viewports);
+}
+
+void d3d11_backend::set_scissor_rects(u32 count, const D3D11_RECT* rects)
+{
+    m_context->RSSetScissorRects(count, rects);
+}
+
+void d3d11_backend::set_blend_state(ID3D11BlendState* state, const f32 factor[4], u32 sample_mask)
+{
+    m_context->OMSetBlendState(state, factor, sample_mask);
+}
+
+void d3d11_backend::set_depth_stencil_state(ID3D11DepthStencilState* state, u32 stencil_ref)
+{
+    m_context->OMSetDepthStencilState(state, stencil_ref);
+}
+
+void d3d11_backend::set_render_targets(u32 count, ID3D11RenderTargetView* const* views, ID3D11DepthStencilView* depth)
+{
+    m_context->OMSetRenderTargets(count, views, depth);
+}
+
+void d3d11_backend::clear_render_target(ID3D11RenderTargetView* view, const f32 color[4])
+{
+    m_context->ClearRenderTargetView(view, color);
+}
+
+void d3d11_backend::clear_depth_stencil(ID3D11DepthStencilView* view, u32 flags, f32 depth, u8 stencil)
+{
+    m_context->ClearDepthStencilView(view, flags, depth, stencil);
+}
+
+void d3d11_backend::draw(u32 vertex_count, u32 first_vertex)
+{
+    m_context->Draw(vertex_count, first_vertex);
+}
+
+void d3d11_backend::draw_indexed(u32 index_count, u32 first_index, i32 base_vertex)
+{
+    m_context->DrawIndexed(index_count, first_index, base_vertex);
+}
+
+void d3d11_backend::draw_indexed_instanced(u32 index_count, u32 instance_count, u32 first_index, i32 base_vertex,
+                                           u32 first_instance)
+{
+    m_context->DrawIndexedInstanced(index_count, instance_count, first_index, base_vertex, first_instance);
+}
+
+void d3d11_backend::dispatch(u32 groups_x, u32 groups_y, u32 groups_z)
+{
+    m_context->Dispatch(groups_x, groups_y, groups_z);
+}
+
+// Recorders have no swap chain
+
+HRESULT d3d11_backend::back_buffer(ID3D11Texture2D** texture)
+{
+    if (!m_swapchain)
+    {
+        return DXGI_ERROR_INVALID_CALL;
+    }
+    return m_swapchain->GetBuffer(0, IID_PPV_ARGS(texture));
+}
+
+void d3d11_backend::present(bool vsync)
+{
+    if (m_swapchain)
+    {
+        m_swapchain->Present(vsync ? 1 : 0, 0);
+    }
+}
+
+void d3d11_backend::set_fullscreen(bool fullscreen)
+{
+    if (m_swapchain)
+    {
+        m_swapchain->SetFullscreenState(fullscreen, nullptr);
+    }
+}
+
+render_backend* d3d11_backend::create_recorder()
+{
+    ID3D11DeviceContext* deferred{};
+    if (FAILED(m_device->CreateDeferredContext(0, &deferred)))
+    {
+        LOG_ERROR("Failed to create a deferred context");
+        return nullptr;
+    }
+
+    m_device->AddRef();
+    return new d3d11_backend{ m_device, deferred, nullptr };
+}
+
+HRESULT d3d11_backend::finish_command_list(ID3D11CommandList** list)
+{
+    if (m_context->GetType() != D3D11_DEVICE_CONTEXT_DEFERRED)
+    {
+        return DXGI_ERROR_INVALID_CALL;
+    }
+
+    // The deferred context starts the next list from the default state as well
+    return m_context->FinishCommandList(FALSE, list);
+}
+
+void d3d11_backend::execute_command_list(ID3D11CommandList* list)
+{
+    m_context->ExecuteCommandList(list, FALSE);
+}
+
+} // namespace yae::gfx
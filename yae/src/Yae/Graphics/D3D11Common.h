@@ -25,19 +25,30 @@
 
 #include "Yae/Common.h"
 
-#include <d3d11.h>
+#ifdef _WIN32
+    #include <d3d11.h>
 
-#define DX_CALL(x)                                                                                                               \
-    if (FAILED(x))                                                                                                               \
-    {                                                                                                                            \
-        char line_number[32];                                                                                                    \
-        sprintf_s(line_number, "%u", __LINE__);                                                                                  \
-        OutputDebugStringA("ERROR IN: ");                                                                                        \
-        OutputDebugStringA(__FILE__);                                                                                            \
-        OutputDebugStringA("\nLine: ");                                                                                          \
-        OutputDebugStringA(line_number);                                                                                         \
-        OutputDebugStringA("\n");                                                                                                \
-        OutputDebugStringA(#x);                                                                                                  \
-        OutputDebugStringA("\n");                                                                                                \
-        return false;                                                                                                            \
-    }
\ No newline at end of file
+    #define DX_CALL(x)                                                                                                           \
+        if (FAILED(x))                                                                                                           \
+        {                                                                                                                        \
+            char line_number[32];                                                                                                \
+            sprintf_s(line_number, "%u", __LINE__);                                                                              \
+            OutputDebugStringA("ERROR IN: ");                                                                                    \
+            OutputDebugStringA(__FILE__);                                                                                        \
+            OutputDebugStringA("\nLine: ");                                                                                      \
+            OutputDebugStringA(line_number);                                                                                     \
+            OutputDebugStringA("\n");                                                                                            \
+            OutputDebugStringA(#x);                                                                                              \
+            OutputDebugStringA("\n");                                                                                            \
+            return false;                                                                                                        \
+        }
+#else
+    #include "D3D11Headless.h"
+
+    #define DX_CALL(x)                                                                                                           \
+        if (FAILED(x))                                                                                                           \
+        {                                                                                                                        \
+            LOG_ERROR("{}({}): {} failed", __FILE__, __LINE__, #x);                                                              \
+            return false;                                                                                                        \
+        }
+#endif
\ No newline at end of file
@@ -23,10 +23,17 @@
 #include "D3D11Core.h"
 
 
+#include "D3D11Backend.h"
+#include "NullBackend.h"
+#include "SoftwareBackend.h"
 #include "Renderer.h"
 #include "Shaders/ShaderLibrary.h"
+#include "StateCache.h"
 #include "Yae/Core/System.h"
 
+#include <atomic>
+#include <thread>
+
 // Linking directx libraries
 //#pragma comment(lib, "d3d11.lib")
 //#pragma comment(lib, "dxgi.lib")
@@ -51,22 +58,19 @@ struct video_card_info
 constexpr f32 clear_color[4]  = { 0.f, 0.f, 0.f, 1.f };
 constexpr f32 blend_factor[4] = { 1.f, 1.f, 1.f, 1.f };
 constexpr f32 blend_factor_nil[4] = { 0.f, 0.f, 0.f, 0.f };
-constexpr u32 buffer_count    = 3;
 
-ID3D11RenderTargetView*   rtv_array[buffer_count];
-ID3D11ShaderResourceView* srv_array[buffer_count];
+gbuffer_views gbuffer{};
 
-ID3D11Texture2D*         dr_depth_stencil_buffer{};
 ID3D11DepthStencilState* dr_depth_stencil_state{};
-ID3D11DepthStencilView*  dr_depth_stencil_view{};
 ID3D11BlendState*        dr_blend_state{};
 ID3D11RasterizerState*   dr_raster_state{};
+ID3D11RasterizerState*   dr_scissor_raster_state{};
+ID3D11RasterizerState*   dr_volume_raster_state{};
+ID3D11DepthStencilState* dr_volume_depth_stencil_state{};
 //D3D11_VIEWPORT           dr_viewport{};
 
 video_card_info          gpu_info{};
-IDXGISwapChain*          swapchain{};
-ID3D11Device*            device{};
-ID3D11DeviceContext*     device_context{};
+render_backend*          current_backend{};
 ID3D11RenderTargetView*  render_target_view{};
 ID3D11Texture2D*         depth_stencil_buffer{};
 ID3D11DepthStencilState* depth_stencil_state{};
@@ -83,6 +87,8 @@ ID3D11BlendState* disabled_blend_state{};
 
 bool initialized{};
 
+std::atomic<std::thread::id> backend_owner{};
+
 DXGI_SWAP_CHAIN_DESC create_swapchain_desc(i32 width, i32 height, u32 numerator, u32 denominator, HWND hwnd)
 {
     DXGI_SWAP_CHAIN_DESC swapchain_desc{};
@@ -126,99 +132,24 @@ DXGI_SWAP_CHAIN_DESC create_swapchain_desc(i32 width, i32 height, u32 numerator,
 }
 
 
-bool init_deferred_renderer(ID3D11Device* device)
-{
-    // Texture for Position and Normal are 32 bit
-    D3D11_TEXTURE2D_DESC pos_norm_desc{};
-    pos_norm_desc.Width              = system::width();
-    pos_norm_desc.Height             = system::height();
-    pos_norm_desc.MipLevels          = 1;
-    pos_norm_desc.ArraySize          = 1;
-    pos_norm_desc.Format             = DXGI_FORMAT_R32G32B32A32_FLOAT;
-    pos_norm_desc.SampleDesc.Count   = 1;
-    pos_norm_desc.SampleDesc.Quality = 0;
-    pos_norm_desc.Usage              = D3D11_USAGE_DEFAULT;
-    pos_norm_desc.BindFlags          = D3D11_BIND_RENDER_TARGET | D3D11_BIND_SHADER_RESOURCE;
-    pos_norm_desc.CPUAccessFlags     = 0;
-    pos_norm_desc.MiscFlags          = 0;
-
-    // Texture for diffuse is 8 bit
-    D3D11_TEXTURE2D_DESC diffuse_desc{};
-    diffuse_desc.Width              = system::width();
-    diffuse_desc.Height             = system::height();
-    diffuse_desc.MipLevels          = 1;
-    diffuse_desc.ArraySize          = 1;
-    diffuse_desc.Format             = DXGI_FORMAT_R8G8B8A8_UNORM;
-    diffuse_desc.SampleDesc.Count   = 1;
-    diffuse_desc.SampleDesc.Quality = 0;
-    diffuse_desc.Usage              = D3D11_USAGE_DEFAULT;
-    diffuse_desc.BindFlags          = D3D11_BIND_RENDER_TARGET | D3D11_BIND_SHADER_RESOURCE;
-    diffuse_desc.CPUAccessFlags     = 0;
-    diffuse_desc.MiscFlags          = 0;
-
-    ID3D11Texture2D* rtvs[buffer_count];
-    DX_CALL(device->CreateTexture2D(&pos_norm_desc, nullptr, &rtvs[0]));
-    DX_CALL(device->CreateTexture2D(&pos_norm_desc, nullptr, &rtvs[1]));
-    DX_CALL(device->CreateTexture2D(&pos_norm_desc, nullptr, &rtvs[2]));
-
-    D3D11_RENDER_TARGET_VIEW_DESC rtv_desc32{};
-    rtv_desc32.Format             = pos_norm_desc.Format;
-    rtv_desc32.ViewDimension      = D3D11_RTV_DIMENSION_TEXTURE2D;
-    rtv_desc32.Texture2D.MipSlice = 0;
-
-    D3D11_RENDER_TARGET_VIEW_DESC rtv_desc8{};
-    rtv_desc8.Format             = pos_norm_desc.Format;
-    rtv_desc8.ViewDimension      = D3D11_RTV_DIMENSION_TEXTURE2D;
-    rtv_desc8.Texture2D.MipSlice = 0;
-
-    DX_CALL(device->CreateRenderTargetView(rtvs[0], &rtv_desc32, &rtv_array[0]));
-    DX_CALL(device->CreateRenderTargetView(rtvs[1], &rtv_desc32, &rtv_array[1]));
-    DX_CALL(device->CreateRenderTargetView(rtvs[2], &rtv_desc8, &rtv_array[2]));
-
-    D3D11_SHADER_RESOURCE_VIEW_DESC srv_desc{};
-    srv_desc.Format                    = pos_norm_desc.Format;
-    srv_desc.ViewDimension             = D3D11_SRV_DIMENSION_TEXTURE2D;
-    srv_desc.Texture2D.MostDetailedMip = 0;
-    srv_desc.Texture2D.MipLevels       = 1;
-
-    for (u32 i = 0; i < buffer_count; ++i)
-    {
-        DX_CALL(device->CreateShaderResourceView(rtvs[i], &srv_desc, &srv_array[i]));
-    }
-
-    for (u32 i = 0; i < buffer_count; ++i)
-    {
-        release(rtvs[i]);
-    }
-
-    D3D11_TEXTURE2D_DESC depth_desc{};
-    depth_desc.Width              = system::width();
-    depth_desc.Height             = system::height();
-    depth_desc.MipLevels          = 1;
-    depth_desc.ArraySize          = 1;
-    depth_desc.Format             = DXGI_FORMAT_R24G8_TYPELESS;
-    depth_desc.SampleDesc.Count   = 1;
-    depth_desc.SampleDesc.Quality = 0;
-    depth_desc.Usage              = D3D11_USAGE_DEFAULT;
-    depth_desc.BindFlags          = D3D11_BIND_DEPTH_STENCIL | D3D11_BIND_SHADER_RESOURCE;
-    depth_desc.CPUAccessFlags     = 0;
-    depth_desc.MiscFlags          = 0;
-
-    DX_CALL(device->CreateTexture2D(&depth_desc, nullptr, &dr_depth_stencil_buffer));
-
-    D3D11_DEPTH_STENCIL_VIEW_DESC dsv_desc{};
-    dsv_desc.Format             = DXGI_FORMAT_D24_UNORM_S8_UINT;
-    dsv_desc.ViewDimension      = D3D11_DSV_DIMENSION_TEXTURE2D;
-    dsv_desc.Texture2D.MipSlice = 0;
-
-    DX_CALL(device->CreateDepthStencilView(dr_depth_stencil_buffer, &dsv_desc, &dr_depth_stencil_view));
-
+bool init_deferred_renderer()
+{
+    // The G-buffer textures come from the frame graph's transient pool, set_gbuffer hands them over each frame
     D3D11_RASTERIZER_DESC rast_desc{};
     rast_desc.CullMode        = D3D11_CULL_BACK;
     rast_desc.FillMode        = D3D11_FILL_SOLID;
     rast_desc.DepthClipEnable = false;
 
-    DX_CALL(device->CreateRasterizerState(&rast_desc, &dr_raster_state));
+    dr_raster_state = state::rasterizer_state(rast_desc);
+
+    rast_desc.ScissorEnable = true;
+    dr_scissor_raster_state = state::rasterizer_state(rast_desc);
+
+    // Light volumes draw their far side, so the camera can stand inside one. Unclipped so volumes crossing the far
+    // plane still cover the pixels behind them
+    rast_desc.ScissorEnable = false;
+    rast_desc.CullMode      = D3D11_CULL_FRONT;
+    dr_volume_raster_state  = state::rasterizer_state(rast_desc);
 
     D3D11_BLEND_DESC blend_desc{};
     blend_desc.AlphaToCoverageEnable                 = false;
@@ -232,22 +163,24 @@ bool init_deferred_renderer(ID3D11Device* device)
     blend_desc.RenderTarget[0].BlendOpAlpha          = D3D11_BLEND_OP_ADD;
     blend_desc.RenderTarget[0].RenderTargetWriteMask = D3D11_COLOR_WRITE_ENABLE_ALL;
 
-    DX_CALL(device->CreateBlendState(&blend_desc, &dr_blend_state));
+    dr_blend_state = state::blend_state(blend_desc);
 
     D3D11_DEPTH_STENCIL_DESC ds_desc{};
     ds_desc.DepthEnable    = true;
     ds_desc.DepthWriteMask = D3D11_DEPTH_WRITE_MASK_ZERO;
     ds_desc.DepthFunc      = D3D11_COMPARISON_LESS_EQUAL;
 
-    DX_CALL(device->CreateDepthStencilState(&ds_desc, &dr_depth_stencil_state));
+    dr_depth_stencil_state = state::depth_stencil_state(ds_desc);
 
-    return true;
-}
-
-} // anonymous namespace
+    // A surface is inside a volume's depth range when the volume's back face is behind it
+    ds_desc.DepthFunc             = D3D11_COMPARISON_GREATER;
+    dr_volume_depth_stencil_state = state::depth_stencil_state(ds_desc);
 
+    return dr_raster_state && dr_scissor_raster_state && dr_volume_raster_state && dr_blend_state && dr_depth_stencil_state &&
+           dr_volume_depth_stencil_state;
+}
 
-bool init(i32 width, i32 height, HWND hwnd, bool fullscreen, f32 screen_depth, f32 screen_near)
+bool create_d3d11_backend(i32 width, i32 height, HWND hwnd)
 {
     IDXGIFactory*     factory{};
     IDXGIAdapter*     adapter{};
@@ -294,13 +227,44 @@ bool init(i32 width, i32 height, HWND hwnd, bool fullscreen, f32 screen_depth, f
     const DXGI_SWAP_CHAIN_DESC  swapchain_desc = create_swapchain_desc(width, height, numerator, denominator, hwnd);
     constexpr D3D_FEATURE_LEVEL feat_level     = D3D_FEATURE_LEVEL_11_0;
 
+    IDXGISwapChain*      swapchain{};
+    ID3D11Device*        device{};
+    ID3D11DeviceContext* device_context{};
     DX_CALL(D3D11CreateDeviceAndSwapChain(nullptr, D3D_DRIVER_TYPE_HARDWARE, nullptr, 0, &feat_level, 1, D3D11_SDK_VERSION,
                                           &swapchain_desc, &swapchain, &device, nullptr, &device_context));
 
+    current_backend = new d3d11_backend{ device, device_context, swapchain };
+    return true;
+}
+
+} // anonymous namespace
+
+
+bool init(i32 width, i32 height, HWND hwnd, bool fullscreen, f32 screen_depth, f32 screen_near)
+{
+    claim_backend();
+
+    const std::string backend_name = g_settings->get<std::string>("engine", "backend");
+    if (backend_name == "null")
+    {
+        current_backend = new null_backend{ (u32) width, (u32) height };
+        strcpy_s(gpu_info.description, "Null backend");
+        LOG_INFO("Using the null render backend, nothing will be drawn");
+    } else if (backend_name == "software")
+    {
+        current_backend = new software_backend{ (u32) width, (u32) height };
+        strcpy_s(gpu_info.description, "Software rasterizer");
+        LOG_INFO("Using the software render backend, frames are rasterized on the CPU");
+    } else if (!create_d3d11_backend(width, height, hwnd))
+    {
+        LOG_FATAL("Failed to create the D3D11 device");
+        return false;
+    }
+
     ID3D11Texture2D* backbuffer_ptr;
-    DX_CALL(swapchain->GetBuffer(0, IID_PPV_ARGS(&backbuffer_ptr)));
+    DX_CALL(current_backend->back_buffer(&backbuffer_ptr));
 
-    DX_CALL(device->CreateRenderTargetView(backbuffer_ptr, nullptr, &render_target_view));
+    DX_CALL(current_backend->create_render_target_view(backbuffer_ptr, nullptr, &render_target_view));
 
     release(backbuffer_ptr);
 
@@ -317,7 +281,7 @@ bool init(i32 width, i32 height, HWND hwnd, bool fullscreen, f32 screen_depth, f
     depth_buffer_desc.CPUAccessFlags     = 0;
     depth_buffer_desc.MiscFlags          = 0;
 
-    DX_CALL(device->CreateTexture2D(&depth_buffer_desc, nullptr, &depth_stencil_buffer));
+    DX_CALL(current_backend->create_texture2d(&depth_buffer_desc, nullptr, &depth_stencil_buffer));
 
     D3D11_DEPTH_STENCIL_DESC depth_stencil_desc{};
     depth_stencil_desc.DepthEnable      = true;
@@ -339,17 +303,22 @@ bool init(i32 width, i32 height, HWND hwnd, bool fullscreen, f32 screen_depth, f
     depth_stencil_desc.BackFace.StencilPassOp      = D3D11_STENCIL_OP_KEEP;
     depth_stencil_desc.BackFace.StencilFunc        = D3D11_COMPARISON_ALWAYS;
 
-    DX_CALL(device->CreateDepthStencilState(&depth_stencil_desc, &depth_stencil_state));
+    depth_stencil_state = state::depth_stencil_state(depth_stencil_desc);
+    if (!depth_stencil_state)
+    {
+        return false;
+    }
 
-    device_context->OMSetDepthStencilState(depth_stencil_state, 1);
+    state::set_depth_stencil_state(depth_stencil_state, 1);
 
     D3D11_DEPTH_STENCIL_VIEW_DESC depth_stencil_view_desc{};
     depth_stencil_view_desc.Format             = DXGI_FORMAT_D24_UNORM_S8_UINT;
     depth_stencil_view_desc.ViewDimension      = D3D11_DSV_DIMENSION_TEXTURE2D;
     depth_stencil_view_desc.Texture2D.MipSlice = 0;
-    DX_CALL(device->CreateDepthStencilView(depth_stencil_buffer, &depth_stencil_view_desc, &depth_stencil_view));
+    DX_CALL(current_backend->create_depth_stencil_view(depth_stencil_buffer, &depth_stencil_view_desc, &depth_stencil_view));
 
-    device_context->OMSetRenderTargets(1, &render_target_view, depth_stencil_view);
+    current_backend->set_render_targets(1, &render_target_view, depth_stencil_view);
+    state::forget_shader_resources();
 
     D3D11_RASTERIZER_DESC raster_desc{};
     raster_desc.AntialiasedLineEnable = false;
@@ -363,9 +332,13 @@ bool init(i32 width, i32 height, HWND hwnd, bool fullscreen, f32 screen_depth, f
     raster_desc.ScissorEnable         = false;
     raster_desc.SlopeScaledDepthBias  = 0.0f;
 
-    DX_CALL(device->CreateRasterizerState(&raster_desc, &raster_state));
+    raster_state = state::rasterizer_state(raster_desc);
+    if (!raster_state)
+    {
+        return false;
+    }
 
-    device_context->RSSetState(raster_state);
+    state::set_rasterizer_state(raster_state);
 
     viewport.Width    = (f32) width;
     viewport.Height   = (f32) height;
@@ -374,7 +347,7 @@ bool init(i32 width, i32 height, HWND hwnd, bool fullscreen, f32 screen_depth, f
     viewport.TopLeftX = 0.0f;
     viewport.TopLeftY = 0.0f;
 
-    device_context->RSSetViewports(1, &viewport);
+    current_backend->set_viewports(1, &viewport);
 
     f32 fov    = math::pi / 4.f;
     f32 aspect = (f32) width / (f32) height;
@@ -399,7 +372,7 @@ bool init(i32 width, i32 height, HWND hwnd, bool fullscreen, f32 screen_depth, f
     disabled_desc.BackFace.StencilPassOp       = D3D11_STENCIL_OP_KEEP;
     disabled_desc.BackFace.StencilFunc         = D3D11_COMPARISON_ALWAYS;
 
-    DX_CALL(device->CreateDepthStencilState(&disabled_desc, &disabled_depth_stencil_state));
+    disabled_depth_stencil_state = state::depth_stencil_state(disabled_desc);
 
     D3D11_BLEND_DESC blend_desc{};
     blend_desc.RenderTarget[0].BlendEnable           = true;
@@ -411,12 +384,18 @@ bool init(i32 width, i32 height, HWND hwnd, bool fullscreen, f32 screen_depth, f
     blend_desc.RenderTarget[0].BlendOpAlpha          = D3D11_BLEND_OP_ADD;
     blend_desc.RenderTarget[0].RenderTargetWriteMask = 0x0f;
 
-    DX_CALL(device->CreateBlendState(&blend_desc, &blend_state));
+    blend_state = state::blend_state(blend_desc);
 
     blend_desc.RenderTarget[0].BlendEnable = false;
-    DX_CALL(device->CreateBlendState(&blend_desc, &disabled_blend_state));
+    disabled_blend_state                   = state::blend_state(blend_desc);
 
-    if (!init_deferred_renderer(device))
+    if (!disabled_depth_stencil_state || !blend_state || !disabled_blend_state)
+    {
+        LOG_FATAL("Failed to create the pipeline state objects");
+        return false;
+    }
+
+    if (!init_deferred_renderer())
     {
         LOG_FATAL("Failed to initialize deferred renderer");
         return false;
@@ -428,7 +407,11 @@ bool init(i32 width, i32 height, HWND hwnd, bool fullscreen, f32 screen_depth, f
         return false;
     }
 
-    init_renderer();
+    if (!init_renderer())
+    {
+        LOG_ERROR("Failed to initialize the renderer");
+        return false;
+    }
 
 
     initialized = true;
@@ -442,103 +425,113 @@ void shutdown()
 
     shaders::shutdown();
 
-    if (swapchain)
+    if (current_backend)
     {
-        swapchain->SetFullscreenState(false, nullptr);
+        current_backend->set_fullscreen(false);
     }
 
-    release(blend_state);
-    release(disabled_blend_state);
     shutdown_renderer();
-    release(dr_depth_stencil_buffer);
-    release(dr_depth_stencil_view);
-    release(dr_raster_state);
-    release(dr_blend_state);
-    release(dr_depth_stencil_state);
+    gbuffer = {};
 
-    for (u32 i = 0; i < buffer_count; ++i)
-    {
-        release(rtv_array[i]);
-        release(srv_array[i]);
-    }
-
-    release(disabled_depth_stencil_state);
-    release(raster_state);
     release(depth_stencil_view);
-    release(depth_stencil_state);
     release(depth_stencil_buffer);
     release(render_target_view);
-    release(device_context);
-    release(device);
-    release(swapchain);
+
+    // The cache owns every blend, depth, raster and sampler state, they all go together
+    state::shutdown();
+    delete current_backend;
+    current_backend = nullptr;
 }
 
-void clear_first_stage()
+void bind_first_stage()
 {
     ID3D11ShaderResourceView* null[] = { nullptr, nullptr, nullptr };
-    device_context->PSSetShaderResources(0, 3, null);
-    device_context->OMSetRenderTargets(3, rtv_array, dr_depth_stencil_view);
-    device_context->RSSetViewports(1, &viewport);
-    device_context->ClearRenderTargetView(rtv_array[0], clear_color);
-    device_context->ClearRenderTargetView(rtv_array[1], clear_color);
-    device_context->ClearRenderTargetView(rtv_array[2], clear_color);
-    device_context->ClearDepthStencilView(dr_depth_stencil_view, D3D11_CLEAR_DEPTH, 1.f, 0);
+    state::set_shader_resources(shader_stage::pixel, 0, 3, null);
+    state::target()->set_render_targets(3, gbuffer.targets, gbuffer.depth);
+    state::forget_shader_resources();
+    state::target()->set_viewports(1, &viewport);
+
+    state::set_rasterizer_state(nullptr);
+    state::set_blend_state(nullptr, blend_factor);
+    state::set_depth_stencil_state(nullptr, 0);
 }
 
-void clear_second_stage()
+void clear_first_stage()
 {
-    device_context->OMSetRenderTargets(1, &render_target_view, dr_depth_stencil_view);
-    device_context->RSSetViewports(1, &viewport);
-    device_context->ClearRenderTargetView(render_target_view, clear_color);
-    device_context->ClearDepthStencilView(dr_depth_stencil_view, D3D11_CLEAR_DEPTH, 1.f, 0);
-    device_context->RSSetState(dr_raster_state);
+    bind_first_stage();
+    for (auto* target : gbuffer.targets)
+    {
+        current_backend->clear_render_target(target, clear_color);
+    }
+
+    current_backend->clear_depth_stencil(gbuffer.depth, D3D11_CLEAR_DEPTH, 1.f, 0);
+}
 
-    device_context->OMSetBlendState(dr_blend_state, blend_factor, 0xFFFFFFFF);
-    device_context->OMSetDepthStencilState(dr_depth_stencil_state, 0);
+void clear_second_stage()
+{
+    current_backend->set_render_targets(1, &render_target_view, gbuffer.depth);
+    state::forget_shader_resources();
+    current_backend->set_viewports(1, &viewport);
+    current_backend->clear_render_target(render_target_view, clear_color);
+    // The G-buffer depth is kept, light volumes are depth tested against it
+    state::set_rasterizer_state(dr_raster_state);
+
+    state::set_blend_state(dr_blend_state, blend_factor);
+    state::set_depth_stencil_state(dr_depth_stencil_state, 0);
 }
 
 void begin_scene(f32 r, f32 g, f32 b, f32 a)
 {
     const f32 color[4]{ r, g, b, a };
-    device_context->ClearRenderTargetView(render_target_view, color);                     // clear back buffer
-    device_context->ClearDepthStencilView(depth_stencil_view, D3D11_CLEAR_DEPTH, 1.f, 0); // clear depth buffer
+    current_backend->clear_render_target(render_target_view, color);                     // clear back buffer
+    current_backend->clear_depth_stencil(depth_stencil_view, D3D11_CLEAR_DEPTH, 1.f, 0); // clear depth buffer
 }
 
 void end_scene()
 {
-    device_context->RSSetState(nullptr);
-    device_context->OMSetBlendState(nullptr, blend_factor, 0xFFFFFFFF);
-    device_context->OMSetDepthStencilState(nullptr, 0);
-    if (g_settings->get<bool>("display", "vsync"))
-    {
-        swapchain->Present(1, 0);
-    } else
-    {
-        swapchain->Present(0, 0);
-    }
+    state::set_rasterizer_state(nullptr);
+    state::set_blend_state(nullptr, blend_factor);
+    state::set_depth_stencil_state(nullptr, 0);
+    current_backend->present(g_settings->get<bool>("display", "vsync"));
 }
 
-ID3D11Device* get_device()
+render_backend* backend()
 {
-    return device;
+    return current_backend;
 }
-ID3D11DeviceContext* get_device_context()
+
+void claim_backend()
+{
+    backend_owner.store(std::this_thread::get_id(), std::memory_order_release);
+}
+
+bool owns_backend()
 {
-    return device_context;
+    return backend_owner.load(std::memory_order_acquire) == std::this_thread::get_id();
+}
+
+void set_gbuffer(const gbuffer_views& views)
+{
+    gbuffer = views;
+}
+
+ID3D11RenderTargetView* back_buffer_view()
+{
+    return render_target_view;
 }
 
 ID3D11ShaderResourceView* position_gbuffer()
 {
-    return srv_array[0];
+    return gbuffer.textures[0];
 }
 
 ID3D11ShaderResourceView* normal_gbuffer()
 {
-    return srv_array[1];
+    return gbuffer.textures[1];
 }
 ID3D11ShaderResourceView* diffuse_gbuffer()
 {
-    return srv_array[2];
+    return gbuffer.textures[2];
 }
 
 math::matrix get_projection_matrix()
@@ -567,35 +560,59 @@ void get_video_card_info(char* card_name, i32& memory)
 
 void set_back_buffer_render_target()
 {
-    device_context->OMSetRenderTargets(1, &render_target_view, depth_stencil_view);
+    current_backend->set_render_targets(1, &render_target_view, depth_stencil_view);
+    state::forget_shader_resources();
 }
 
 void reset_viewport()
 {
-    device_context->RSSetViewports(1, &viewport);
+    current_backend->set_viewports(1, &viewport);
 }
 
 void enable_zbuffer()
 {
-    device_context->OMSetDepthStencilState(depth_stencil_state, 1);
+    state::set_depth_stencil_state(depth_stencil_state, 1);
 }
 
 void disable_zbuffer()
 {
-    device_context->RSSetState(nullptr);
-    device_context->OMSetBlendState(nullptr, blend_factor, 0xFFFFFFFF);
+    state::set_rasterizer_state(nullptr);
+    state::set_blend_state(nullptr, blend_factor);
     //device_context->OMSetDepthStencilState(nullptr, 0);
-    device_context->OMSetDepthStencilState(disabled_depth_stencil_state, 1);
+    state::set_depth_stencil_state(disabled_depth_stencil_state, 1);
 }
 
 void enable_alpha_blending()
 {
-    device_context->OMSetBlendState(blend_state, blend_factor_nil, 0xffffffff);
+    state::set_blend_state(blend_state, blend_factor_nil);
 }
 
 void disable_alpha_blending()
 {
-    device_context->OMSetBlendState(disabled_blend_state, blend_factor_nil, 0xffffffff);
+    state::set_blend_state(disabled_blend_state, blend_factor_nil);
+}
+
+void enable_scissor(const D3D11_RECT& rect)
+{
+    state::set_rasterizer_state(dr_scissor_raster_state);
+    current_backend->set_scissor_rects(1, &rect);
+}
+
+void disable_scissor()
+{
+    state::set_rasterizer_state(dr_raster_state);
+}
+
+void enable_light_volumes()
+{
+    state::set_rasterizer_state(dr_volume_raster_state);
+    state::set_depth_stencil_state(dr_volume_depth_stencil_state, 0);
+}
+
+void disable_light_volumes()
+{
+    state::set_rasterizer_state(dr_raster_state);
+    state::set_depth_stencil_state(dr_depth_stencil_state, 0);
 }
 
 
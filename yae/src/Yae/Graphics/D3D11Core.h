@@ -23,7 +23,7 @@
 
 #pragma once
 
-#include "D3D11Common.h"
+#include "Backend.h"
 
 #pragma comment(lib, "d3d11.lib")
 #pragma comment(lib, "dxgi.lib")
@@ -54,17 +54,41 @@ constexpr void shutdown(T*& resource)
     }
 }
 
+// Views of the G-buffer the deferred stages draw into and read, owned by whoever sets them
+struct gbuffer_views
+{
+    ID3D11RenderTargetView*   targets[3]{};
+    ID3D11ShaderResourceView* textures[3]{};
+    ID3D11DepthStencilView*   depth{};
+};
+
 bool init(i32 width, i32 height, HWND hwnd, bool fullscreen, f32 screen_depth, f32 screen_near);
 void shutdown();
 
 
+// Binds the G-buffer and the default states it is drawn with, on the recorder when the calling thread is recording
+void bind_first_stage();
 void clear_first_stage();
 void clear_second_stage();
 void begin_scene(f32 r, f32 g, f32 b, f32 a);
 void end_scene();
 
-ID3D11Device*        get_device();
-ID3D11DeviceContext* get_device_context();
+// The stages use these until the next call, the frame graph sets them from its transients before each pass
+void set_gbuffer(const gbuffer_views& views);
+ID3D11RenderTargetView* back_buffer_view();
+
+// The backend picked by the engine.backend setting at init, everything that talks to the GPU goes through it
+render_backend* backend();
+
+/**
+ * \brief Makes the calling thread the owner of the immediate backend and the state cache. init makes its caller the
+ * owner, the render thread claims them while it runs and hands them back when it stops
+ */
+void claim_backend();
+
+// True on the thread that owns the immediate backend. Loading models, textures or state objects anywhere else races
+// the render thread, the loaders assert on it in debug builds
+bool owns_backend();
 
 ID3D11ShaderResourceView* position_gbuffer();
 ID3D11ShaderResourceView* normal_gbuffer();
@@ -87,4 +111,12 @@ void disable_zbuffer();
 void enable_alpha_blending();
 void disable_alpha_blending();
 
+// Limits the deferred lighting stage's draws to a rectangle in pixels until disable_scissor is called
+void enable_scissor(const D3D11_RECT& rect);
+void disable_scissor();
+
+// Back faces only, passing where they are behind the G-buffer depth, until disable_light_volumes is called
+void enable_light_volumes();
+void disable_light_volumes();
+
 } // namespace yae::gfx::core
\ No newline at end of file
@@ -0,0 +1,709 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: D3D11Headless.h
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+
+#pragma once
+
+// The part of d3d11.h the null backend, its recorder and the headers they pull in use, for builds without the Windows
+// SDK. Interfaces only declare the methods the engine calls or the null objects implement, values match the SDK's
+// except interface ids, which only have to be distinct. The few MSVC runtime functions the backends use are mapped to
+// their POSIX equivalents
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <strings.h>
+
+using BYTE    = uint8_t;
+using UINT8   = uint8_t;
+using INT     = int32_t;
+using UINT    = uint32_t;
+using LONG    = int32_t;
+using ULONG   = uint32_t;
+using UINT64  = uint64_t;
+using SIZE_T  = size_t;
+using BOOL    = int32_t;
+using FLOAT   = float;
+using HRESULT = int32_t;
+using LPCSTR  = const char*;
+
+#define STDMETHODCALLTYPE
+
+#define SUCCEEDED(hr) (((HRESULT) (hr)) >= 0)
+#define FAILED(hr)    (((HRESULT) (hr)) < 0)
+
+#define S_OK                    ((HRESULT) 0)
+#define S_FALSE                 ((HRESULT) 1)
+#define E_NOINTERFACE           ((HRESULT) 0x80004002)
+#define E_POINTER               ((HRESULT) 0x80004003)
+#define E_FAIL                  ((HRESULT) 0x80004005)
+#define E_OUTOFMEMORY           ((HRESULT) 0x8007000E)
+#define E_INVALIDARG            ((HRESULT) 0x80070057)
+#define DXGI_ERROR_INVALID_CALL ((HRESULT) 0x887A0001)
+#define DXGI_ERROR_NOT_FOUND    ((HRESULT) 0x887A0002)
+#define DXGI_ERROR_MORE_DATA    ((HRESULT) 0x887A0003)
+
+inline int _stricmp(const char* a, const char* b)
+{
+    return strcasecmp(a, b);
+}
+
+inline int fopen_s(FILE** file, const char* filename, const char* mode)
+{
+    *file = fopen(filename, mode);
+    return *file ? 0 : -1;
+}
+
+struct GUID
+{
+    uint32_t Data1;
+    uint16_t Data2;
+    uint16_t Data3;
+    uint8_t  Data4[8];
+
+    constexpr bool operator==(const GUID& other) const
+    {
+        if (Data1 != other.Data1 || Data2 != other.Data2 || Data3 != other.Data3)
+        {
+            return false;
+        }
+        for (uint32_t i = 0; i < 8; ++i)
+        {
+            if (Data4[i] != other.Data4[i])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+using IID     = GUID;
+using REFGUID = const GUID&;
+using REFIID  = const IID&;
+
+// Every interface carries its id, MinGW resolves __uuidof the same way
+#define __uuidof(T) T::iid
+
+#define YAE_HEADLESS_IID(n)                                                                                                      \
+    static constexpr IID iid { 0x79ae0000u + (n), 0, 0, { 0, 0, 0, 0, 0, 0, 0, 0 } }
+
+inline constexpr GUID WKPDID_D3DDebugObjectName{ 0x429b8c22, 0x9188, 0x4b0c, { 0x87, 0x42, 0xac, 0xb0, 0xbf, 0x85, 0xc2, 0x00 } };
+
+struct RECT
+{
+    LONG left;
+    LONG top;
+    LONG right;
+    LONG bottom;
+};
+
+// Formats
+
+enum DXGI_FORMAT : UINT
+{
+    DXGI_FORMAT_UNKNOWN               = 0,
+    DXGI_FORMAT_R32G32B32A32_TYPELESS = 1,
+    DXGI_FORMAT_R32G32B32A32_FLOAT    = 2,
+    DXGI_FORMAT_R32G32B32A32_UINT     = 3,
+    DXGI_FORMAT_R32G32B32A32_SINT     = 4,
+    DXGI_FORMAT_R32G32B32_FLOAT       = 6,
+    DXGI_FORMAT_R32G32B32_UINT        = 7,
+    DXGI_FORMAT_R32G32B32_SINT        = 8,
+    DXGI_FORMAT_R16G16B16A16_FLOAT    = 10,
+    DXGI_FORMAT_R32G32_FLOAT          = 16,
+    DXGI_FORMAT_R32G32_UINT           = 17,
+    DXGI_FORMAT_R32G32_SINT           = 18,
+    DXGI_FORMAT_R8G8B8A8_UNORM        = 28,
+    DXGI_FORMAT_R32_TYPELESS          = 39,
+    DXGI_FORMAT_D32_FLOAT             = 40,
+    DXGI_FORMAT_R32_FLOAT             = 41,
+    DXGI_FORMAT_R32_UINT              = 42,
+    DXGI_FORMAT_R24G8_TYPELESS        = 44,
+    DXGI_FORMAT_D24_UNORM_S8_UINT     = 45,
+    DXGI_FORMAT_R24_UNORM_X8_TYPELESS = 46,
+    DXGI_FORMAT_R8G8_UNORM            = 49,
+    DXGI_FORMAT_R16_FLOAT             = 54,
+    DXGI_FORMAT_R16_UINT              = 57,
+    DXGI_FORMAT_R8_UNORM              = 61,
+    DXGI_FORMAT_B8G8R8A8_UNORM        = 87,
+};
+
+struct DXGI_SAMPLE_DESC
+{
+    UINT Count;
+    UINT Quality;
+};
+
+// Enumerations
+
+enum D3D11_USAGE : UINT
+{
+    D3D11_USAGE_DEFAULT   = 0,
+    D3D11_USAGE_IMMUTABLE = 1,
+    D3D11_USAGE_DYNAMIC   = 2,
+    D3D11_USAGE_STAGING   = 3,
+};
+
+enum D3D11_BIND_FLAG : UINT
+{
+    D3D11_BIND_VERTEX_BUFFER    = 0x1,
+    D3D11_BIND_INDEX_BUFFER     = 0x2,
+    D3D11_BIND_CONSTANT_BUFFER  = 0x4,
+    D3D11_BIND_SHADER_RESOURCE  = 0x8,
+    D3D11_BIND_STREAM_OUTPUT    = 0x10,
+    D3D11_BIND_RENDER_TARGET    = 0x20,
+    D3D11_BIND_DEPTH_STENCIL    = 0x40,
+    D3D11_BIND_UNORDERED_ACCESS = 0x80,
+};
+
+enum D3D11_CPU_ACCESS_FLAG : UINT
+{
+    D3D11_CPU_ACCESS_WRITE = 0x10000,
+    D3D11_CPU_ACCESS_READ  = 0x20000,
+};
+
+enum D3D11_MAP : UINT
+{
+    D3D11_MAP_READ               = 1,
+    D3D11_MAP_WRITE              = 2,
+    D3D11_MAP_READ_WRITE         = 3,
+    D3D11_MAP_WRITE_DISCARD      = 4,
+    D3D11_MAP_WRITE_NO_OVERWRITE = 5,
+};
+
+enum D3D11_RESOURCE_DIMENSION : UINT
+{
+    D3D11_RESOURCE_DIMENSION_UNKNOWN   = 0,
+    D3D11_RESOURCE_DIMENSION_BUFFER    = 1,
+    D3D11_RESOURCE_DIMENSION_TEXTURE1D = 2,
+    D3D11_RESOURCE_DIMENSION_TEXTURE2D = 3,
+    D3D11_RESOURCE_DIMENSION_TEXTURE3D = 4,
+};
+
+enum D3D11_PRIMITIVE_TOPOLOGY : UINT
+{
+    D3D11_PRIMITIVE_TOPOLOGY_UNDEFINED     = 0,
+    D3D11_PRIMITIVE_TOPOLOGY_POINTLIST     = 1,
+    D3D11_PRIMITIVE_TOPOLOGY_LINELIST      = 2,
+    D3D11_PRIMITIVE_TOPOLOGY_LINESTRIP     = 3,
+    D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST  = 4,
+    D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP = 5,
+};
+
+enum D3D11_CLEAR_FLAG : UINT
+{
+    D3D11_CLEAR_DEPTH   = 0x1,
+    D3D11_CLEAR_STENCIL = 0x2,
+};
+
+// State values the software backend emulates, the null backend only copies states around
+enum D3D11_FILTER : UINT
+{
+    D3D11_FILTER_MIN_MAG_MIP_POINT = 0,
+};
+
+enum D3D11_TEXTURE_ADDRESS_MODE : UINT
+{
+    D3D11_TEXTURE_ADDRESS_WRAP   = 1,
+    D3D11_TEXTURE_ADDRESS_MIRROR = 2,
+    D3D11_TEXTURE_ADDRESS_CLAMP  = 3,
+    D3D11_TEXTURE_ADDRESS_BORDER = 4,
+};
+
+enum D3D11_COMPARISON_FUNC : UINT
+{
+    D3D11_COMPARISON_NEVER         = 1,
+    D3D11_COMPARISON_LESS          = 2,
+    D3D11_COMPARISON_EQUAL         = 3,
+    D3D11_COMPARISON_LESS_EQUAL    = 4,
+    D3D11_COMPARISON_GREATER       = 5,
+    D3D11_COMPARISON_NOT_EQUAL     = 6,
+    D3D11_COMPARISON_GREATER_EQUAL = 7,
+    D3D11_COMPARISON_ALWAYS        = 8,
+};
+
+enum D3D11_BLEND : UINT
+{
+    D3D11_BLEND_ZERO             = 1,
+    D3D11_BLEND_ONE              = 2,
+    D3D11_BLEND_SRC_COLOR        = 3,
+    D3D11_BLEND_INV_SRC_COLOR    = 4,
+    D3D11_BLEND_SRC_ALPHA        = 5,
+    D3D11_BLEND_INV_SRC_ALPHA    = 6,
+    D3D11_BLEND_DEST_ALPHA       = 7,
+    D3D11_BLEND_INV_DEST_ALPHA   = 8,
+    D3D11_BLEND_DEST_COLOR       = 9,
+    D3D11_BLEND_INV_DEST_COLOR   = 10,
+    D3D11_BLEND_SRC_ALPHA_SAT    = 11,
+    D3D11_BLEND_BLEND_FACTOR     = 14,
+    D3D11_BLEND_INV_BLEND_FACTOR = 15,
+};
+
+enum D3D11_BLEND_OP : UINT
+{
+    D3D11_BLEND_OP_ADD          = 1,
+    D3D11_BLEND_OP_SUBTRACT     = 2,
+    D3D11_BLEND_OP_REV_SUBTRACT = 3,
+    D3D11_BLEND_OP_MIN          = 4,
+    D3D11_BLEND_OP_MAX          = 5,
+};
+
+enum D3D11_DEPTH_WRITE_MASK : UINT
+{
+    D3D11_DEPTH_WRITE_MASK_ZERO = 0,
+    D3D11_DEPTH_WRITE_MASK_ALL  = 1,
+};
+
+enum D3D11_STENCIL_OP : UINT
+{
+    D3D11_STENCIL_OP_KEEP = 1,
+};
+
+enum D3D11_COLOR_WRITE_ENABLE : UINT
+{
+    D3D11_COLOR_WRITE_ENABLE_ALL = 0xF,
+};
+
+enum D3D11_FILL_MODE : UINT
+{
+    D3D11_FILL_WIREFRAME = 2,
+    D3D11_FILL_SOLID     = 3,
+};
+
+enum D3D11_CULL_MODE : UINT
+{
+    D3D11_CULL_NONE  = 1,
+    D3D11_CULL_FRONT = 2,
+    D3D11_CULL_BACK  = 3,
+};
+
+enum D3D11_SRV_DIMENSION : UINT
+{};
+enum D3D11_RTV_DIMENSION : UINT
+{};
+enum D3D11_DSV_DIMENSION : UINT
+{};
+
+enum D3D11_INPUT_CLASSIFICATION : UINT
+{
+    D3D11_INPUT_PER_VERTEX_DATA   = 0,
+    D3D11_INPUT_PER_INSTANCE_DATA = 1,
+};
+
+constexpr UINT D3D11_APPEND_ALIGNED_ELEMENT                            = 0xffffffff;
+constexpr UINT D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT        = 14;
+constexpr UINT D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT                = 32;
+constexpr UINT D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT                  = 8;
+constexpr UINT D3D11_SO_BUFFER_SLOT_COUNT                              = 4;
+constexpr UINT D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE = 16;
+
+// Descriptions
+
+struct D3D11_BUFFER_DESC
+{
+    UINT        ByteWidth;
+    D3D11_USAGE Usage;
+    UINT        BindFlags;
+    UINT        CPUAccessFlags;
+    UINT        MiscFlags;
+    UINT        StructureByteStride;
+};
+
+struct D3D11_TEXTURE2D_DESC
+{
+    UINT             Width;
+    UINT             Height;
+    UINT             MipLevels;
+    UINT             ArraySize;
+    DXGI_FORMAT      Format;
+    DXGI_SAMPLE_DESC SampleDesc;
+    D3D11_USAGE      Usage;
+    UINT             BindFlags;
+    UINT             CPUAccessFlags;
+    UINT             MiscFlags;
+};
+
+struct D3D11_SUBRESOURCE_DATA
+{
+    const void* pSysMem;
+    UINT        SysMemPitch;
+    UINT        SysMemSlicePitch;
+};
+
+struct D3D11_MAPPED_SUBRESOURCE
+{
+    void* pData;
+    UINT  RowPitch;
+    UINT  DepthPitch;
+};
+
+// Views only describe the 2D texture and structured buffer cases the engine creates
+struct D3D11_SHADER_RESOURCE_VIEW_DESC
+{
+    DXGI_FORMAT         Format;
+    D3D11_SRV_DIMENSION ViewDimension;
+    union
+    {
+        struct
+        {
+            UINT FirstElement;
+            UINT NumElements;
+        } Buffer;
+        struct
+        {
+            UINT MostDetailedMip;
+            UINT MipLevels;
+        } Texture2D;
+    };
+};
+
+struct D3D11_RENDER_TARGET_VIEW_DESC
+{
+    DXGI_FORMAT         Format;
+    D3D11_RTV_DIMENSION ViewDimension;
+    struct
+    {
+        UINT MipSlice;
+    } Texture2D;
+};
+
+struct D3D11_DEPTH_STENCIL_VIEW_DESC
+{
+    DXGI_FORMAT         Format;
+    D3D11_DSV_DIMENSION ViewDimension;
+    UINT                Flags;
+    struct
+    {
+        UINT MipSlice;
+    } Texture2D;
+};
+
+struct D3D11_SAMPLER_DESC
+{
+    D3D11_FILTER               Filter;
+    D3D11_TEXTURE_ADDRESS_MODE AddressU;
+    D3D11_TEXTURE_ADDRESS_MODE AddressV;
+    D3D11_TEXTURE_ADDRESS_MODE AddressW;
+    FLOAT                      MipLODBias;
+    UINT                       MaxAnisotropy;
+    D3D11_COMPARISON_FUNC      ComparisonFunc;
+    FLOAT                      BorderColor[4];
+    FLOAT                      MinLOD;
+    FLOAT                      MaxLOD;
+};
+
+struct D3D11_RENDER_TARGET_BLEND_DESC
+{
+    BOOL           BlendEnable;
+    D3D11_BLEND    SrcBlend;
+    D3D11_BLEND    DestBlend;
+    D3D11_BLEND_OP BlendOp;
+    D3D11_BLEND    SrcBlendAlpha;
+    D3D11_BLEND    DestBlendAlpha;
+    D3D11_BLEND_OP BlendOpAlpha;
+    UINT8          RenderTargetWriteMask;
+};
+
+struct D3D11_BLEND_DESC
+{
+    BOOL                           AlphaToCoverageEnable;
+    BOOL                           IndependentBlendEnable;
+    D3D11_RENDER_TARGET_BLEND_DESC RenderTarget[D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT];
+};
+
+struct D3D11_DEPTH_STENCILOP_DESC
+{
+    D3D11_STENCIL_OP      StencilFailOp;
+    D3D11_STENCIL_OP      StencilDepthFailOp;
+    D3D11_STENCIL_OP      StencilPassOp;
+    D3D11_COMPARISON_FUNC StencilFunc;
+};
+
+struct D3D11_DEPTH_STENCIL_DESC
+{
+    BOOL                       DepthEnable;
+    D3D11_DEPTH_WRITE_MASK     DepthWriteMask;
+    D3D11_COMPARISON_FUNC      DepthFunc;
+    BOOL                       StencilEnable;
+    UINT8                      StencilReadMask;
+    UINT8                      StencilWriteMask;
+    D3D11_DEPTH_STENCILOP_DESC FrontFace;
+    D3D11_DEPTH_STENCILOP_DESC BackFace;
+};
+
+struct D3D11_RASTERIZER_DESC
+{
+    D3D11_FILL_MODE FillMode;
+    D3D11_CULL_MODE CullMode;
+    BOOL            FrontCounterClockwise;
+    INT             DepthBias;
+    FLOAT           DepthBiasClamp;
+    FLOAT           SlopeScaledDepthBias;
+    BOOL            DepthClipEnable;
+    BOOL            ScissorEnable;
+    BOOL            MultisampleEnable;
+    BOOL            AntialiasedLineEnable;
+};
+
+struct D3D11_INPUT_ELEMENT_DESC
+{
+    LPCSTR                     SemanticName;
+    UINT                       SemanticIndex;
+    DXGI_FORMAT                Format;
+    UINT                       InputSlot;
+    UINT                       AlignedByteOffset;
+    D3D11_INPUT_CLASSIFICATION InputSlotClass;
+    UINT                       InstanceDataStepRate;
+};
+
+struct D3D11_SO_DECLARATION_ENTRY
+{
+    UINT   Stream;
+    LPCSTR SemanticName;
+    UINT   SemanticIndex;
+    BYTE   StartComponent;
+    BYTE   ComponentCount;
+    BYTE   OutputSlot;
+};
+
+struct D3D11_VIEWPORT
+{
+    FLOAT TopLeftX;
+    FLOAT TopLeftY;
+    FLOAT Width;
+    FLOAT Height;
+    FLOAT MinDepth;
+    FLOAT MaxDepth;
+};
+
+using D3D11_RECT = RECT;
+
+// The default states, as the SDK's d3d11.h helpers build them
+
+struct CD3D11_DEFAULT
+{};
+
+struct CD3D11_RASTERIZER_DESC : D3D11_RASTERIZER_DESC
+{
+    explicit CD3D11_RASTERIZER_DESC(CD3D11_DEFAULT)
+    {
+        FillMode              = D3D11_FILL_SOLID;
+        CullMode              = D3D11_CULL_BACK;
+        FrontCounterClockwise = 0;
+        DepthBias             = 0;
+        DepthBiasClamp        = 0.f;
+        SlopeScaledDepthBias  = 0.f;
+        DepthClipEnable       = 1;
+        ScissorEnable         = 0;
+        MultisampleEnable     = 0;
+        AntialiasedLineEnable = 0;
+    }
+};
+
+struct CD3D11_DEPTH_STENCIL_DESC : D3D11_DEPTH_STENCIL_DESC
+{
+    explicit CD3D11_DEPTH_STENCIL_DESC(CD3D11_DEFAULT)
+    {
+        DepthEnable      = 1;
+        DepthWriteMask   = D3D11_DEPTH_WRITE_MASK_ALL;
+        DepthFunc        = D3D11_COMPARISON_LESS;
+        StencilEnable    = 0;
+        StencilReadMask  = 0xFF;
+        StencilWriteMask = 0xFF;
+        FrontFace        = { D3D11_STENCIL_OP_KEEP, D3D11_STENCIL_OP_KEEP, D3D11_STENCIL_OP_KEEP, D3D11_COMPARISON_ALWAYS };
+        BackFace         = FrontFace;
+    }
+};
+
+struct CD3D11_BLEND_DESC : D3D11_BLEND_DESC
+{
+    explicit CD3D11_BLEND_DESC(CD3D11_DEFAULT)
+    {
+        AlphaToCoverageEnable  = 0;
+        IndependentBlendEnable = 0;
+        for (D3D11_RENDER_TARGET_BLEND_DESC& target : RenderTarget)
+        {
+            target = { 0,
+                       D3D11_BLEND_ONE,
+                       D3D11_BLEND_ZERO,
+                       D3D11_BLEND_OP_ADD,
+                       D3D11_BLEND_ONE,
+                       D3D11_BLEND_ZERO,
+                       D3D11_BLEND_OP_ADD,
+                       D3D11_COLOR_WRITE_ENABLE_ALL };
+        }
+    }
+};
+
+// Interfaces
+
+struct ID3D11Device;
+
+struct IUnknown
+{
+    YAE_HEADLESS_IID(0);
+
+    virtual HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** object) = 0;
+    virtual ULONG STDMETHODCALLTYPE   AddRef()                                   = 0;
+    virtual ULONG STDMETHODCALLTYPE   Release()                                  = 0;
+};
+
+struct ID3D11DeviceChild : IUnknown
+{
+    YAE_HEADLESS_IID(1);
+
+    virtual void STDMETHODCALLTYPE    GetDevice(ID3D11Device** device)                          = 0;
+    virtual HRESULT STDMETHODCALLTYPE GetPrivateData(REFGUID guid, UINT* size, void* data)      = 0;
+    virtual HRESULT STDMETHODCALLTYPE SetPrivateData(REFGUID guid, UINT size, const void* data) = 0;
+    virtual HRESULT STDMETHODCALLTYPE SetPrivateDataInterface(REFGUID guid, const IUnknown* data) = 0;
+};
+
+struct ID3D11Resource : ID3D11DeviceChild
+{
+    YAE_HEADLESS_IID(2);
+
+    virtual void STDMETHODCALLTYPE GetType(D3D11_RESOURCE_DIMENSION* dimension) = 0;
+    virtual void STDMETHODCALLTYPE SetEvictionPriority(UINT priority)           = 0;
+    virtual UINT STDMETHODCALLTYPE GetEvictionPriority()                        = 0;
+};
+
+struct ID3D11Buffer : ID3D11Resource
+{
+    YAE_HEADLESS_IID(3);
+
+    virtual void STDMETHODCALLTYPE GetDesc(D3D11_BUFFER_DESC* desc) = 0;
+};
+
+struct ID3D11Texture2D : ID3D11Resource
+{
+    YAE_HEADLESS_IID(4);
+
+    virtual void STDMETHODCALLTYPE GetDesc(D3D11_TEXTURE2D_DESC* desc) = 0;
+};
+
+struct ID3D11View : ID3D11DeviceChild
+{
+    YAE_HEADLESS_IID(5);
+
+    virtual void STDMETHODCALLTYPE GetResource(ID3D11Resource** resource) = 0;
+};
+
+struct ID3D11ShaderResourceView : ID3D11View
+{
+    YAE_HEADLESS_IID(6);
+
+    virtual void STDMETHODCALLTYPE GetDesc(D3D11_SHADER_RESOURCE_VIEW_DESC* desc) = 0;
+};
+
+struct ID3D11RenderTargetView : ID3D11View
+{
+    YAE_HEADLESS_IID(7);
+
+    virtual void STDMETHODCALLTYPE GetDesc(D3D11_RENDER_TARGET_VIEW_DESC* desc) = 0;
+};
+
+struct ID3D11DepthStencilView : ID3D11View
+{
+    YAE_HEADLESS_IID(8);
+
+    virtual void STDMETHODCALLTYPE GetDesc(D3D11_DEPTH_STENCIL_VIEW_DESC* desc) = 0;
+};
+
+// Never created by the null backend, only passed through
+struct ID3D11UnorderedAccessView : ID3D11View
+{
+    YAE_HEADLESS_IID(9);
+};
+
+struct ID3D11SamplerState : ID3D11DeviceChild
+{
+    YAE_HEADLESS_IID(10);
+
+    virtual void STDMETHODCALLTYPE GetDesc(D3D11_SAMPLER_DESC* desc) = 0;
+};
+
+struct ID3D11BlendState : ID3D11DeviceChild
+{
+    YAE_HEADLESS_IID(11);
+
+    virtual void STDMETHODCALLTYPE GetDesc(D3D11_BLEND_DESC* desc) = 0;
+};
+
+struct ID3D11DepthStencilState : ID3D11DeviceChild
+{
+    YAE_HEADLESS_IID(12);
+
+    virtual void STDMETHODCALLTYPE GetDesc(D3D11_DEPTH_STENCIL_DESC* desc) = 0;
+};
+
+struct ID3D11RasterizerState : ID3D11DeviceChild
+{
+    YAE_HEADLESS_IID(13);
+
+    virtual void STDMETHODCALLTYPE GetDesc(D3D11_RASTERIZER_DESC* desc) = 0;
+};
+
+struct ID3D11InputLayout : ID3D11DeviceChild
+{
+    YAE_HEADLESS_IID(14);
+};
+
+struct ID3D11VertexShader : ID3D11DeviceChild
+{
+    YAE_HEADLESS_IID(15);
+};
+
+struct ID3D11PixelShader : ID3D11DeviceChild
+{
+    YAE_HEADLESS_IID(16);
+};
+
+struct ID3D11HullShader : ID3D11DeviceChild
+{
+    YAE_HEADLESS_IID(17);
+};
+
+struct ID3D11DomainShader : ID3D11DeviceChild
+{
+    YAE_HEADLESS_IID(18);
+};
+
+struct ID3D11GeometryShader : ID3D11DeviceChild
+{
+    YAE_HEADLESS_IID(19);
+};
+
+struct ID3D11ComputeShader : ID3D11DeviceChild
+{
+    YAE_HEADLESS_IID(20);
+};
+
+struct ID3D11CommandList : ID3D11DeviceChild
+{
+    YAE_HEADLESS_IID(21);
+
+    virtual UINT STDMETHODCALLTYPE GetContextFlags() = 0;
+};
+
+#undef YAE_HEADLESS_IID
@@ -0,0 +1,72 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: FrameConstants.cpp
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+#include "FrameConstants.h"
+
+#include "D3D11Core.h"
+#include "StateCache.h"
+
+namespace yae::gfx::frame
+{
+
+namespace
+{
+ID3D11Buffer* buffer{};
+} // anonymous namespace
+
+bool init()
+{
+    D3D11_BUFFER_DESC desc{};
+    desc.Usage          = D3D11_USAGE_DYNAMIC;
+    desc.ByteWidth      = sizeof(frame_constants);
+    desc.BindFlags      = D3D11_BIND_CONSTANT_BUFFER;
+    desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+    DX_CALL(core::backend()->create_buffer(&desc, nullptr, &buffer));
+    return true;
+}
+
+void shutdown()
+{
+    core::release(buffer);
+}
+
+bool upload(const frame_constants& constants)
+{
+    render_backend* backend = core::backend();
+
+    D3D11_MAPPED_SUBRESOURCE mapped{};
+    DX_CALL(backend->map(buffer, 0, D3D11_MAP_WRITE_DISCARD, &mapped));
+    memcpy(mapped.pData, &constants, sizeof(frame_constants));
+    backend->unmap(buffer, 0);
+
+    bind();
+    return true;
+}
+
+void bind()
+{
+    state::set_constant_buffer(shader_stage::vertex, buffer_slot, buffer);
+    state::set_constant_buffer(shader_stage::pixel, buffer_slot, buffer);
+}
+
+} // namespace yae::gfx::frame
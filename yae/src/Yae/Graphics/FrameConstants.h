@@ -0,0 +1,67 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: FrameConstants.h
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+
+#pragma once
+
+#include "D3D11Common.h"
+
+namespace yae::gfx
+{
+
+// Mirrors cbuffer FrameData in Shaders/FrameData.hlsli, matrices are stored transposed for HLSL
+struct frame_constants
+{
+    math::mat4 view{};
+    math::mat4 projection{};
+    math::vec4 ambient_color{};
+    math::vec4 dir_light_color{};
+    math::vec3 camera_pos{};
+    f32        padding0{};
+    math::vec3 light_direction{};
+    f32        padding1{};
+};
+
+namespace frame
+{
+
+// Shaders skip creating and binding their own copy of a buffer with this name
+constexpr const char* buffer_name = "FrameData";
+constexpr u32         buffer_slot = 12;
+
+bool init();
+void shutdown();
+
+/**
+ * \brief Uploads the frame's constants and binds them to the vertex and pixel stages. Nothing else binds the slot, so
+ * this is the only upload of the buffer in a frame
+ * \param constants The frame's constants
+ * \return False if the buffer could not be mapped
+ */
+bool upload(const frame_constants& constants);
+
+// Binds the buffer again, for command lists and after executing one, which both start from the default state
+void bind();
+
+} // namespace frame
+
+} // namespace yae::gfx
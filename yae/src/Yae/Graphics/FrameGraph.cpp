@@ -0,0 +1,420 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: FrameGraph.cpp
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+
+#include "FrameGraph.h"
+
+#include <algorithm>
+
+namespace yae::gfx
+{
+namespace
+{
+
+void add_unique(std::vector<u32>& list, u32 value)
+{
+    if (std::ranges::find(list, value) == list.end())
+    {
+        list.push_back(value);
+    }
+}
+
+bool contains(const std::vector<u32>& list, u32 value)
+{
+    return std::ranges::find(list, value) != list.end();
+}
+
+} // anonymous namespace
+
+u32 frame_graph::add_pass(std::string_view name, execute_func execute)
+{
+    m_compiled = false;
+    m_passes.push_back({ .name = std::string{ name }, .execute = std::move(execute) });
+    return (u32) m_passes.size() - 1;
+}
+
+void frame_graph::create(u32 pass, std::string_view resource, const transient_desc& desc)
+{
+    m_compiled  = false;
+    const u32 r = find_or_add(resource);
+    if (m_resources[r].creator != pass)
+    {
+        ++m_resources[r].creators;
+    }
+
+    m_resources[r].creator = pass;
+    m_resources[r].desc    = desc;
+    add_unique(m_passes[pass].writes, r);
+}
+
+void frame_graph::read(u32 pass, std::string_view resource)
+{
+    m_compiled = false;
+    add_unique(m_passes[pass].reads, find_or_add(resource));
+}
+
+void frame_graph::write(u32 pass, std::string_view resource)
+{
+    m_compiled = false;
+    add_unique(m_passes[pass].writes, find_or_add(resource));
+}
+
+void frame_graph::keep(u32 pass)
+{
+    m_compiled          = false;
+    m_passes[pass].kept = true;
+}
+
+void frame_graph::import(std::string_view resource, const graph_views& views)
+{
+    m_compiled              = false;
+    const u32 r             = find_or_add(resource);
+    m_resources[r].imported = true;
+    m_resources[r].views    = views;
+}
+
+void frame_graph::clear()
+{
+    m_resources.clear();
+    m_passes.clear();
+    m_names.clear();
+    m_order.clear();
+    m_physical.clear();
+    m_compiled = false;
+}
+
+bool frame_graph::compile()
+{
+    m_compiled = false;
+    m_order.clear();
+    m_physical.clear();
+
+    bool valid = true;
+    for (auto& res : m_resources)
+    {
+        res.first    = invalid_u32;
+        res.last     = invalid_u32;
+        res.physical = invalid_u32;
+
+        if (res.creators > 1)
+        {
+            LOG_ERROR("Frame graph resource {} is created by {} passes", res.name, res.creators);
+            valid = false;
+        } else if (res.imported && res.creator != invalid_u32)
+        {
+            LOG_ERROR("Frame graph resource {} is both imported and created by {}", res.name, m_passes[res.creator].name);
+            valid = false;
+        } else if (!res.imported && res.creator == invalid_u32)
+        {
+            LOG_ERROR("Frame graph resource {} is used but neither imported nor created by a pass", res.name);
+            valid = false;
+        }
+    }
+
+    for (u32 p = 0; p < (u32) m_passes.size(); ++p)
+    {
+        for (const u32 r : m_passes[p].reads)
+        {
+            if (m_resources[r].creator == p)
+            {
+                LOG_ERROR("Frame graph pass {} reads {}, which it creates", m_passes[p].name, m_resources[r].name);
+                valid = false;
+            }
+        }
+    }
+
+    if (!valid)
+    {
+        return false;
+    }
+
+    cull();
+    if (!sort())
+    {
+        return false;
+    }
+
+    assign_slots();
+    m_compiled = true;
+
+    const auto culled = std::ranges::count_if(m_passes, [](const pass& p) { return p.culled; });
+    const auto transients =
+        std::ranges::count_if(m_resources, [](const resource& r) { return r.physical != invalid_u32; });
+    LOG_INFO("Frame graph compiled: {} passes, {} culled, {} transient resources in {} textures", m_order.size(), culled,
+             transients, m_physical.size());
+    return true;
+}
+
+void frame_graph::execute(const allocate_func& allocate)
+{
+    if (!m_compiled)
+    {
+        LOG_WARN("Frame graph executed without a successful compile, nothing was drawn");
+        return;
+    }
+
+    std::vector<graph_views> slots(m_physical.size());
+    for (u32 i = 0; i < (u32) m_physical.size(); ++i)
+    {
+        slots[i] = allocate(m_physical[i]);
+    }
+
+    for (auto& res : m_resources)
+    {
+        if (res.physical != invalid_u32)
+        {
+            res.views = slots[res.physical];
+        }
+    }
+
+    for (const u32 p : m_order)
+    {
+        if (m_passes[p].execute)
+        {
+            m_passes[p].execute(*this);
+        }
+    }
+}
+
+const graph_views& frame_graph::views(std::string_view resource) const
+{
+    static constexpr graph_views none{};
+
+    const auto it = m_names.find(std::string{ resource });
+    return it != m_names.end() ? m_resources[it->second].views : none;
+}
+
+u32 frame_graph::physical_slot(std::string_view resource) const
+{
+    const auto it = m_names.find(std::string{ resource });
+    return it != m_names.end() ? m_resources[it->second].physical : invalid_u32;
+}
+
+u32 frame_graph::find_or_add(std::string_view name)
+{
+    const auto [it, added] = m_names.try_emplace(std::string{ name }, (u32) m_resources.size());
+    if (added)
+    {
+        m_resources.push_back({ .name = std::string{ name } });
+    }
+
+    return it->second;
+}
+
+// Reference counting: a pass is needed while something reads a resource it writes. Resources nobody reads release
+// their writers, a pass left with no references is culled and releases what it reads in turn
+void frame_graph::cull()
+{
+    std::vector<u32> unread{};
+    for (auto& res : m_resources)
+    {
+        res.readers = 0;
+    }
+
+    for (auto& p : m_passes)
+    {
+        p.culled = false;
+        p.refs   = (u32) p.writes.size();
+        for (const u32 r : p.reads)
+        {
+            ++m_resources[r].readers;
+        }
+    }
+
+    auto release_pass = [&](pass& p) {
+        p.culled = true;
+        for (const u32 r : p.reads)
+        {
+            if (--m_resources[r].readers == 0 && !m_resources[r].imported)
+            {
+                unread.push_back(r);
+            }
+        }
+    };
+
+    for (u32 r = 0; r < (u32) m_resources.size(); ++r)
+    {
+        if (m_resources[r].readers == 0 && !m_resources[r].imported)
+        {
+            unread.push_back(r);
+        }
+    }
+
+    for (auto& p : m_passes)
+    {
+        if (p.refs == 0 && !p.kept)
+        {
+            release_pass(p);
+        }
+    }
+
+    while (!unread.empty())
+    {
+        const u32 r = unread.back();
+        unread.pop_back();
+
+        for (auto& p : m_passes)
+        {
+            if (!p.culled && contains(p.writes, r) && --p.refs == 0 && !p.kept)
+            {
+                release_pass(p);
+            }
+        }
+    }
+}
+
+// Kahn's algorithm, always taking the earliest declared pass that is ready so the order stays close to the declarations
+bool frame_graph::sort()
+{
+    const u32 count = (u32) m_passes.size();
+
+    auto depends_on = [&](u32 reader, u32 writer) {
+        const pass& p = m_passes[reader];
+        const pass& w = m_passes[writer];
+        for (const u32 r : p.reads)
+        {
+            if (!contains(w.writes, r))
+            {
+                continue;
+            }
+
+            // Reads see the writes declared before them, or every write when the reader comes first and doesn't
+            // modify the resource itself
+            bool earlier_writer = false;
+            for (u32 i = 0; i < reader; ++i)
+            {
+                earlier_writer |= !m_passes[i].culled && contains(m_passes[i].writes, r);
+            }
+
+            if (writer < reader || (!earlier_writer && !contains(p.writes, r)))
+            {
+                return true;
+            }
+        }
+
+        // Writes to the same resource keep their declaration order
+        if (writer < reader)
+        {
+            for (const u32 r : p.writes)
+            {
+                if (contains(w.writes, r))
+                {
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    };
+
+    std::vector<std::vector<u32>> dependencies(count);
+    for (u32 p = 0; p < count; ++p)
+    {
+        for (u32 w = 0; w < count && !m_passes[p].culled; ++w)
+        {
+            if (w != p && !m_passes[w].culled && depends_on(p, w))
+            {
+                dependencies[p].push_back(w);
+            }
+        }
+    }
+
+    std::vector<bool> placed(count);
+    u32               remaining = (u32) std::ranges::count_if(m_passes, [](const pass& p) { return !p.culled; });
+    while (remaining > 0)
+    {
+        u32 next = invalid_u32;
+        for (u32 p = 0; p < count && next == invalid_u32; ++p)
+        {
+            if (!m_passes[p].culled && !placed[p] &&
+                std::ranges::all_of(dependencies[p], [&](u32 d) { return placed[d]; }))
+            {
+                next = p;
+            }
+        }
+
+        if (next == invalid_u32)
+        {
+            LOG_ERROR("Frame graph passes depend on each other in a cycle");
+            m_order.clear();
+            return false;
+        }
+
+        placed[next] = true;
+        m_order.push_back(next);
+        --remaining;
+    }
+
+    return true;
+}
+
+// Greedy: a resource takes a free slot with the same description when its first pass runs and returns it after its
+// last, textures are only added when no free slot fits
+void frame_graph::assign_slots()
+{
+    for (u32 i = 0; i < (u32) m_order.size(); ++i)
+    {
+        const pass& p = m_passes[m_order[i]];
+        for (const auto* list : { &p.reads, &p.writes })
+        {
+            for (const u32 r : *list)
+            {
+                resource& res = m_resources[r];
+                res.first     = std::min(res.first, i);
+                res.last      = res.last == invalid_u32 ? i : std::max(res.last, i);
+            }
+        }
+    }
+
+    std::vector<u32> free_slots{};
+    for (u32 i = 0; i < (u32) m_order.size(); ++i)
+    {
+        for (auto& res : m_resources)
+        {
+            if (res.imported || res.first != i)
+            {
+                continue;
+            }
+
+            const auto slot = std::ranges::find_if(free_slots, [&](u32 s) { return m_physical[s] == res.desc; });
+            if (slot != free_slots.end())
+            {
+                res.physical = *slot;
+                free_slots.erase(slot);
+            } else
+            {
+                res.physical = (u32) m_physical.size();
+                m_physical.push_back(res.desc);
+            }
+        }
+
+        for (const auto& res : m_resources)
+        {
+            if (!res.imported && res.last == i)
+            {
+                free_slots.push_back(res.physical);
+            }
+        }
+    }
+}
+
+} // namespace yae::gfx
@@ -0,0 +1,158 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: FrameGraph.h
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+
+#pragma once
+
+#include "D3D11Common.h"
+
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace yae::gfx
+{
+
+// Size and format of a transient texture. Resources whose lifetimes don't overlap share a texture when these match
+struct transient_desc
+{
+    u32         width{};
+    u32         height{};
+    DXGI_FORMAT format{ DXGI_FORMAT_UNKNOWN };
+    bool        depth{}; // Depth stencil target instead of a render target, format is the depth view's
+
+    bool operator==(const transient_desc&) const = default;
+};
+
+// Views a pass gets for a resource. Transients have all that apply, imported resources what they were imported with
+struct graph_views
+{
+    ID3D11RenderTargetView*   rtv{};
+    ID3D11DepthStencilView*   dsv{};
+    ID3D11ShaderResourceView* srv{};
+};
+
+/**
+ * \brief Passes of a frame and the named resources they read and write.\n\n
+ * compile() works on the declarations alone, so it runs without a device. Passes whose writes nobody reads are culled,
+ * unless they write an imported resource or are kept. The rest are ordered so every reader comes after the writers
+ * declared before it, and declaration order otherwise. Each transient resource lives from the first to the last pass
+ * that uses it, resources with matching descriptions and disjoint lifetimes are given the same physical slot.\n\n
+ * execute() asks for one texture per slot and runs the passes in order. Textures start with undefined contents, the
+ * pass that creates a resource clears it.
+ */
+class frame_graph
+{
+public:
+    using execute_func  = std::function<void(const frame_graph& graph)>;
+    using allocate_func = std::function<graph_views(const transient_desc& desc)>;
+
+    frame_graph()  = default;
+    ~frame_graph() = default;
+    DISABLE_COPY_AND_MOVE(frame_graph);
+
+    // Declaration, invalidates a previous compile
+
+    // Returns the pass index the resource declarations below take
+    u32  add_pass(std::string_view name, execute_func execute);
+    void create(u32 pass, std::string_view resource, const transient_desc& desc);
+    void read(u32 pass, std::string_view resource);
+    void write(u32 pass, std::string_view resource);
+
+    // Never culled, for passes whose results leave the graph some other way
+    void keep(u32 pass);
+
+    // A resource owned outside the graph, such as the back buffer. Passes writing one are never culled
+    void import(std::string_view resource, const graph_views& views);
+
+    // Drops every pass and resource
+    void clear();
+
+    /**
+     * \brief Culls, orders and assigns physical slots
+     * \return False if a resource is read but never written, created twice, or the dependencies form a cycle
+     */
+    bool compile();
+
+    /**
+     * \brief Runs the compiled passes in order
+     * \param allocate Returns the views of a texture for a slot's description, called once per slot before any pass
+     */
+    void execute(const allocate_func& allocate);
+
+    // Views of a resource, valid inside a pass's execute
+    const graph_views& views(std::string_view resource) const;
+
+    // Results of the last compile
+
+    bool                  compiled() const { return m_compiled; }
+    std::span<const u32>  order() const { return m_order; }
+    bool                  culled(u32 pass) const { return m_passes[pass].culled; }
+    u32                   physical_slot(std::string_view resource) const; // invalid_u32 for imported or unused ones
+    u32                   physical_count() const { return (u32) m_physical.size(); }
+    const transient_desc& physical_desc(u32 slot) const { return m_physical[slot]; }
+    u32                   pass_count() const { return (u32) m_passes.size(); }
+    const std::string&    pass_name(u32 pass) const { return m_passes[pass].name; }
+
+private:
+    struct resource
+    {
+        std::string    name{};
+        transient_desc desc{};
+        graph_views    views{};
+        bool           imported{};
+        u32            creator{ invalid_u32 };
+        u32            creators{};               // Passes that declared creating it, anything but one is an error
+        u32            readers{};                // Passes still reading it while culling
+        u32            first{ invalid_u32 };     // Positions in m_order
+        u32            last{ invalid_u32 };
+        u32            physical{ invalid_u32 };
+    };
+
+    struct pass
+    {
+        std::string      name{};
+        execute_func     execute{};
+        std::vector<u32> reads{};
+        std::vector<u32> writes{}; // Created resources included
+        bool             kept{};
+        bool             culled{};
+        u32              refs{}; // Written resources somebody still reads, while culling
+    };
+
+    u32  find_or_add(std::string_view name);
+    void cull();
+    bool sort();
+    void assign_slots();
+
+    std::vector<resource>                m_resources{};
+    std::vector<pass>                    m_passes{};
+    std::unordered_map<std::string, u32> m_names{};
+    std::vector<u32>                     m_order{};
+    std::vector<transient_desc>          m_physical{};
+    bool                                 m_compiled{};
+};
+
+} // namespace yae::gfx
@@ -0,0 +1,64 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: FramePacket.h
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+
+#pragma once
+
+#include "Light.h"
+#include "RenderQueue.h"
+
+#include <string>
+#include <vector>
+
+namespace yae::gfx
+{
+
+class text_string;
+
+// A string, what it shows this frame and in which color. Drawn on top of the overlay pass in submission order
+struct text_draw
+{
+    ref<text_string> string{};
+    std::string      text{};
+    math::vec4       color{ 1.f, 1.f, 1.f, 1.f };
+};
+
+/**
+ * \brief What one frame draws, copied out of the simulation once its update is done: the camera, the queued draws with
+ * their world matrices and materials, the packed point lights and the text. The renderer only reads the packet, so
+ * the simulation can fill the next one while this one is drawn.\n\n
+ * Models, textures and text strings are shared with the packet, so they outlive a component destroyed while the
+ * frame is still queued. Materials are referenced by id and are never unregistered. What changes per frame, like a
+ * text's color, is copied into the packet instead of being set on the shared object
+ */
+struct frame_packet
+{
+    u64                            frame{};
+    math::matrix                   view{};
+    math::vec3                     camera_pos{};
+    render_queue                   queue{};
+    std::vector<packed_pointlight> lights{};
+    std::vector<text_draw>         text{};
+    f32                            extract_ms{}; // Time the simulation spent filling the packet
+};
+
+} // namespace yae::gfx
@@ -54,4 +54,21 @@ struct point_light
     math::vec3 position{};
 };
 
+/**
+ * \brief Point light as the lighting pass reads it. Three 16 byte rows so the array can be copied straight into a
+ * shader buffer
+ */
+struct packed_pointlight
+{
+    math::vec3 position{};
+    f32        radius{};
+    math::vec3 color{};
+    f32        intensity{};
+    f32        falloff{};
+    f32        padding[3]{};
+};
+
+// The stride of PointLight in PointLight.hlsli
+static_assert(sizeof(packed_pointlight) == 48);
+
 } // namespace yae::gfx
\ No newline at end of file
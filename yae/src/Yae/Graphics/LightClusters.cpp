@@ -0,0 +1,357 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: LightClusters.cpp
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+
+#include "LightClusters.h"
+
+#include "Yae/Core/Jobs.h"
+
+#include <bit>
+#include <immintrin.h>
+
+namespace yae::gfx
+{
+namespace
+{
+
+// Padding tiles get an inverted box this size, so their distance to any light is huge
+constexpr f32 empty_bound = 1e30f;
+
+f32 axis_distance(f32 value, f32 min, f32 max)
+{
+    return std::max(std::max(min - value, value - max), 0.f);
+}
+
+} // anonymous namespace
+
+light_clusters::light_clusters(u32 tiles_x, u32 tiles_y, u32 slices) :
+    m_tiles_x{ tiles_x }, m_tiles_y{ tiles_y }, m_slices{ slices }, m_tile_stride{ (tiles_x * tiles_y + 3) & ~3u }
+{
+    m_min_x.resize(m_tile_stride * m_slices);
+    m_max_x.resize(m_tile_stride * m_slices);
+    m_min_y.resize(m_tile_stride * m_slices);
+    m_max_y.resize(m_tile_stride * m_slices);
+    m_slice_near.resize(m_slices);
+    m_slice_far.resize(m_slices);
+
+    m_slice_lists.resize(m_slices);
+    m_slice_offsets.resize(m_slices);
+    m_ranges.resize(cluster_count());
+}
+
+void light_clusters::set_projection(const math::matrix& projection)
+{
+    // Left handed perspective: z' = z * a + b with a = f / (f - n) and b = -n * f / (f - n)
+    const f32 a = XMVectorGetZ(projection.r[2]);
+    const f32 b = XMVectorGetZ(projection.r[3]);
+
+    m_x_scale     = XMVectorGetX(projection.r[0]);
+    m_y_scale     = XMVectorGetY(projection.r[1]);
+    m_near        = -b / a;
+    m_far         = b / (1.f - a);
+    m_slice_scale = (f32) m_slices / logf(m_far / m_near);
+    m_slice_bias  = -m_slice_scale * logf(m_near);
+
+    for (u32 s = 0; s < m_slices; ++s)
+    {
+        const f32 z0    = m_near * powf(m_far / m_near, (f32) s / (f32) m_slices);
+        const f32 z1    = m_near * powf(m_far / m_near, (f32) (s + 1) / (f32) m_slices);
+        m_slice_near[s] = z0;
+        m_slice_far[s]  = z1;
+
+        for (u32 i = 0; i < m_tile_stride; ++i)
+        {
+            const u32 index = s * m_tile_stride + i;
+            if (i >= m_tiles_x * m_tiles_y)
+            {
+                m_min_x[index] = m_min_y[index] = empty_bound;
+                m_max_x[index] = m_max_y[index] = -empty_bound;
+                continue;
+            }
+
+            // Tile edges in NDC, row 0 at the top of the screen. View space x at depth z is ndc * z / x_scale
+            const u32 x      = i % m_tiles_x;
+            const u32 y      = i / m_tiles_x;
+            const f32 left   = -1.f + 2.f * (f32) x / (f32) m_tiles_x;
+            const f32 right  = -1.f + 2.f * (f32) (x + 1) / (f32) m_tiles_x;
+            const f32 top    = 1.f - 2.f * (f32) y / (f32) m_tiles_y;
+            const f32 bottom = 1.f - 2.f * (f32) (y + 1) / (f32) m_tiles_y;
+
+            m_min_x[index] = std::min(left * z0, left * z1) / m_x_scale;
+            m_max_x[index] = std::max(right * z0, right * z1) / m_x_scale;
+            m_min_y[index] = std::min(bottom * z0, bottom * z1) / m_y_scale;
+            m_max_y[index] = std::max(top * z0, top * z1) / m_y_scale;
+        }
+    }
+}
+
+void light_clusters::build(const math::matrix& view, const math::matrix& projection, const packed_pointlight* lights, u32 count)
+{
+    prepare(view, projection, lights, count);
+
+    jobs::parallel_for(0, m_slices, 1, [this](u32 begin, u32 end) {
+        for (u32 s = begin; s < end; ++s)
+        {
+            assign_slice(s, true);
+            sort_slice(s);
+        }
+    });
+
+    finish();
+
+    jobs::parallel_for(0, m_slices, 1, [this](u32 begin, u32 end) {
+        for (u32 s = begin; s < end; ++s)
+        {
+            gather_slice(s);
+        }
+    });
+}
+
+void light_clusters::build_scalar(const math::matrix& view, const math::matrix& projection, const packed_pointlight* lights,
+                                  u32 count)
+{
+    prepare(view, projection, lights, count);
+
+    for (u32 s = 0; s < m_slices; ++s)
+    {
+        assign_slice(s, false);
+        sort_slice(s);
+    }
+
+    finish();
+
+    for (u32 s = 0; s < m_slices; ++s)
+    {
+        gather_slice(s);
+    }
+}
+
+u32 light_clusters::slice(f32 view_z) const
+{
+    if (view_z <= m_near)
+    {
+        return 0;
+    }
+    return std::min((u32) (logf(view_z) * m_slice_scale + m_slice_bias), m_slices - 1);
+}
+
+void light_clusters::prepare(const math::matrix& view, const math::matrix& projection, const packed_pointlight* lights,
+                             u32 count)
+{
+    if (XMVectorGetX(projection.r[0]) != m_x_scale || XMVectorGetY(projection.r[1]) != m_y_scale ||
+        -XMVectorGetZ(projection.r[3]) / XMVectorGetZ(projection.r[2]) != m_near)
+    {
+        set_projection(projection);
+    }
+
+    m_lights.resize(count);
+    m_visible_count = 0;
+    m_footprint     = { { FLT_MAX, FLT_MAX }, { -FLT_MAX, -FLT_MAX }, FLT_MAX, -FLT_MAX };
+    for (u32 i = 0; i < count; ++i)
+    {
+        const packed_pointlight& light = lights[i];
+        view_light&              vl    = m_lights[i];
+
+        math::sphere view_sphere{ {}, light.radius };
+        XMStoreFloat3(&view_sphere.center, XMVector3TransformCoord(XMLoadFloat3(&light.position), view));
+        vl.position  = view_sphere.center;
+        vl.radius_sq = light.radius * light.radius;
+
+        if (!math::project_sphere(view_sphere, m_x_scale, m_y_scale, m_near, m_far, vl.bounds))
+        {
+            // Marks the light as touching no slice
+            vl.first_slice = 1;
+            vl.last_slice  = 0;
+            continue;
+        }
+
+        // Widened by one on each side, the exact test below decides
+        const u32 first = slice(vl.bounds.near_z);
+        vl.first_slice  = first > 0 ? first - 1 : 0;
+        vl.last_slice   = std::min(slice(vl.bounds.far_z) + 1, m_slices - 1);
+
+        // Tiles under the projected rectangle, row 0 at the top
+        vl.first_x = std::min((u32) ((vl.bounds.min.x + 1.f) * .5f * (f32) m_tiles_x), m_tiles_x - 1);
+        vl.last_x  = std::min((u32) ((vl.bounds.max.x + 1.f) * .5f * (f32) m_tiles_x), m_tiles_x - 1);
+        vl.first_y = std::min((u32) ((1.f - vl.bounds.max.y) * .5f * (f32) m_tiles_y), m_tiles_y - 1);
+        vl.last_y  = std::min((u32) ((1.f - vl.bounds.min.y) * .5f * (f32) m_tiles_y), m_tiles_y - 1);
+
+        ++m_visible_count;
+        m_footprint.min.x  = std::min(m_footprint.min.x, vl.bounds.min.x);
+        m_footprint.min.y  = std::min(m_footprint.min.y, vl.bounds.min.y);
+        m_footprint.max.x  = std::max(m_footprint.max.x, vl.bounds.max.x);
+        m_footprint.max.y  = std::max(m_footprint.max.y, vl.bounds.max.y);
+        m_footprint.near_z = std::min(m_footprint.near_z, vl.bounds.near_z);
+        m_footprint.far_z  = std::max(m_footprint.far_z, vl.bounds.far_z);
+    }
+}
+
+void light_clusters::assign_slice(u32 slice, bool batched)
+{
+    slice_lists& lists = m_slice_lists[slice];
+    lists.hit_tiles.clear();
+    lists.hit_lights.clear();
+
+    const f32  z0    = m_slice_near[slice];
+    const f32  z1    = m_slice_far[slice];
+    const u32  base  = slice * m_tile_stride;
+    const f32* min_x = m_min_x.data() + base;
+    const f32* max_x = m_max_x.data() + base;
+    const f32* min_y = m_min_y.data() + base;
+    const f32* max_y = m_max_y.data() + base;
+
+    for (u32 l = 0; l < (u32) m_lights.size(); ++l)
+    {
+        const view_light& light = m_lights[l];
+        if (slice < light.first_slice || slice > light.last_slice)
+        {
+            continue;
+        }
+
+        // Depth is the same for every tile in the slice, only x and y are tested per tile
+        const f32 dz        = axis_distance(light.position.z, z0, z1);
+        const f32 remaining = light.radius_sq - dz * dz;
+        if (remaining < 0.f)
+        {
+            continue;
+        }
+
+        if (batched)
+        {
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 px   = _mm_set1_ps(light.position.x);
+            const __m128 py   = _mm_set1_ps(light.position.y);
+            const __m128 r2   = _mm_set1_ps(remaining);
+
+            for (u32 y = light.first_y; y <= light.last_y; ++y)
+            {
+                // Groups of 4 start on a multiple of 4, lanes outside the light's tiles are masked off
+                const u32 first = y * m_tiles_x + light.first_x;
+                const u32 last  = y * m_tiles_x + light.last_x;
+                for (u32 t = first & ~3u; t <= last; t += 4)
+                {
+                    const __m128 dx = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(min_x + t), px),
+                                                            _mm_sub_ps(px, _mm_loadu_ps(max_x + t))),
+                                                 zero);
+                    const __m128 dy = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(min_y + t), py),
+                                                            _mm_sub_ps(py, _mm_loadu_ps(max_y + t))),
+                                                 zero);
+                    const __m128 d2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+
+                    u32 lanes = 0xF;
+                    if (t < first)
+                    {
+                        lanes &= 0xFu << (first - t);
+                    }
+                    if (t + 3 > last)
+                    {
+                        lanes &= 0xFu >> (t + 3 - last);
+                    }
+
+                    u32 mask = (u32) _mm_movemask_ps(_mm_cmple_ps(d2, r2)) & lanes;
+                    while (mask)
+                    {
+                        const u32 bit = (u32) std::countr_zero(mask);
+                        lists.hit_tiles.push_back(t + bit);
+                        lists.hit_lights.push_back(l);
+                        mask &= mask - 1;
+                    }
+                }
+            }
+        } else
+        {
+            for (u32 y = light.first_y; y <= light.last_y; ++y)
+            {
+                for (u32 x = light.first_x; x <= light.last_x; ++x)
+                {
+                    const u32 t  = y * m_tiles_x + x;
+                    const f32 dx = axis_distance(light.position.x, min_x[t], max_x[t]);
+                    const f32 dy = axis_distance(light.position.y, min_y[t], max_y[t]);
+                    if (dx * dx + dy * dy <= remaining)
+                    {
+                        lists.hit_tiles.push_back(t);
+                        lists.hit_lights.push_back(l);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void light_clusters::sort_slice(u32 slice)
+{
+    // Counting sort by tile. Hits were found light by light, so every tile's lights stay in ascending order
+    slice_lists& lists = m_slice_lists[slice];
+    const u32    tiles = m_tiles_x * m_tiles_y;
+
+    lists.tile_offsets.assign(tiles + 1, 0);
+    for (const u32 t : lists.hit_tiles)
+    {
+        ++lists.tile_offsets[t + 1];
+    }
+    for (u32 t = 0; t < tiles; ++t)
+    {
+        lists.tile_offsets[t + 1] += lists.tile_offsets[t];
+    }
+
+    lists.indices.resize(lists.hit_tiles.size());
+    for (u32 i = 0; i < (u32) lists.hit_tiles.size(); ++i)
+    {
+        lists.indices[lists.tile_offsets[lists.hit_tiles[i]]++] = lists.hit_lights[i];
+    }
+
+    // The scatter moved every offset to the end of its tile, shift them back
+    for (u32 t = tiles; t > 0; --t)
+    {
+        lists.tile_offsets[t] = lists.tile_offsets[t - 1];
+    }
+    lists.tile_offsets[0] = 0;
+}
+
+void light_clusters::finish()
+{
+    u32 total = 0;
+    for (u32 s = 0; s < m_slices; ++s)
+    {
+        m_slice_offsets[s] = total;
+        total             += (u32) m_slice_lists[s].indices.size();
+    }
+    m_indices.resize(total);
+}
+
+void light_clusters::gather_slice(u32 slice)
+{
+    const slice_lists& lists = m_slice_lists[slice];
+    const u32          base  = m_slice_offsets[slice];
+    const u32          tiles = m_tiles_x * m_tiles_y;
+
+    for (u32 t = 0; t < tiles; ++t)
+    {
+        cluster_range& range = m_ranges[slice * tiles + t];
+        range.offset         = base + lists.tile_offsets[t];
+        range.count          = lists.tile_offsets[t + 1] - lists.tile_offsets[t];
+    }
+
+    std::copy(lists.indices.begin(), lists.indices.end(), m_indices.begin() + base);
+}
+
+} // namespace yae::gfx
@@ -0,0 +1,158 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: LightClusters.h
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+
+#pragma once
+
+#include "Light.h"
+#include "Yae/Common.h"
+#include "Yae/Util/Bounds.h"
+
+#include <vector>
+
+namespace yae::gfx
+{
+
+// Start and length of one cluster's run in the light index list, laid out like the shader's uint2
+struct cluster_range
+{
+    u32 offset{};
+    u32 count{};
+};
+
+/**
+ * \brief Assigns point lights to view space clusters: the screen is split into tiles, and every tile into depth
+ * slices that grow exponentially with distance.\n\n
+ * Built on the CPU every frame, the result is a range per cluster into one compact list of light indices, ready to be
+ * copied into shader buffers. Only the math library is used, so it runs without a device.
+ */
+class light_clusters
+{
+public:
+    light_clusters(u32 tiles_x = 16, u32 tiles_y = 9, u32 slices = 24);
+    ~light_clusters() = default;
+    DISABLE_COPY_AND_MOVE(light_clusters);
+
+    /**
+     * \brief Rebuilds the cluster volumes. build calls this itself whenever the projection changes
+     * \param projection Left handed perspective projection
+     */
+    void set_projection(const math::matrix& projection);
+
+    /**
+     * \brief Assigns every light to the clusters its sphere touches. Slices are built in parallel, each one testing
+     * a light against 4 tiles at a time
+     * \param view Camera view matrix
+     * \param projection Camera projection matrix
+     * \param lights World space lights
+     * \param count Number of lights
+     */
+    void build(const math::matrix& view, const math::matrix& projection, const packed_pointlight* lights, u32 count);
+
+    /**
+     * \brief One cluster at a time on the calling thread, kept as the reference build must match exactly
+     */
+    void build_scalar(const math::matrix& view, const math::matrix& projection, const packed_pointlight* lights, u32 count);
+
+    constexpr u32 tiles_x() const { return m_tiles_x; }
+    constexpr u32 tiles_y() const { return m_tiles_y; }
+    constexpr u32 slices() const { return m_slices; }
+    constexpr u32 cluster_count() const { return m_tiles_x * m_tiles_y * m_slices; }
+
+    constexpr u32 cluster_index(u32 x, u32 y, u32 slice) const { return (slice * m_tiles_y + y) * m_tiles_x + x; }
+
+    // The slice of a view space depth is <code>floor(log(z) * slice_scale + slice_bias)</code>
+    constexpr f32 slice_scale() const { return m_slice_scale; }
+    constexpr f32 slice_bias() const { return m_slice_bias; }
+    u32           slice(f32 view_z) const;
+
+    // Indexed by cluster_index
+    const std::vector<cluster_range>& ranges() const { return m_ranges; }
+    const std::vector<u32>&           indices() const { return m_indices; }
+
+    // Lights from the last build that are on screen. Lights behind the camera or outside the view are rejected before
+    // any cluster is tested
+    constexpr u32 visible_count() const { return m_visible_count; }
+
+    // Union of the visible lights' screen rectangles and depth ranges, only meaningful when visible_count isn't 0
+    constexpr const math::screen_bounds& footprint() const { return m_footprint; }
+
+private:
+    // Light in view space with its projected footprint and the slices and tiles it covers
+    struct view_light
+    {
+        math::vec3          position{};
+        f32                 radius_sq{};
+        math::screen_bounds bounds{};
+        u32                 first_slice{};
+        u32                 last_slice{};
+        u32                 first_x{};
+        u32                 last_x{};
+        u32                 first_y{};
+        u32                 last_y{};
+    };
+
+    // Per slice scratch, so slices can be built on different threads
+    struct slice_lists
+    {
+        std::vector<u32> hit_tiles{};
+        std::vector<u32> hit_lights{};
+        std::vector<u32> tile_offsets{};
+        std::vector<u32> indices{};
+    };
+
+    void prepare(const math::matrix& view, const math::matrix& projection, const packed_pointlight* lights, u32 count);
+    void assign_slice(u32 slice, bool batched);
+    void sort_slice(u32 slice);
+    void gather_slice(u32 slice);
+    void finish();
+
+    u32 m_tiles_x;
+    u32 m_tiles_y;
+    u32 m_slices;
+    u32 m_tile_stride; // Tiles per slice rounded up to a multiple of 4, the padding never passes the test
+
+    f32 m_x_scale{};
+    f32 m_y_scale{};
+    f32 m_near{};
+    f32 m_far{};
+    f32 m_slice_scale{};
+    f32 m_slice_bias{};
+
+    // View space bounds of every cluster, m_tile_stride per slice
+    std::vector<f32> m_min_x{};
+    std::vector<f32> m_max_x{};
+    std::vector<f32> m_min_y{};
+    std::vector<f32> m_max_y{};
+    std::vector<f32> m_slice_near{};
+    std::vector<f32> m_slice_far{};
+
+    std::vector<view_light>    m_lights{};
+    std::vector<slice_lists>   m_slice_lists{};
+    std::vector<u32>           m_slice_offsets{};
+    std::vector<cluster_range> m_ranges{};
+    std::vector<u32>           m_indices{};
+    u32                        m_visible_count{};
+    math::screen_bounds        m_footprint{};
+};
+
+} // namespace yae::gfx
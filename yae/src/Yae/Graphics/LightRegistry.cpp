@@ -0,0 +1,155 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: LightRegistry.cpp
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+
+#include "LightRegistry.h"
+
+namespace yae::gfx::lights
+{
+namespace
+{
+
+// Light parameters in SoA form. The slot map keeps its dense order in step with the arrays, both swap the last light
+// in when one is removed. [dirty_begin, dirty_end) is the range of dense indices the next pack has to rewrite
+struct pointlight_soa
+{
+    slot_map<u8, pointlight_component> slots{};
+
+    std::vector<math::vec3> positions{};
+    std::vector<math::vec3> colors{};
+    std::vector<f32>        radii{};
+    std::vector<f32>        intensities{};
+    std::vector<f32>        falloffs{};
+
+    std::vector<packed_pointlight> packed{};
+
+    u32 dirty_begin{ invalid_u32 };
+    u32 dirty_end{};
+
+    void mark_dirty(u32 index)
+    {
+        dirty_begin = std::min(dirty_begin, index);
+        dirty_end   = std::max(dirty_end, index + 1);
+    }
+
+    void resize(u32 size)
+    {
+        positions.resize(size);
+        colors.resize(size);
+        radii.resize(size);
+        intensities.resize(size);
+        falloffs.resize(size);
+        packed.resize(size);
+    }
+};
+
+pointlight_soa lights;
+
+} // anonymous namespace
+
+pointlight_handle add(const math::vec3& position, const math::vec3& color, f32 radius, f32 intensity, f32 falloff)
+{
+    const pointlight_handle h = lights.slots.emplace();
+    lights.resize(lights.slots.size());
+
+    const u32 index           = lights.slots.dense_index(h);
+    lights.positions[index]   = position;
+    lights.colors[index]      = color;
+    lights.radii[index]       = radius;
+    lights.intensities[index] = intensity;
+    lights.falloffs[index]    = falloff;
+    lights.mark_dirty(index);
+    return h;
+}
+
+void remove(pointlight_handle h)
+{
+    const u32 index = lights.slots.dense_index(h);
+    if (index == invalid_u32)
+    {
+        return;
+    }
+
+    const u32 last = lights.slots.size() - 1;
+    if (index != last)
+    {
+        lights.positions[index]   = lights.positions[last];
+        lights.colors[index]      = lights.colors[last];
+        lights.radii[index]       = lights.radii[last];
+        lights.intensities[index] = lights.intensities[last];
+        lights.falloffs[index]    = lights.falloffs[last];
+        lights.mark_dirty(index);
+    }
+
+    lights.slots.remove(h);
+    lights.resize(last);
+    lights.dirty_end = std::min(lights.dirty_end, last);
+}
+
+void set_position(pointlight_handle h, const math::vec3& position)
+{
+    if (const u32 index = lights.slots.dense_index(h); index != invalid_u32)
+    {
+        lights.positions[index] = position;
+        lights.mark_dirty(index);
+    }
+}
+
+void set_params(pointlight_handle h, const math::vec3& color, f32 radius, f32 intensity, f32 falloff)
+{
+    if (const u32 index = lights.slots.dense_index(h); index != invalid_u32)
+    {
+        lights.colors[index]      = color;
+        lights.radii[index]       = radius;
+        lights.intensities[index] = intensity;
+        lights.falloffs[index]    = falloff;
+        lights.mark_dirty(index);
+    }
+}
+
+void pack()
+{
+    for (u32 i = lights.dirty_begin; i < lights.dirty_end; ++i)
+    {
+        packed_pointlight& p = lights.packed[i];
+        p.position           = lights.positions[i];
+        p.radius             = lights.radii[i];
+        p.color              = lights.colors[i];
+        p.intensity          = lights.intensities[i];
+        p.falloff            = lights.falloffs[i];
+    }
+
+    lights.dirty_begin = invalid_u32;
+    lights.dirty_end   = 0;
+}
+
+const std::vector<packed_pointlight>& packed()
+{
+    return lights.packed;
+}
+
+u32 count()
+{
+    return lights.slots.size();
+}
+
+} // namespace yae::gfx::lights
@@ -0,0 +1,72 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: LightRegistry.h
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+
+#pragma once
+
+#include "Light.h"
+#include "Yae/Util/Handle.h"
+
+namespace yae
+{
+class pointlight_component;
+} // namespace yae
+
+namespace yae::gfx
+{
+
+using pointlight_handle = handle<pointlight_component>;
+
+namespace lights
+{
+
+/**
+ * \brief Registers a point light. Parameters and world positions are kept in dense arrays, removal swaps the last
+ * light into the hole
+ * \param position World position of the light
+ * \param color Light color
+ * \param radius Distance at which the light stops contributing
+ * \param intensity Brightness multiplier
+ * \param falloff Attenuation exponent
+ * \return Handle used to move, change and remove the light
+ */
+pointlight_handle add(const math::vec3& position, const math::vec3& color, f32 radius, f32 intensity, f32 falloff);
+
+// Stale handles are ignored
+void remove(pointlight_handle h);
+
+void set_position(pointlight_handle h, const math::vec3& position);
+void set_params(pointlight_handle h, const math::vec3& color, f32 radius, f32 intensity, f32 falloff);
+
+/**
+ * \brief Rebuilds the packed array for the lights that were added, moved or changed since the last call. Lights
+ * outside the dirty range are left as they are
+ */
+void pack();
+
+// Result of the last pack, in dense order
+const std::vector<packed_pointlight>& packed();
+
+u32 count();
+
+} // namespace lights
+} // namespace yae::gfx
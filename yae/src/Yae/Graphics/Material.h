@@ -29,6 +29,10 @@
 namespace yae::gfx
 {
 
+/**
+ * \brief Describes a material. Descriptions are registered with <code>materials::create</code>, which bakes them into
+ * an immutable material referenced by id
+ */
 struct material
 {
     ID3D11ShaderResourceView* diffuse{};
@@ -39,4 +43,10 @@ struct material
     ID3D11SamplerState*       sampler{};
 };
 
+// Index of a registered material, see MaterialRegistry.h
+using material_id = u32;
+
+// Default textures and sampler, always registered first
+constexpr material_id default_material = 0;
+
 } // namespace yae::gfx
\ No newline at end of file
@@ -0,0 +1,237 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: MaterialRegistry.cpp
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+#include "MaterialRegistry.h"
+
+#include "D3D11Core.h"
+#include "Shaders/ShaderLibrary.h"
+#include "StateCache.h"
+#include "Yae/Util/AssetManager.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+namespace yae::gfx::materials
+{
+
+namespace
+{
+// Fixed capacity so registered entries never move: the simulation may register materials while the render thread
+// reads earlier ones. An entry is written before its id is published, creation itself is serialized
+constexpr u32 max_materials = 4096;
+constexpr u32 max_blocks    = 1024;
+
+std::mutex                        create_mutex{};
+std::unique_ptr<material[]>       descs{};
+std::unique_ptr<u32[]>            block_indices{}; // Per material
+std::unique_ptr<material_block[]> blocks{};
+std::atomic<u32>                  material_count{};
+std::atomic<u32>                  block_total{};
+
+ref<texture>        default_diffuse{};
+ref<texture>        default_normal{};
+ID3D11SamplerState* default_sampler_state{};
+
+bool same_desc(const material& a, const material& b)
+{
+    return a.diffuse == b.diffuse && a.normal == b.normal && a.blend == b.blend && a.sampler == b.sampler &&
+           a.specular_power == b.specular_power && a.tint.x == b.tint.x && a.tint.y == b.tint.y && a.tint.z == b.tint.z &&
+           a.tint.w == b.tint.w;
+}
+
+bool same_block(const material_block& a, const material_block& b)
+{
+    return a.ps == b.ps && a.first_srv == b.first_srv && a.srv_count == b.srv_count &&
+           std::equal(a.srvs, a.srvs + a.srv_count, b.srvs) && a.sampler_slot == b.sampler_slot && a.sampler == b.sampler;
+}
+
+bool bake(const material& desc, material_block& blk)
+{
+    using namespace literals;
+
+    // Blend maps need the multitexture variant
+    blk.shader = desc.blend ? 1 : 0;
+    blk.ps     = desc.blend ? shaders::multitexture()->ps : shaders::deferred()->ps;
+
+    const std::pair<shader_slot, ID3D11ShaderResourceView*> textures[]{
+        { blk.ps->srv_slot("textureSRV"_param), desc.diffuse ? desc.diffuse : default_diffuse->texture_view() },
+        { blk.ps->srv_slot("textureSRVBump"_param), desc.normal ? desc.normal : default_normal->texture_view() },
+        { blk.ps->srv_slot("textureSRVBlend"_param), desc.blend },
+    };
+
+    u32 first = invalid_u32;
+    u32 end   = 0;
+    for (const auto& [slot, srv] : textures)
+    {
+        if (slot.is_valid() && srv)
+        {
+            first = std::min(first, slot.bind_index);
+            end   = std::max(end, slot.bind_index + 1);
+        }
+    }
+
+    if (first == invalid_u32 || end - first > max_material_srvs)
+    {
+        return false;
+    }
+
+    blk.first_srv = first;
+    blk.srv_count = end - first;
+    for (const auto& [slot, srv] : textures)
+    {
+        if (slot.is_valid() && srv)
+        {
+            blk.srvs[slot.bind_index - first] = srv;
+        }
+    }
+
+    blk.sampler_slot = blk.ps->sampler_slot("Sampler"_param).bind_index;
+    blk.sampler      = desc.sampler ? desc.sampler : default_sampler_state;
+    return true;
+}
+} // anonymous namespace
+
+bool init(ID3D11SamplerState* default_sampler)
+{
+    descs                 = std::make_unique<material[]>(max_materials);
+    block_indices         = std::make_unique<u32[]>(max_materials);
+    blocks                = std::make_unique<material_block[]>(max_blocks);
+    default_sampler_state = default_sampler;
+    default_diffuse       = assets::load_texture("./assets/textures/default.tga");
+    default_normal        = assets::load_texture("./assets/textures/default_normal.tga");
+    if (!default_diffuse || !default_normal)
+    {
+        LOG_ERROR("Failed to load the default material textures");
+        return false;
+    }
+
+    return create({}) == default_material;
+}
+
+void shutdown()
+{
+    material_count = 0;
+    block_total    = 0;
+    descs.reset();
+    block_indices.reset();
+    blocks.reset();
+    default_diffuse.reset();
+    default_normal.reset();
+    default_sampler_state = nullptr;
+}
+
+material_id create(const material& desc)
+{
+    std::lock_guard lock{ create_mutex };
+
+    const u32 count = material_count.load(std::memory_order_relaxed);
+    for (u32 i = 0; i < count; ++i)
+    {
+        if (same_desc(descs[i], desc))
+        {
+            return i;
+        }
+    }
+
+    if (count == max_materials)
+    {
+        LOG_ERROR("Material registry is full ({} materials), using the default material", max_materials);
+        return default_material;
+    }
+
+    material_block blk{};
+    if (!bake(desc, blk))
+    {
+        LOG_ERROR("Material textures don't fit its shader's slots, using the default material");
+        return default_material;
+    }
+
+    const u32 total = block_total.load(std::memory_order_relaxed);
+    u32       index = 0;
+    while (index < total && !same_block(blocks[index], blk))
+    {
+        ++index;
+    }
+
+    if (index == total)
+    {
+        if (total == max_blocks)
+        {
+            LOG_ERROR("Material registry is out of binding blocks ({}), using the default material", max_blocks);
+            return default_material;
+        }
+
+        blocks[total] = blk;
+        block_total.store(total + 1, std::memory_order_release);
+    }
+
+    descs[count]         = desc;
+    block_indices[count] = index;
+    material_count.store(count + 1, std::memory_order_release);
+    return count;
+}
+
+const material& desc(material_id id)
+{
+    assert(id < material_count.load(std::memory_order_acquire));
+    return descs[id];
+}
+
+const math::vec4& tint(material_id id)
+{
+    assert(id < material_count.load(std::memory_order_acquire));
+    return descs[id].tint;
+}
+
+u32 block_index(material_id id)
+{
+    assert(id < material_count.load(std::memory_order_acquire));
+    return block_indices[id];
+}
+
+const material_block& block(u32 index)
+{
+    assert(index < block_total.load(std::memory_order_acquire));
+    return blocks[index];
+}
+
+void bind(const material_block& blk)
+{
+    state::set_shader_resources(shader_stage::pixel, blk.first_srv, blk.srv_count, blk.srvs);
+    if (blk.sampler_slot != invalid_u32)
+    {
+        state::set_sampler(shader_stage::pixel, blk.sampler_slot, blk.sampler);
+    }
+}
+
+u32 count()
+{
+    return material_count.load(std::memory_order_acquire);
+}
+
+u32 block_count()
+{
+    return block_total.load(std::memory_order_acquire);
+}
+
+} // namespace yae::gfx::materials
@@ -0,0 +1,85 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: MaterialRegistry.h
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+
+#pragma once
+
+#include "Material.h"
+
+namespace yae::gfx
+{
+
+class pixel_shader;
+
+constexpr u32 max_material_srvs = 4;
+
+/**
+ * \brief Everything binding a material takes, resolved against its shader's reflection when the material is created.
+ * Missing maps are replaced by the default textures and the textures form one run of slots, set with a single call
+ */
+struct material_block
+{
+    pixel_shader*             ps{};
+    u32                       shader{}; // Shader variant, the sort key's shader field
+    u32                       first_srv{};
+    u32                       srv_count{};
+    ID3D11ShaderResourceView* srvs[max_material_srvs]{};
+    u32                       sampler_slot{ invalid_u32 };
+    ID3D11SamplerState*       sampler{};
+};
+
+namespace materials
+{
+
+/**
+ * \brief Loads the default textures and registers the default material. Needs the engine shaders
+ * \param default_sampler Sampler used by materials that don't set one
+ */
+bool init(ID3D11SamplerState* default_sampler);
+void shutdown();
+
+/**
+ * \brief Registers a material. A description equal to a registered one returns the existing id, and materials binding
+ * the same shader, textures and sampler share a binding block, so draws batch across them.\n\n
+ * Safe to call while the render thread draws with registered materials, entries never move once created. The registry
+ * holds a fixed number of materials and blocks
+ * \param desc The material's description
+ * \return The material's id, the default material if the description can't be bound by its shader
+ */
+material_id create(const material& desc);
+
+const material&   desc(material_id id);
+const math::vec4& tint(material_id id);
+
+// Index of the material's binding block. Sorting on it groups every material that binds the same state
+u32                   block_index(material_id id);
+const material_block& block(u32 index);
+
+// Sets the block's textures and sampler on the pixel stage, its shader is bound separately
+void bind(const material_block& block);
+
+u32 count();
+u32 block_count();
+
+} // namespace materials
+
+} // namespace yae::gfx
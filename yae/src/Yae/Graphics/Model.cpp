@@ -23,6 +23,7 @@
 #include "Model.h"
 
 #include "D3D11Core.h"
+#include "StateCache.h"
 #include "Shaders/Shader.h"
 
 #include <fstream>
@@ -88,6 +89,8 @@ model::model()
 
 bool model::init(const std::string_view filename)
 {
+    assert(core::owns_backend());
+
     m_stride = sizeof(vertex_pos_norm_tex_tang);
 
     std::vector<vertex_pos_norm_tex_tang> vertices = load_model(filename.data());
@@ -100,6 +103,7 @@ bool model::init(const std::string_view filename)
     m_index_count  = m_vertex_count;
 
     calculate_vectors(vertices);
+    calculate_bounds(&vertices.data()->position, m_vertex_count, m_stride);
 
     std::vector<u32> indices(m_index_count);
     for (u32 i = 0; i < m_index_count; ++i)
@@ -124,7 +128,7 @@ bool model::init(const std::string_view filename)
     vertex_data.SysMemPitch      = 0;
     vertex_data.SysMemSlicePitch = 0;
 
-    DX_CALL(core::get_device()->CreateBuffer(&vertex_buffer_desc, &vertex_data, &m_vertex_buffer));
+    DX_CALL(core::backend()->create_buffer(&vertex_buffer_desc, &vertex_data, &m_vertex_buffer));
 
     index_buffer_desc.Usage               = D3D11_USAGE_DEFAULT;
     index_buffer_desc.ByteWidth           = sizeof(u32) * m_index_count;
@@ -137,7 +141,7 @@ bool model::init(const std::string_view filename)
     index_data.SysMemPitch      = 0;
     index_data.SysMemSlicePitch = 0;
 
-    DX_CALL(core::get_device()->CreateBuffer(&index_buffer_desc, &index_data, &m_index_buffer));
+    DX_CALL(core::backend()->create_buffer(&index_buffer_desc, &index_data, &m_index_buffer));
 
     return true;
 }
@@ -151,13 +155,42 @@ void model::shutdown()
 
 void model::bind() const
 {
-    constexpr u32 offset = 0;
-    core::get_device_context()->IASetVertexBuffers(0, 1, &m_vertex_buffer, &m_stride, &offset);
-    core::get_device_context()->IASetIndexBuffer(m_index_buffer, DXGI_FORMAT_R32_UINT, 0);
-    core::get_device_context()->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    state::set_vertex_buffer(0, m_vertex_buffer, m_stride, 0);
+    state::set_index_buffer(m_index_buffer, DXGI_FORMAT_R32_UINT);
+    state::set_topology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 }
 
 
+void model::calculate_bounds(const math::vec3* first_position, u32 count, u32 stride)
+{
+    const u8* data = reinterpret_cast<const u8*>(first_position);
+
+    const auto position = [data, stride](u32 i) { return XMLoadFloat3(reinterpret_cast<const math::vec3*>(data + i * stride)); };
+
+    math::vector min = position(0);
+    math::vector max = min;
+    for (u32 i = 1; i < count; ++i)
+    {
+        const math::vector p = position(i);
+        min                  = XMVectorMin(min, p);
+        max                  = XMVectorMax(max, p);
+    }
+
+    XMStoreFloat3(&m_bounds.min, min);
+    XMStoreFloat3(&m_bounds.max, max);
+
+    // Centered on the box, which is close enough to the minimal sphere for culling
+    const math::vector center    = XMVectorScale(XMVectorAdd(min, max), .5f);
+    math::vector       radius_sq = XMVectorZero();
+    for (u32 i = 0; i < count; ++i)
+    {
+        radius_sq = XMVectorMax(radius_sq, XMVector3LengthSq(XMVectorSubtract(position(i), center)));
+    }
+
+    XMStoreFloat3(&m_sphere.center, center);
+    m_sphere.radius = XMVectorGetX(XMVectorSqrt(radius_sq));
+}
+
 void model::calculate_vectors(std::vector<vertex_pos_norm_tex_tang>& vertices)
 {
     const u32                      face_count = m_vertex_count / 3;
@@ -26,6 +26,7 @@
 #include "D3D11Common.h"
 #include "D3D11Core.h"
 #include "Vertex.h"
+#include "Yae/Util/Bounds.h"
 
 
 template<typename T>
@@ -44,6 +45,8 @@ public:
     template<vertex_type VertexType>
     bool init(std::vector<VertexType>& vertices, const std::vector<u32> indices)
     {
+        assert(core::owns_backend());
+
         m_stride       = sizeof(VertexType);
         m_vertex_count = (u32) vertices.size();
         m_index_count  = (u32) indices.size();
@@ -53,6 +56,11 @@ public:
             calculate_vectors(vertices);
         }
 
+        if (!vertices.empty())
+        {
+            calculate_bounds(&vertices.data()->position, m_vertex_count, sizeof(VertexType));
+        }
+
         D3D11_BUFFER_DESC      vertex_buffer_desc{};
         D3D11_BUFFER_DESC      index_buffer_desc{};
         D3D11_SUBRESOURCE_DATA vertex_data{};
@@ -70,7 +78,7 @@ public:
         vertex_data.SysMemPitch      = 0;
         vertex_data.SysMemSlicePitch = 0;
 
-        DX_CALL(core::get_device()->CreateBuffer(&vertex_buffer_desc, &vertex_data, &m_vertex_buffer));
+        DX_CALL(core::backend()->create_buffer(&vertex_buffer_desc, &vertex_data, &m_vertex_buffer));
 
         index_buffer_desc.Usage               = D3D11_USAGE_DEFAULT;
         index_buffer_desc.ByteWidth           = sizeof(u32) * m_index_count;
@@ -83,7 +91,7 @@ public:
         index_data.SysMemPitch      = 0;
         index_data.SysMemSlicePitch = 0;
 
-        DX_CALL(core::get_device()->CreateBuffer(&index_buffer_desc, &index_data, &m_index_buffer));
+        DX_CALL(core::backend()->create_buffer(&index_buffer_desc, &index_data, &m_index_buffer));
 
         return true;
     }
@@ -96,7 +104,21 @@ public:
 
     constexpr u32 index_count() const { return m_index_count; }
 
+    // Object space bounds, computed from the vertices when the model is created
+    constexpr const math::aabb&   bounds() const { return m_bounds; }
+    constexpr const math::sphere& bounding_sphere() const { return m_sphere; }
+
+    math::aabb   world_bounds(const math::matrix& world) const { return math::transform_aabb(m_bounds, world); }
+    math::sphere world_sphere(const math::matrix& world) const { return math::transform_sphere(m_sphere, world); }
+
 private:
+    /**
+     * \brief Computes the box and sphere from the vertex positions, reading them straight out of the vertex array
+     * \param first_position Position of the first vertex
+     * \param count Number of vertices
+     * \param stride Bytes between two positions
+     */
+    void calculate_bounds(const math::vec3* first_position, u32 count, u32 stride);
     void calculate_vectors(std::vector<vertex_pos_norm_tex_tang>& vertices);
     void calculate_tangents(const vertex_position_normal_texture& vtx1, const vertex_position_normal_texture& vtx2,
                             const vertex_position_normal_texture& vtx3, math::vec3& tangent, math::vec3& binormal);
@@ -106,6 +128,8 @@ private:
     u32           m_vertex_count{};
     u32           m_index_count{};
     u32           m_stride{};
+    math::aabb    m_bounds{};
+    math::sphere  m_sphere{};
 };
 
 
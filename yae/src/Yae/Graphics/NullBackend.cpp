@@ -0,0 +1,517 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: NullBackend.cpp
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+#include "NullBackend.h"
+#include "NullObjects.h"
+#include "CommandRecorder.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace yae::gfx
+{
+
+namespace
+{
+
+// Command lists are recorded on job threads
+std::atomic<u32> live_object_count{};
+std::atomic<u64> live_byte_count{};
+
+} // anonymous namespace
+
+namespace null_objects
+{
+
+void track(i32 objects, i64 bytes)
+{
+    live_object_count += objects;
+    live_byte_count += bytes;
+}
+
+u32 bytes_per_pixel(DXGI_FORMAT format)
+{
+    switch (format)
+    {
+    case DXGI_FORMAT_R32G32B32A32_FLOAT:
+    case DXGI_FORMAT_R32G32B32A32_UINT:
+    case DXGI_FORMAT_R32G32B32A32_SINT: return 16;
+    case DXGI_FORMAT_R32G32B32_FLOAT: return 12;
+    case DXGI_FORMAT_R16G16B16A16_FLOAT:
+    case DXGI_FORMAT_R32G32_FLOAT: return 8;
+    case DXGI_FORMAT_R8_UNORM: return 1;
+    case DXGI_FORMAT_R16_FLOAT:
+    case DXGI_FORMAT_R8G8_UNORM: return 2;
+    default: return 4;
+    }
+}
+
+} // namespace null_objects
+
+null_backend::null_backend(u32 width, u32 height)
+{
+    D3D11_TEXTURE2D_DESC desc{};
+    desc.Width            = width;
+    desc.Height           = height;
+    desc.MipLevels        = 1;
+    desc.ArraySize        = 1;
+    desc.Format           = DXGI_FORMAT_R8G8B8A8_UNORM;
+    desc.SampleDesc.Count = 1;
+    desc.Usage            = D3D11_USAGE_DEFAULT;
+    desc.BindFlags        = D3D11_BIND_RENDER_TARGET;
+    create_texture2d(&desc, nullptr, &m_back_buffer);
+    m_frame.reset();
+}
+
+null_backend::~null_backend()
+{
+    if (m_back_buffer)
+    {
+        m_back_buffer->Release();
+    }
+
+    if (live_object_count)
+    {
+        LOG_WARN("Null backend shut down with {} objects ({} bytes) still alive", live_object_count.load(),
+                 live_byte_count.load());
+    }
+}
+
+u32 null_backend::live_objects()
+{
+    return live_object_count;
+}
+
+u64 null_backend::live_bytes()
+{
+    return live_byte_count;
+}
+
+null_frame_stats null_backend::frame_counters::snapshot() const
+{
+    null_frame_stats stats{};
+    stats.calls          = calls.load(std::memory_order_relaxed);
+    stats.creates        = creates.load(std::memory_order_relaxed);
+    stats.binds          = binds.load(std::memory_order_relaxed);
+    stats.maps           = maps.load(std::memory_order_relaxed);
+    stats.draws          = draws.load(std::memory_order_relaxed);
+    stats.vertices       = vertices.load(std::memory_order_relaxed);
+    stats.bytes_uploaded = bytes_uploaded.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void null_backend::frame_counters::reset()
+{
+    calls          = 0;
+    creates        = 0;
+    binds          = 0;
+    maps           = 0;
+    draws          = 0;
+    vertices       = 0;
+    bytes_uploaded = 0;
+}
+
+void null_backend::count_create()
+{
+    ++m_frame.calls;
+    ++m_frame.creates;
+}
+
+void null_backend::count_bind()
+{
+    ++m_frame.calls;
+    ++m_frame.binds;
+}
+
+HRESULT null_backend::create_buffer(const D3D11_BUFFER_DESC* desc, const D3D11_SUBRESOURCE_DATA* data, ID3D11Buffer** buffer)
+{
+    count_create();
+    if (data)
+    {
+        m_frame.bytes_uploaded += desc->ByteWidth;
+    }
+
+    *buffer = new null_buffer{ *desc, desc->ByteWidth, desc->ByteWidth };
+    return S_OK;
+}
+
+HRESULT null_backend::create_texture2d(const D3D11_TEXTURE2D_DESC* desc, const D3D11_SUBRESOURCE_DATA* data,
+                                       ID3D11Texture2D** texture)
+{
+    count_create();
+
+    const u32 row_pitch = desc->Width * null_objects::bytes_per_pixel(desc->Format);
+    u64       bytes     = (u64) row_pitch * desc->Height * std::max(desc->ArraySize, 1u);
+    if (desc->MipLevels != 1)
+    {
+        bytes += bytes / 3; // A full chain adds a third
+    }
+
+    if (data)
+    {
+        m_frame.bytes_uploaded += (u64) row_pitch * desc->Height;
+    }
+
+    *texture = new null_texture2d{ *desc, bytes, row_pitch };
+    return S_OK;
+}
+
+HRESULT null_backend::create_shader_resource_view(ID3D11Resource* resource, const D3D11_SHADER_RESOURCE_VIEW_DESC* desc,
+                                                  ID3D11ShaderResourceView** view)
+{
+    count_create();
+    *view = new null_shader_resource_view{ resource, desc };
+    return S_OK;
+}
+
+HRESULT null_backend::create_render_target_view(ID3D11Resource* resource, const D3D11_RENDER_TARGET_VIEW_DESC* desc,
+                                                ID3D11RenderTargetView** view)
+{
+    count_create();
+    *view = new null_render_target_view{ resource, desc };
+    return S_OK;
+}
+
+HRESULT null_backend::create_depth_stencil_view(ID3D11Resource* resource, const D3D11_DEPTH_STENCIL_VIEW_DESC* desc,
+                                                ID3D11DepthStencilView** view)
+{
+    count_create();
+    *view = new null_depth_stencil_view{ resource, desc };
+    return S_OK;
+}
+
+HRESULT null_backend::create_input_layout(const D3D11_INPUT_ELEMENT_DESC*, u32, const void*, size_t, ID3D11InputLayout** layout)
+{
+    count_create();
+    *layout = new null_object<ID3D11InputLayout>{};
+    return S_OK;
+}
+
+HRESULT null_backend::create_vertex_shader(const void*, size_t, ID3D11VertexShader** shader)
+{
+    count_create();
+    *shader = new null_object<ID3D11VertexShader>{};
+    return S_OK;
+}
+
+HRESULT null_backend::create_pixel_shader(const void*, size_t, ID3D11PixelShader** shader)
+{
+    count_create();
+    *shader = new null_object<ID3D11PixelShader>{};
+    return S_OK;
+}
+
+HRESULT null_backend::create_hull_shader(const void*, size_t, ID3D11HullShader** shader)
+{
+    count_create();
+    *shader = new null_object<ID3D11HullShader>{};
+    return S_OK;
+}
+
+HRESULT null_backend::create_domain_shader(const void*, size_t, ID3D11DomainShader** shader)
+{
+    count_create();
+    *shader = new null_object<ID3D11DomainShader>{};
+    return S_OK;
+}
+
+HRESULT null_backend::create_geometry_shader(const void*, size_t, ID3D11GeometryShader** shader)
+{
+    count_create();
+    *shader = new null_object<ID3D11GeometryShader>{};
+    return S_OK;
+}
+
+HRESULT null_backend::create_geometry_shader_with_stream_output(const void*, size_t, const D3D11_SO_DECLARATION_ENTRY*, u32, u32,
+                                                                ID3D11GeometryShader** shader)
+{
+    count_create();
+    *shader = new null_object<ID3D11GeometryShader>{};
+    return S_OK;
+}
+
+HRESULT null_backend::create_compute_shader(const void*, size_t, ID3D11ComputeShader** shader)
+{
+    count_create();
+    *shader = new null_object<ID3D11ComputeShader>{};
+    return S_OK;
+}
+
+HRESULT null_backend::create_sampler_state(const D3D11_SAMPLER_DESC* desc, ID3D11SamplerState** state)
+{
+    count_create();
+    *state = new null_sampler_state{ *desc };
+    return S_OK;
+}
+
+HRESULT null_backend::create_blend_state(const D3D11_BLEND_DESC* desc, ID3D11BlendState** state)
+{
+    count_create();
+    *state = new null_blend_state{ *desc };
+    return S_OK;
+}
+
+HRESULT null_backend::create_depth_stencil_state(const D3D11_DEPTH_STENCIL_DESC* desc, ID3D11DepthStencilState** state)
+{
+    count_create();
+    *state = new null_depth_stencil_state{ *desc };
+    return S_OK;
+}
+
+HRESULT null_backend::create_rasterizer_state(const D3D11_RASTERIZER_DESC* desc, ID3D11RasterizerState** state)
+{
+    count_create();
+    *state = new null_rasterizer_state{ *desc };
+    return S_OK;
+}
+
+HRESULT null_backend::map(ID3D11Resource* resource, u32, D3D11_MAP, D3D11_MAPPED_SUBRESOURCE* mapped)
+{
+    ++m_frame.calls;
+    ++m_frame.maps;
+
+    if (is_null_buffer(resource))
+    {
+        null_buffer* buffer = as_null_buffer(resource);
+        mapped->pData       = buffer->memory();
+        mapped->RowPitch    = buffer->row_pitch();
+        mapped->DepthPitch  = buffer->row_pitch();
+    } else
+    {
+        null_texture2d* texture = as_null_texture2d(resource);
+        mapped->pData           = texture->memory();
+        mapped->RowPitch        = texture->row_pitch();
+        mapped->DepthPitch      = (u32) texture->bytes();
+    }
+    return S_OK;
+}
+
+void null_backend::unmap(ID3D11Resource*, u32)
+{
+    ++m_frame.calls;
+}
+
+void null_backend::update_subresource(ID3D11Resource* resource, u32, const void*, u32 row_pitch, u32 depth_pitch)
+{
+    ++m_frame.calls;
+
+    if (is_null_buffer(resource))
+    {
+        m_frame.bytes_uploaded += as_null_buffer(resource)->bytes();
+    } else
+    {
+        D3D11_TEXTURE2D_DESC desc{};
+        as_null_texture2d(resource)->GetDesc(&desc);
+        m_frame.bytes_uploaded += depth_pitch ? depth_pitch : (u64) row_pitch * desc.Height;
+    }
+}
+
+void null_backend::generate_mips(ID3D11ShaderResourceView*)
+{
+    ++m_frame.calls;
+}
+
+void null_backend::set_input_layout(ID3D11InputLayout*)
+{
+    count_bind();
+}
+
+void null_backend::set_vertex_buffers(u32, u32, ID3D11Buffer* const*, const u32*, const u32*)
+{
+    count_bind();
+}
+
+void null_backend::set_index_buffer(ID3D11Buffer*, DXGI_FORMAT, u32)
+{
+    count_bind();
+}
+
+void null_backend::set_topology(D3D11_PRIMITIVE_TOPOLOGY)
+{
+    count_bind();
+}
+
+void null_backend::set_vertex_shader(ID3D11VertexShader*)
+{
+    count_bind();
+}
+
+void null_backend::set_pixel_shader(ID3D11PixelShader*)
+{
+    count_bind();
+}
+
+void null_backend::set_hull_shader(ID3D11HullShader*)
+{
+    count_bind();
+}
+
+void null_backend::set_domain_shader(ID3D11DomainShader*)
+{
+    count_bind();
+}
+
+void null_backend::set_geometry_shader(ID3D11GeometryShader*)
+{
+    count_bind();
+}
+
+void null_backend::set_compute_shader(ID3D11ComputeShader*)
+{
+    count_bind();
+}
+
+void null_backend::set_constant_buffers(shader_stage, u32, u32, ID3D11Buffer* const*)
+{
+    count_bind();
+}
+
+void null_backend::set_constant_buffer_ranges(shader_stage, u32, u32, ID3D11Buffer* const*, const u32*, const u32*)
+{
+    count_bind();
+}
+
+void null_backend::set_shader_resources(shader_stage, u32, u32, ID3D11ShaderResourceView* const*)
+{
+    count_bind();
+}
+
+void null_backend::set_samplers(shader_stage, u32, u32, ID3D11SamplerState* const*)
+{
+    count_bind();
+}
+
+void null_backend::set_unordered_access_views(u32, u32, ID3D11UnorderedAccessView* const*, const u32*)
+{
+    count_bind();
+}
+
+void null_backend::set_stream_output_targets(u32, ID3D11Buffer* const*, const u32*)
+{
+    count_bind();
+}
+
+void null_backend::set_rasterizer_state(ID3D11RasterizerState*)
+{
+    count_bind();
+}
+
+void null_backend::set_viewports(u32, const D3D11_VIEWPORT*)
+{
+    count_bind();
+}
+
+void null_backend::set_scissor_rects(u32, const D3D11_RECT*)
+{
+    count_bind();
+}
+
+void null_backend::set_blend_state(ID3D11BlendState*, const f32[4], u32)
+{
+    count_bind();
+}
+
+void null_backend::set_depth_stencil_state(ID3D11DepthStencilState*, u32)
+{
+    count_bind();
+}
+
+void null_backend::set_render_targets(u32, ID3D11RenderTargetView* const*, ID3D11DepthStencilView*)
+{
+    count_bind();
+}
+
+void null_backend::clear_render_target(ID3D11RenderTargetView*, const f32[4])
+{
+    ++m_frame.calls;
+}
+
+void null_backend::clear_depth_stencil(ID3D11DepthStencilView*, u32, f32, u8)
+{
+    ++m_frame.calls;
+}
+
+void null_backend::draw(u32 vertex_count, u32)
+{
+    ++m_frame.calls;
+    ++m_frame.draws;
+    m_frame.vertices += vertex_count;
+}
+
+void null_backend::draw_indexed(u32 index_count, u32, i32)
+{
+    ++m_frame.calls;
+    ++m_frame.draws;
+    m_frame.vertices += index_count;
+}
+
+void null_backend::draw_indexed_instanced(u32 index_count, u32 instance_count, u32, i32, u32)
+{
+    ++m_frame.calls;
+    ++m_frame.draws;
+    m_frame.vertices += (u64) index_count * instance_count;
+}
+
+void null_backend::dispatch(u32, u32, u32)
+{
+    ++m_frame.calls;
+    ++m_frame.draws;
+}
+
+HRESULT null_backend::back_buffer(ID3D11Texture2D** texture)
+{
+    m_back_buffer->AddRef();
+    *texture = m_back_buffer;
+    return S_OK;
+}
+
+void null_backend::present(bool)
+{
+    ++m_frame.calls;
+    m_previous = m_frame.snapshot();
+    m_frame.reset();
+    ++m_frames;
+}
+
+void null_backend::set_fullscreen(bool)
+{
+    ++m_frame.calls;
+}
+
+render_backend* null_backend::create_recorder()
+{
+    return new command_recorder{ this };
+}
+
+HRESULT null_backend::finish_command_list(ID3D11CommandList**)
+{
+    return DXGI_ERROR_INVALID_CALL;
+}
+
+void null_backend::execute_command_list(ID3D11CommandList* list)
+{
+    ++m_frame.calls;
+    static_cast<recorded_command_list*>(list)->execute(*this);
+    reset_state();
+}
+
+} // namespace yae::gfx
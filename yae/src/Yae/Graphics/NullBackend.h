@@ -0,0 +1,177 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: NullBackend.h
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+
+#pragma once
+
+#include "Backend.h"
+
+#include <atomic>
+
+namespace yae::gfx
+{
+
+struct null_frame_stats
+{
+    u32 calls{};          // Every call made to the backend
+    u32 creates{};        // Resources, views, shaders and states created
+    u32 binds{};          // Calls setting pipeline state
+    u32 maps{};           // Map calls, what was written is counted by the caller's own upload stats
+    u32 draws{};          // Draw and dispatch calls
+    u64 vertices{};       // Vertices and indices drawn, instances included
+    u64 bytes_uploaded{}; // Initial data and update_subresource
+};
+
+/**
+ * \brief Accepts every call and renders nothing, so whole frames run without a GPU or a swap chain.\n\n
+ * Created objects are stand-ins that keep their descriptions and the bytes they would occupy, mapping one hands out
+ * memory owned by the object. Calls are counted per frame, present ends the frame. The software backend builds on it
+ */
+class null_backend : public render_backend
+{
+public:
+    null_backend(u32 width, u32 height);
+    ~null_backend() override;
+    DISABLE_COPY_AND_MOVE(null_backend);
+
+    null_frame_stats        current() const { return m_frame.snapshot(); }
+    const null_frame_stats& last_frame() const { return m_previous; }
+    u32                     frames_presented() const { return m_frames; }
+
+    // Objects created by any null backend that haven't been released yet, and the memory their resources describe
+    static u32 live_objects();
+    static u64 live_bytes();
+
+    backend_type type() const override { return backend_type::null; }
+
+    HRESULT create_buffer(const D3D11_BUFFER_DESC* desc, const D3D11_SUBRESOURCE_DATA* data, ID3D11Buffer** buffer) override;
+    HRESULT create_texture2d(const D3D11_TEXTURE2D_DESC* desc, const D3D11_SUBRESOURCE_DATA* data,
+                             ID3D11Texture2D** texture) override;
+    HRESULT create_shader_resource_view(ID3D11Resource* resource, const D3D11_SHADER_RESOURCE_VIEW_DESC* desc,
+                                        ID3D11ShaderResourceView** view) override;
+    HRESULT create_render_target_view(ID3D11Resource* resource, const D3D11_RENDER_TARGET_VIEW_DESC* desc,
+                                      ID3D11RenderTargetView** view) override;
+    HRESULT create_depth_stencil_view(ID3D11Resource* resource, const D3D11_DEPTH_STENCIL_VIEW_DESC* desc,
+                                      ID3D11DepthStencilView** view) override;
+
+    HRESULT create_input_layout(const D3D11_INPUT_ELEMENT_DESC* elements, u32 count, const void* bytecode, size_t size,
+                                ID3D11InputLayout** layout) override;
+    HRESULT create_vertex_shader(const void* bytecode, size_t size, ID3D11VertexShader** shader) override;
+    HRESULT create_pixel_shader(const void* bytecode, size_t size, ID3D11PixelShader** shader) override;
+    HRESULT create_hull_shader(const void* bytecode, size_t size, ID3D11HullShader** shader) override;
+    HRESULT create_domain_shader(const void* bytecode, size_t size, ID3D11DomainShader** shader) override;
+    HRESULT create_geometry_shader(const void* bytecode, size_t size, ID3D11GeometryShader** shader) override;
+    HRESULT create_geometry_shader_with_stream_output(const void* bytecode, size_t size,
+                                                      const D3D11_SO_DECLARATION_ENTRY* entries, u32 entry_count,
+                                                      u32 rasterized_stream, ID3D11GeometryShader** shader) override;
+    HRESULT create_compute_shader(const void* bytecode, size_t size, ID3D11ComputeShader** shader) override;
+
+    HRESULT create_sampler_state(const D3D11_SAMPLER_DESC* desc, ID3D11SamplerState** state) override;
+    HRESULT create_blend_state(const D3D11_BLEND_DESC* desc, ID3D11BlendState** state) override;
+    HRESULT create_depth_stencil_state(const D3D11_DEPTH_STENCIL_DESC* desc, ID3D11DepthStencilState** state) override;
+    HRESULT create_rasterizer_state(const D3D11_RASTERIZER_DESC* desc, ID3D11RasterizerState** state) override;
+
+    // Offsets are accepted like everything else, so the constant ring runs the same way it does on hardware
+    bool supports_constant_offsets() const override { return true; }
+
+    HRESULT map(ID3D11Resource* resource, u32 subresource, D3D11_MAP type, D3D11_MAPPED_SUBRESOURCE* mapped) override;
+    void    unmap(ID3D11Resource* resource, u32 subresource) override;
+    void    update_subresource(ID3D11Resource* resource, u32 subresource, const void* data, u32 row_pitch,
+                               u32 depth_pitch) override;
+    void    generate_mips(ID3D11ShaderResourceView* view) override;
+
+    void set_input_layout(ID3D11InputLayout* layout) override;
+    void set_vertex_buffers(u32 slot, u32 count, ID3D11Buffer* const* buffers, const u32* strides, const u32* offsets) override;
+    void set_index_buffer(ID3D11Buffer* buffer, DXGI_FORMAT format, u32 offset) override;
+    void set_topology(D3D11_PRIMITIVE_TOPOLOGY topology) override;
+
+    void set_vertex_shader(ID3D11VertexShader* shader) override;
+    void set_pixel_shader(ID3D11PixelShader* shader) override;
+    void set_hull_shader(ID3D11HullShader* shader) override;
+    void set_domain_shader(ID3D11DomainShader* shader) override;
+    void set_geometry_shader(ID3D11GeometryShader* shader) override;
+    void set_compute_shader(ID3D11ComputeShader* shader) override;
+
+    void set_constant_buffers(shader_stage stage, u32 slot, u32 count, ID3D11Buffer* const* buffers) override;
+    void set_constant_buffer_ranges(shader_stage stage, u32 slot, u32 count, ID3D11Buffer* const* buffers,
+                                    const u32* first_constants, const u32* constant_counts) override;
+    void set_shader_resources(shader_stage stage, u32 slot, u32 count, ID3D11ShaderResourceView* const* views) override;
+    void set_samplers(shader_stage stage, u32 slot, u32 count, ID3D11SamplerState* const* samplers) override;
+
+    void set_unordered_access_views(u32 slot, u32 count, ID3D11UnorderedAccessView* const* views,
+                                    const u32* initial_counts) override;
+    void set_stream_output_targets(u32 count, ID3D11Buffer* const* buffers, const u32* offsets) override;
+
+    void set_rasterizer_state(ID3D11RasterizerState* state) override;
+    void set_viewports(u32 count, const D3D11_VIEWPORT* viewports) override;
+    void set_scissor_rects(u32 count, const D3D11_RECT* rects) override;
+    void set_blend_state(ID3D11BlendState* state, const f32 factor[4], u32 sample_mask) override;
+    void set_depth_stencil_state(ID3D11DepthStencilState* state, u32 stencil_ref) override;
+    void set_render_targets(u32 count, ID3D11RenderTargetView* const* views, ID3D11DepthStencilView* depth) override;
+
+    void clear_render_target(ID3D11RenderTargetView* view, const f32 color[4]) override;
+    void clear_depth_stencil(ID3D11DepthStencilView* view, u32 flags, f32 depth, u8 stencil) override;
+
+    void draw(u32 vertex_count, u32 first_vertex) override;
+    void draw_indexed(u32 index_count, u32 first_index, i32 base_vertex) override;
+    void draw_indexed_instanced(u32 index_count, u32 instance_count, u32 first_index, i32 base_vertex,
+                                u32 first_instance) override;
+    void dispatch(u32 groups_x, u32 groups_y, u32 groups_z) override;
+
+    HRESULT back_buffer(ID3D11Texture2D** texture) override;
+    void    present(bool vsync) override;
+    void    set_fullscreen(bool fullscreen) override;
+
+    // Recorders store calls in a recorded_command_list, executing one replays them on this backend
+    render_backend* create_recorder() override;
+    HRESULT         finish_command_list(ID3D11CommandList** list) override;
+    void            execute_command_list(ID3D11CommandList* list) override;
+
+protected:
+    void count_create();
+    void count_bind();
+
+    // Back to the default pipeline state, after a command list has executed
+    virtual void reset_state() {}
+
+    // The frame's null_frame_stats. Recorders create objects through their parent from job threads, so they are atomic
+    struct frame_counters
+    {
+        std::atomic<u32> calls{};
+        std::atomic<u32> creates{};
+        std::atomic<u32> binds{};
+        std::atomic<u32> maps{};
+        std::atomic<u32> draws{};
+        std::atomic<u64> vertices{};
+        std::atomic<u64> bytes_uploaded{};
+
+        null_frame_stats snapshot() const;
+        void             reset();
+    };
+
+    ID3D11Texture2D* m_back_buffer{};
+    frame_counters   m_frame{};
+    null_frame_stats m_previous{};
+    u32              m_frames{};
+};
+
+} // namespace yae::gfx
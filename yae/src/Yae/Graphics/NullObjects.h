@@ -0,0 +1,257 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: NullObjects.h
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+
+#pragma once
+
+#include "D3D11Common.h"
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+namespace yae::gfx
+{
+
+namespace null_objects
+{
+// Adjusts the totals reported by null_backend::live_objects() and live_bytes()
+void track(i32 objects, i64 bytes);
+
+u32 bytes_per_pixel(DXGI_FORMAT format);
+} // namespace null_objects
+
+/**
+ * \brief IUnknown and ID3D11DeviceChild for every object the null backend hands out. Debug names set through
+ * <code>WKPDID_D3DDebugObjectName</code> are kept, other private data is dropped. Reference counting is atomic, so
+ * objects may be created and released on any thread, the rest of the object is not thread safe
+ */
+template<typename Interface>
+class null_child : public Interface
+{
+public:
+    null_child() { null_objects::track(1, 0); }
+    virtual ~null_child() { null_objects::track(-1, 0); }
+
+    HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** object) override
+    {
+        if (!object)
+        {
+            return E_POINTER;
+        }
+
+        if (riid == __uuidof(Interface) || riid == __uuidof(IUnknown) || riid == __uuidof(ID3D11DeviceChild) || is_a(riid))
+        {
+            *object = static_cast<Interface*>(this);
+            AddRef();
+            return S_OK;
+        }
+
+        *object = nullptr;
+        return E_NOINTERFACE;
+    }
+
+    ULONG STDMETHODCALLTYPE AddRef() override { return m_refs.fetch_add(1, std::memory_order_relaxed) + 1; }
+
+    ULONG STDMETHODCALLTYPE Release() override
+    {
+        // Whoever drops the last reference sees every write made through the others before deleting
+        const ULONG refs = m_refs.fetch_sub(1, std::memory_order_acq_rel) - 1;
+        if (refs == 0)
+        {
+            delete this;
+        }
+        return refs;
+    }
+
+    void STDMETHODCALLTYPE GetDevice(ID3D11Device** device) override { *device = nullptr; }
+
+    HRESULT STDMETHODCALLTYPE GetPrivateData(REFGUID guid, UINT* size, void* data) override
+    {
+        if (!size)
+        {
+            return E_INVALIDARG;
+        }
+
+        if (guid != WKPDID_D3DDebugObjectName || m_name.empty())
+        {
+            *size = 0;
+            return DXGI_ERROR_NOT_FOUND;
+        }
+
+        if (data)
+        {
+            if (*size < (UINT) m_name.size())
+            {
+                return DXGI_ERROR_MORE_DATA;
+            }
+            memcpy(data, m_name.data(), m_name.size());
+        }
+        *size = (UINT) m_name.size();
+        return S_OK;
+    }
+
+    HRESULT STDMETHODCALLTYPE SetPrivateData(REFGUID guid, UINT size, const void* data) override
+    {
+        if (guid == WKPDID_D3DDebugObjectName)
+        {
+            m_name.assign((const char*) data, data ? size : 0);
+        }
+        return S_OK;
+    }
+
+    HRESULT STDMETHODCALLTYPE SetPrivateDataInterface(REFGUID, const IUnknown*) override { return S_OK; }
+
+    const std::string& name() const { return m_name; }
+
+protected:
+    // Intermediate interfaces between ID3D11DeviceChild and Interface
+    virtual bool is_a(REFIID) const { return false; }
+
+private:
+    std::atomic<ULONG> m_refs{ 1 };
+    std::string        m_name{};
+};
+
+// Buffers and textures. Memory for map and for backends that keep contents is only allocated on first use
+template<typename Interface, typename Desc, D3D11_RESOURCE_DIMENSION Dimension>
+class null_resource final : public null_child<Interface>
+{
+public:
+    null_resource(const Desc& desc, u64 bytes, u32 row_pitch) : m_desc{ desc }, m_bytes{ bytes }, m_row_pitch{ row_pitch }
+    {
+        null_objects::track(0, (i64) m_bytes);
+    }
+    ~null_resource() override { null_objects::track(0, -(i64) m_bytes); }
+
+    void STDMETHODCALLTYPE GetType(D3D11_RESOURCE_DIMENSION* dimension) override { *dimension = Dimension; }
+    void STDMETHODCALLTYPE SetEvictionPriority(UINT) override {}
+    UINT STDMETHODCALLTYPE GetEvictionPriority() override { return 0; }
+    void STDMETHODCALLTYPE GetDesc(Desc* desc) override { *desc = m_desc; }
+
+    constexpr const Desc& desc() const { return m_desc; }
+    constexpr u64         bytes() const { return m_bytes; }
+    constexpr u32         row_pitch() const { return m_row_pitch; }
+
+    u8* memory()
+    {
+        if (m_memory.empty())
+        {
+            m_memory.resize(m_bytes);
+        }
+        return m_memory.data();
+    }
+
+protected:
+    bool is_a(REFIID riid) const override { return riid == __uuidof(ID3D11Resource); }
+
+private:
+    Desc            m_desc;
+    u64             m_bytes;
+    u32             m_row_pitch;
+    std::vector<u8> m_memory{};
+};
+
+using null_buffer    = null_resource<ID3D11Buffer, D3D11_BUFFER_DESC, D3D11_RESOURCE_DIMENSION_BUFFER>;
+using null_texture2d = null_resource<ID3D11Texture2D, D3D11_TEXTURE2D_DESC, D3D11_RESOURCE_DIMENSION_TEXTURE2D>;
+
+// Views keep their resource alive, as D3D11 views do
+template<typename Interface, typename Desc>
+class null_view final : public null_child<Interface>
+{
+public:
+    null_view(ID3D11Resource* resource, const Desc* desc) : m_resource{ resource }
+    {
+        m_resource->AddRef();
+        if (desc)
+        {
+            m_desc = *desc;
+        }
+    }
+    ~null_view() override { m_resource->Release(); }
+
+    void STDMETHODCALLTYPE GetResource(ID3D11Resource** resource) override
+    {
+        m_resource->AddRef();
+        *resource = m_resource;
+    }
+    void STDMETHODCALLTYPE GetDesc(Desc* desc) override { *desc = m_desc; }
+
+    // Not AddRef'd, the view holds its own reference
+    constexpr ID3D11Resource* resource() const { return m_resource; }
+    constexpr const Desc&     desc() const { return m_desc; }
+
+protected:
+    bool is_a(REFIID riid) const override { return riid == __uuidof(ID3D11View); }
+
+private:
+    ID3D11Resource* m_resource;
+    Desc            m_desc{};
+};
+
+using null_shader_resource_view = null_view<ID3D11ShaderResourceView, D3D11_SHADER_RESOURCE_VIEW_DESC>;
+using null_render_target_view   = null_view<ID3D11RenderTargetView, D3D11_RENDER_TARGET_VIEW_DESC>;
+using null_depth_stencil_view   = null_view<ID3D11DepthStencilView, D3D11_DEPTH_STENCIL_VIEW_DESC>;
+
+template<typename Interface, typename Desc>
+class null_state final : public null_child<Interface>
+{
+public:
+    explicit null_state(const Desc& desc) : m_desc{ desc } {}
+
+    void STDMETHODCALLTYPE GetDesc(Desc* desc) override { *desc = m_desc; }
+
+    constexpr const Desc& desc() const { return m_desc; }
+
+private:
+    Desc m_desc;
+};
+
+using null_sampler_state       = null_state<ID3D11SamplerState, D3D11_SAMPLER_DESC>;
+using null_blend_state         = null_state<ID3D11BlendState, D3D11_BLEND_DESC>;
+using null_depth_stencil_state = null_state<ID3D11DepthStencilState, D3D11_DEPTH_STENCIL_DESC>;
+using null_rasterizer_state    = null_state<ID3D11RasterizerState, D3D11_RASTERIZER_DESC>;
+
+// Shaders and input layouts have nothing beyond the device child
+template<typename Interface>
+class null_object : public null_child<Interface>
+{};
+
+// Only buffers and 2D textures are ever created by the null backend, anything else is one of those two
+inline bool is_null_buffer(ID3D11Resource* resource)
+{
+    D3D11_RESOURCE_DIMENSION dimension{};
+    resource->GetType(&dimension);
+    return dimension == D3D11_RESOURCE_DIMENSION_BUFFER;
+}
+
+inline null_buffer* as_null_buffer(ID3D11Resource* resource)
+{
+    return static_cast<null_buffer*>(static_cast<ID3D11Buffer*>(resource));
+}
+
+inline null_texture2d* as_null_texture2d(ID3D11Resource* resource)
+{
+    return static_cast<null_texture2d*>(static_cast<ID3D11Texture2D*>(resource));
+}
+
+} // namespace yae::gfx
@@ -0,0 +1,174 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: RenderQueue.cpp
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+
+#include "RenderQueue.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace yae::gfx
+{
+namespace
+{
+
+// Positive floats keep their order when read as integers, negative depths are clamped to 0
+u32 depth_bits(f32 depth)
+{
+    return std::bit_cast<u32>(std::max(depth, 0.f));
+}
+
+u32 fold_pointer(const void* ptr, u32 hash)
+{
+    // FNV-1a over the pointer value
+    u64 value = (u64) ptr;
+    for (u32 i = 0; i < 8; ++i)
+    {
+        hash ^= (u32) (value & 0xFF);
+        hash *= 16777619u;
+        value >>= 8;
+    }
+    return hash;
+}
+
+} // anonymous namespace
+
+void render_queue::begin(const math::matrix& view)
+{
+    XMStoreFloat4x4(&m_view, view);
+}
+
+void render_queue::submit(ref<const model> mesh, const math::matrix& world, material_id mat, u32 block_index, u32 shader)
+{
+    const f32 depth = XMVectorGetZ(XMVector3TransformCoord(world.r[3], XMLoadFloat4x4(&m_view)));
+    m_keys.push_back(geometry_key(shader, block_index, mesh.get(), depth));
+
+    draw_packet& packet = m_packets.emplace_back();
+    packet.mesh         = std::move(mesh);
+    packet.mat          = mat;
+    packet.pass         = render_pass::geometry;
+    XMStoreFloat4x4(&packet.world, world);
+}
+
+void render_queue::submit(ref<const model> mesh, ref<const texture> tex, const math::matrix& world)
+{
+    const u32 texture_id = fold_pointer(tex.get(), 2166136261u) & ((1u << material_bits) - 1);
+
+    draw_packet& packet = m_packets.emplace_back();
+    packet.mesh         = std::move(mesh);
+    packet.tex          = std::move(tex);
+    packet.pass         = render_pass::overlay;
+    XMStoreFloat4x4(&packet.world, world);
+
+    m_keys.push_back(overlay_key(XMVectorGetZ(world.r[3]), texture_id));
+}
+
+void render_queue::sort()
+{
+    const u32 count = size();
+    m_sorted_keys.assign(m_keys.begin(), m_keys.end());
+    m_order.resize(count);
+    for (u32 i = 0; i < count; ++i)
+    {
+        m_order[i] = i;
+    }
+    m_key_scratch.resize(count);
+    m_order_scratch.resize(count);
+
+    // LSD radix sort, a byte per pass. Passes where every key has the same byte are skipped
+    for (u32 shift = 0; shift < 64; shift += 8)
+    {
+        u32 offsets[256]{};
+        for (const u64 k : m_sorted_keys)
+        {
+            ++offsets[(k >> shift) & 0xFF];
+        }
+
+        if (count == 0 || offsets[(m_sorted_keys[0] >> shift) & 0xFF] == count)
+        {
+            continue;
+        }
+
+        u32 total = 0;
+        for (u32& offset : offsets)
+        {
+            const u32 bucket = offset;
+            offset           = total;
+            total           += bucket;
+        }
+
+        for (u32 i = 0; i < count; ++i)
+        {
+            const u32 dst        = offsets[(m_sorted_keys[i] >> shift) & 0xFF]++;
+            m_key_scratch[dst]   = m_sorted_keys[i];
+            m_order_scratch[dst] = m_order[i];
+        }
+
+        m_sorted_keys.swap(m_key_scratch);
+        m_order.swap(m_order_scratch);
+    }
+}
+
+std::span<const u32> render_queue::sorted(render_pass pass) const
+{
+    // The pass is the top of the key, so each pass is one contiguous run
+    const u64  wanted = (u64) pass;
+    const auto first  = std::lower_bound(m_sorted_keys.begin(), m_sorted_keys.end(), wanted << pass_shift);
+    const auto last   = std::lower_bound(first, m_sorted_keys.end(), (wanted + 1) << pass_shift);
+
+    return { m_order.data() + (first - m_sorted_keys.begin()), (size_t) (last - first) };
+}
+
+void render_queue::clear(render_pass pass)
+{
+    u32 kept = 0;
+    for (u32 i = 0; i < size(); ++i)
+    {
+        if (m_packets[i].pass != pass)
+        {
+            m_packets[kept] = std::move(m_packets[i]);
+            m_keys[kept]    = m_keys[i];
+            ++kept;
+        }
+    }
+
+    m_packets.resize(kept);
+    m_keys.resize(kept);
+    m_sorted_keys.clear();
+    m_order.clear();
+}
+
+u64 render_queue::geometry_key(u32 shader, u32 block_index, const model* mesh, f32 depth)
+{
+    const u32 mesh_id = fold_pointer(mesh, 2166136261u) & ((1u << mesh_bits) - 1);
+    return ((u64) render_pass::geometry << pass_shift) | ((u64) (shader & 0x3F) << shader_shift) |
+           ((u64) (block_index & ((1u << material_bits) - 1)) << material_shift) | ((u64) mesh_id << mesh_shift) |
+           (depth_bits(depth) >> 16);
+}
+
+u64 render_queue::overlay_key(f32 depth, u32 texture_id)
+{
+    return ((u64) render_pass::overlay << pass_shift) | ((u64) ~depth_bits(depth) << material_bits) |
+           (texture_id & ((1u << material_bits) - 1));
+}
+
+} // namespace yae::gfx
@@ -0,0 +1,135 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: RenderQueue.h
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+
+#pragma once
+
+#include "Material.h"
+#include "Yae/Common.h"
+
+#include <span>
+#include <vector>
+
+namespace yae::gfx
+{
+
+class model;
+
+enum class render_pass : u8
+{
+    geometry, // Opaque 3D into the G-buffer, front to back within a material
+    overlay,  // 2D on top of the lit image, back to front
+
+    count
+};
+
+/**
+ * \brief One draw as submitted by a component. The packet shares ownership of the model and texture, so a component
+ * destroyed while its frame is still queued on the render thread doesn't free them under the draw
+ */
+struct draw_packet
+{
+    ref<const model>   mesh{};
+    material_id        mat{};
+    ref<const texture> tex{};
+    math::mat4         world{};
+    render_pass        pass{};
+};
+
+/**
+ * \brief Collects the frame's draws and orders them by a 64 bit key.\n\n
+ * Geometry keys hold, from the top: pass (2 bits), shader (6), material block (24), mesh (16), view depth (16), so
+ * draws are grouped by shader, bound state and mesh (runs the renderer can instance) and go front to back inside a
+ * group. The depth keeps the top half of the float's bits, enough to order it coarsely. Overlay keys hold the pass,
+ * the inverted depth (32) and the texture (24), so they go back to front. The keys are radix sorted, equal keys keep
+ * their submission order.\n\n
+ * Nothing here touches the device, the renderer executes the sorted packets.
+ */
+class render_queue
+{
+public:
+    static constexpr u32 pass_shift     = 62;
+    static constexpr u32 shader_shift   = 56;
+    static constexpr u32 material_shift = 32;
+    static constexpr u32 material_bits  = 24;
+    static constexpr u32 mesh_shift     = 16;
+    static constexpr u32 mesh_bits      = 16;
+
+    render_queue()  = default;
+    ~render_queue() = default;
+    DISABLE_COPY_AND_MOVE(render_queue);
+
+    /**
+     * \brief Sets the camera geometry depths are measured with. Call once per frame before submitting
+     * \param view Camera view matrix
+     */
+    void begin(const math::matrix& view);
+
+    /**
+     * \brief Queues a 3D draw for the geometry pass. The caller resolves the material, the queue never looks at the
+     * registry
+     * \param mesh The model to draw
+     * \param world World matrix
+     * \param mat Registered material, kept in the packet
+     * \param block_index The material's binding block, the key's material field
+     * \param shader The block's shader variant, the key's shader field
+     */
+    void submit(ref<const model> mesh, const math::matrix& world, material_id mat, u32 block_index, u32 shader);
+
+    /**
+     * \brief Queues a 2D draw for the overlay pass
+     * \param mesh The model to draw
+     * \param tex Texture to draw it with
+     * \param world World matrix, its z orders overlays back to front
+     */
+    void submit(ref<const model> mesh, ref<const texture> tex, const math::matrix& world);
+
+    // Sorts the queued packets by key. Submitting afterwards needs another sort
+    void sort();
+
+    // Packet indices of one pass in execution order, valid after sort
+    std::span<const u32> sorted(render_pass pass) const;
+
+    // Drops one pass's packets, the others stay queued
+    void clear(render_pass pass);
+
+    const draw_packet& packet(u32 index) const { return m_packets[index]; }
+    u64                key(u32 index) const { return m_keys[index]; }
+    u32                size() const { return (u32) m_packets.size(); }
+
+    static u64 geometry_key(u32 shader, u32 block_index, const model* mesh, f32 depth);
+    static u64 overlay_key(f32 depth, u32 texture_id);
+
+private:
+    std::vector<draw_packet> m_packets{};
+    std::vector<u64>         m_keys{};
+
+    // Sorted keys and packet indices, plus scratch space for the radix passes
+    std::vector<u64> m_sorted_keys{};
+    std::vector<u32> m_order{};
+    std::vector<u64> m_key_scratch{};
+    std::vector<u32> m_order_scratch{};
+
+    math::mat4 m_view{};
+};
+
+} // namespace yae::gfx
@@ -25,7 +25,14 @@
 
 #include "Shaders/ShaderLibrary.h"
 #include "Yae/Core/Application.h"
+#include "BitmapFont.h"
+#include "Yae/Core/Jobs.h"
+#include "Yae/Core/System.h"
+#include "Geometry.h"
 #include "Light.h"
+#include "LightClusters.h"
+#include "MaterialRegistry.h"
+#include "StateCache.h"
 
 namespace yae::gfx
 {
@@ -33,17 +40,201 @@ namespace yae::gfx
 namespace
 {
 
-std::vector<std::pair<game_object*, pointlight_component*>> pointlights{};
-
 ID3D11SamplerState* sampler_state{};
 
+// Dynamic structured buffer, recreated with room to spare whenever an upload doesn't fit
+struct structured_buffer
+{
+    ID3D11Buffer*             buffer{};
+    ID3D11ShaderResourceView* srv{};
+    u32                       capacity{};
+
+    bool upload(const void* data, u32 count, u32 stride)
+    {
+        if (count > capacity)
+        {
+            release();
+            capacity = std::max(count + count / 2, 64u);
+
+            D3D11_BUFFER_DESC desc{};
+            desc.ByteWidth           = capacity * stride;
+            desc.Usage               = D3D11_USAGE_DYNAMIC;
+            desc.BindFlags           = D3D11_BIND_SHADER_RESOURCE;
+            desc.CPUAccessFlags      = D3D11_CPU_ACCESS_WRITE;
+            desc.MiscFlags           = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+            desc.StructureByteStride = stride;
+            DX_CALL(core::backend()->create_buffer(&desc, nullptr, &buffer));
+
+            D3D11_SHADER_RESOURCE_VIEW_DESC srv_desc{};
+            srv_desc.Format             = DXGI_FORMAT_UNKNOWN;
+            srv_desc.ViewDimension      = D3D11_SRV_DIMENSION_BUFFER;
+            srv_desc.Buffer.NumElements = capacity;
+            DX_CALL(core::backend()->create_shader_resource_view(buffer, &srv_desc, &srv));
+        }
+
+        if (count == 0)
+        {
+            return true;
+        }
+
+        D3D11_MAPPED_SUBRESOURCE mapped{};
+        DX_CALL(core::backend()->map(buffer, 0, D3D11_MAP_WRITE_DISCARD, &mapped));
+        memcpy(mapped.pData, data, (size_t) count * stride);
+        core::backend()->unmap(buffer, 0);
+        return true;
+    }
+
+    void release()
+    {
+        core::release(srv);
+        core::release(buffer);
+        capacity = 0;
+    }
+};
+
+// Dynamic vertex buffer for per instance data, grown the same way
+struct instance_buffer
+{
+    ID3D11Buffer* buffer{};
+    u32           capacity{};
+
+    bool upload(const void* data, u32 count, u32 stride)
+    {
+        if (count > capacity)
+        {
+            release();
+            capacity = std::max(count + count / 2, 256u);
+
+            D3D11_BUFFER_DESC desc{};
+            desc.ByteWidth      = capacity * stride;
+            desc.Usage          = D3D11_USAGE_DYNAMIC;
+            desc.BindFlags      = D3D11_BIND_VERTEX_BUFFER;
+            desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+            DX_CALL(core::backend()->create_buffer(&desc, nullptr, &buffer));
+        }
+
+        D3D11_MAPPED_SUBRESOURCE mapped{};
+        DX_CALL(core::backend()->map(buffer, 0, D3D11_MAP_WRITE_DISCARD, &mapped));
+        memcpy(mapped.pData, data, (size_t) count * stride);
+        core::backend()->unmap(buffer, 0);
+        return true;
+    }
+
+    void release()
+    {
+        core::release(buffer);
+        capacity = 0;
+    }
+};
+
+// Matches the per instance stream of DeferredVertexShader.hlsl
+struct instance_data
+{
+    math::mat4 world{};
+    math::vec4 tint{};
+};
+
+light_clusters    clusters{};
+structured_buffer light_buffer{};
+structured_buffer cluster_buffer{};
+structured_buffer index_buffer{};
+
+// Point lights are either shaded per cluster in one full screen pass, or drawn as instanced spheres that only touch
+// the pixels they cover. Picked at startup from the graphics settings
+bool       use_light_volumes{};
+ref<model> light_volume{};
+
+// Coarse on purpose, the sphere only has to enclose the light. Its faces sit inside the unit sphere, so the radius is
+// pushed out until the flattest point of any face is at 1
+constexpr u32 volume_slices = 12;
+constexpr u32 volume_stacks = 8;
+const f32     volume_radius = 1.f / (cosf(math::pi / (f32) volume_slices) * cosf(math::pi / (2.f * (f32) volume_stacks)));
+
+instance_buffer            geometry_instances{};
+std::vector<instance_data> instance_staging{};
+
+// With graphics.command_lists above 1 the geometry pass is split into that many chunks, each recorded by a job into
+// its own command list. Small passes aren't worth the jobs and are drawn directly
+constexpr u32                   min_packets_per_list = 128;
+std::vector<render_backend*>    recorders{};
+std::vector<ID3D11CommandList*> recorded_lists{};
+std::vector<u32>                list_bounds{}; // Chunk i covers [list_bounds[i], list_bounds[i + 1]) of the order
+
+// The packet the simulation is filling and the one being drawn. They are the same packet without a render thread
+frame_packet* extracting{};
+frame_packet* drawing{};
+
+// Resolved once the engine shaders are loaded so draws never look a name up
+struct overlay_handles
+{
+    shader_param world{};
+    shader_slot  sampler{};
+    shader_slot  texture{};
+};
+
+overlay_handles overlay{};
+
+// The clustered light pass reads the G-buffer and the three light buffers
+struct cluster_handles
+{
+    shader_slot position{};
+    shader_slot normal{};
+    shader_slot diffuse{};
+    shader_slot lights{};
+    shader_slot ranges{};
+    shader_slot indices{};
+    shader_slot sampler{};
+};
+
+cluster_handles clustered{};
+
+// Light volumes read the lights in both stages, the vertex shader to place each sphere
+struct volume_handles
+{
+    shader_slot vs_lights{};
+    shader_slot position{};
+    shader_slot normal{};
+    shader_slot diffuse{};
+    shader_slot lights{};
+};
+
+volume_handles volumes{};
+
+// Mirrors cbuffer Data in LightPixelShader.hlsl, the camera comes from the frame buffer
+struct light_constants
+{
+    f32        slice_scale{};
+    math::vec2 tile_scale{};
+    f32        slice_bias{};
+    u32        tiles_x{};
+    u32        tiles_y{};
+    u32        slices{};
+
+    static std::span<const cbuffer_field> layout()
+    {
+        static constexpr cbuffer_field fields[]{
+            CBUFFER_FIELD(light_constants, slice_scale, "sliceScale"),
+            CBUFFER_FIELD(light_constants, tile_scale, "tileScale"),
+            CBUFFER_FIELD(light_constants, slice_bias, "sliceBias"),
+            CBUFFER_FIELD(light_constants, tiles_x, "tilesX"),
+            CBUFFER_FIELD(light_constants, tiles_y, "tilesY"),
+            CBUFFER_FIELD(light_constants, slices, "slices"),
+        };
+        return fields;
+    }
+};
+
+typed_cbuffer<light_constants> light_cbuffer{};
+
+render_context context{};
+
 math::vec4 ambient{ 0.05f, 0.05f, 0.05f, 1.f };
 math::vec4 dir_light_color{ .4f, .4f, .4f, .4f };
 math::vec3 light_direction{ 1.f, -0.4f, 1.f };
 } // anonymous namespace
 
 
-void init_renderer()
+bool init_renderer()
 {
     D3D11_SAMPLER_DESC sampler_desc = {};
     sampler_desc.AddressU           = D3D11_TEXTURE_ADDRESS_WRAP;
@@ -52,113 +243,361 @@ void init_renderer()
     sampler_desc.Filter             = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
     sampler_desc.MaxAnisotropy      = 16;
     sampler_desc.MaxLOD             = D3D11_FLOAT32_MAX;
-    core::get_device()->CreateSamplerState(&sampler_desc, &sampler_state);
-}
-void shutdown_renderer()
-{
-    core::release(sampler_state);
-}
-
-void render3d(const model* model, const math::matrix& world, const material& mat)
-{
-    ID3D11SamplerState* sampler{};
-    if (!mat.sampler)
+    sampler_state                   = state::sampler_state(sampler_desc);
+
+    using namespace literals;
+    overlay.world   = shaders::texture_shader()->vs->param("worldMatrix"_param);
+    overlay.sampler = shaders::texture_shader()->ps->sampler_slot("SamplerType"_param);
+    overlay.texture = shaders::texture_shader()->ps->srv_slot("shaderTexture"_param);
+    light_cbuffer   = shaders::lighting()->ps->typed_buffer<light_constants>("Data");
+
+    const pixel_shader* lighting_ps = shaders::lighting()->ps;
+    clustered.position              = lighting_ps->srv_slot("positionGB"_param);
+    clustered.normal                = lighting_ps->srv_slot("normalGB"_param);
+    clustered.diffuse               = lighting_ps->srv_slot("diffuseGB"_param);
+    clustered.lights                = lighting_ps->srv_slot("pointLights"_param);
+    clustered.ranges                = lighting_ps->srv_slot("clusterRanges"_param);
+    clustered.indices               = lighting_ps->srv_slot("lightIndices"_param);
+    clustered.sampler               = lighting_ps->sampler_slot("Sampler"_param);
+
+    const pixel_shader* volume_ps = shaders::light_volumes()->ps;
+    volumes.vs_lights             = shaders::light_volumes()->vs->srv_slot("pointLights"_param);
+    volumes.position              = volume_ps->srv_slot("positionGB"_param);
+    volumes.normal                = volume_ps->srv_slot("normalGB"_param);
+    volumes.diffuse               = volume_ps->srv_slot("diffuseGB"_param);
+    volumes.lights                = volume_ps->srv_slot("pointLights"_param);
+
+    use_light_volumes = g_settings->get<bool>("graphics", "light_volumes");
+    light_volume      = geometry::create_sphere(volume_radius, volume_slices, volume_stacks);
+    LOG_INFO("Point lights are drawn {}", use_light_volumes ? "as instanced light volumes" : "by clustered shading");
+
+    const u32 list_count = g_settings->get<u32>("graphics", "command_lists");
+    for (u32 i = 0; list_count > 1 && i < list_count; ++i)
     {
-        sampler = default_sampler_state();
-    } else
-    {
-        sampler = mat.sampler;
+        render_backend* recorder = core::backend()->create_recorder();
+        if (!recorder)
+        {
+            LOG_WARN("Backend can't record command lists, the geometry pass is drawn directly");
+            break;
+        }
+        recorders.push_back(recorder);
     }
-    vertex_shader* vs = shaders::deferred()->vs;
-    pixel_shader*  ps;
-    if (!mat.blend)
+    if (recorders.size() < 2)
     {
-        ps = shaders::deferred()->ps;
+        for (render_backend* recorder : recorders)
+        {
+            delete recorder;
+        }
+        recorders.clear();
     } else
     {
-        ps = shaders::multitexture()->ps;
+        LOG_INFO("Geometry pass is recorded into up to {} command lists", recorders.size());
     }
 
-    const auto w = XMMatrixTranspose(world);
-    const auto p = XMMatrixTranspose(core::get_projection_matrix());
-    const auto v = XMMatrixTranspose(app::instance()->camera()->view());
-    vs->set_matrix("worldMatrix", w);
-    vs->set_matrix("projectionMatrix", p);
-    vs->set_matrix("viewMatrix", v);
-    vs->set_float3("cameraPos", app::instance()->camera()->position());
-
-    vs->copy_all_buffers();
-    vs->bind();
-
-    if (mat.diffuse)
-    {
-        ps->set_shader_resource_view("textureSRV", mat.diffuse);
-    } else
-    {
-        ps->set_shader_resource_view("textureSRV", assets::load_texture("./assets/textures/default.tga")->texture_view());
-    }
-    if (mat.blend && ps == shaders::multitexture()->ps)
+    return frame::init() && materials::init(sampler_state);
+}
+void shutdown_renderer()
+{
+    light_buffer.release();
+    cluster_buffer.release();
+    index_buffer.release();
+    geometry_instances.release();
+    for (render_backend* recorder : recorders)
     {
-        ps->set_shader_resource_view("textureSRVBlend", mat.blend);
+        delete recorder;
     }
+    recorders.clear();
+    light_volume = nullptr;
+    frame::shutdown();
+    materials::shutdown();
+    context       = {};
+    sampler_state = nullptr;
+}
 
-    if (mat.normal)
-    {
-        ps->set_shader_resource_view("textureSRVBump", mat.normal);
-    } else
+void begin_extract(frame_packet& packet, const math::matrix& view, const math::vec3& camera_pos)
+{
+    packet.view       = view;
+    packet.camera_pos = camera_pos;
+    packet.queue.clear(render_pass::geometry);
+    packet.queue.clear(render_pass::overlay);
+    packet.queue.begin(view);
+    packet.text.clear();
+    extracting = &packet;
+}
+
+void end_extract()
+{
+    // Only the lights that changed are repacked, the packet still copies all of them
+    lights::pack();
+    extracting->lights = lights::packed();
+    extracting         = nullptr;
+}
+
+bool begin_frame(frame_packet& packet)
+{
+    drawing = &packet;
+
+    context.view       = packet.view;
+    context.projection = core::get_projection_matrix();
+    context.camera_pos = packet.camera_pos;
+
+    frame_constants& constants = context.constants;
+    XMStoreFloat4x4(&constants.view, XMMatrixTranspose(context.view));
+    XMStoreFloat4x4(&constants.projection, XMMatrixTranspose(context.projection));
+    constants.ambient_color   = ambient;
+    constants.dir_light_color = dir_light_color;
+    constants.camera_pos      = packet.camera_pos;
+    constants.light_direction = light_direction;
+
+    if (!frame::upload(constants))
     {
-        ps->set_shader_resource_view("textureSRVBump",
-                                     assets::load_texture("./assets/textures/default_normal.tga")->texture_view());
+        LOG_ERROR("Failed to upload the frame constants");
+        return false;
     }
+    return true;
+}
 
-    ps->set_sampler_state("Sampler", sampler);
+const render_context& frame_context()
+{
+    return context;
+}
 
-    ps->set_float4("tintColor", mat.tint);
-    ps->set_float4("ambientColor", ambient);
-    ps->set_float3("lightDirection", light_direction);
-    ps->set_float4("dirLightColor", dir_light_color);
+void render3d(ref<const model> model, const math::matrix& world, material_id mat)
+{
+    const u32 block = materials::block_index(mat);
+    extracting->queue.submit(std::move(model), world, mat, block, materials::block(block).shader);
+}
 
+void render2d(ref<const model> model, ref<const texture> tex, const math::matrix& world)
+{
+    extracting->queue.submit(std::move(model), std::move(tex), world);
+}
 
-    //ps->set_float3("lightDirection", { 1.f, -1.f, 0.f });
-    //ps->set_float3("cameraPos", app::instance()->camera()->position());
-    //ps->set_float3("lightColor", { 1.f, 1.f, 1.f });
+void render_text(ref<text_string> string, const std::string& text, const math::vec4& color)
+{
+    extracting->text.push_back({ std::move(string), text, color });
+}
 
-    ps->copy_all_buffers();
-    ps->bind();
+namespace
+{
 
-    model->bind();
+// True if the packets at positions a and b of the order can go in the same instanced draw
+bool same_run(std::span<const u32> order, u32 a, u32 b)
+{
+    const draw_packet& first  = drawing->queue.packet(order[a]);
+    const draw_packet& second = drawing->queue.packet(order[b]);
+    return first.mesh == second.mesh && materials::block_index(first.mat) == materials::block_index(second.mat);
+}
 
-    core::get_device_context()->DrawIndexed(model->index_count(), 0, 0);
+// Draws order[begin, end) of the geometry pass on whatever the calling thread targets. Instance i of the instance
+// buffer belongs to order[i], so any range of whole runs can be drawn on its own
+void draw_geometry(std::span<const u32> order, u32 begin, u32 end)
+{
+    // Whatever is already bound is skipped, the queue's order makes long runs of equal state likely
+    const model*  bound_model{};
+    u32           bound_block{ invalid_u32 };
+    pixel_shader* bound_ps{};
+
+    for (u32 first = begin; first < end;)
+    {
+        const draw_packet& packet      = drawing->queue.packet(order[first]);
+        const u32          block_index = materials::block_index(packet.mat);
+
+        // The sort puts packets sharing a mesh and binding block next to each other, each run is one instanced
+        // draw. Materials differing only in tint share a block, the tint travels with the instance
+        u32 last = first + 1;
+        while (last < end && same_run(order, first, last))
+        {
+            ++last;
+        }
+
+        const material_block& block = materials::block(block_index);
+        if (block.ps != bound_ps)
+        {
+            block.ps->bind();
+            bound_ps = block.ps;
+        }
+
+        if (block_index != bound_block)
+        {
+            materials::bind(block);
+            bound_block = block_index;
+        }
+
+        if (packet.mesh.get() != bound_model)
+        {
+            packet.mesh->bind();
+            bound_model = packet.mesh.get();
+        }
+
+        state::target()->draw_indexed_instanced(packet.mesh->index_count(), last - first, 0, 0, first);
+        first = last;
+    }
 }
 
-void render2d(const model* model, const texture* tex, const math::matrix& world)
+// Runs on a job. A command list starts from the default state, so everything the pass relies on is bound again
+void record_geometry(u32 chunk, std::span<const u32> order)
 {
-    vertex_shader* vs = shaders::texture_shader()->vs;
-    pixel_shader*  ps = shaders::texture_shader()->ps;
+    render_backend* recorder = recorders[chunk];
+    state::begin_recording(recorder);
 
+    core::bind_first_stage();
+    frame::bind();
+    shaders::deferred()->vs->bind();
+    state::set_vertex_buffer(1, geometry_instances.buffer, sizeof(instance_data), 0);
+    draw_geometry(order, list_bounds[chunk], list_bounds[chunk + 1]);
 
-    const auto w = XMMatrixTranspose(world);
-    const auto p = XMMatrixTranspose(core::get_orthographic_matrix());
-    const auto v = XMMatrixTranspose(default_view_matrix());
+    if (FAILED(recorder->finish_command_list(&recorded_lists[chunk])))
+    {
+        LOG_ERROR("Failed to finish geometry command list {}", chunk);
+        recorded_lists[chunk] = nullptr;
+    }
 
-    vs->set_matrix("worldMatrix", w);
-    vs->set_matrix("projectionMatrix", p);
-    vs->set_matrix("viewMatrix", v);
+    state::end_recording();
+}
 
-    vs->copy_all_buffers();
-    vs->bind();
+// Splits the order into chunks of whole runs, records them in parallel and executes the lists in order
+void draw_geometry_recorded(std::span<const u32> order, u32 chunk_count)
+{
+    const u32 count = (u32) order.size();
 
-    ps->set_sampler_state("SamplerType", tex->sampler_state());
-    ps->set_shader_resource_view("shaderTexture", tex->texture_view());
+    list_bounds.clear();
+    list_bounds.push_back(0);
+    for (u32 i = 1; i < chunk_count; ++i)
+    {
+        u32 bound = std::max((u32) ((u64) count * i / chunk_count), list_bounds.back());
+        while (bound > 0 && bound < count && same_run(order, bound - 1, bound))
+        {
+            ++bound;
+        }
+        list_bounds.push_back(bound);
+    }
+    list_bounds.push_back(count);
+    recorded_lists.assign(chunk_count, nullptr);
 
-    // TODO: Temp
-    ps->set_float4("tintColor", { 1.f, 1.f, 1.f, 1.f });
+    jobs::parallel_for(0, chunk_count, 1, [order](u32 begin, u32 end) {
+        for (u32 chunk = begin; chunk < end; ++chunk)
+        {
+            record_geometry(chunk, order);
+        }
+    });
 
-    ps->copy_all_buffers();
-    ps->bind();
+    for (ID3D11CommandList*& list : recorded_lists)
+    {
+        if (list)
+        {
+            core::backend()->execute_command_list(list);
+            core::release(list);
+        }
+    }
 
-    model->bind();
-    core::get_device_context()->DrawIndexed(model->index_count(), 0, 0);
+    // Executing leaves the immediate context at the default state, nothing the cache remembers still holds
+    state::invalidate();
+    frame::bind();
+}
+
+// Drops the pass's packets. Text goes over everything else, after the overlay
+void end_pass(render_pass pass)
+{
+    drawing->queue.clear(pass);
+    if (pass == render_pass::overlay)
+    {
+        for (const text_draw& t : drawing->text)
+        {
+            t.string->draw(t.text, t.color);
+        }
+    }
+}
+
+} // anonymous namespace
+
+void flush_queue(render_pass pass)
+{
+    render_queue& queue = drawing->queue;
+    queue.sort();
+
+    const std::span<const u32> order = queue.sorted(pass);
+    if (order.empty())
+    {
+        end_pass(pass);
+        return;
+    }
+
+    if (pass == render_pass::geometry)
+    {
+        // Every packet's world matrix and tint go into the instance buffer up front, one map for the whole pass
+        instance_staging.clear();
+        for (const u32 index : order)
+        {
+            const draw_packet& packet = queue.packet(index);
+            instance_staging.push_back({ packet.world, materials::tint(packet.mat) });
+        }
+
+        if (!geometry_instances.upload(instance_staging.data(), (u32) instance_staging.size(), sizeof(instance_data)))
+        {
+            LOG_ERROR("Failed to upload the geometry instance buffer");
+            end_pass(pass);
+            return;
+        }
+
+        const u32 chunk_count = std::min((u32) recorders.size(), (u32) order.size() / min_packets_per_list);
+        if (chunk_count > 1)
+        {
+            draw_geometry_recorded(order, chunk_count);
+        } else
+        {
+            // View, projection, camera and the directional light are in the frame buffer already
+            shaders::deferred()->vs->bind();
+
+            state::set_vertex_buffer(1, geometry_instances.buffer, sizeof(instance_data), 0);
+            draw_geometry(order, 0, (u32) order.size());
+
+            // Slot 1 stays bound otherwise, and nothing else reads it
+            state::set_vertex_buffer(1, nullptr, sizeof(instance_data), 0);
+        }
+    } else
+    {
+        // Whatever is already bound is skipped, the queue's order makes long runs of equal state likely
+        const model*   bound_model{};
+        const texture* bound_texture{};
+
+        vertex_shader* vs = shaders::texture_shader()->vs;
+        pixel_shader*  ps = shaders::texture_shader()->ps;
+
+        vs->set_matrix("projectionMatrix", XMMatrixTranspose(core::get_orthographic_matrix()));
+        vs->set_matrix("viewMatrix", XMMatrixTranspose(default_view_matrix()));
+        vs->bind();
+
+        // TODO: Temp
+        ps->set_float4("tintColor", { 1.f, 1.f, 1.f, 1.f });
+        ps->copy_all_buffers();
+        ps->bind();
+
+        for (const u32 index : order)
+        {
+            const draw_packet& packet = queue.packet(index);
+
+            if (packet.tex.get() != bound_texture)
+            {
+                ps->set_sampler_state(overlay.sampler, packet.tex->sampler_state());
+                ps->set_shader_resource_view(overlay.texture, packet.tex->texture_view());
+                bound_texture = packet.tex.get();
+            }
+
+            vs->set_matrix(overlay.world, XMMatrixTranspose(XMLoadFloat4x4(&packet.world)));
+            vs->copy_all_buffers();
+
+            if (packet.mesh.get() != bound_model)
+            {
+                packet.mesh->bind();
+                bound_model = packet.mesh.get();
+            }
+
+            core::backend()->draw_indexed(packet.mesh->index_count(), 0, 0);
+        }
+    }
+
+    end_pass(pass);
 }
 
 void render_base_to_screen()
@@ -177,71 +616,124 @@ void render_base_to_screen()
     ps->copy_all_buffers();
     ps->bind();
 
-    ID3D11Buffer* nothing{};
-    constexpr u32 stride = sizeof(vertex_position_normal_texture);
-    constexpr u32 offset{};
-    core::get_device_context()->IASetVertexBuffers(0, 1, &nothing, &stride, &offset);
-    core::get_device_context()->IASetIndexBuffer(nullptr, DXGI_FORMAT_R32_UINT, 0);
-    core::get_device_context()->Draw(3, 0);
+    state::set_vertex_buffer(0, nullptr, sizeof(vertex_position_normal_texture), 0);
+    state::set_index_buffer(nullptr, DXGI_FORMAT_R32_UINT);
+    core::backend()->draw(3, 0);
 }
 
-void render_pointlight(const math::vec3& pos, const math::matrix& world, const math::vec3& light_color, f32 radius, f32 intensity,
-                       f32 falloff)
+namespace
+{
+
+// One full screen pass, each pixel loops over the lights of its cluster
+void render_light_clusters(const std::vector<packed_pointlight>& packed)
 {
-    vertex_shader* vs = shaders::lighting()->vs;
-    pixel_shader*  ps = shaders::lighting()->ps;
+    clusters.build(context.view, context.projection, packed.data(), (u32) packed.size());
 
-    //model->bind();
+    // Nothing on screen is lit, skip the pass before touching any state
+    if (clusters.visible_count() == 0)
+    {
+        return;
+    }
 
-    //const auto w = XMMatrixTranspose(world);
-    //const auto p = XMMatrixTranspose(core::get_projection_matrix());
-    //const auto v = XMMatrixTranspose(app::instance()->camera()->view());
-    //vs->set_matrix("worldMatrix", w);
-    //vs->set_matrix("projectionMatrix", p);
-    //vs->set_matrix("viewMatrix", v);
+    if (!light_buffer.upload(packed.data(), (u32) packed.size(), sizeof(packed_pointlight)) ||
+        !cluster_buffer.upload(clusters.ranges().data(), (u32) clusters.ranges().size(), sizeof(cluster_range)) ||
+        !index_buffer.upload(clusters.indices().data(), (u32) clusters.indices().size(), sizeof(u32)))
+    {
+        LOG_ERROR("Failed to upload the clustered light buffers");
+        return;
+    }
 
-    //vs->copy_all_buffers();
-    vs->bind();
+    vertex_shader* vs = shaders::lighting()->vs;
+    pixel_shader*  ps = shaders::lighting()->ps;
 
-    ps->set_shader_resource_view("positionGB", core::position_gbuffer());
-    ps->set_shader_resource_view("normalGB", core::normal_gbuffer());
-    ps->set_shader_resource_view("diffuseGB", core::diffuse_gbuffer());
-    ps->set_sampler_state("Sampler", sampler_state);
+    vs->bind();
 
-    ps->set_float3("cameraPos", app::instance()->camera()->position());
-    ps->set_float3("lightColor", light_color);
-    ps->set_float3("lightPos", pos);
-    ps->set_float("radius", radius);
-    ps->set_float("intensity", intensity);
-    ps->set_float("falloff", falloff);
-    ps->set_float4("ambientColor", ambient);
+    ps->set_shader_resource_view(clustered.position, core::position_gbuffer());
+    ps->set_shader_resource_view(clustered.normal, core::normal_gbuffer());
+    ps->set_shader_resource_view(clustered.diffuse, core::diffuse_gbuffer());
+    ps->set_shader_resource_view(clustered.lights, light_buffer.srv);
+    ps->set_shader_resource_view(clustered.ranges, cluster_buffer.srv);
+    ps->set_shader_resource_view(clustered.indices, index_buffer.srv);
+    ps->set_sampler_state(clustered.sampler, sampler_state);
+
+    light_constants constants{};
+    constants.slice_scale = clusters.slice_scale();
+    constants.slice_bias  = clusters.slice_bias();
+    constants.tile_scale  = { (f32) clusters.tiles_x() / (f32) system::width(),
+                              (f32) clusters.tiles_y() / (f32) system::height() };
+    constants.tiles_x     = clusters.tiles_x();
+    constants.tiles_y     = clusters.tiles_y();
+    constants.slices      = clusters.slices();
+    ps->set_buffer(light_cbuffer, constants);
 
     ps->copy_all_buffers();
     ps->bind();
 
-    //core::get_device_context()->DrawIndexed(model->index_count(), 0, 0);
-    ID3D11Buffer* nothing{};
-    constexpr u32 stride = sizeof(vertex_position_normal_texture);
-    u32           offset{};
-    core::get_device_context()->IASetVertexBuffers(0, 1, &nothing, &stride, &offset);
-    core::get_device_context()->IASetIndexBuffer(nullptr, DXGI_FORMAT_R32_UINT, 0);
-    core::get_device_context()->Draw(3, 0);
+    // Only the pixels under some light's projected footprint are shaded. NDC y points up, pixel rows go down
+    const math::screen_bounds& footprint = clusters.footprint();
+    const f32                  width     = (f32) system::width();
+    const f32                  height    = (f32) system::height();
+
+    D3D11_RECT scissor{};
+    scissor.left   = (LONG) floorf((footprint.min.x + 1.f) * .5f * width);
+    scissor.right  = (LONG) ceilf((footprint.max.x + 1.f) * .5f * width);
+    scissor.top    = (LONG) floorf((1.f - footprint.max.y) * .5f * height);
+    scissor.bottom = (LONG) ceilf((1.f - footprint.min.y) * .5f * height);
+    core::enable_scissor(scissor);
+
+    state::set_vertex_buffer(0, nullptr, sizeof(vertex_position_normal_texture), 0);
+    state::set_index_buffer(nullptr, DXGI_FORMAT_R32_UINT);
+    core::backend()->draw(3, 0);
+
+    core::disable_scissor();
 }
 
-void add_pointlight(game_object* obj, pointlight_component* light)
+// A single instanced draw of one sphere per light. Lights off screen are clipped by the GPU, and the depth test keeps
+// each sphere to the surfaces inside its depth range, so the cost follows what the lights cover on screen
+void render_light_volumes(const std::vector<packed_pointlight>& packed)
 {
-    pointlights.push_back({ obj, light });
+    if (packed.empty())
+    {
+        return;
+    }
+
+    if (!light_buffer.upload(packed.data(), (u32) packed.size(), sizeof(packed_pointlight)))
+    {
+        LOG_ERROR("Failed to upload the light volume buffer");
+        return;
+    }
+
+    vertex_shader* vs = shaders::light_volumes()->vs;
+    pixel_shader*  ps = shaders::light_volumes()->ps;
+
+    vs->set_shader_resource_view(volumes.vs_lights, light_buffer.srv);
+    vs->bind();
+
+    ps->set_shader_resource_view(volumes.position, core::position_gbuffer());
+    ps->set_shader_resource_view(volumes.normal, core::normal_gbuffer());
+    ps->set_shader_resource_view(volumes.diffuse, core::diffuse_gbuffer());
+    ps->set_shader_resource_view(volumes.lights, light_buffer.srv);
+    ps->copy_all_buffers();
+    ps->bind();
+
+    light_volume->bind();
+
+    core::enable_light_volumes();
+    core::backend()->draw_indexed_instanced(light_volume->index_count(), (u32) packed.size(), 0, 0, 0);
+    core::disable_light_volumes();
 }
 
+} // anonymous namespace
+
 void render_all_pointlights()
 {
-    for (auto pl : pointlights)
+    const auto& packed = drawing->lights;
+    if (use_light_volumes)
     {
-        auto* obj   = pl.first;
-        auto* light = pl.second;
-
-        render_pointlight(obj->position(), obj->world_transformation(), light->light_color(), light->radius(), light->intensity(),
-                          light->falloff());
+        render_light_volumes(packed);
+    } else
+    {
+        render_light_clusters(packed);
     }
 }
 
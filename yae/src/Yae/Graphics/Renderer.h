@@ -23,7 +23,11 @@
 
 #pragma once
 
+#include "FrameConstants.h"
+#include "FramePacket.h"
+#include "LightRegistry.h"
 #include "Model.h"
+#include "RenderQueue.h"
 #include "Texture.h"
 #include "Yae/Scene/GameComponent.h"
 #include "Yae/Scene/GameObject.h"
@@ -31,18 +35,82 @@
 namespace yae::gfx
 {
 
-void init_renderer();
+// Everything the frame's draws share, built once by begin_frame from the frame's packet
+struct render_context
+{
+    frame_constants constants{}; // As uploaded to the frame buffer
+    math::matrix    view{};
+    math::matrix    projection{};
+    math::vec3      camera_pos{};
+};
+
+bool init_renderer();
 void shutdown_renderer();
-void render3d(const model* model, const math::matrix& world, const material& mat);
-void render2d(const model* model, const texture* tex, const math::matrix& world);
 
-void render_base_to_screen();
+/**
+ * \brief Starts filling a frame packet on the simulation side. render3d, render2d and render_text add to it until
+ * end_extract
+ * \param packet Packet to fill, its previous contents are dropped
+ * \param view Camera view matrix, depths of 3D draws are measured from it
+ * \param camera_pos Camera world position
+ */
+void begin_extract(frame_packet& packet, const math::matrix& view, const math::vec3& camera_pos);
+
+// Copies the point lights into the packet, which is then ready for begin_frame
+void end_extract();
+
+/**
+ * \brief Starts drawing a frame. Fills the render context, uploads and binds the per-frame constant buffer, so per
+ * draw work is left with world matrices and materials. Passes are flushed from the packet until the next begin_frame
+ * \param packet An extracted packet, it isn't touched by the simulation until the frame is drawn
+ * \return False if the frame constants could not be uploaded
+ */
+bool begin_frame(frame_packet& packet);
 
-void render_pointlight(const math::vec3& pos, const math::matrix& world, const math::vec3& light_color, f32 radius, f32 intensity,
-                       f32 falloff);
+const render_context& frame_context();
 
-void add_pointlight(game_object* obj, pointlight_component* light);
+/**
+ * \brief Queues a 3D draw for the geometry pass of the packet being extracted. Nothing is drawn until the pass is
+ * flushed
+ * \param model The model to draw, the packet keeps it alive until the frame is drawn
+ * \param world World matrix
+ * \param mat Registered material
+ */
+void render3d(ref<const model> model, const math::matrix& world, material_id mat);
+
+/**
+ * \brief Queues a 2D draw for the overlay pass of the packet being extracted. Nothing is drawn until the pass is
+ * flushed
+ * \param model The model to draw, the packet keeps it alive until the frame is drawn
+ * \param tex Texture to draw with, kept alive the same way
+ * \param world World matrix, its z orders overlays back to front
+ */
+void render2d(ref<const model> model, ref<const texture> tex, const math::matrix& world);
+
+/**
+ * \brief Queues text for the overlay pass of the packet being extracted, drawn after its 2D draws
+ * \param string String to draw with, the packet keeps it alive until the frame is drawn
+ * \param text What it shows this frame
+ * \param color Color it is drawn in this frame
+ */
+void render_text(ref<text_string> string, const std::string& text, const math::vec4& color);
+
+/**
+ * \brief Sorts the frame's queue and draws one pass's packets, binding shaders, materials and models only when they
+ * change. The overlay pass draws the frame's text last
+ * \param pass The pass to draw. Its packets are removed from the queue afterwards
+ */
+void flush_queue(render_pass pass);
+
+void render_base_to_screen();
 
+/**
+ * \brief Adds the point lights extracted into the frame's packet to the lit G-buffer.\n\n
+ * By default the lights are assigned to view space clusters and shaded in a single full screen pass, each pixel only
+ * evaluating the lights in its cluster, scissored to the screen rectangle the visible lights project to. With
+ * <code>graphics.light_volumes</code> set every light is instead a low poly sphere, all of them drawn in one instanced
+ * call that only shades the pixels inside some light's volume
+ */
 void render_all_pointlights();
 
 ID3D11SamplerState* default_sampler_state();
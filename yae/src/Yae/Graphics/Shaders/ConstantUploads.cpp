@@ -0,0 +1,152 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: ConstantUploads.cpp
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+#include "ConstantUploads.h"
+
+#include "../D3D11Core.h"
+
+namespace yae::gfx::constant_uploads
+{
+
+namespace
+{
+constexpr u32 block_alignment = 256; // Offset binding works on multiples of 16 constants
+
+ID3D11Buffer* ring{};
+u32           ring_size{};
+u32           ring_offset{};
+u32           ring_generation{};
+
+upload_stats frame{};
+upload_stats previous{};
+} // anonymous namespace
+
+bool init(u32 size)
+{
+    render_backend* backend = core::backend();
+    if (!backend->supports_constant_offsets())
+    {
+        LOG_WARN("Constant buffer offsetting is not supported, per-draw constants fall back to UpdateSubresource");
+        return true;
+    }
+
+    D3D11_BUFFER_DESC desc{};
+    desc.Usage          = D3D11_USAGE_DYNAMIC;
+    desc.ByteWidth      = (size + block_alignment - 1) & ~(block_alignment - 1);
+    desc.BindFlags      = D3D11_BIND_CONSTANT_BUFFER;
+    desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+    if (FAILED(backend->create_buffer(&desc, nullptr, &ring)))
+    {
+        LOG_ERROR("Failed to create the constant buffer ring");
+        return false;
+    }
+
+    ring_size   = desc.ByteWidth;
+    ring_offset = ring_size; // Forces a discard on the first allocation
+    LOG_INFO("Created constant buffer ring of {} KB", ring_size / 1024);
+    return true;
+}
+
+void shutdown()
+{
+    core::release(ring);
+    ring_size   = 0;
+    ring_offset = 0;
+}
+
+bool ring_available()
+{
+    return ring != nullptr;
+}
+
+bool allocate(const void* data, u32 size, ring_range& range)
+{
+    const u32 aligned = (size + block_alignment - 1) & ~(block_alignment - 1);
+    if (!ring || aligned > ring_size)
+    {
+        return false;
+    }
+
+    D3D11_MAP map_type = D3D11_MAP_WRITE_NO_OVERWRITE;
+    if (ring_offset + aligned > ring_size)
+    {
+        // Discarding hands us fresh memory while the GPU keeps reading the old ring
+        map_type    = D3D11_MAP_WRITE_DISCARD;
+        ring_offset = 0;
+        ++ring_generation;
+    }
+
+    D3D11_MAPPED_SUBRESOURCE mapped{};
+    if (FAILED(core::backend()->map(ring, 0, map_type, &mapped)))
+    {
+        return false;
+    }
+
+    memcpy((u8*) mapped.pData + ring_offset, data, size);
+    core::backend()->unmap(ring, 0);
+
+    range.buffer         = ring;
+    range.first_constant = ring_offset / 16;
+    range.constant_count = aligned / 16;
+    range.generation     = ring_generation;
+    ring_offset += aligned;
+    return true;
+}
+
+bool stale(const ring_range& range)
+{
+    return !range.buffer || range.generation != ring_generation;
+}
+
+void record_upload(u32 bytes, bool ring_upload)
+{
+    frame.bytes_uploaded += bytes;
+    ++frame.uploads;
+    if (ring_upload)
+    {
+        ++frame.ring_uploads;
+    }
+}
+
+void record_skip()
+{
+    ++frame.skipped;
+}
+
+const upload_stats& current()
+{
+    return frame;
+}
+
+const upload_stats& last_frame()
+{
+    return previous;
+}
+
+void end_frame()
+{
+    previous = frame;
+    frame    = {};
+}
+
+} // namespace yae::gfx::constant_uploads
@@ -0,0 +1,84 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: ConstantUploads.h
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+
+#pragma once
+
+#include "../D3D11Common.h"
+
+namespace yae::gfx::constant_uploads
+{
+
+struct upload_stats
+{
+    u64 bytes_uploaded{};
+    u32 uploads{};
+    u32 ring_uploads{};
+    u32 skipped{}; // Copies requested on buffers that were not dirty
+};
+
+// Where a ring backed constant buffer currently lives, in 16 byte constants as the offset binding expects
+struct ring_range
+{
+    ID3D11Buffer* buffer{};
+    u32           first_constant{};
+    u32           constant_count{};
+    u32           generation{}; // Ring wrap the range was written in
+};
+
+/**
+ * \brief Creates the dynamic ring used by per-draw constant buffers. Offset binding needs a backend that supports
+ * constant offsets, without one the ring stays disabled and every buffer is uploaded with <code>UpdateSubresource</code>
+ * \param size Size of the ring in bytes
+ * \return False if the ring buffer could not be created
+ */
+bool init(u32 size = 4 * 1024 * 1024);
+void shutdown();
+
+bool ring_available();
+
+/**
+ * \brief Copies data into the next free 256 byte aligned block of the ring. Wrapping around discards the ring,
+ * everything else is appended with <code>NO_OVERWRITE</code>
+ * \param data Constant data
+ * \param size Size of the data in bytes
+ * \param range Receives the buffer and constant range to bind
+ * \return False if the ring is unavailable or the data is larger than the ring
+ */
+bool allocate(const void* data, u32 size, ring_range& range);
+
+// True once the ring has wrapped since the range was written, its contents were discarded and must be uploaded again
+bool stale(const ring_range& range);
+
+void record_upload(u32 bytes, bool ring_upload);
+void record_skip();
+
+// Counters of the frame in progress
+const upload_stats& current();
+
+// Counters of the last finished frame
+const upload_stats& last_frame();
+
+// Called once the frame has been presented
+void end_frame();
+
+} // namespace yae::gfx::constant_uploads
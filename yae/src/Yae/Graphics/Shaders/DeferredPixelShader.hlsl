@@ -2,14 +2,7 @@ Texture2D textureSRV : register(t0);
 Texture2D textureSRVBump : register(t1);
 SamplerState Sampler : register(s0);
 
-cbuffer Data : register(b0)
-{
-    float4 tintColor;
-    float4 ambientColor;
-    float4 dirLightColor;
-    float3 lightDirection;
-    float padding;
-}
+#include "FrameData.hlsli"
 
 struct PixelInput
 {
@@ -20,6 +13,7 @@ struct PixelInput
     float3 tangent : TANGENT;
     float3 binormal : BINORMAL;
     float3 viewDirection : TEXCOORD1;
+    float4 tint : COLOR0;
 };
 
 struct PixelOutput
@@ -34,7 +28,7 @@ PixelOutput main(PixelInput input)
     PixelOutput output;
 
     const float4 diffuse = textureSRV.Sample(Sampler, input.uv);
-    float4 diff = diffuse * tintColor;
+    float4 diff = diffuse * input.tint;
     float4 color = ambientColor * diff;
 
     float4 bump = textureSRVBump.Sample(Sampler, input.uv);
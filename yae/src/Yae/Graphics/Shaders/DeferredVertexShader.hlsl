@@ -1,16 +1,5 @@
 
-cbuffer MatrixData : register(b0)
-{
-    matrix worldMatrix;
-    matrix viewMatrix;
-    matrix projectionMatrix;
-}
-
-cbuffer Data : register(b1)
-{
-    float3 cameraPos;
-    float padding;
-}
+#include "FrameData.hlsli"
 
 struct VertexInput
 {
@@ -19,6 +8,13 @@ struct VertexInput
     float2 uv : TEXCOORD0;
     float3 tangent : TANGENT;
     float3 binormal : BINORMAL;
+
+    // Per instance stream, the world matrix's rows as uploaded from the CPU
+    float4 world0 : WORLD_PER_INSTANCE0;
+    float4 world1 : WORLD_PER_INSTANCE1;
+    float4 world2 : WORLD_PER_INSTANCE2;
+    float4 world3 : WORLD_PER_INSTANCE3;
+    float4 tint : TINT_PER_INSTANCE;
 };
 
 struct PixelInput
@@ -30,12 +26,15 @@ struct PixelInput
     float3 tangent : TANGENT;
     float3 binormal : BINORMAL;
     float3 viewDirection : TEXCOORD1;
+    float4 tint : COLOR0;
 };
 
 PixelInput main(VertexInput input)
 {
     PixelInput output;
 
+    matrix worldMatrix = float4x4(input.world0, input.world1, input.world2, input.world3);
+
     matrix wvp = mul(mul(worldMatrix, viewMatrix), projectionMatrix);
     output.position = mul(float4(input.position, 1.0f), wvp);
     output.worldPos = mul(float4(input.position, 1.0f), worldMatrix).xyz;
@@ -49,6 +48,7 @@ PixelInput main(VertexInput input)
     output.binormal = normalize(output.binormal);
 
     output.viewDirection = normalize(cameraPos - output.worldPos);
+    output.tint = input.tint;
 
     return output;
 }
\ No newline at end of file
@@ -0,0 +1,12 @@
+// Written once per frame by the renderer, see FrameConstants.h. Shaders only read it, they never own or bind it
+cbuffer FrameData : register(b12)
+{
+    matrix viewMatrix;
+    matrix projectionMatrix;
+    float4 ambientColor;
+    float4 dirLightColor;
+    float3 cameraPos;
+    float framePadding0;
+    float3 lightDirection;
+    float framePadding1;
+}
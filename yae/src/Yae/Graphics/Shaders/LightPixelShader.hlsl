@@ -3,15 +3,22 @@ Texture2D normalGB : register(t1);
 Texture2D diffuseGB : register(t2);
 SamplerState Sampler : register(s0);
 
+#include "FrameData.hlsli"
+#include "PointLight.hlsli"
+
+// Filled on the CPU every frame, see LightClusters.h
+StructuredBuffer<PointLight> pointLights : register(t3);
+StructuredBuffer<uint2> clusterRanges : register(t4);
+StructuredBuffer<uint> lightIndices : register(t5);
+
 cbuffer Data : register(b0)
 {
-    float3 cameraPos;
-    float3 lightColor;
-    float3 lightPos;
-    float radius;
-    float intensity;
-    float falloff;
-    float4 ambientColor;
+    float sliceScale;
+    float2 tileScale;
+    float sliceBias;
+    uint tilesX;
+    uint tilesY;
+    uint slices;
 }
 
 struct PixelInput
@@ -19,40 +26,12 @@ struct PixelInput
     float4 position : SV_POSITION;
 };
 
-
-float sqr(float x)
-{
-    return x * x;
-}
-
-float CalculateAttenuation(float dist)
-{
-    float s = dist / radius;
-    if (s >= 1.0f)
-    {
-        return 0.0f;
-    }
-
-    float s2 = sqr(s);
-    return intensity * sqr(1 - s2) / (1 + falloff * s);
-}
-
-float4 CalculatePointLight(float3 normal, float3 viewDir, float4 textureColor, float3 pos)
+uint ClusterIndex(float2 pixel, float3 position)
 {
-    float3 lightDir = normalize(pos);
-    float diff = max(dot(normal, lightDir), 0.0f);
-    float3 reflectDir = reflect(-lightDir, normal);
-    float spec = pow(max(dot(viewDir, reflectDir), 0.0f), 32.0f);
-    
-    float dist = length(pos);
-    //float atten = 1.0f / (light.constantFactor + light.linearFactor * dist + light.quadraticFactor * dist * dist);
-    float atten = CalculateAttenuation(dist);
-
-    float4 ambient = ambientColor * textureColor * atten;
-    float4 dif = float4(lightColor, 1.0f) * diff * textureColor * atten;
-    float4 specColor = float4(lightColor, 1.0f) * spec * textureColor * atten;
-
-    return ambient + dif + specColor;
+    float viewZ = mul(float4(position, 1.0f), viewMatrix).z;
+    uint slice = (uint) clamp(floor(log(max(viewZ, 1e-4f)) * sliceScale + sliceBias), 0.0f, (float) (slices - 1));
+    uint2 tile = min((uint2) (pixel * tileScale), uint2(tilesX - 1, tilesY - 1));
+    return (slice * tilesY + tile.y) * tilesX + tile.x;
 }
 
 float4 main(PixelInput input) : SV_TARGET
@@ -61,8 +40,17 @@ float4 main(PixelInput input) : SV_TARGET
     float3 normal = normalGB.Load(sampleIndices).xyz;
     float3 position = positionGB.Load(sampleIndices).xyz;
     float4 diffuse = diffuseGB.Load(sampleIndices);
+    float3 viewDir = normalize(cameraPos - position);
 
-    float4 color = CalculatePointLight(normal, normalize(cameraPos - position), diffuse, lightPos - position);
+    // Only the lights assigned to this pixel's cluster are evaluated
+    uint2 range = clusterRanges[ClusterIndex(input.position.xy, position)];
+
+    float4 color = float4(0.0f, 0.0f, 0.0f, 0.0f);
+    for (uint i = 0; i < range.y; ++i)
+    {
+        PointLight light = pointLights[lightIndices[range.x + i]];
+        color += CalculatePointLight(light, normal, viewDir, diffuse, light.position - position);
+    }
 
     return color;
-}
\ No newline at end of file
+}
@@ -0,0 +1,27 @@
+Texture2D positionGB : register(t0);
+Texture2D normalGB : register(t1);
+Texture2D diffuseGB : register(t2);
+
+#include "FrameData.hlsli"
+#include "PointLight.hlsli"
+
+StructuredBuffer<PointLight> pointLights : register(t3);
+
+struct PixelInput
+{
+    float4 position : SV_POSITION;
+    nointerpolation uint light : LIGHTINDEX;
+};
+
+// Runs only where the volume's back faces lie behind the G-buffer surface, each light adds its own contribution
+float4 main(PixelInput input) : SV_TARGET
+{
+    int3 sampleIndices = int3(input.position.xy, 0);
+    float3 normal = normalGB.Load(sampleIndices).xyz;
+    float3 position = positionGB.Load(sampleIndices).xyz;
+    float4 diffuse = diffuseGB.Load(sampleIndices);
+    float3 viewDir = normalize(cameraPos - position);
+
+    PointLight light = pointLights[input.light];
+    return CalculatePointLight(light, normal, viewDir, diffuse, light.position - position);
+}
@@ -0,0 +1,31 @@
+#include "FrameData.hlsli"
+#include "PointLight.hlsli"
+
+// Same buffer the pixel shader reads, one instance per light
+StructuredBuffer<PointLight> pointLights : register(t0);
+
+struct VertexInput
+{
+    float3 position : POSITION;
+    uint instance : SV_InstanceID;
+};
+
+struct PixelInput
+{
+    float4 position : SV_POSITION;
+    nointerpolation uint light : LIGHTINDEX;
+};
+
+PixelInput main(VertexInput input)
+{
+    PixelInput output;
+
+    // The mesh is a unit sphere slightly inflated so its flat faces still enclose the light's radius
+    PointLight light = pointLights[input.instance];
+    float4 worldPos = float4(light.position + input.position * light.radius, 1.0f);
+
+    output.position = mul(mul(worldPos, viewMatrix), projectionMatrix);
+    output.light = input.instance;
+
+    return output;
+}
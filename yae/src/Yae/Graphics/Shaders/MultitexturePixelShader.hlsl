@@ -3,14 +3,7 @@ Texture2D textureSRVBlend : register(t1);
 Texture2D textureSRVBump : register(t2);
 SamplerState Sampler : register(s0);
 
-cbuffer Data : register(b0)
-{
-    float4 tintColor;
-    float4 ambientColor;
-    float4 dirLightColor;
-    float3 lightDirection;
-    float padding;
-}
+#include "FrameData.hlsli"
 
 struct PixelInput
 {
@@ -21,6 +14,7 @@ struct PixelInput
     float3 tangent : TANGENT;
     float3 binormal : BINORMAL;
     float3 viewDirection : TEXCOORD1;
+    float4 tint : COLOR0;
 };
 
 struct PixelOutput
@@ -37,7 +31,7 @@ PixelOutput main(PixelInput input)
     const float4 diffuse = textureSRV.Sample(Sampler, input.uv);
     const float4 blend = textureSRVBlend.Sample(Sampler, input.uv);
 
-    float4 diff = saturate(diffuse * blend * 2.0) * tintColor;
+    float4 diff = saturate(diffuse * blend * 2.0) * input.tint;
     float4 color = ambientColor * diff;
 
     float4 bump = textureSRVBump.Sample(Sampler, input.uv);
@@ -0,0 +1,44 @@
+// Point light as packed on the CPU, see packed_pointlight in Light.h. Needs FrameData.hlsli included first
+struct PointLight
+{
+    float3 position;
+    float radius;
+    float3 color;
+    float intensity;
+    float falloff;
+    float3 padding;
+};
+
+float sqr(float x)
+{
+    return x * x;
+}
+
+float CalculateAttenuation(PointLight light, float dist)
+{
+    float s = dist / light.radius;
+    if (s >= 1.0f)
+    {
+        return 0.0f;
+    }
+
+    float s2 = sqr(s);
+    return light.intensity * sqr(1 - s2) / (1 + light.falloff * s);
+}
+
+float4 CalculatePointLight(PointLight light, float3 normal, float3 viewDir, float4 textureColor, float3 pos)
+{
+    float3 lightDir = normalize(pos);
+    float diff = max(dot(normal, lightDir), 0.0f);
+    float3 reflectDir = reflect(-lightDir, normal);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0f), 32.0f);
+    
+    float dist = length(pos);
+    float atten = CalculateAttenuation(light, dist);
+
+    float4 ambient = ambientColor * textureColor * atten;
+    float4 dif = float4(light.color, 1.0f) * diff * textureColor * atten;
+    float4 specColor = float4(light.color, 1.0f) * spec * textureColor * atten;
+
+    return ambient + dif + specColor;
+}
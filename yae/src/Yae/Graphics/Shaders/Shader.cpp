@@ -26,8 +26,11 @@
 #include "Yae/Core/System.h"
 #include "Yae/Core/Application.h"
 #include "../D3D11Core.h"
+#include "../FrameConstants.h"
+#include "../StateCache.h"
 
 #include <d3dcompiler.h>
+#include <filesystem>
 
 
 using namespace DirectX;
@@ -40,8 +43,7 @@ namespace yae::gfx
 
 shader::shader()
 {
-    m_device  = core::get_device();
-    m_context = core::get_device_context();
+    m_backend = core::backend();
 }
 
 shader::~shader()
@@ -61,6 +63,7 @@ bool shader::load_from_file(const std::string& filename)
 
     DX_CALL(D3DReadFileToBlob(widefile.c_str(), &m_blob));
 
+    m_name  = std::filesystem::path{ filename }.stem().string();
     m_valid = create_shader(m_blob);
     if (!m_valid)
     {
@@ -87,10 +90,12 @@ bool shader::load_from_file(const std::string& filename)
         switch (res_desc.Type)
         {
         case D3D_SIT_TEXTURE:
+        case D3D_SIT_STRUCTURED:
         {
             LOG_DEBUG("Found shader resource '{}' at bind index: {}", res_desc.Name, res_desc.BindPoint);
             shader_resource* srv = new shader_resource{ (u32) m_shader_resources.size(), res_desc.BindPoint };
             m_texture_table.insert(std::pair<std::string, shader_resource*>{ res_desc.Name, srv });
+            m_srv_hashes.insert({ param_hash(res_desc.Name), shader_slot{ res_desc.BindPoint } });
             m_shader_resources.push_back(srv);
         }
         break;
@@ -99,6 +104,7 @@ bool shader::load_from_file(const std::string& filename)
             LOG_DEBUG("Found sampler '{}' at bind index: {}", res_desc.Name, res_desc.BindPoint);
             sampler* samp = new sampler{ (u32) m_samplers.size(), res_desc.BindPoint };
             m_sampler_table.insert(std::pair<std::string, sampler*>{ res_desc.Name, samp });
+            m_sampler_hashes.insert({ param_hash(res_desc.Name), shader_slot{ res_desc.BindPoint } });
             m_samplers.push_back(samp);
         }
         break;
@@ -119,6 +125,21 @@ bool shader::load_from_file(const std::string& filename)
         m_constant_buffers[i].bind_index = bind_desc.BindPoint;
         m_constant_buffers[i].name       = buf_desc.Name;
         LOG_DEBUG("Found constant buffer '{}' at bind index: {}", buf_desc.Name, bind_desc.BindPoint);
+
+        // The renderer owns the per-frame buffer, its variables are not settable through the shader
+        if (m_constant_buffers[i].name == frame::buffer_name)
+        {
+            if (buf_desc.Size != sizeof(frame_constants))
+            {
+                LOG_ERROR("'{}' in `{}` is {} bytes, frame_constants is {}", buf_desc.Name, filename, buf_desc.Size,
+                          sizeof(frame_constants));
+            }
+            m_constant_buffers[i].external = true;
+            m_constant_buffers[i].dirty    = false;
+            m_constant_buffers[i].size     = buf_desc.Size;
+            continue;
+        }
+
         m_const_buffer_table.insert(std::pair<std::string, constant_buffer*>{ buf_desc.Name, &m_constant_buffers[i] });
 
         D3D11_BUFFER_DESC new_buf_desc{};
@@ -129,7 +150,7 @@ bool shader::load_from_file(const std::string& filename)
         new_buf_desc.MiscFlags           = 0;
         new_buf_desc.StructureByteStride = 0;
 
-        DX_CALL(m_device->CreateBuffer(&new_buf_desc, nullptr, &m_constant_buffers[i].const_buffer));
+        DX_CALL(m_backend->create_buffer(&new_buf_desc, nullptr, &m_constant_buffers[i].const_buffer));
 
         m_constant_buffers[i].size        = buf_desc.Size;
         m_constant_buffers[i].data_buffer = new u8[buf_desc.Size];
@@ -147,6 +168,10 @@ bool shader::load_from_file(const std::string& filename)
             std::string name = var_desc.Name;
             LOG_DEBUG("Found variable '{}'", name);
             m_var_table.insert({ name, sv });
+            if (!m_param_hashes.insert({ param_hash(name), shader_param{ i, sv.byte_offset, sv.size } }).second)
+            {
+                LOG_WARN("Parameter hash collision on '{}' in `{}`, its handle resolves to another variable", name, filename);
+            }
             m_constant_buffers[i].variables.push_back(sv);
         }
     }
@@ -176,7 +201,7 @@ void shader::copy_all_buffers() const
 
     for (u32 i = 0; i < m_buffer_count; ++i)
     {
-        m_context->UpdateSubresource(m_constant_buffers[i].const_buffer, 0, nullptr, m_constant_buffers[i].data_buffer, 0, 0);
+        upload(m_constant_buffers[i]);
     }
 }
 
@@ -192,13 +217,7 @@ void shader::copy_buffer(u32 index) const
         return;
     }
 
-    const constant_buffer* cb = &m_constant_buffers[index];
-    if (!cb)
-    {
-        return;
-    }
-
-    m_context->UpdateSubresource(cb->const_buffer, 0, nullptr, cb->data_buffer, 0, 0);
+    upload(m_constant_buffers[index]);
 }
 
 void shader::copy_buffer(const std::string& name)
@@ -208,13 +227,26 @@ void shader::copy_buffer(const std::string& name)
         return;
     }
 
-    const constant_buffer* cb = find_constant_buffer(name);
+    constant_buffer* cb = find_constant_buffer(name);
     if (!cb)
     {
         return;
     }
 
-    m_context->UpdateSubresource(cb->const_buffer, 0, nullptr, cb->data_buffer, 0, 0);
+    upload(*cb);
+}
+
+bool shader::use_ring(const std::string& name)
+{
+    constant_buffer* cb = find_constant_buffer(name);
+    if (!cb || !constant_uploads::ring_available())
+    {
+        return false;
+    }
+
+    cb->ring  = true;
+    cb->dirty = true;
+    return true;
 }
 
 bool shader::set_data(const std::string& name, const void* data, u32 size)
@@ -225,7 +257,13 @@ bool shader::set_data(const std::string& name, const void* data, u32 size)
         return false;
     }
 
-    CopyMemory(m_constant_buffers[var->constant_buffer_index].data_buffer + var->byte_offset, data, size);
+    constant_buffer& cb  = m_constant_buffers[var->constant_buffer_index];
+    u8*              dst = cb.data_buffer + var->byte_offset;
+    if (memcmp(dst, data, size) != 0)
+    {
+        CopyMemory(dst, data, size);
+        cb.dirty = true;
+    }
     return true;
 }
 
@@ -277,6 +315,91 @@ bool shader::set_matrix(const std::string& name, const math::mat4& data)
     return set_data(name, &data, sizeof(f32) * 16);
 }
 
+shader_param shader::param(u32 name_hash) const
+{
+    const auto it = m_param_hashes.find(name_hash);
+    if (it == m_param_hashes.end())
+    {
+        return {};
+    }
+
+    return it->second;
+}
+
+shader_slot shader::srv_slot(u32 name_hash) const
+{
+    const auto it = m_srv_hashes.find(name_hash);
+    if (it == m_srv_hashes.end())
+    {
+        return {};
+    }
+
+    return it->second;
+}
+
+shader_slot shader::sampler_slot(u32 name_hash) const
+{
+    const auto it = m_sampler_hashes.find(name_hash);
+    if (it == m_sampler_hashes.end())
+    {
+        return {};
+    }
+
+    return it->second;
+}
+
+bool shader::set_data(shader_param param, const void* data, u32 size)
+{
+    if (!param.is_valid() || size > param.size)
+    {
+        return false;
+    }
+
+    constant_buffer& cb  = m_constant_buffers[param.buffer_index];
+    u8*              dst = cb.data_buffer + param.byte_offset;
+    if (memcmp(dst, data, size) != 0)
+    {
+        CopyMemory(dst, data, size);
+        cb.dirty = true;
+    }
+    return true;
+}
+
+bool shader::set_int(shader_param param, i32 data)
+{
+    return set_data(param, &data, sizeof(i32));
+}
+
+bool shader::set_float(shader_param param, f32 data)
+{
+    return set_data(param, &data, sizeof(f32));
+}
+
+bool shader::set_float2(shader_param param, const math::vec2& data)
+{
+    return set_data(param, &data, sizeof(f32) * 2);
+}
+
+bool shader::set_float3(shader_param param, const math::vec3& data)
+{
+    return set_data(param, &data, sizeof(f32) * 3);
+}
+
+bool shader::set_float4(shader_param param, const math::vec4& data)
+{
+    return set_data(param, &data, sizeof(f32) * 4);
+}
+
+bool shader::set_matrix(shader_param param, const math::matrix& data)
+{
+    return set_data(param, &data, sizeof(f32) * 16);
+}
+
+bool shader::set_matrix(shader_param param, const math::mat4& data)
+{
+    return set_data(param, &data, sizeof(f32) * 16);
+}
+
 const shader_variable* shader::variable_info(const std::string& name)
 {
     return find_variable(name, 0);
@@ -326,6 +449,48 @@ const sampler* shader::sampler_info(u32 index) const
     return m_samplers[index];
 }
 
+void shader::upload(constant_buffer& cb) const
+{
+    if (cb.external)
+    {
+        return;
+    }
+
+    if (!cb.dirty && !(cb.ring && constant_uploads::stale(cb.ring_range)))
+    {
+        constant_uploads::record_skip();
+        return;
+    }
+
+    if (cb.ring)
+    {
+        if (constant_uploads::allocate(cb.data_buffer, cb.size, cb.ring_range))
+        {
+            // The new range only takes effect once bound, shaders are usually bound before their per-draw copies
+            bind_constant_buffer(cb);
+            constant_uploads::record_upload(cb.size, true);
+            cb.dirty = false;
+            return;
+        }
+
+        LOG_WARN("Constant ring allocation failed for '{}', falling back to its own buffer", cb.name);
+        cb.ring = false;
+        bind_constant_buffer(cb);
+    }
+
+    m_backend->update_subresource(cb.const_buffer, 0, cb.data_buffer, 0, 0);
+    constant_uploads::record_upload(cb.size, false);
+    cb.dirty = false;
+}
+
+void shader::name_object(ID3D11DeviceChild* object) const
+{
+    if (object && !m_name.empty())
+    {
+        object->SetPrivateData(WKPDID_D3DDebugObjectName, (u32) m_name.size(), m_name.data());
+    }
+}
+
 u32 shader::buffer_size(u32 index)
 {
     assert(index < m_buffer_count);
@@ -381,6 +546,9 @@ void shader::shutdown()
     m_const_buffer_table.clear();
     m_sampler_table.clear();
     m_texture_table.clear();
+    m_param_hashes.clear();
+    m_srv_hashes.clear();
+    m_sampler_hashes.clear();
 }
 
 shader_variable* shader::find_variable(const std::string& name, u32 size)
@@ -413,6 +581,68 @@ constant_buffer* shader::find_constant_buffer(const std::string& name)
     return it->second;
 }
 
+u32 shader::validate_buffer(const std::string& name, std::span<const cbuffer_field> fields, u32 size)
+{
+    const constant_buffer* cb = find_constant_buffer(name);
+    if (!cb)
+    {
+        LOG_ERROR("Typed constant buffer '{}' not found", name);
+        return invalid_u32;
+    }
+
+    const u32 index = (u32) (cb - m_constant_buffers);
+
+    // HLSL pads buffers to 16 bytes, the struct may stop short of that padding but not of any variable
+    if (size > cb->size)
+    {
+        LOG_ERROR("Typed constant buffer '{}' is {} bytes, the struct is {}", name, cb->size, size);
+        return invalid_u32;
+    }
+
+    u32 matched{};
+    for (const auto& [var_name, var] : m_var_table)
+    {
+        if (var.constant_buffer_index != index)
+        {
+            continue;
+        }
+
+        const auto field =
+            std::find_if(fields.begin(), fields.end(), [&](const cbuffer_field& f) { return f.name == var_name; });
+        if (field == fields.end() || field->offset != var.byte_offset || field->size != var.size)
+        {
+            LOG_ERROR("Typed constant buffer '{}' does not match variable '{}' (offset {}, size {})", name, var_name,
+                      var.byte_offset, var.size);
+            return invalid_u32;
+        }
+        ++matched;
+    }
+
+    if (matched != (u32) fields.size())
+    {
+        LOG_ERROR("Typed constant buffer '{}' has {} variables, the struct lists {}", name, matched, fields.size());
+        return invalid_u32;
+    }
+
+    return index;
+}
+
+bool shader::set_buffer_data(u32 index, const void* data, u32 size)
+{
+    if (index >= m_buffer_count)
+    {
+        return false;
+    }
+
+    constant_buffer& cb = m_constant_buffers[index];
+    if (memcmp(cb.data_buffer, data, size) != 0)
+    {
+        CopyMemory(cb.data_buffer, data, size);
+        cb.dirty = true;
+    }
+    return true;
+}
+
 
 ///////////// VERTEX SHADER ///////////////////
 
@@ -429,7 +659,7 @@ bool vertex_shader::set_sampler_state(const std::string& name, ID3D11SamplerStat
         return false;
     }
 
-    m_context->VSSetSamplers(info->bind_index, 1, &samp);
+    state::set_sampler(shader_stage::vertex, info->bind_index, samp);
     return true;
 }
 
@@ -441,7 +671,7 @@ bool vertex_shader::set_shader_resource_view(const std::string& name, ID3D11Shad
         return false;
     }
 
-    m_context->VSSetShaderResources(info->bind_index, 1, &srv);
+    state::set_shader_resources(shader_stage::vertex, info->bind_index, 1, &srv);
     return true;
 }
 
@@ -449,7 +679,8 @@ bool vertex_shader::create_shader(ID3D10Blob* blob)
 {
     shutdown();
     LOG_DEBUG("Creating vertex shader");
-    DX_CALL(m_device->CreateVertexShader(blob->GetBufferPointer(), blob->GetBufferSize(), nullptr, &m_shader));
+    DX_CALL(m_backend->create_vertex_shader(blob->GetBufferPointer(), blob->GetBufferSize(), &m_shader));
+    name_object(m_shader);
 
     if (m_input_layout)
     {
@@ -469,6 +700,12 @@ bool vertex_shader::create_shader(ID3D10Blob* blob)
         D3D11_SIGNATURE_PARAMETER_DESC param_desc{};
         refl->GetInputParameterDesc(i, &param_desc);
 
+        // SV_VertexID and SV_InstanceID are generated by the input assembler, no buffer feeds them
+        if (param_desc.SystemValueType != D3D_NAME_UNDEFINED)
+        {
+            continue;
+        }
+
         std::string per_instance_str = "_PER_INSTANCE";
         std::string sem              = param_desc.SemanticName;
         const i32   len_diff         = (i32)sem.size() - (i32)per_instance_str.size();
@@ -529,11 +766,17 @@ bool vertex_shader::create_shader(ID3D10Blob* blob)
         layout_desc.push_back(elem_desc);
     }
 
-    DX_CALL(m_device->CreateInputLayout(layout_desc.data(), (u32)layout_desc.size(), blob->GetBufferPointer(), blob->GetBufferSize(),
-                                        &m_input_layout));
-
     refl->Release();
 
+    // Shaders fed only by system values, like the full screen triangle, draw without a layout
+    if (layout_desc.empty())
+    {
+        return true;
+    }
+
+    DX_CALL(m_backend->create_input_layout(layout_desc.data(), (u32)layout_desc.size(), blob->GetBufferPointer(),
+                                           blob->GetBufferSize(), &m_input_layout));
+
     return true;
 }
 
@@ -544,13 +787,52 @@ void vertex_shader::set_shader_constant_buffers()
         return;
     }
 
-    m_context->IASetInputLayout(m_input_layout);
-    m_context->VSSetShader(m_shader, nullptr, 0);
+    state::set_input_layout(m_input_layout);
+    state::set_vertex_shader(m_shader);
 
     for (u32 i = 0; i < m_buffer_count; ++i)
     {
-        m_context->VSSetConstantBuffers(m_constant_buffers[i].bind_index, 1, &m_constant_buffers[i].const_buffer);
+        bind_constant_buffer(m_constant_buffers[i]);
+    }
+}
+
+void vertex_shader::bind_constant_buffer(const constant_buffer& cb) const
+{
+    if (cb.external)
+    {
+        return;
+    }
+
+    if (cb.ring)
+    {
+        const constant_uploads::ring_range& r = cb.ring_range;
+        state::set_constant_buffer(shader_stage::vertex, cb.bind_index, r.buffer, r.first_constant, r.constant_count);
+    } else
+    {
+        state::set_constant_buffer(shader_stage::vertex, cb.bind_index, cb.const_buffer);
+    }
+}
+
+bool vertex_shader::set_shader_resource_view(shader_slot slot, ID3D11ShaderResourceView* srv)
+{
+    if (!slot.is_valid())
+    {
+        return false;
     }
+
+    state::set_shader_resources(shader_stage::vertex, slot.bind_index, 1, &srv);
+    return true;
+}
+
+bool vertex_shader::set_sampler_state(shader_slot slot, ID3D11SamplerState* sampler_state)
+{
+    if (!slot.is_valid())
+    {
+        return false;
+    }
+
+    state::set_sampler(shader_stage::vertex, slot.bind_index, sampler_state);
+    return true;
 }
 
 void vertex_shader::shutdown()
@@ -577,7 +859,7 @@ bool pixel_shader::set_shader_resource_view(const std::string& name, ID3D11Shade
         return false;
     }
 
-    m_context->PSSetShaderResources(info->bind_index, 1, &srv);
+    state::set_shader_resources(shader_stage::pixel, info->bind_index, 1, &srv);
     return true;
 }
 
@@ -589,7 +871,7 @@ bool pixel_shader::set_sampler_state(const std::string& name, ID3D11SamplerState
         return false;
     }
 
-    m_context->PSSetSamplers(info->bind_index, 1, &samp);
+    state::set_sampler(shader_stage::pixel, info->bind_index, samp);
     return true;
 }
 
@@ -597,7 +879,8 @@ bool pixel_shader::create_shader(ID3D10Blob* blob)
 {
     LOG_DEBUG("Creating pixel shader");
     shutdown();
-    DX_CALL(m_device->CreatePixelShader(blob->GetBufferPointer(), blob->GetBufferSize(), nullptr, &m_shader));
+    DX_CALL(m_backend->create_pixel_shader(blob->GetBufferPointer(), blob->GetBufferSize(), &m_shader));
+    name_object(m_shader);
 
     return true;
 }
@@ -609,12 +892,51 @@ void pixel_shader::set_shader_constant_buffers()
         return;
     }
 
-    m_context->PSSetShader(m_shader, nullptr, 0);
+    state::set_pixel_shader(m_shader);
 
     for (u32 i = 0; i < m_buffer_count; ++i)
     {
-        m_context->PSSetConstantBuffers(m_constant_buffers[i].bind_index, 1, &m_constant_buffers[i].const_buffer);
+        bind_constant_buffer(m_constant_buffers[i]);
+    }
+}
+
+void pixel_shader::bind_constant_buffer(const constant_buffer& cb) const
+{
+    if (cb.external)
+    {
+        return;
+    }
+
+    if (cb.ring)
+    {
+        const constant_uploads::ring_range& r = cb.ring_range;
+        state::set_constant_buffer(shader_stage::pixel, cb.bind_index, r.buffer, r.first_constant, r.constant_count);
+    } else
+    {
+        state::set_constant_buffer(shader_stage::pixel, cb.bind_index, cb.const_buffer);
+    }
+}
+
+bool pixel_shader::set_shader_resource_view(shader_slot slot, ID3D11ShaderResourceView* srv)
+{
+    if (!slot.is_valid())
+    {
+        return false;
+    }
+
+    state::set_shader_resources(shader_stage::pixel, slot.bind_index, 1, &srv);
+    return true;
+}
+
+bool pixel_shader::set_sampler_state(shader_slot slot, ID3D11SamplerState* sampler_state)
+{
+    if (!slot.is_valid())
+    {
+        return false;
     }
+
+    state::set_sampler(shader_stage::pixel, slot.bind_index, sampler_state);
+    return true;
 }
 
 void pixel_shader::shutdown()
@@ -640,7 +962,7 @@ bool domain_shader::set_shader_resource_view(const std::string& name, ID3D11Shad
         return false;
     }
 
-    m_context->DSSetShaderResources(info->bind_index, 1, &srv);
+    state::set_shader_resources(shader_stage::domain, info->bind_index, 1, &srv);
     return true;
 }
 
@@ -652,7 +974,7 @@ bool domain_shader::set_sampler_state(const std::string& name, ID3D11SamplerStat
         return false;
     }
 
-    m_context->DSSetSamplers(info->bind_index, 1, &sampler_state);
+    state::set_sampler(shader_stage::domain, info->bind_index, sampler_state);
     return true;
 }
 
@@ -660,7 +982,8 @@ bool domain_shader::create_shader(ID3D10Blob* blob)
 {
     LOG_DEBUG("Creating domain shader");
     shutdown();
-    DX_CALL(m_device->CreateDomainShader(blob->GetBufferPointer(), blob->GetBufferSize(), nullptr, &m_shader));
+    DX_CALL(m_backend->create_domain_shader(blob->GetBufferPointer(), blob->GetBufferSize(), &m_shader));
+    name_object(m_shader);
     return true;
 }
 
@@ -671,14 +994,53 @@ void domain_shader::set_shader_constant_buffers()
         return;
     }
 
-    m_context->DSSetShader(m_shader, nullptr, 0);
+    state::set_domain_shader(m_shader);
 
     for (u32 i = 0; i < m_buffer_count; ++i)
     {
-        m_context->DSSetConstantBuffers(m_constant_buffers[i].bind_index, 1, &m_constant_buffers[i].const_buffer);
+        bind_constant_buffer(m_constant_buffers[i]);
     }
 }
 
+void domain_shader::bind_constant_buffer(const constant_buffer& cb) const
+{
+    if (cb.external)
+    {
+        return;
+    }
+
+    if (cb.ring)
+    {
+        const constant_uploads::ring_range& r = cb.ring_range;
+        state::set_constant_buffer(shader_stage::domain, cb.bind_index, r.buffer, r.first_constant, r.constant_count);
+    } else
+    {
+        state::set_constant_buffer(shader_stage::domain, cb.bind_index, cb.const_buffer);
+    }
+}
+
+bool domain_shader::set_shader_resource_view(shader_slot slot, ID3D11ShaderResourceView* srv)
+{
+    if (!slot.is_valid())
+    {
+        return false;
+    }
+
+    state::set_shader_resources(shader_stage::domain, slot.bind_index, 1, &srv);
+    return true;
+}
+
+bool domain_shader::set_sampler_state(shader_slot slot, ID3D11SamplerState* sampler_state)
+{
+    if (!slot.is_valid())
+    {
+        return false;
+    }
+
+    state::set_sampler(shader_stage::domain, slot.bind_index, sampler_state);
+    return true;
+}
+
 void domain_shader::shutdown()
 {
     shader::shutdown();
@@ -701,7 +1063,7 @@ bool hull_shader::set_shader_resource_view(const std::string& name, ID3D11Shader
         return false;
     }
 
-    m_context->HSSetShaderResources(info->bind_index, 1, &srv);
+    state::set_shader_resources(shader_stage::hull, info->bind_index, 1, &srv);
     return true;
 }
 
@@ -713,7 +1075,7 @@ bool hull_shader::set_sampler_state(const std::string& name, ID3D11SamplerState*
         return false;
     }
 
-    m_context->HSSetSamplers(info->bind_index, 1, &sampler_state);
+    state::set_sampler(shader_stage::hull, info->bind_index, sampler_state);
     return true;
 }
 
@@ -721,7 +1083,8 @@ bool hull_shader::create_shader(ID3D10Blob* blob)
 {
     LOG_DEBUG("Creating hull shader");
     shutdown();
-    DX_CALL(m_device->CreateHullShader(blob->GetBufferPointer(), blob->GetBufferSize(), nullptr, &m_shader));
+    DX_CALL(m_backend->create_hull_shader(blob->GetBufferPointer(), blob->GetBufferSize(), &m_shader));
+    name_object(m_shader);
     return true;
 }
 
@@ -732,14 +1095,53 @@ void hull_shader::set_shader_constant_buffers()
         return;
     }
 
-    m_context->HSSetShader(m_shader, nullptr, 0);
+    state::set_hull_shader(m_shader);
 
     for (u32 i = 0; i < m_buffer_count; ++i)
     {
-        m_context->HSSetConstantBuffers(m_constant_buffers[i].bind_index, 1, &m_constant_buffers[i].const_buffer);
+        bind_constant_buffer(m_constant_buffers[i]);
+    }
+}
+
+void hull_shader::bind_constant_buffer(const constant_buffer& cb) const
+{
+    if (cb.external)
+    {
+        return;
+    }
+
+    if (cb.ring)
+    {
+        const constant_uploads::ring_range& r = cb.ring_range;
+        state::set_constant_buffer(shader_stage::hull, cb.bind_index, r.buffer, r.first_constant, r.constant_count);
+    } else
+    {
+        state::set_constant_buffer(shader_stage::hull, cb.bind_index, cb.const_buffer);
     }
 }
 
+bool hull_shader::set_shader_resource_view(shader_slot slot, ID3D11ShaderResourceView* srv)
+{
+    if (!slot.is_valid())
+    {
+        return false;
+    }
+
+    state::set_shader_resources(shader_stage::hull, slot.bind_index, 1, &srv);
+    return true;
+}
+
+bool hull_shader::set_sampler_state(shader_slot slot, ID3D11SamplerState* sampler_state)
+{
+    if (!slot.is_valid())
+    {
+        return false;
+    }
+
+    state::set_sampler(shader_stage::hull, slot.bind_index, sampler_state);
+    return true;
+}
+
 void hull_shader::shutdown()
 {
     shader::shutdown();
@@ -762,7 +1164,7 @@ bool geometry_shader::set_shader_resource_view(const std::string& name, ID3D11Sh
         return false;
     }
 
-    m_context->GSSetShaderResources(info->bind_index, 1, &srv);
+    state::set_shader_resources(shader_stage::geometry, info->bind_index, 1, &srv);
     return true;
 }
 
@@ -774,7 +1176,7 @@ bool geometry_shader::set_sampler_state(const std::string& name, ID3D11SamplerSt
         return false;
     }
 
-    m_context->GSSetSamplers(info->bind_index, 1, &sampler_state);
+    state::set_sampler(shader_stage::geometry, info->bind_index, sampler_state);
     return true;
 }
 
@@ -793,7 +1195,7 @@ bool geometry_shader::create_compatible_stream_out_buffer(ID3D11Buffer** buffer,
     desc.StructureByteStride = 0;
     desc.Usage               = D3D11_USAGE_DEFAULT;
 
-    DX_CALL(m_device->CreateBuffer(&desc, nullptr, buffer));
+    DX_CALL(m_backend->create_buffer(&desc, nullptr, buffer));
     return true;
 }
 
@@ -801,7 +1203,7 @@ void geometry_shader::unbind_stream_out_stage()
 {
     constexpr u32 offset{};
     ID3D11Buffer* unset[1]{};
-    core::get_device_context()->SOSetTargets(1, unset, &offset);
+    core::backend()->set_stream_output_targets(1, unset, &offset);
 }
 
 bool geometry_shader::create_shader(ID3D10Blob* blob)
@@ -814,7 +1216,8 @@ bool geometry_shader::create_shader(ID3D10Blob* blob)
         return create_shader_stream_out(blob);
     }
 
-    DX_CALL(m_device->CreateGeometryShader(blob->GetBufferPointer(), blob->GetBufferSize(), nullptr, &m_shader));
+    DX_CALL(m_backend->create_geometry_shader(blob->GetBufferPointer(), blob->GetBufferSize(), &m_shader));
+    name_object(m_shader);
     return true;
 }
 
@@ -825,12 +1228,51 @@ void geometry_shader::set_shader_constant_buffers()
         return;
     }
 
-    m_context->GSSetShader(m_shader, nullptr, 0);
+    state::set_geometry_shader(m_shader);
 
     for (u32 i = 0; i < m_buffer_count; ++i)
     {
-        m_context->GSSetConstantBuffers(m_constant_buffers[i].bind_index, 1, &m_constant_buffers[i].const_buffer);
+        bind_constant_buffer(m_constant_buffers[i]);
+    }
+}
+
+void geometry_shader::bind_constant_buffer(const constant_buffer& cb) const
+{
+    if (cb.external)
+    {
+        return;
+    }
+
+    if (cb.ring)
+    {
+        const constant_uploads::ring_range& r = cb.ring_range;
+        state::set_constant_buffer(shader_stage::geometry, cb.bind_index, r.buffer, r.first_constant, r.constant_count);
+    } else
+    {
+        state::set_constant_buffer(shader_stage::geometry, cb.bind_index, cb.const_buffer);
+    }
+}
+
+bool geometry_shader::set_shader_resource_view(shader_slot slot, ID3D11ShaderResourceView* srv)
+{
+    if (!slot.is_valid())
+    {
+        return false;
     }
+
+    state::set_shader_resources(shader_stage::geometry, slot.bind_index, 1, &srv);
+    return true;
+}
+
+bool geometry_shader::set_sampler_state(shader_slot slot, ID3D11SamplerState* sampler_state)
+{
+    if (!slot.is_valid())
+    {
+        return false;
+    }
+
+    state::set_sampler(shader_stage::geometry, slot.bind_index, sampler_state);
+    return true;
 }
 
 void geometry_shader::shutdown()
@@ -872,8 +1314,9 @@ bool geometry_shader::create_shader_stream_out(ID3D10Blob* blob)
 
     const u32 rast = m_allow_stream_out_rasterization ? 0 : D3D11_SO_NO_RASTERIZED_STREAM;
 
-    DX_CALL(m_device->CreateGeometryShaderWithStreamOutput(blob->GetBufferPointer(), blob->GetBufferSize(), sodecl.data(),
-                                                           (u32)sodecl.size(), nullptr, 0, rast, nullptr, &m_shader));
+    DX_CALL(m_backend->create_geometry_shader_with_stream_output(blob->GetBufferPointer(), blob->GetBufferSize(), sodecl.data(),
+                                                                 (u32)sodecl.size(), rast, &m_shader));
+    name_object(m_shader);
 
     return true;
 }
@@ -905,7 +1348,7 @@ bool compute_shader::set_shader_resource_view(const std::string& name, ID3D11Sha
         return false;
     }
 
-    m_context->CSSetShaderResources(info->bind_index, 1, &srv);
+    m_backend->set_shader_resources(shader_stage::compute, info->bind_index, 1, &srv);
     return true;
 }
 
@@ -917,18 +1360,18 @@ bool compute_shader::set_sampler_state(const std::string& name, ID3D11SamplerSta
         return false;
     }
 
-    m_context->CSSetSamplers(info->bind_index, 1, &sampler_state);
+    m_backend->set_samplers(shader_stage::compute, info->bind_index, 1, &sampler_state);
     return true;
 }
 
 void compute_shader::dispatch_by_groups(u32 groups_x, u32 groups_y, u32 groups_z) const
 {
-    m_context->Dispatch(groups_x, groups_y, groups_z);
+    m_backend->dispatch(groups_x, groups_y, groups_z);
 }
 
 void compute_shader::dispatch_by_threads(u32 threads_x, u32 threads_y, u32 threads_z) const
 {
-    m_context->Dispatch(std::max((u32) ceil((f32) threads_x / m_threads_x), 1u),
+    m_backend->dispatch(std::max((u32) ceil((f32) threads_x / m_threads_x), 1u),
                         std::max((u32) ceil((f32) threads_y / m_threads_y), 1u),
                         std::max((u32) ceil((f32) threads_z / m_threads_z), 1u));
 }
@@ -941,7 +1384,7 @@ bool compute_shader::set_unordered_access_view(const std::string& name, ID3D11Un
         return false;
     }
 
-    m_context->CSSetUnorderedAccessViews(bind_index, 1, &uav, &append_consume_offset);
+    m_backend->set_unordered_access_views(bind_index, 1, &uav, &append_consume_offset);
     return true;
 }
 
@@ -961,7 +1404,8 @@ bool compute_shader::create_shader(ID3D10Blob* blob)
     LOG_DEBUG("Creating compute shader");
     shutdown();
 
-    DX_CALL(m_device->CreateComputeShader(blob->GetBufferPointer(), blob->GetBufferSize(), nullptr, &m_shader));
+    DX_CALL(m_backend->create_compute_shader(blob->GetBufferPointer(), blob->GetBufferSize(), &m_shader));
+    name_object(m_shader);
 
     ID3D11ShaderReflection* refl;
     D3DReflect(blob->GetBufferPointer(), blob->GetBufferSize(), IID_ID3D11ShaderReflection, (void**) &refl);
@@ -1004,14 +1448,54 @@ void compute_shader::set_shader_constant_buffers()
         return;
     }
 
-    m_context->CSSetShader(m_shader, nullptr, 0);
+    m_backend->set_compute_shader(m_shader);
 
     for (u32 i = 0; i < m_buffer_count; ++i)
     {
-        m_context->CSSetConstantBuffers(m_constant_buffers[i].bind_index, 1, &m_constant_buffers[i].const_buffer);
+        bind_constant_buffer(m_constant_buffers[i]);
     }
 }
 
+void compute_shader::bind_constant_buffer(const constant_buffer& cb) const
+{
+    if (cb.external)
+    {
+        return;
+    }
+
+    if (cb.ring)
+    {
+        const constant_uploads::ring_range& r = cb.ring_range;
+        m_backend->set_constant_buffer_ranges(shader_stage::compute, cb.bind_index, 1, &r.buffer, &r.first_constant,
+                                              &r.constant_count);
+    } else
+    {
+        m_backend->set_constant_buffers(shader_stage::compute, cb.bind_index, 1, &cb.const_buffer);
+    }
+}
+
+bool compute_shader::set_shader_resource_view(shader_slot slot, ID3D11ShaderResourceView* srv)
+{
+    if (!slot.is_valid())
+    {
+        return false;
+    }
+
+    m_backend->set_shader_resources(shader_stage::compute, slot.bind_index, 1, &srv);
+    return true;
+}
+
+bool compute_shader::set_sampler_state(shader_slot slot, ID3D11SamplerState* sampler_state)
+{
+    if (!slot.is_valid())
+    {
+        return false;
+    }
+
+    m_backend->set_samplers(shader_stage::compute, slot.bind_index, 1, &sampler_state);
+    return true;
+}
+
 void compute_shader::shutdown()
 {
     shader::shutdown();
@@ -22,10 +22,15 @@
 //  ------------------------------------------------------------------------------
 
 #pragma once
-#include "../D3D11Common.h"
+#include "../Backend.h"
+#include "ConstantUploads.h"
 
+#include <algorithm>
+#include <cstddef>
 #include <functional>
 #include <format>
+#include <span>
+#include <string_view>
 
 //namespace yae
 //{
@@ -68,30 +73,30 @@ public:
     ~shader_layout() = default;
 
     template<typename T>
-    void add(const char* name, bool aligned = true)
+    void add(const char* name, bool aligned = true, u32 semantic_index = 0)
     {
-        if (m_elements.empty())
-        {
-            m_elements.push_back({});
-            auto& elem                = m_elements.back();
-            elem.SemanticName         = name;
-            elem.SemanticIndex        = 0;
-            elem.Format               = resolve_shader_type<T>();
-            elem.InputSlot            = 0;
-            elem.AlignedByteOffset    = 0;
-            elem.InputSlotClass       = D3D11_INPUT_PER_VERTEX_DATA;
-            elem.InstanceDataStepRate = 0;
-        } else
+        add_element(name, semantic_index, resolve_shader_type<T>(), 0, aligned, false);
+    }
+
+    /**
+     * \brief Adds an element read once per instance from its own vertex buffer slot
+     * \tparam T Element type
+     * \param name Semantic name
+     * \param semantic_index Semantic index, matrices are added as one float4 row per index
+     * \param slot Input slot the instance buffer is bound to
+     */
+    template<typename T>
+    void add_per_instance(const char* name, u32 semantic_index = 0, u32 slot = 1)
+    {
+        add_element(name, semantic_index, resolve_shader_type<T>(), slot, true, true);
+    }
+
+    // Four float4 rows with semantic indices 0 to 3
+    void add_per_instance_matrix(const char* name, u32 slot = 1)
+    {
+        for (u32 row = 0; row < 4; ++row)
         {
-            m_elements.push_back({});
-            auto& elem                = m_elements.back();
-            elem.SemanticName         = name;
-            elem.SemanticIndex        = 0;
-            elem.Format               = resolve_shader_type<T>();
-            elem.InputSlot            = 0;
-            elem.AlignedByteOffset    = aligned ? D3D11_APPEND_ALIGNED_ELEMENT : 0;
-            elem.InputSlotClass       = D3D11_INPUT_PER_VERTEX_DATA;
-            elem.InstanceDataStepRate = 0;
+            add_per_instance<math::vec4>(name, row, slot);
         }
     }
 
@@ -100,6 +105,23 @@ public:
     constexpr u32 size() const { return (u32) m_elements.size(); }
 
 private:
+    void add_element(const char* name, u32 semantic_index, DXGI_FORMAT format, u32 slot, bool aligned, bool per_instance)
+    {
+        // The first element of each slot starts at offset 0
+        const bool first_in_slot = std::none_of(m_elements.begin(), m_elements.end(),
+                                                [slot](const D3D11_INPUT_ELEMENT_DESC& e) { return e.InputSlot == slot; });
+
+        m_elements.push_back({});
+        auto& elem                = m_elements.back();
+        elem.SemanticName         = name;
+        elem.SemanticIndex        = semantic_index;
+        elem.Format               = format;
+        elem.InputSlot            = slot;
+        elem.AlignedByteOffset    = !first_in_slot && aligned ? D3D11_APPEND_ALIGNED_ELEMENT : 0;
+        elem.InputSlotClass       = per_instance ? D3D11_INPUT_PER_INSTANCE_DATA : D3D11_INPUT_PER_VERTEX_DATA;
+        elem.InstanceDataStepRate = per_instance ? 1 : 0;
+    }
+
     std::vector<D3D11_INPUT_ELEMENT_DESC> m_elements{};
 };
 
@@ -119,6 +141,10 @@ struct constant_buffer
     ID3D11Buffer*                const_buffer{};
     u8*                          data_buffer{};
     std::vector<shader_variable> variables{};
+    bool                         dirty{ true }; // Set when data_buffer differs from what the GPU has
+    bool                         ring{};        // Uploaded into the constant ring instead of const_buffer
+    bool                         external{};    // Owned, uploaded and bound outside the shader, e.g. the frame buffer
+    constant_uploads::ring_range ring_range{};
 };
 
 struct shader_resource
@@ -133,6 +159,71 @@ struct sampler
     u32 bind_index{};
 };
 
+// FNV-1a of a parameter name, the tables used by handle lookups are keyed by it
+constexpr u32 param_hash(std::string_view name)
+{
+    u32 hash = 2166136261u;
+    for (const char c : name)
+    {
+        hash = (hash ^ (u8) c) * 16777619u;
+    }
+    return hash;
+}
+
+namespace literals
+{
+// "worldMatrix"_param is hashed at compile time
+consteval u32 operator""_param(const char* name, size_t length)
+{
+    return param_hash({ name, length });
+}
+} // namespace literals
+
+// Resolved location of a constant buffer variable, setting through it writes straight into the CPU copy of the buffer
+struct shader_param
+{
+    u32 buffer_index{ invalid_u32 };
+    u32 byte_offset{};
+    u32 size{};
+
+    constexpr bool is_valid() const { return buffer_index != invalid_u32; }
+};
+
+// Resolved bind point of a texture, structured buffer or sampler
+struct shader_slot
+{
+    u32 bind_index{ invalid_u32 };
+
+    constexpr bool is_valid() const { return bind_index != invalid_u32; }
+};
+
+// One member of a typed constant buffer struct, checked against the reflected variable of the same name
+struct cbuffer_field
+{
+    std::string_view name{};
+    u32              offset{};
+    u32              size{};
+};
+
+#define CBUFFER_FIELD(type, member, hlsl_name)                                                                                   \
+    ::yae::gfx::cbuffer_field                                                                                                    \
+    {                                                                                                                            \
+        hlsl_name, (u32) offsetof(type, member), (u32) sizeof(type::member)                                                      \
+    }
+
+/**
+ * \brief Constant buffer validated against a struct mirroring its HLSL layout. The struct provides
+ * <code>static std::span<const cbuffer_field> layout()</code> listing every member
+ * \tparam T The struct uploaded as a whole
+ */
+template<typename T>
+struct typed_cbuffer
+{
+    u32 buffer_index{ invalid_u32 };
+
+    constexpr bool is_valid() const { return buffer_index != invalid_u32; }
+};
+
 class shader
 {
 public:
@@ -144,10 +235,20 @@ public:
     constexpr bool is_valid() const { return m_valid; }
 
     void bind();
+
+    // Only buffers changed since their last upload are copied
     void copy_all_buffers() const;
     void copy_buffer(u32 index) const;
     void copy_buffer(const std::string& name);
 
+    /**
+     * \brief Backs a constant buffer rewritten for most draws with the shared constant ring. Each upload is appended to
+     * the ring and rebound by offset instead of updating the same buffer again
+     * \param name The name of the constant buffer
+     * \return False if the buffer is not found or the ring is unavailable, the buffer then keeps its own storage
+     */
+    bool use_ring(const std::string& name);
+
 
     bool set_data(const std::string& name, const void* data, u32 size);
 
@@ -163,8 +264,51 @@ public:
     bool set_matrix(const std::string& name, const math::matrix& data);
     bool set_matrix(const std::string& name, const math::mat4& data);
 
+    /**
+     * \brief Resolves a constant buffer variable once so it can be set without string lookups
+     * \param name_hash <code>param_hash</code> of the variable name
+     * \return An invalid handle if the shader has no such variable
+     */
+    shader_param param(u32 name_hash) const;
+    shader_param param(std::string_view name) const { return param(param_hash(name)); }
+
+    shader_slot srv_slot(u32 name_hash) const;
+    shader_slot srv_slot(std::string_view name) const { return srv_slot(param_hash(name)); }
+    shader_slot sampler_slot(u32 name_hash) const;
+    shader_slot sampler_slot(std::string_view name) const { return sampler_slot(param_hash(name)); }
+
+    bool set_data(shader_param param, const void* data, u32 size);
+
+    bool set_int(shader_param param, i32 data);
+    bool set_float(shader_param param, f32 data);
+    bool set_float2(shader_param param, const math::vec2& data);
+    bool set_float3(shader_param param, const math::vec3& data);
+    bool set_float4(shader_param param, const math::vec4& data);
+    bool set_matrix(shader_param param, const math::matrix& data);
+    bool set_matrix(shader_param param, const math::mat4& data);
+
+    /**
+     * \brief Resolves a constant buffer that is written as one struct. Every reflected variable must match a field of
+     * <code>T::layout()</code> by name, offset and size
+     * \param name The name of the constant buffer
+     * \return An invalid handle if the buffer is missing or its layout differs from T
+     */
+    template<typename T>
+    typed_cbuffer<T> typed_buffer(const std::string& name)
+    {
+        return { validate_buffer(name, T::layout(), (u32) sizeof(T)) };
+    }
+
+    template<typename T>
+    bool set_buffer(typed_cbuffer<T> buffer, const T& data)
+    {
+        return set_buffer_data(buffer.buffer_index, &data, (u32) sizeof(T));
+    }
+
     virtual bool set_shader_resource_view(const std::string& name, ID3D11ShaderResourceView* srv) = 0;
     virtual bool set_sampler_state(const std::string& name, ID3D11SamplerState* sampler_state)    = 0;
+    virtual bool set_shader_resource_view(shader_slot slot, ID3D11ShaderResourceView* srv)        = 0;
+    virtual bool set_sampler_state(shader_slot slot, ID3D11SamplerState* sampler_state)           = 0;
 
     const shader_variable* variable_info(const std::string& name);
 
@@ -183,12 +327,17 @@ public:
     const constant_buffer* buffer_info(u32 index);
 
     constexpr ID3D10Blob* blob() const { return m_blob; }
+    // File the shader was loaded from without directory or extension, e.g. DeferredVertexShader
+    const std::string& name() const { return m_name; }
 
 protected:
-    virtual bool create_shader(ID3D10Blob* blob) = 0;
-    virtual void set_shader_constant_buffers()   = 0;
+    virtual bool create_shader(ID3D10Blob* blob)                       = 0;
+    virtual void set_shader_constant_buffers()                         = 0;
+    virtual void bind_constant_buffer(const constant_buffer& cb) const = 0;
     virtual void shutdown();
 
+    void upload(constant_buffer& cb) const;
+
     /**
      * \brief Finds a <code>shader_variable</code> by name
      * \param name The name of the variable
@@ -204,6 +353,13 @@ protected:
      */
     constant_buffer* find_constant_buffer(const std::string& name);
 
+    // Index of the buffer if its reflected variables match the fields, invalid_u32 otherwise
+    u32  validate_buffer(const std::string& name, std::span<const cbuffer_field> fields, u32 size);
+    bool set_buffer_data(u32 index, const void* data, u32 size);
+
+    // Gives a created shader the shader's name, shown by graphics debuggers and used by the software backend
+    void name_object(ID3D11DeviceChild* object) const;
+
     bool m_valid{};
     u32  m_buffer_count{};
 
@@ -214,10 +370,13 @@ protected:
     std::unordered_map<std::string, shader_variable>  m_var_table{};
     std::unordered_map<std::string, shader_resource*> m_texture_table{};
     std::unordered_map<std::string, sampler*>         m_sampler_table{};
+    std::unordered_map<u32, shader_param>             m_param_hashes{};
+    std::unordered_map<u32, shader_slot>              m_srv_hashes{};
+    std::unordered_map<u32, shader_slot>              m_sampler_hashes{};
 
-    ID3D10Blob*          m_blob{};
-    ID3D11Device*        m_device{};
-    ID3D11DeviceContext* m_context{};
+    ID3D10Blob*     m_blob{};
+    render_backend* m_backend{};
+    std::string     m_name{};
 };
 
 
@@ -237,10 +396,13 @@ public:
 
     bool set_sampler_state(const std::string& name, ID3D11SamplerState* sampler) override;
     bool set_shader_resource_view(const std::string& name, ID3D11ShaderResourceView* srv) override;
+    bool set_shader_resource_view(shader_slot slot, ID3D11ShaderResourceView* srv) override;
+    bool set_sampler_state(shader_slot slot, ID3D11SamplerState* sampler_state) override;
 
 protected:
     bool create_shader(ID3D10Blob* blob) override;
     void set_shader_constant_buffers() override;
+    void bind_constant_buffer(const constant_buffer& cb) const override;
     void shutdown() override;
 
     ID3D11InputLayout*  m_input_layout{};
@@ -258,10 +420,13 @@ public:
 
     bool set_shader_resource_view(const std::string& name, ID3D11ShaderResourceView* srv) override;
     bool set_sampler_state(const std::string& name, ID3D11SamplerState* sampler) override;
+    bool set_shader_resource_view(shader_slot slot, ID3D11ShaderResourceView* srv) override;
+    bool set_sampler_state(shader_slot slot, ID3D11SamplerState* sampler_state) override;
 
 protected:
     bool create_shader(ID3D10Blob* blob) override;
     void set_shader_constant_buffers() override;
+    void bind_constant_buffer(const constant_buffer& cb) const override;
     void shutdown() override;
 
     ID3D11PixelShader* m_shader{};
@@ -277,10 +442,13 @@ public:
 
     bool set_shader_resource_view(const std::string& name, ID3D11ShaderResourceView* srv) override;
     bool set_sampler_state(const std::string& name, ID3D11SamplerState* sampler_state) override;
+    bool set_shader_resource_view(shader_slot slot, ID3D11ShaderResourceView* srv) override;
+    bool set_sampler_state(shader_slot slot, ID3D11SamplerState* sampler_state) override;
 
 protected:
     bool create_shader(ID3D10Blob* blob) override;
     void set_shader_constant_buffers() override;
+    void bind_constant_buffer(const constant_buffer& cb) const override;
     void shutdown() override;
 
     ID3D11DomainShader* m_shader{};
@@ -296,10 +464,13 @@ public:
 
     bool set_shader_resource_view(const std::string& name, ID3D11ShaderResourceView* srv) override;
     bool set_sampler_state(const std::string& name, ID3D11SamplerState* sampler_state) override;
+    bool set_shader_resource_view(shader_slot slot, ID3D11ShaderResourceView* srv) override;
+    bool set_sampler_state(shader_slot slot, ID3D11SamplerState* sampler_state) override;
 
 protected:
     bool create_shader(ID3D10Blob* blob) override;
     void set_shader_constant_buffers() override;
+    void bind_constant_buffer(const constant_buffer& cb) const override;
     void shutdown() override;
 
     ID3D11HullShader* m_shader{};
@@ -318,6 +489,8 @@ public:
 
     bool set_shader_resource_view(const std::string& name, ID3D11ShaderResourceView* srv) override;
     bool set_sampler_state(const std::string& name, ID3D11SamplerState* sampler_state) override;
+    bool set_shader_resource_view(shader_slot slot, ID3D11ShaderResourceView* srv) override;
+    bool set_sampler_state(shader_slot slot, ID3D11SamplerState* sampler_state) override;
 
     bool create_compatible_stream_out_buffer(ID3D11Buffer** buffer, u32 vertex_count) const;
 
@@ -326,6 +499,7 @@ public:
 protected:
     bool create_shader(ID3D10Blob* blob) override;
     void set_shader_constant_buffers() override;
+    void bind_constant_buffer(const constant_buffer& cb) const override;
     void shutdown() override;
     bool       create_shader_stream_out(ID3D10Blob* blob);
     static u32  calculate_component_count(u32 mask);
@@ -347,6 +521,8 @@ public:
 
     bool set_shader_resource_view(const std::string& name, ID3D11ShaderResourceView* srv) override;
     bool set_sampler_state(const std::string& name, ID3D11SamplerState* sampler_state) override;
+    bool set_shader_resource_view(shader_slot slot, ID3D11ShaderResourceView* srv) override;
+    bool set_sampler_state(shader_slot slot, ID3D11SamplerState* sampler_state) override;
 
     void dispatch_by_groups(u32 groups_x, u32 groups_y, u32 groups_z) const;
     void dispatch_by_threads(u32 threads_x, u32 threads_y, u32 threads_z) const;
@@ -359,6 +535,7 @@ public:
 protected:
     bool create_shader(ID3D10Blob* blob) override;
     void set_shader_constant_buffers() override;
+    void bind_constant_buffer(const constant_buffer& cb) const override;
     void shutdown() override;
 
     ID3D11ComputeShader* m_shader{};
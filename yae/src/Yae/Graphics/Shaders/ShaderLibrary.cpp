@@ -30,6 +30,7 @@ namespace
 {
 shader_obj tex{};
 shader_obj lights{};
+shader_obj volumes{};
 shader_obj dr{};
 shader_obj dir{};
 shader_obj fonts{};
@@ -38,10 +39,17 @@ shader_obj multitex{};
 
 bool init()
 {
+    if (!constant_uploads::init())
+    {
+        return false;
+    }
+
     tex.vs      = new vertex_shader{};
     tex.ps      = new pixel_shader{};
     lights.vs   = new vertex_shader{};
     lights.ps   = new pixel_shader{};
+    volumes.vs  = new vertex_shader{};
+    volumes.ps  = new pixel_shader{};
     dr.vs       = new vertex_shader{};
     dr.ps       = new pixel_shader{};
     dir.vs      = new vertex_shader{};
@@ -81,6 +89,18 @@ bool init()
         return false;
     }
 
+    if (!volumes.vs->load_from_file(firstbit + "LightVolumeVertexShader.cso"))
+    {
+        shutdown();
+        return false;
+    }
+
+    if (!volumes.ps->load_from_file(firstbit + "LightVolumePixelShader.cso"))
+    {
+        shutdown();
+        return false;
+    }
+
     if (!dr.vs->load_from_file(firstbit + "DeferredVertexShader.cso"))
     {
         shutdown();
@@ -123,6 +143,10 @@ bool init()
         return false;
     }
 
+    // Rewritten for every overlay quad and text string
+    tex.vs->use_ring("MatrixBuffer");
+    fonts.vs->use_ring("MatrixData");
+
     return true;
 }
 
@@ -132,6 +156,8 @@ void shutdown()
     SAFE_DELETE(tex.ps);
     SAFE_DELETE(lights.vs);
     SAFE_DELETE(lights.ps);
+    SAFE_DELETE(volumes.vs);
+    SAFE_DELETE(volumes.ps);
     SAFE_DELETE(dr.vs);
     SAFE_DELETE(dr.ps);
     SAFE_DELETE(dir.vs);
@@ -139,6 +165,7 @@ void shutdown()
     SAFE_DELETE(fonts.vs);
     SAFE_DELETE(fonts.ps);
     SAFE_DELETE(multitex.ps);
+    constant_uploads::shutdown();
 }
 
 shader_obj* texture_shader()
@@ -165,6 +192,11 @@ shader_obj* lighting()
     return &lights;
 }
 
+shader_obj* light_volumes()
+{
+    return &volumes;
+}
+
 shader_obj* font()
 {
     return &fonts;
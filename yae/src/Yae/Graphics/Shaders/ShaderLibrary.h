@@ -48,6 +48,8 @@ shader_obj* toscreen();
 
 shader_obj* lighting();
 
+shader_obj* light_volumes();
+
 shader_obj* font();
 
 shader_obj* multitexture();
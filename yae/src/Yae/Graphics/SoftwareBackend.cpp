@@ -0,0 +1,779 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: SoftwareBackend.cpp
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+#include "SoftwareBackend.h"
+
+#include "Yae/Core/Jobs.h"
+#include "NullObjects.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace yae::gfx
+{
+
+namespace
+{
+
+constexpr u32 no_target = ~0u;
+
+// Keeps what vertex fetch needs from the layout's elements, with offsets resolved and semantics mapped to vertex_input
+class software_input_layout final : public null_object<ID3D11InputLayout>
+{
+public:
+    struct element
+    {
+        u32 slot{};
+        u32 offset{}; // In bytes from the start of the vertex or instance
+        u32 floats{}; // Copied into vertex_input
+        u32 target{ no_target };
+    };
+
+    std::vector<element> elements{};
+};
+
+u32 format_components(DXGI_FORMAT format)
+{
+    switch (format)
+    {
+    case DXGI_FORMAT_R32G32B32A32_FLOAT:
+    case DXGI_FORMAT_R32G32B32A32_UINT:
+    case DXGI_FORMAT_R32G32B32A32_SINT: return 4;
+    case DXGI_FORMAT_R32G32B32_FLOAT:
+    case DXGI_FORMAT_R32G32B32_UINT:
+    case DXGI_FORMAT_R32G32B32_SINT: return 3;
+    case DXGI_FORMAT_R32G32_FLOAT:
+    case DXGI_FORMAT_R32G32_UINT:
+    case DXGI_FORMAT_R32G32_SINT: return 2;
+    default: return 1;
+    }
+}
+
+bool is_float_format(DXGI_FORMAT format)
+{
+    return format == DXGI_FORMAT_R32G32B32A32_FLOAT || format == DXGI_FORMAT_R32G32B32_FLOAT ||
+           format == DXGI_FORMAT_R32G32_FLOAT || format == DXGI_FORMAT_R32_FLOAT;
+}
+
+// Where an element lands in vertex_input. Semantics are matched without case, as the input assembler does
+void map_semantic(const char* name, u32 index, software_input_layout::element& element)
+{
+    using software::vertex_input;
+
+    const auto field = [&element](u32 offset, u32 floats) {
+        element.target = offset;
+        element.floats = std::min(element.floats, floats);
+    };
+
+    if (_stricmp(name, "POSITION") == 0 || _stricmp(name, "SV_POSITION") == 0)
+    {
+        field(offsetof(vertex_input, position), 3);
+    } else if (_stricmp(name, "NORMAL") == 0)
+    {
+        field(offsetof(vertex_input, normal), 3);
+    } else if (_stricmp(name, "TEXCOORD") == 0 && index == 0)
+    {
+        field(offsetof(vertex_input, uv), 2);
+    } else if (_stricmp(name, "TANGENT") == 0)
+    {
+        field(offsetof(vertex_input, tangent), 3);
+    } else if (_stricmp(name, "BINORMAL") == 0)
+    {
+        field(offsetof(vertex_input, binormal), 3);
+    } else if (_stricmp(name, "WORLD_PER_INSTANCE") == 0 && index < 4)
+    {
+        field(offsetof(vertex_input, world) + index * sizeof(math::vec4), 4);
+    } else if (_stricmp(name, "TINT_PER_INSTANCE") == 0)
+    {
+        field(offsetof(vertex_input, tint), 4);
+    }
+}
+
+u32 stage_index(shader_stage stage)
+{
+    return stage == shader_stage::vertex ? 0 : stage == shader_stage::pixel ? 1 : no_target;
+}
+
+null_texture2d* view_texture(ID3D11View* view)
+{
+    ID3D11Resource* resource{};
+    view->GetResource(&resource);
+    resource->Release(); // The view keeps its own reference
+    return is_null_buffer(resource) ? nullptr : as_null_texture2d(resource);
+}
+
+// Shaders are named by the engine after the file they were compiled from
+template<typename Interface>
+const std::string& object_name(Interface* object)
+{
+    return static_cast<null_child<Interface>*>(object)->name();
+}
+
+u8 to_unorm(f32 value)
+{
+    return (u8) (std::clamp(value, 0.f, 1.f) * 255.f + .5f);
+}
+
+} // anonymous namespace
+
+software_backend::software_backend(u32 width, u32 height) : null_backend{ width, height }
+{
+    m_presented.resize((size_t) width * height * 4);
+}
+
+bool software_backend::save_back_buffer(const std::filesystem::path& path)
+{
+    D3D11_TEXTURE2D_DESC desc{};
+    m_back_buffer->GetDesc(&desc);
+
+    FILE* fptr;
+    if (fopen_s(&fptr, path.string().c_str(), "wb"))
+    {
+        LOG_ERROR("Could not open {} to save the back buffer", path.string());
+        return false;
+    }
+
+    // Uncompressed true color, 8 bits of alpha, rows bottom up like the files texture::load_targa_32bit reads
+    u8 header[18]{};
+    header[2]  = 2;
+    header[12] = (u8) (desc.Width & 0xFF);
+    header[13] = (u8) (desc.Width >> 8);
+    header[14] = (u8) (desc.Height & 0xFF);
+    header[15] = (u8) (desc.Height >> 8);
+    header[16] = 32;
+    header[17] = 8;
+
+    std::vector<u8> pixels(m_presented.size());
+    for (u32 y = 0; y < desc.Height; ++y)
+    {
+        const u8* src = m_presented.data() + (size_t) (desc.Height - 1 - y) * desc.Width * 4;
+        u8*       dst = pixels.data() + (size_t) y * desc.Width * 4;
+        for (u32 x = 0; x < desc.Width; ++x, src += 4, dst += 4)
+        {
+            dst[0] = src[2];
+            dst[1] = src[1];
+            dst[2] = src[0];
+            dst[3] = src[3];
+        }
+    }
+
+    const bool written =
+        fwrite(header, sizeof(header), 1, fptr) == 1 && fwrite(pixels.data(), 1, pixels.size(), fptr) == pixels.size();
+    fclose(fptr);
+    if (!written)
+    {
+        LOG_ERROR("Failed to write the back buffer to {}", path.string());
+    }
+    return written;
+}
+
+HRESULT software_backend::create_buffer(const D3D11_BUFFER_DESC* desc, const D3D11_SUBRESOURCE_DATA* data, ID3D11Buffer** buffer)
+{
+    const HRESULT result = null_backend::create_buffer(desc, data, buffer);
+    if (SUCCEEDED(result) && data && data->pSysMem)
+    {
+        memcpy(as_null_buffer(*buffer)->memory(), data->pSysMem, desc->ByteWidth);
+    }
+    return result;
+}
+
+HRESULT software_backend::create_texture2d(const D3D11_TEXTURE2D_DESC* desc, const D3D11_SUBRESOURCE_DATA* data,
+                                           ID3D11Texture2D** texture)
+{
+    const HRESULT result = null_backend::create_texture2d(desc, data, texture);
+    if (SUCCEEDED(result) && data && data->pSysMem)
+    {
+        update_subresource(*texture, 0, data->pSysMem, data->SysMemPitch, 0);
+    }
+    return result;
+}
+
+HRESULT software_backend::create_input_layout(const D3D11_INPUT_ELEMENT_DESC* elements, u32 count, const void*, size_t,
+                                              ID3D11InputLayout** layout)
+{
+    count_create();
+
+    software_input_layout* result = new software_input_layout{};
+    u32                    next[D3D11_IA_VERTEX_INPUT_RESOURCE_SLOT_COUNT]{};
+    for (u32 i = 0; i < count; ++i)
+    {
+        const D3D11_INPUT_ELEMENT_DESC& desc = elements[i];
+        const u32                       size = format_components(desc.Format) * 4;
+
+        software_input_layout::element element{};
+        element.slot   = desc.InputSlot;
+        element.offset = desc.AlignedByteOffset == D3D11_APPEND_ALIGNED_ELEMENT ? next[desc.InputSlot] : desc.AlignedByteOffset;
+        element.floats = format_components(desc.Format);
+        next[desc.InputSlot] = element.offset + size;
+
+        // The engine's shaders only take floats, anything else is left for the vertex program to do without
+        if (is_float_format(desc.Format) && desc.InputSlot < stream_count)
+        {
+            map_semantic(desc.SemanticName, desc.SemanticIndex, element);
+        }
+
+        if (element.target != no_target)
+        {
+            result->elements.push_back(element);
+        }
+    }
+
+    *layout = result;
+    return S_OK;
+}
+
+void software_backend::update_subresource(ID3D11Resource* resource, u32 subresource, const void* data, u32 row_pitch,
+                                          u32 depth_pitch)
+{
+    null_backend::update_subresource(resource, subresource, data, row_pitch, depth_pitch);
+
+    if (is_null_buffer(resource))
+    {
+        null_buffer* buffer = as_null_buffer(resource);
+        memcpy(buffer->memory(), data, buffer->bytes());
+        return;
+    }
+
+    // Only the top mip is ever sampled
+    null_texture2d* texture = as_null_texture2d(resource);
+    if (subresource != 0)
+    {
+        return;
+    }
+
+    const u32 row_bytes = std::min(row_pitch, texture->row_pitch());
+    u8*       dst       = texture->memory();
+    const u8* src       = (const u8*) data;
+    for (u32 y = 0; y < texture->desc().Height; ++y)
+    {
+        memcpy(dst + (size_t) y * texture->row_pitch(), src + (size_t) y * row_pitch, row_bytes);
+    }
+}
+
+void software_backend::set_input_layout(ID3D11InputLayout* layout)
+{
+    null_backend::set_input_layout(layout);
+    m_layout = layout;
+}
+
+void software_backend::set_vertex_buffers(u32 slot, u32 count, ID3D11Buffer* const* buffers, const u32* strides,
+                                          const u32* offsets)
+{
+    null_backend::set_vertex_buffers(slot, count, buffers, strides, offsets);
+    for (u32 i = 0; i < count && slot + i < stream_count; ++i)
+    {
+        m_streams[slot + i] = { buffers[i], strides[i], offsets[i] };
+    }
+}
+
+void software_backend::set_index_buffer(ID3D11Buffer* buffer, DXGI_FORMAT format, u32 offset)
+{
+    null_backend::set_index_buffer(buffer, format, offset);
+    m_index_buffer = buffer;
+    m_index_format = format;
+    m_index_offset = offset;
+}
+
+void software_backend::set_topology(D3D11_PRIMITIVE_TOPOLOGY topology)
+{
+    null_backend::set_topology(topology);
+    m_topology = topology;
+}
+
+void software_backend::set_vertex_shader(ID3D11VertexShader* shader)
+{
+    null_backend::set_vertex_shader(shader);
+    m_vertex_program = shader ? software::find_vertex_program(object_name(shader)) : software::vertex_program{};
+}
+
+void software_backend::set_pixel_shader(ID3D11PixelShader* shader)
+{
+    null_backend::set_pixel_shader(shader);
+    m_pixel_program = shader ? software::find_pixel_program(object_name(shader)) : nullptr;
+}
+
+void software_backend::set_constant_buffers(shader_stage stage, u32 slot, u32 count, ID3D11Buffer* const* buffers)
+{
+    null_backend::set_constant_buffers(stage, slot, count, buffers);
+    bind_constants(stage, slot, count, buffers, nullptr, nullptr);
+}
+
+void software_backend::set_constant_buffer_ranges(shader_stage stage, u32 slot, u32 count, ID3D11Buffer* const* buffers,
+                                                  const u32* first_constants, const u32* constant_counts)
+{
+    null_backend::set_constant_buffer_ranges(stage, slot, count, buffers, first_constants, constant_counts);
+    bind_constants(stage, slot, count, buffers, first_constants, constant_counts);
+}
+
+void software_backend::bind_constants(shader_stage stage, u32 slot, u32 count, ID3D11Buffer* const* buffers,
+                                      const u32* first_constants, const u32* constant_counts)
+{
+    const u32 index = stage_index(stage);
+    if (index == no_target)
+    {
+        return;
+    }
+
+    stage_objects& objects = m_stages[index];
+    for (u32 i = 0; i < count && slot + i < software::max_constant_buffers; ++i)
+    {
+        objects.constants[slot + i]        = buffers ? buffers[i] : nullptr;
+        objects.constant_offsets[slot + i] = first_constants ? first_constants[i] * 16 : 0;
+        objects.constant_sizes[slot + i]   = constant_counts ? constant_counts[i] * 16 : 0;
+    }
+}
+
+void software_backend::set_shader_resources(shader_stage stage, u32 slot, u32 count, ID3D11ShaderResourceView* const* views)
+{
+    null_backend::set_shader_resources(stage, slot, count, views);
+
+    const u32 index = stage_index(stage);
+    for (u32 i = 0; index != no_target && i < count && slot + i < software::max_resources; ++i)
+    {
+        m_stages[index].resources[slot + i] = views ? views[i] : nullptr;
+    }
+}
+
+void software_backend::set_samplers(shader_stage stage, u32 slot, u32 count, ID3D11SamplerState* const* samplers)
+{
+    null_backend::set_samplers(stage, slot, count, samplers);
+
+    const u32 index = stage_index(stage);
+    for (u32 i = 0; index != no_target && i < count && slot + i < software::max_samplers; ++i)
+    {
+        m_stages[index].samplers[slot + i] = samplers ? samplers[i] : nullptr;
+    }
+}
+
+void software_backend::set_rasterizer_state(ID3D11RasterizerState* state)
+{
+    null_backend::set_rasterizer_state(state);
+    m_rasterizer_state = state;
+}
+
+void software_backend::set_viewports(u32 count, const D3D11_VIEWPORT* viewports)
+{
+    null_backend::set_viewports(count, viewports);
+    if (count)
+    {
+        m_viewport = viewports[0];
+    }
+}
+
+void software_backend::set_scissor_rects(u32 count, const D3D11_RECT* rects)
+{
+    null_backend::set_scissor_rects(count, rects);
+    if (count)
+    {
+        m_scissor = rects[0];
+    }
+}
+
+void software_backend::set_blend_state(ID3D11BlendState* state, const f32 factor[4], u32 sample_mask)
+{
+    null_backend::set_blend_state(state, factor, sample_mask);
+    m_blend_state = state;
+    for (u32 i = 0; i < 4; ++i)
+    {
+        m_blend_factor[i] = factor ? factor[i] : 1.f;
+    }
+}
+
+void software_backend::set_depth_stencil_state(ID3D11DepthStencilState* state, u32 stencil_ref)
+{
+    null_backend::set_depth_stencil_state(state, stencil_ref);
+    m_depth_state = state;
+}
+
+void software_backend::set_render_targets(u32 count, ID3D11RenderTargetView* const* views, ID3D11DepthStencilView* depth)
+{
+    null_backend::set_render_targets(count, views, depth);
+
+    m_target_count = std::min(count, software::max_targets);
+    for (u32 i = 0; i < software::max_targets; ++i)
+    {
+        m_targets[i] = i < m_target_count ? views[i] : nullptr;
+    }
+    m_depth = depth;
+}
+
+void software_backend::reset_state()
+{
+    m_layout       = nullptr;
+    m_index_buffer = nullptr;
+    m_index_format = DXGI_FORMAT_R32_UINT;
+    m_index_offset = 0;
+    m_topology     = D3D11_PRIMITIVE_TOPOLOGY_UNDEFINED;
+    std::fill(std::begin(m_streams), std::end(m_streams), vertex_stream{});
+
+    m_vertex_program = {};
+    m_pixel_program  = nullptr;
+    std::fill(std::begin(m_stages), std::end(m_stages), stage_objects{});
+
+    m_rasterizer_state = nullptr;
+    m_blend_state      = nullptr;
+    m_depth_state      = nullptr;
+    std::fill(std::begin(m_blend_factor), std::end(m_blend_factor), 1.f);
+    m_viewport     = {};
+    m_scissor      = {};
+    m_target_count = 0;
+    std::fill(std::begin(m_targets), std::end(m_targets), nullptr);
+    m_depth = nullptr;
+}
+
+void software_backend::clear_render_target(ID3D11RenderTargetView* view, const f32 color[4])
+{
+    null_backend::clear_render_target(view, color);
+
+    null_texture2d* texture = view_texture(view);
+    if (!texture)
+    {
+        return;
+    }
+
+    const D3D11_TEXTURE2D_DESC& desc = texture->desc();
+    u8*                         row  = texture->memory();
+    for (u32 y = 0; y < desc.Height; ++y, row += texture->row_pitch())
+    {
+        if (desc.Format == DXGI_FORMAT_R32G32B32A32_FLOAT)
+        {
+            for (u32 x = 0; x < desc.Width; ++x)
+            {
+                memcpy(row + (size_t) x * 16, color, 16);
+            }
+        } else
+        {
+            const u8 texel[4]{ to_unorm(color[0]), to_unorm(color[1]), to_unorm(color[2]), to_unorm(color[3]) };
+            for (u32 x = 0; x < desc.Width; ++x)
+            {
+                memcpy(row + (size_t) x * 4, texel, 4);
+            }
+        }
+    }
+}
+
+void software_backend::clear_depth_stencil(ID3D11DepthStencilView* view, u32 flags, f32 depth, u8 stencil)
+{
+    null_backend::clear_depth_stencil(view, flags, depth, stencil);
+
+    null_texture2d* texture = view_texture(view);
+    if (!texture || !(flags & D3D11_CLEAR_DEPTH))
+    {
+        return;
+    }
+
+    f32* texels = (f32*) texture->memory();
+    std::fill(texels, texels + (size_t) texture->desc().Width * texture->desc().Height, depth);
+}
+
+void software_backend::resolve(const stage_objects& objects, software::stage_bindings& bindings) const
+{
+    bindings = software::stage_bindings{};
+
+    for (u32 i = 0; i < software::max_constant_buffers; ++i)
+    {
+        if (!objects.constants[i])
+        {
+            continue;
+        }
+
+        null_buffer* buffer = as_null_buffer(objects.constants[i]);
+        const u32    offset = std::min(objects.constant_offsets[i], (u32) buffer->bytes());
+        const u32    size   = objects.constant_sizes[i] ? objects.constant_sizes[i] : (u32) buffer->bytes();
+
+        bindings.constants[i].data = buffer->memory() + offset;
+        bindings.constants[i].size = std::min(size, (u32) buffer->bytes() - offset);
+    }
+
+    for (u32 i = 0; i < software::max_resources; ++i)
+    {
+        if (!objects.resources[i])
+        {
+            continue;
+        }
+
+        const null_shader_resource_view* view     = static_cast<const null_shader_resource_view*>(objects.resources[i]);
+        software::resource_binding&      resource = bindings.resources[i];
+        if (is_null_buffer(view->resource()))
+        {
+            null_buffer* buffer = as_null_buffer(view->resource());
+            const u32    offset = std::min(view->desc().Buffer.FirstElement * buffer->desc().StructureByteStride,
+                                           (u32) buffer->bytes());
+            resource.memory     = buffer->memory() + offset;
+            resource.size       = (u32) buffer->bytes() - offset;
+        } else
+        {
+            null_texture2d* texture = as_null_texture2d(view->resource());
+            resource.memory         = texture->memory();
+            resource.size           = (u32) texture->bytes();
+            resource.width          = texture->desc().Width;
+            resource.height         = texture->desc().Height;
+            resource.row_pitch      = texture->row_pitch();
+            resource.format         = texture->desc().Format;
+        }
+    }
+
+    for (u32 i = 0; i < software::max_samplers; ++i)
+    {
+        if (!objects.samplers[i])
+        {
+            continue;
+        }
+
+        const D3D11_SAMPLER_DESC& desc = static_cast<const null_sampler_state*>(objects.samplers[i])->desc();
+        bindings.samplers[i].point     = desc.Filter == D3D11_FILTER_MIN_MAG_MIP_POINT;
+        bindings.samplers[i].address_u = desc.AddressU;
+        bindings.samplers[i].address_v = desc.AddressV;
+    }
+}
+
+bool software_backend::prepare_state()
+{
+    if (m_topology != D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST || !m_vertex_program.run || !m_pixel_program)
+    {
+        ++m_skipped;
+        return false;
+    }
+
+    software::raster_state& state = m_state;
+    state.width                   = ~0u;
+    state.height                  = ~0u;
+
+    const auto fit = [&state](const null_texture2d* texture) {
+        state.width  = std::min(state.width, texture->desc().Width);
+        state.height = std::min(state.height, texture->desc().Height);
+    };
+
+    state.target_count = 0;
+    for (u32 i = 0; i < m_target_count; ++i)
+    {
+        null_texture2d* texture = m_targets[i] ? view_texture(m_targets[i]) : nullptr;
+        if (texture)
+        {
+            state.targets[i]   = { texture->memory(), texture->row_pitch(), texture->desc().Format };
+            state.target_count = i + 1;
+            fit(texture);
+        } else
+        {
+            state.targets[i] = {};
+        }
+    }
+
+    null_texture2d* depth = m_depth ? view_texture(m_depth) : nullptr;
+    state.depth           = depth ? (f32*) depth->memory() : nullptr;
+    state.depth_pitch     = depth ? depth->row_pitch() / 4 : 0;
+    if (depth)
+    {
+        fit(depth);
+    }
+
+    if (state.width == ~0u)
+    {
+        ++m_skipped;
+        return false;
+    }
+
+    // Unbound states are the D3D11 defaults
+    const D3D11_RASTERIZER_DESC raster = m_rasterizer_state ? static_cast<null_rasterizer_state*>(m_rasterizer_state)->desc()
+                                                            : CD3D11_RASTERIZER_DESC{ CD3D11_DEFAULT{} };
+    state.viewport       = m_viewport;
+    state.cull           = raster.CullMode;
+    state.front_ccw      = raster.FrontCounterClockwise;
+    state.depth_clip     = raster.DepthClipEnable;
+    state.scissor_enable = raster.ScissorEnable;
+    state.scissor        = m_scissor;
+
+    const D3D11_DEPTH_STENCIL_DESC depth_desc = m_depth_state ? static_cast<null_depth_stencil_state*>(m_depth_state)->desc()
+                                                              : CD3D11_DEPTH_STENCIL_DESC{ CD3D11_DEFAULT{} };
+    state.depth_enable = depth_desc.DepthEnable && state.depth;
+    state.depth_write  = depth_desc.DepthWriteMask == D3D11_DEPTH_WRITE_MASK_ALL;
+    state.depth_func   = depth_desc.DepthFunc;
+
+    state.blend = m_blend_state ? static_cast<null_blend_state*>(m_blend_state)->desc().RenderTarget[0]
+                                : CD3D11_BLEND_DESC{ CD3D11_DEFAULT{} }.RenderTarget[0];
+    std::copy(std::begin(m_blend_factor), std::end(m_blend_factor), state.blend_factor);
+
+    resolve(m_stages[0], m_bindings[0]);
+    resolve(m_stages[1], m_bindings[1]);
+
+    state.program       = m_pixel_program;
+    state.context       = &m_bindings[1];
+    state.varying_count = m_vertex_program.varying_count;
+    return true;
+}
+
+void software_backend::draw(u32 vertex_count, u32 first_vertex)
+{
+    null_backend::draw(vertex_count, first_vertex);
+    if (prepare_state())
+    {
+        shade_and_draw(first_vertex, vertex_count, {}, 1, 0);
+    }
+}
+
+void software_backend::draw_indexed(u32 index_count, u32 first_index, i32 base_vertex)
+{
+    null_backend::draw_indexed(index_count, first_index, base_vertex);
+    draw_indices(index_count, 1, first_index, base_vertex, 0);
+}
+
+void software_backend::draw_indexed_instanced(u32 index_count, u32 instance_count, u32 first_index, i32 base_vertex,
+                                              u32 first_instance)
+{
+    null_backend::draw_indexed_instanced(index_count, instance_count, first_index, base_vertex, first_instance);
+    draw_indices(index_count, instance_count, first_index, base_vertex, first_instance);
+}
+
+void software_backend::draw_indices(u32 index_count, u32 instance_count, u32 first_index, i32 base_vertex, u32 first_instance)
+{
+    if (!index_count || !instance_count || !m_index_buffer || !prepare_state())
+    {
+        return;
+    }
+
+    null_buffer* buffer = as_null_buffer(m_index_buffer);
+    const u32    stride = m_index_format == DXGI_FORMAT_R16_UINT ? 2 : 4;
+    const u64    start  = m_index_offset + (u64) first_index * stride;
+    if (start + (u64) index_count * stride > buffer->bytes())
+    {
+        ++m_skipped;
+        return;
+    }
+
+    const u8* memory = buffer->memory() + start;
+    m_fetched.resize(index_count);
+    i64 lowest  = std::numeric_limits<i64>::max();
+    i64 highest = std::numeric_limits<i64>::min();
+    for (u32 i = 0; i < index_count; ++i)
+    {
+        const i64 index = (stride == 2 ? (i64) ((const u16*) memory)[i] : (i64) ((const u32*) memory)[i]) + base_vertex;
+        lowest          = std::min(lowest, index);
+        highest         = std::max(highest, index);
+        m_fetched[i]    = (u32) index;
+    }
+
+    if (lowest < 0)
+    {
+        ++m_skipped;
+        return;
+    }
+
+    for (u32& index : m_fetched)
+    {
+        index -= (u32) lowest;
+    }
+    shade_and_draw((u32) lowest, (u32) (highest - lowest + 1), m_fetched, instance_count, first_instance);
+}
+
+void software_backend::shade_and_draw(u32 first, u32 vertex_count, std::span<const u32> indices, u32 instance_count,
+                                      u32 first_instance)
+{
+    struct stream
+    {
+        const u8* memory{};
+        u64       bytes{};
+        u32       stride{};
+    };
+
+    // Memory is handed out lazily, so it is fetched here rather than from the jobs
+    stream streams[stream_count]{};
+    for (u32 i = 0; i < stream_count; ++i)
+    {
+        if (m_streams[i].buffer)
+        {
+            null_buffer* buffer = as_null_buffer(m_streams[i].buffer);
+            const u64    offset = std::min<u64>(m_streams[i].offset, buffer->bytes());
+            streams[i]          = { buffer->memory() + offset, buffer->bytes() - offset, m_streams[i].stride };
+        }
+    }
+
+    // Shaders fed only by system values draw without a layout
+    using element = software_input_layout::element;
+    const software_input_layout*    layout   = static_cast<const software_input_layout*>(m_layout);
+    const std::span<const element>  elements = layout ? std::span<const element>{ layout->elements } : std::span<const element>{};
+    const software::vertex_program& program  = m_vertex_program;
+    const software::stage_bindings& bindings = m_bindings[0];
+    const u32                       total    = vertex_count * instance_count;
+
+    m_shaded.assign(total, {});
+    jobs::parallel_for(0, total, 256, [&](u32 begin, u32 end) {
+        for (u32 i = begin; i < end; ++i)
+        {
+            software::vertex_input input{};
+            input.vertex_id   = first + i % vertex_count;
+            input.instance_id = i / vertex_count;
+
+            for (const element& e : elements)
+            {
+                const stream& source = streams[e.slot];
+                const u64     index  = e.slot == 0 ? input.vertex_id : (u64) first_instance + input.instance_id;
+                const u64     at     = index * source.stride + e.offset;
+                if (source.memory && at + e.floats * 4 <= source.bytes)
+                {
+                    memcpy((u8*) &input + e.target, source.memory + at, e.floats * 4);
+                }
+            }
+
+            program.run(bindings, input, m_shaded[i]);
+        }
+    });
+
+    m_indices.resize((size_t) (indices.empty() ? vertex_count : indices.size()) * instance_count);
+    u32* out = m_indices.data();
+    for (u32 instance = 0; instance < instance_count; ++instance)
+    {
+        const u32 base = instance * vertex_count;
+        if (indices.empty())
+        {
+            for (u32 i = 0; i < vertex_count; ++i)
+            {
+                *out++ = base + i;
+            }
+        } else
+        {
+            for (const u32 index : indices)
+            {
+                *out++ = base + index;
+            }
+        }
+    }
+
+    m_rasterizer.draw(m_state, m_shaded, m_indices);
+}
+
+void software_backend::present(bool vsync)
+{
+    null_texture2d* back_buffer = as_null_texture2d(m_back_buffer);
+    const u8*       memory      = back_buffer->memory();
+    for (u32 y = 0; y < back_buffer->desc().Height; ++y)
+    {
+        memcpy(m_presented.data() + (size_t) y * back_buffer->desc().Width * 4, memory + (size_t) y * back_buffer->row_pitch(),
+               (size_t) back_buffer->desc().Width * 4);
+    }
+
+    null_backend::present(vsync);
+    m_rasterizer.end_frame();
+    m_skipped_previous = m_skipped;
+    m_skipped          = 0;
+}
+
+} // namespace yae::gfx
@@ -0,0 +1,176 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: SoftwareBackend.h
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+
+#pragma once
+
+#include "NullBackend.h"
+#include "SoftwarePrograms.h"
+
+#include <filesystem>
+
+namespace yae::gfx
+{
+
+/**
+ * \brief Renders frames on the CPU, for reference images and for running the engine where there is no GPU.\n\n
+ * Builds on the null backend: its stand-in objects keep their contents here, binds are recorded and draws run the CPU
+ * versions of the engine's shaders, found by the shader's debug name, through a tile_rasterizer. Only triangle lists,
+ * the top mip of each texture and depth without stencil are supported. Draws with a shader that has no CPU version
+ * are counted and skipped
+ */
+class software_backend final : public null_backend
+{
+public:
+    software_backend(u32 width, u32 height);
+    ~software_backend() override = default;
+    DISABLE_COPY_AND_MOVE(software_backend);
+
+    // Rasterizer counters and per tile costs of the last presented frame
+    const software::raster_stats&    raster_stats() const { return m_rasterizer.last_frame(); }
+    const software::tile_rasterizer& rasterizer() const { return m_rasterizer; }
+    // Draws skipped in the last presented frame, for a topology or shader without CPU support
+    u32 skipped_draws() const { return m_skipped_previous; }
+
+    /**
+     * \brief Writes the back buffer as it was last presented to a 32 bit targa, the format textures are loaded from
+     * \param path File to write
+     * \return False if the file could not be written
+     */
+    bool save_back_buffer(const std::filesystem::path& path);
+
+    backend_type type() const override { return backend_type::software; }
+
+    HRESULT create_buffer(const D3D11_BUFFER_DESC* desc, const D3D11_SUBRESOURCE_DATA* data, ID3D11Buffer** buffer) override;
+    HRESULT create_texture2d(const D3D11_TEXTURE2D_DESC* desc, const D3D11_SUBRESOURCE_DATA* data,
+                             ID3D11Texture2D** texture) override;
+    HRESULT create_input_layout(const D3D11_INPUT_ELEMENT_DESC* elements, u32 count, const void* bytecode, size_t size,
+                                ID3D11InputLayout** layout) override;
+
+    void update_subresource(ID3D11Resource* resource, u32 subresource, const void* data, u32 row_pitch,
+                            u32 depth_pitch) override;
+
+    void set_input_layout(ID3D11InputLayout* layout) override;
+    void set_vertex_buffers(u32 slot, u32 count, ID3D11Buffer* const* buffers, const u32* strides, const u32* offsets) override;
+    void set_index_buffer(ID3D11Buffer* buffer, DXGI_FORMAT format, u32 offset) override;
+    void set_topology(D3D11_PRIMITIVE_TOPOLOGY topology) override;
+
+    void set_vertex_shader(ID3D11VertexShader* shader) override;
+    void set_pixel_shader(ID3D11PixelShader* shader) override;
+
+    void set_constant_buffers(shader_stage stage, u32 slot, u32 count, ID3D11Buffer* const* buffers) override;
+    void set_constant_buffer_ranges(shader_stage stage, u32 slot, u32 count, ID3D11Buffer* const* buffers,
+                                    const u32* first_constants, const u32* constant_counts) override;
+    void set_shader_resources(shader_stage stage, u32 slot, u32 count, ID3D11ShaderResourceView* const* views) override;
+    void set_samplers(shader_stage stage, u32 slot, u32 count, ID3D11SamplerState* const* samplers) override;
+
+    void set_rasterizer_state(ID3D11RasterizerState* state) override;
+    void set_viewports(u32 count, const D3D11_VIEWPORT* viewports) override;
+    void set_scissor_rects(u32 count, const D3D11_RECT* rects) override;
+    void set_blend_state(ID3D11BlendState* state, const f32 factor[4], u32 sample_mask) override;
+    void set_depth_stencil_state(ID3D11DepthStencilState* state, u32 stencil_ref) override;
+    void set_render_targets(u32 count, ID3D11RenderTargetView* const* views, ID3D11DepthStencilView* depth) override;
+
+    void clear_render_target(ID3D11RenderTargetView* view, const f32 color[4]) override;
+    void clear_depth_stencil(ID3D11DepthStencilView* view, u32 flags, f32 depth, u8 stencil) override;
+
+    void draw(u32 vertex_count, u32 first_vertex) override;
+    void draw_indexed(u32 index_count, u32 first_index, i32 base_vertex) override;
+    void draw_indexed_instanced(u32 index_count, u32 instance_count, u32 first_index, i32 base_vertex,
+                                u32 first_instance) override;
+
+    void present(bool vsync) override;
+
+private:
+    static constexpr u32 stream_count = 2; // Per vertex and per instance, the two slots the engine's layouts use
+
+    // A bound buffer or view as the stage sees it, the backend holds no references so objects must outlive their binds
+    struct vertex_stream
+    {
+        ID3D11Buffer* buffer{};
+        u32           stride{};
+        u32           offset{};
+    };
+
+    struct stage_objects
+    {
+        ID3D11Buffer*             constants[software::max_constant_buffers]{};
+        u32                       constant_offsets[software::max_constant_buffers]{}; // In bytes
+        u32                       constant_sizes[software::max_constant_buffers]{};   // 0 for the whole buffer
+        ID3D11ShaderResourceView* resources[software::max_resources]{};
+        ID3D11SamplerState*       samplers[software::max_samplers]{};
+    };
+
+    void reset_state() override;
+
+    void bind_constants(shader_stage stage, u32 slot, u32 count, ID3D11Buffer* const* buffers, const u32* first_constants,
+                        const u32* constant_counts);
+    void resolve(const stage_objects& objects, software::stage_bindings& bindings) const;
+    bool prepare_state();
+
+    // Reads the draw's indices from the bound index buffer and draws the vertex range they cover
+    void draw_indices(u32 index_count, u32 instance_count, u32 first_index, i32 base_vertex, u32 first_instance);
+
+    /**
+     * \brief Runs the vertex program over the vertices the draw touches, then rasterizes its triangles
+     * \param first Lowest vertex read, base vertex included
+     * \param vertex_count Vertices from first on, per instance
+     * \param indices Triangle list indices relative to first, empty for a non indexed draw
+     * \param instance_count Instances to draw, every one shades its own copy of the vertices
+     * \param first_instance Instance the per instance stream starts at
+     */
+    void shade_and_draw(u32 first, u32 vertex_count, std::span<const u32> indices, u32 instance_count, u32 first_instance);
+
+    software::tile_rasterizer m_rasterizer{};
+
+    ID3D11InputLayout*       m_layout{};
+    vertex_stream            m_streams[stream_count]{};
+    ID3D11Buffer*            m_index_buffer{};
+    DXGI_FORMAT              m_index_format{ DXGI_FORMAT_R32_UINT };
+    u32                      m_index_offset{};
+    D3D11_PRIMITIVE_TOPOLOGY m_topology{ D3D11_PRIMITIVE_TOPOLOGY_UNDEFINED };
+
+    software::vertex_program m_vertex_program{};
+    software::pixel_program  m_pixel_program{};
+    stage_objects            m_stages[2]{}; // Vertex and pixel
+
+    ID3D11RasterizerState*   m_rasterizer_state{};
+    ID3D11BlendState*        m_blend_state{};
+    f32                      m_blend_factor[4]{ 1.f, 1.f, 1.f, 1.f };
+    ID3D11DepthStencilState* m_depth_state{};
+    D3D11_VIEWPORT           m_viewport{};
+    D3D11_RECT               m_scissor{};
+    ID3D11RenderTargetView*  m_targets[software::max_targets]{};
+    u32                      m_target_count{};
+    ID3D11DepthStencilView*  m_depth{};
+
+    software::raster_state               m_state{};
+    software::stage_bindings             m_bindings[2]{};
+    std::vector<software::shaded_vertex> m_shaded{};
+    std::vector<u32>                     m_fetched{};   // Indices as read from the index buffer
+    std::vector<u32>                     m_indices{};   // Repeated per instance, into m_shaded
+    std::vector<u8>                      m_presented{}; // Back buffer as of the last present, RGBA
+    u32                                  m_skipped{};
+    u32                                  m_skipped_previous{};
+};
+
+} // namespace yae::gfx
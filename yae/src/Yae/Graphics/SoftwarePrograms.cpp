@@ -0,0 +1,461 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: SoftwarePrograms.cpp
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+#include "SoftwarePrograms.h"
+
+#include "FrameConstants.h"
+#include "Light.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace yae::gfx::software
+{
+
+namespace
+{
+
+// Mirrors cbuffer MatrixData in FontVertexShader.hlsl. TextureVertexShader's MatrixBuffer is set the same way
+struct overlay_constants
+{
+    math::mat4 world{};
+    math::mat4 view{};
+    math::mat4 projection{};
+};
+
+// Mirrors cbuffer Data in LightPixelShader.hlsl
+struct cluster_constants
+{
+    f32        slice_scale{};
+    math::vec2 tile_scale{};
+    f32        slice_bias{};
+    u32        tiles_x{};
+    u32        tiles_y{};
+    u32        slices{};
+};
+
+// Varyings written by the deferred vertex program, in floats
+constexpr u32 v_normal    = 0;
+constexpr u32 v_world_pos = 3;
+constexpr u32 v_uv        = 6;
+constexpr u32 v_tangent   = 8;
+constexpr u32 v_binormal  = 11;
+constexpr u32 v_view_dir  = 14;
+constexpr u32 v_tint      = 17;
+constexpr u32 v_deferred  = 21;
+
+template<typename T>
+const T& constants(const stage_bindings& bindings, u32 slot)
+{
+    static const T unbound{};
+    const constant_binding& cb = bindings.constants[slot];
+    return cb.data && cb.size >= sizeof(T) ? *(const T*) cb.data : unbound;
+}
+
+// Structured buffer element, zero when out of range as on the GPU
+template<typename T>
+T element(const resource_binding& buffer, u32 index)
+{
+    if (!buffer.memory || ((u64) index + 1) * sizeof(T) > buffer.size)
+    {
+        return {};
+    }
+    T value;
+    memcpy(&value, buffer.memory + (size_t) index * sizeof(T), sizeof(T));
+    return value;
+}
+
+// Constant buffers hold matrices transposed for HLSL, this gives back the matrix the CPU wrote
+math::matrix cbuffer_matrix(const math::mat4& m)
+{
+    return XMMatrixTranspose(XMLoadFloat4x4(&m));
+}
+
+void store3(f32* out, math::vector v)
+{
+    XMStoreFloat3((math::vec3*) out, v);
+}
+
+math::vector load3(const f32* in)
+{
+    return XMLoadFloat3((const math::vec3*) in);
+}
+
+math::vector load4(const f32* in)
+{
+    return XMLoadFloat4((const math::vec4*) in);
+}
+
+math::vector fetch(const resource_binding& texture, i32 x, i32 y)
+{
+    if (!texture.memory || x < 0 || y < 0 || (u32) x >= texture.width || (u32) y >= texture.height)
+    {
+        return XMVectorZero();
+    }
+
+    const u8* row = texture.memory + (size_t) y * texture.row_pitch;
+    if (texture.format == DXGI_FORMAT_R32G32B32A32_FLOAT)
+    {
+        return XMLoadFloat4((const math::vec4*) (row + (size_t) x * 16));
+    }
+
+    const u8* p = row + (size_t) x * 4;
+    return XMVectorScale(XMVectorSet(p[0], p[1], p[2], p[3]), 1.f / 255.f);
+}
+
+i32 address(i32 coord, u32 size, D3D11_TEXTURE_ADDRESS_MODE mode)
+{
+    if (mode == D3D11_TEXTURE_ADDRESS_WRAP)
+    {
+        const i32 wrapped = coord % (i32) size;
+        return wrapped < 0 ? wrapped + (i32) size : wrapped;
+    }
+    return std::clamp(coord, 0, (i32) size - 1);
+}
+
+// Texture2D.Load, used on the G-buffer
+math::vector load(const resource_binding& texture, const pixel_input& input)
+{
+    return fetch(texture, (i32) input.x, (i32) input.y);
+}
+
+// Texture2D.Sample on the top mip, bilinear unless the sampler filters by point
+math::vector sample(const resource_binding& texture, const sampler_binding& sampler, f32 u, f32 v)
+{
+    if (!texture.memory || !texture.width || !texture.height)
+    {
+        return XMVectorZero();
+    }
+
+    const f32 x = u * (f32) texture.width - .5f;
+    const f32 y = v * (f32) texture.height - .5f;
+
+    if (sampler.point)
+    {
+        return fetch(texture, address((i32) floorf(x + .5f), texture.width, sampler.address_u),
+                     address((i32) floorf(y + .5f), texture.height, sampler.address_v));
+    }
+
+    const f32 fx = floorf(x);
+    const f32 fy = floorf(y);
+    const i32 x0 = address((i32) fx, texture.width, sampler.address_u);
+    const i32 x1 = address((i32) fx + 1, texture.width, sampler.address_u);
+    const i32 y0 = address((i32) fy, texture.height, sampler.address_v);
+    const i32 y1 = address((i32) fy + 1, texture.height, sampler.address_v);
+
+    const math::vector top    = XMVectorLerp(fetch(texture, x0, y0), fetch(texture, x1, y0), x - fx);
+    const math::vector bottom = XMVectorLerp(fetch(texture, x0, y1), fetch(texture, x1, y1), x - fx);
+    return XMVectorLerp(top, bottom, y - fy);
+}
+
+math::vector reflect(math::vector incident, math::vector normal)
+{
+    return XMVector3Reflect(incident, normal);
+}
+
+// CalculateAttenuation and CalculatePointLight from PointLight.hlsli
+f32 attenuation(const packed_pointlight& light, f32 dist)
+{
+    const f32 s = dist / light.radius;
+    if (s >= 1.f)
+    {
+        return 0.f;
+    }
+
+    const f32 s2 = s * s;
+    return light.intensity * (1.f - s2) * (1.f - s2) / (1.f + light.falloff * s);
+}
+
+math::vector point_light(const packed_pointlight& light, const frame_constants& frame, math::vector normal, math::vector view_dir,
+                         math::vector texture_color, math::vector pos)
+{
+    const math::vector light_dir   = XMVector3Normalize(pos);
+    const f32          diff        = std::max(XMVectorGetX(XMVector3Dot(normal, light_dir)), 0.f);
+    const math::vector reflect_dir = reflect(XMVectorNegate(light_dir), normal);
+    const f32          spec        = powf(std::max(XMVectorGetX(XMVector3Dot(view_dir, reflect_dir)), 0.f), 32.f);
+    const f32          atten       = attenuation(light, XMVectorGetX(XMVector3Length(pos)));
+
+    const math::vector color    = XMVectorSet(light.color.x, light.color.y, light.color.z, 1.f);
+    const math::vector ambient  = XMVectorScale(XMVectorMultiply(XMLoadFloat4(&frame.ambient_color), texture_color), atten);
+    const math::vector lit      = XMVectorMultiply(color, texture_color);
+    return XMVectorAdd(ambient, XMVectorScale(lit, (diff + spec) * atten));
+}
+
+// The lit G-buffer pixel, shared by DeferredPixelShader and MultitexturePixelShader
+void shade_gbuffer(const frame_constants& frame, const f32* varyings, math::vector diff, math::vector bump,
+                   bool normalize_reflection, pixel_output& output)
+{
+    math::vector color = XMVectorMultiply(XMLoadFloat4(&frame.ambient_color), diff);
+
+    bump                          = XMVectorSubtract(XMVectorScale(bump, 2.f), XMVectorSplatOne());
+    const math::vector bump_normal = XMVector3Normalize(XMVectorAdd(
+        XMVectorAdd(XMVectorScale(load3(varyings + v_tangent), XMVectorGetX(bump)),
+                    XMVectorScale(load3(varyings + v_binormal), XMVectorGetY(bump))),
+        XMVectorScale(load3(varyings + v_normal), XMVectorGetZ(bump))));
+
+    const math::vector light_dir       = XMVectorNegate(XMLoadFloat3(&frame.light_direction));
+    const f32          light_intensity = std::clamp(XMVectorGetX(XMVector3Dot(bump_normal, light_dir)), 0.f, 1.f);
+    const math::vector dir_color       = XMLoadFloat4(&frame.dir_light_color);
+
+    color = XMVectorAdd(color, XMVectorScale(XMVectorMultiply(dir_color, diff), light_intensity));
+
+    if (light_intensity > 0.f)
+    {
+        const math::vector incident    = normalize_reflection ? XMVector3Normalize(XMVectorNegate(light_dir))
+                                                              : XMVectorNegate(light_dir);
+        const math::vector reflect_dir = reflect(incident, bump_normal);
+        const f32 spec = powf(std::clamp(XMVectorGetX(XMVector3Dot(load3(varyings + v_view_dir), reflect_dir)), 0.f, 1.f), 32.f);
+        color          = XMVectorAdd(color, XMVectorScale(XMVectorMultiply(dir_color, diff), spec));
+    }
+
+    const math::vector world_pos = load3(varyings + v_world_pos);
+    XMStoreFloat4(&output.color[0], XMVectorSetW(world_pos, 1.f));
+    XMStoreFloat4(&output.color[1], XMVectorSetW(bump_normal, 1.f));
+    XMStoreFloat4(&output.color[2], XMVectorSaturate(color));
+}
+
+// DeferredVertexShader.hlsl
+void deferred_vs(const stage_bindings& bindings, const vertex_input& input, shaded_vertex& output)
+{
+    const frame_constants& frame = constants<frame_constants>(bindings, frame::buffer_slot);
+
+    const math::matrix world{ XMLoadFloat4(&input.world[0]), XMLoadFloat4(&input.world[1]), XMLoadFloat4(&input.world[2]),
+                              XMLoadFloat4(&input.world[3]) };
+    const math::matrix wvp = world * cbuffer_matrix(frame.view) * cbuffer_matrix(frame.projection);
+
+    const math::vector position  = XMVectorSetW(XMLoadFloat3(&input.position), 1.f);
+    const math::vector world_pos = XMVector4Transform(position, world);
+
+    XMStoreFloat4(&output.position, XMVector4Transform(position, wvp));
+    f32* v = output.varyings;
+    store3(v + v_normal, XMVector3Normalize(XMVector3TransformNormal(XMLoadFloat3(&input.normal), world)));
+    store3(v + v_world_pos, world_pos);
+    v[v_uv]     = input.uv.x;
+    v[v_uv + 1] = input.uv.y;
+    store3(v + v_tangent, XMVector3Normalize(XMVector3TransformNormal(XMLoadFloat3(&input.tangent), world)));
+    store3(v + v_binormal, XMVector3Normalize(XMVector3TransformNormal(XMLoadFloat3(&input.binormal), world)));
+    store3(v + v_view_dir, XMVector3Normalize(XMVectorSubtract(XMLoadFloat3(&frame.camera_pos), world_pos)));
+    XMStoreFloat4((math::vec4*) (v + v_tint), XMLoadFloat4(&input.tint));
+}
+
+// LightVolumeVertexShader.hlsl, the light index travels as the only varying
+void light_volume_vs(const stage_bindings& bindings, const vertex_input& input, shaded_vertex& output)
+{
+    const frame_constants&  frame = constants<frame_constants>(bindings, frame::buffer_slot);
+    const packed_pointlight light = element<packed_pointlight>(bindings.resources[0], input.instance_id);
+
+    const math::vector world_pos = XMVectorSetW(
+        XMVectorAdd(XMLoadFloat3(&light.position), XMVectorScale(XMLoadFloat3(&input.position), light.radius)), 1.f);
+
+    XMStoreFloat4(&output.position, XMVector4Transform(world_pos, cbuffer_matrix(frame.view) * cbuffer_matrix(frame.projection)));
+    output.varyings[0] = (f32) input.instance_id;
+}
+
+// ToScreenVertexShader.hlsl and LightVertexShader.hlsl, a triangle covering the screen from three vertex ids
+void full_screen_vs(const stage_bindings&, const vertex_input& input, shaded_vertex& output)
+{
+    const f32 u     = (f32) ((input.vertex_id << 1) & 2);
+    const f32 v     = (f32) (input.vertex_id & 2);
+    output.position = { u * 2.f - 1.f, v * -2.f + 1.f, 0.f, 1.f };
+}
+
+// FontVertexShader.hlsl and TextureVertexShader.hlsl
+void overlay_vs(const stage_bindings& bindings, const vertex_input& input, shaded_vertex& output)
+{
+    const overlay_constants& matrices = constants<overlay_constants>(bindings, 0);
+    const math::matrix       wvp =
+        cbuffer_matrix(matrices.world) * cbuffer_matrix(matrices.view) * cbuffer_matrix(matrices.projection);
+
+    XMStoreFloat4(&output.position, XMVector4Transform(XMVectorSetW(XMLoadFloat3(&input.position), 1.f), wvp));
+    output.varyings[0] = input.uv.x;
+    output.varyings[1] = input.uv.y;
+}
+
+// DeferredPixelShader.hlsl
+void deferred_ps(const void* context, const pixel_input& input, pixel_output& output)
+{
+    const stage_bindings&  b     = *(const stage_bindings*) context;
+    const frame_constants& frame = constants<frame_constants>(b, frame::buffer_slot);
+    const f32*             v     = input.varyings;
+
+    const math::vector diffuse = sample(b.resources[0], b.samplers[0], v[v_uv], v[v_uv + 1]);
+    const math::vector bump    = sample(b.resources[1], b.samplers[0], v[v_uv], v[v_uv + 1]);
+    shade_gbuffer(frame, v, XMVectorMultiply(diffuse, load4(v + v_tint)), bump, true, output);
+}
+
+// MultitexturePixelShader.hlsl
+void multitexture_ps(const void* context, const pixel_input& input, pixel_output& output)
+{
+    const stage_bindings&  b     = *(const stage_bindings*) context;
+    const frame_constants& frame = constants<frame_constants>(b, frame::buffer_slot);
+    const f32*             v     = input.varyings;
+
+    const math::vector diffuse = sample(b.resources[0], b.samplers[0], v[v_uv], v[v_uv + 1]);
+    const math::vector blend   = sample(b.resources[1], b.samplers[0], v[v_uv], v[v_uv + 1]);
+    const math::vector bump    = sample(b.resources[2], b.samplers[0], v[v_uv], v[v_uv + 1]);
+    const math::vector diff    = XMVectorMultiply(XMVectorSaturate(XMVectorScale(XMVectorMultiply(diffuse, blend), 2.f)),
+                                                  load4(v + v_tint));
+    shade_gbuffer(frame, v, diff, bump, false, output);
+}
+
+// ToScreenPixelShader.hlsl
+void to_screen_ps(const void* context, const pixel_input& input, pixel_output& output)
+{
+    const stage_bindings& b = *(const stage_bindings*) context;
+    XMStoreFloat4(&output.color[0], load(b.resources[2], input));
+}
+
+// LightPixelShader.hlsl, the lights of the pixel's cluster
+void clustered_lights_ps(const void* context, const pixel_input& input, pixel_output& output)
+{
+    const stage_bindings&    b        = *(const stage_bindings*) context;
+    const frame_constants&   frame    = constants<frame_constants>(b, frame::buffer_slot);
+    const cluster_constants& clusters = constants<cluster_constants>(b, 0);
+
+    const math::vector position = load(b.resources[0], input);
+    const math::vector normal   = load(b.resources[1], input);
+    const math::vector diffuse  = load(b.resources[2], input);
+    const math::vector view_dir = XMVector3Normalize(XMVectorSubtract(XMLoadFloat3(&frame.camera_pos), position));
+
+    const f32 view_z = XMVectorGetZ(XMVector4Transform(XMVectorSetW(position, 1.f), cbuffer_matrix(frame.view)));
+    const f32 slice  = std::clamp(floorf(logf(std::max(view_z, 1e-4f)) * clusters.slice_scale + clusters.slice_bias), 0.f,
+                                  (f32) (clusters.slices ? clusters.slices - 1 : 0));
+    const u32 tile_x = std::min((u32) (input.x * clusters.tile_scale.x), clusters.tiles_x ? clusters.tiles_x - 1 : 0);
+    const u32 tile_y = std::min((u32) (input.y * clusters.tile_scale.y), clusters.tiles_y ? clusters.tiles_y - 1 : 0);
+    const u32 index  = ((u32) slice * clusters.tiles_y + tile_y) * clusters.tiles_x + tile_x;
+
+    struct range
+    {
+        u32 offset;
+        u32 count;
+    };
+    const range cluster = element<range>(b.resources[4], index);
+
+    math::vector color = XMVectorZero();
+    for (u32 i = 0; i < cluster.count; ++i)
+    {
+        const u32               light_index = element<u32>(b.resources[5], cluster.offset + i);
+        const packed_pointlight light       = element<packed_pointlight>(b.resources[3], light_index);
+        color = XMVectorAdd(color, point_light(light, frame, normal, view_dir, diffuse,
+                                               XMVectorSubtract(XMLoadFloat3(&light.position), position)));
+    }
+    XMStoreFloat4(&output.color[0], color);
+}
+
+// LightVolumePixelShader.hlsl
+void light_volume_ps(const void* context, const pixel_input& input, pixel_output& output)
+{
+    const stage_bindings&  b     = *(const stage_bindings*) context;
+    const frame_constants& frame = constants<frame_constants>(b, frame::buffer_slot);
+
+    const math::vector position = load(b.resources[0], input);
+    const math::vector normal   = load(b.resources[1], input);
+    const math::vector diffuse  = load(b.resources[2], input);
+    const math::vector view_dir = XMVector3Normalize(XMVectorSubtract(XMLoadFloat3(&frame.camera_pos), position));
+
+    // Every vertex of an instance carries the same index, rounding only undoes interpolation error
+    const packed_pointlight light = element<packed_pointlight>(b.resources[3], (u32) (input.varyings[0] + .5f));
+    XMStoreFloat4(&output.color[0], point_light(light, frame, normal, view_dir, diffuse,
+                                                XMVectorSubtract(XMLoadFloat3(&light.position), position)));
+}
+
+// FontPixelShader.hlsl
+void font_ps(const void* context, const pixel_input& input, pixel_output& output)
+{
+    const stage_bindings& b    = *(const stage_bindings*) context;
+    const math::vec4&     tint = constants<math::vec4>(b, 0);
+
+    math::vector color = sample(b.resources[0], b.samplers[0], input.varyings[0], input.varyings[1]);
+    if (XMVectorGetX(color) == 0.f)
+    {
+        color = XMVectorSetW(color, 0.f);
+    }
+    XMStoreFloat4(&output.color[0], XMVectorMultiply(color, XMLoadFloat4(&tint)));
+}
+
+// TexturePixelShader.hlsl, the overlay's texture times tintColor
+void texture_ps(const void* context, const pixel_input& input, pixel_output& output)
+{
+    const stage_bindings& b    = *(const stage_bindings*) context;
+    const math::vec4&     tint = constants<math::vec4>(b, 0);
+
+    const math::vector color = sample(b.resources[0], b.samplers[0], input.varyings[0], input.varyings[1]);
+    XMStoreFloat4(&output.color[0], XMVectorMultiply(color, XMLoadFloat4(&tint)));
+}
+
+} // anonymous namespace
+
+vertex_program find_vertex_program(std::string_view name)
+{
+    if (name == "DeferredVertexShader")
+    {
+        return { deferred_vs, v_deferred };
+    }
+    if (name == "LightVolumeVertexShader")
+    {
+        return { light_volume_vs, 1 };
+    }
+    if (name == "ToScreenVertexShader" || name == "LightVertexShader")
+    {
+        return { full_screen_vs, 0 };
+    }
+    if (name == "FontVertexShader" || name == "TextureVertexShader")
+    {
+        return { overlay_vs, 2 };
+    }
+    return {};
+}
+
+pixel_program find_pixel_program(std::string_view name)
+{
+    if (name == "DeferredPixelShader")
+    {
+        return deferred_ps;
+    }
+    if (name == "MultitexturePixelShader")
+    {
+        return multitexture_ps;
+    }
+    if (name == "ToScreenPixelShader")
+    {
+        return to_screen_ps;
+    }
+    if (name == "LightPixelShader")
+    {
+        return clustered_lights_ps;
+    }
+    if (name == "LightVolumePixelShader")
+    {
+        return light_volume_ps;
+    }
+    if (name == "FontPixelShader")
+    {
+        return font_ps;
+    }
+    if (name == "TexturePixelShader")
+    {
+        return texture_ps;
+    }
+    return nullptr;
+}
+
+} // namespace yae::gfx::software
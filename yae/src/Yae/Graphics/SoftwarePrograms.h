@@ -0,0 +1,101 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: SoftwarePrograms.h
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+
+#pragma once
+
+#include "SoftwareRasterizer.h"
+
+#include <string_view>
+
+namespace yae::gfx::software
+{
+
+constexpr u32 max_constant_buffers = D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT;
+constexpr u32 max_resources        = 8;
+constexpr u32 max_samplers         = 4;
+
+struct constant_binding
+{
+    const u8* data{};
+    u32       size{};
+};
+
+// A texture's top mip or a buffer's bytes, whichever the view points at
+struct resource_binding
+{
+    const u8*   memory{};
+    u32         size{};
+    u32         width{};
+    u32         height{};
+    u32         row_pitch{};
+    DXGI_FORMAT format{};
+};
+
+struct sampler_binding
+{
+    bool                       point{};
+    D3D11_TEXTURE_ADDRESS_MODE address_u{ D3D11_TEXTURE_ADDRESS_WRAP };
+    D3D11_TEXTURE_ADDRESS_MODE address_v{ D3D11_TEXTURE_ADDRESS_WRAP };
+};
+
+// What a shader stage can read, resolved from the backend's bound objects once per draw
+struct stage_bindings
+{
+    constant_binding constants[max_constant_buffers]{};
+    resource_binding resources[max_resources]{};
+    sampler_binding  samplers[max_samplers]{};
+};
+
+// One vertex as the input layout fed it, by semantic. Anything the layout doesn't have stays zero
+struct vertex_input
+{
+    math::vec3 position{};
+    math::vec3 normal{};
+    math::vec2 uv{};
+    math::vec3 tangent{};
+    math::vec3 binormal{};
+    math::vec4 world[4]{};
+    math::vec4 tint{};
+    u32        vertex_id{};
+    u32        instance_id{};
+};
+
+using vertex_function = void (*)(const stage_bindings& bindings, const vertex_input& input, shaded_vertex& output);
+
+struct vertex_program
+{
+    vertex_function run{};
+    u32             varying_count{};
+};
+
+/**
+ * \brief Finds the CPU version of an engine vertex shader. Shaders are named after the file they were loaded from
+ * \param name Debug name of the shader object, e.g. <code>DeferredVertexShader</code>
+ * \return A program with no function if the shader has no CPU version, its draws are skipped
+ */
+vertex_program find_vertex_program(std::string_view name);
+
+// Same for pixel shaders, the program's context is the pixel stage's stage_bindings
+pixel_program find_pixel_program(std::string_view name);
+
+} // namespace yae::gfx::software
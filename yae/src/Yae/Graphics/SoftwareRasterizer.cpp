@@ -0,0 +1,623 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: SoftwareRasterizer.cpp
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+#include "SoftwareRasterizer.h"
+
+#include "Yae/Core/Jobs.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <immintrin.h>
+
+namespace yae::gfx::software
+{
+
+namespace
+{
+
+constexpr f32 min_w = 1e-5f; // Without depth clipping only vertices behind the eye are clipped
+
+// Distance of a clip space position to the planes that are clipped against, positive inside
+f32 plane_distance(const math::vec4& p, u32 plane)
+{
+    switch (plane)
+    {
+    case 0: return p.z;       // Near, D3D clip space starts at z = 0
+    case 1: return p.w - p.z; // Far
+    default: return p.w - min_w;
+    }
+}
+
+shaded_vertex lerp(const shaded_vertex& a, const shaded_vertex& b, f32 t, u32 varying_count)
+{
+    shaded_vertex v;
+    v.position = { a.position.x + (b.position.x - a.position.x) * t, a.position.y + (b.position.y - a.position.y) * t,
+                   a.position.z + (b.position.z - a.position.z) * t, a.position.w + (b.position.w - a.position.w) * t };
+    for (u32 i = 0; i < varying_count; ++i)
+    {
+        v.varyings[i] = a.varyings[i] + (b.varyings[i] - a.varyings[i]) * t;
+    }
+    return v;
+}
+
+bool depth_passes(D3D11_COMPARISON_FUNC func, f32 depth, f32 stored)
+{
+    switch (func)
+    {
+    case D3D11_COMPARISON_NEVER: return false;
+    case D3D11_COMPARISON_LESS: return depth < stored;
+    case D3D11_COMPARISON_EQUAL: return depth == stored;
+    case D3D11_COMPARISON_LESS_EQUAL: return depth <= stored;
+    case D3D11_COMPARISON_GREATER: return depth > stored;
+    case D3D11_COMPARISON_NOT_EQUAL: return depth != stored;
+    case D3D11_COMPARISON_GREATER_EQUAL: return depth >= stored;
+    default: return true;
+    }
+}
+
+f32 blend_factor(D3D11_BLEND blend, u32 channel, const f32 src[4], const f32 dst[4], const f32 constant[4])
+{
+    switch (blend)
+    {
+    case D3D11_BLEND_ZERO: return 0.f;
+    case D3D11_BLEND_SRC_COLOR: return src[channel];
+    case D3D11_BLEND_INV_SRC_COLOR: return 1.f - src[channel];
+    case D3D11_BLEND_SRC_ALPHA: return src[3];
+    case D3D11_BLEND_INV_SRC_ALPHA: return 1.f - src[3];
+    case D3D11_BLEND_DEST_ALPHA: return dst[3];
+    case D3D11_BLEND_INV_DEST_ALPHA: return 1.f - dst[3];
+    case D3D11_BLEND_DEST_COLOR: return dst[channel];
+    case D3D11_BLEND_INV_DEST_COLOR: return 1.f - dst[channel];
+    case D3D11_BLEND_SRC_ALPHA_SAT: return channel == 3 ? 1.f : std::min(src[3], 1.f - dst[3]);
+    case D3D11_BLEND_BLEND_FACTOR: return constant[channel];
+    case D3D11_BLEND_INV_BLEND_FACTOR: return 1.f - constant[channel];
+    default: return 1.f;
+    }
+}
+
+f32 blend_op(D3D11_BLEND_OP op, f32 src, f32 src_factor, f32 dst, f32 dst_factor)
+{
+    switch (op)
+    {
+    case D3D11_BLEND_OP_SUBTRACT: return src * src_factor - dst * dst_factor;
+    case D3D11_BLEND_OP_REV_SUBTRACT: return dst * dst_factor - src * src_factor;
+    case D3D11_BLEND_OP_MIN: return std::min(src, dst);
+    case D3D11_BLEND_OP_MAX: return std::max(src, dst);
+    default: return src * src_factor + dst * dst_factor;
+    }
+}
+
+// Lanes whose edge function is positive, or zero on a top or left edge
+__m128d inside_edge(__m128d value, __m128d top_left)
+{
+    const __m128d zero = _mm_setzero_pd();
+    return _mm_or_pd(_mm_cmpgt_pd(value, zero), _mm_and_pd(_mm_cmpeq_pd(value, zero), top_left));
+}
+
+void read_texel(const color_target& target, u32 x, u32 y, f32 texel[4])
+{
+    const u8* row = target.memory + (size_t) y * target.row_pitch;
+    if (target.format == DXGI_FORMAT_R32G32B32A32_FLOAT)
+    {
+        memcpy(texel, row + (size_t) x * 16, sizeof(f32) * 4);
+    } else
+    {
+        const u8* p = row + (size_t) x * 4;
+        for (u32 i = 0; i < 4; ++i)
+        {
+            texel[i] = (f32) p[i] / 255.f;
+        }
+    }
+}
+
+void write_texel(const color_target& target, u32 x, u32 y, const f32 texel[4], u8 write_mask)
+{
+    u8* row = target.memory + (size_t) y * target.row_pitch;
+    if (target.format == DXGI_FORMAT_R32G32B32A32_FLOAT)
+    {
+        f32* p = (f32*) (row + (size_t) x * 16);
+        for (u32 i = 0; i < 4; ++i)
+        {
+            if (write_mask & (1 << i))
+            {
+                p[i] = texel[i];
+            }
+        }
+    } else
+    {
+        u8* p = row + (size_t) x * 4;
+        for (u32 i = 0; i < 4; ++i)
+        {
+            if (write_mask & (1 << i))
+            {
+                p[i] = (u8) (std::clamp(texel[i], 0.f, 1.f) * 255.f + .5f);
+            }
+        }
+    }
+}
+
+void output_pixel(const raster_state& state, u32 x, u32 y, const pixel_output& output)
+{
+    const D3D11_RENDER_TARGET_BLEND_DESC& blend = state.blend;
+    for (u32 i = 0; i < state.target_count; ++i)
+    {
+        const color_target& target = state.targets[i];
+        if (!target.memory)
+        {
+            continue;
+        }
+
+        f32 src[4]{ output.color[i].x, output.color[i].y, output.color[i].z, output.color[i].w };
+        if (!blend.BlendEnable)
+        {
+            write_texel(target, x, y, src, blend.RenderTargetWriteMask);
+            continue;
+        }
+
+        // Normalized formats clamp the shader's output before it is blended
+        if (target.format != DXGI_FORMAT_R32G32B32A32_FLOAT)
+        {
+            for (f32& c : src)
+            {
+                c = std::clamp(c, 0.f, 1.f);
+            }
+        }
+
+        f32 dst[4];
+        read_texel(target, x, y, dst);
+
+        f32 result[4];
+        for (u32 c = 0; c < 3; ++c)
+        {
+            result[c] = blend_op(blend.BlendOp, src[c], blend_factor(blend.SrcBlend, c, src, dst, state.blend_factor), dst[c],
+                                 blend_factor(blend.DestBlend, c, src, dst, state.blend_factor));
+        }
+        result[3] = blend_op(blend.BlendOpAlpha, src[3], blend_factor(blend.SrcBlendAlpha, 3, src, dst, state.blend_factor),
+                             dst[3], blend_factor(blend.DestBlendAlpha, 3, src, dst, state.blend_factor));
+
+        write_texel(target, x, y, result, blend.RenderTargetWriteMask);
+    }
+}
+
+} // anonymous namespace
+
+void tile_rasterizer::draw(const raster_state& state, std::span<const shaded_vertex> vertices, std::span<const u32> indices)
+{
+    ++m_frame.draws;
+    if (!state.program || !state.width || !state.height)
+    {
+        return;
+    }
+
+    const D3D11_VIEWPORT& vp = state.viewport;
+    m_bounds.left            = std::max((LONG) vp.TopLeftX, (LONG) 0);
+    m_bounds.top             = std::max((LONG) vp.TopLeftY, (LONG) 0);
+    m_bounds.right           = std::min((LONG) (vp.TopLeftX + vp.Width), (LONG) state.width);
+    m_bounds.bottom          = std::min((LONG) (vp.TopLeftY + vp.Height), (LONG) state.height);
+    if (state.scissor_enable)
+    {
+        m_bounds.left   = std::max(m_bounds.left, state.scissor.left);
+        m_bounds.top    = std::max(m_bounds.top, state.scissor.top);
+        m_bounds.right  = std::min(m_bounds.right, state.scissor.right);
+        m_bounds.bottom = std::min(m_bounds.bottom, state.scissor.bottom);
+    }
+
+    if (m_bounds.left >= m_bounds.right || m_bounds.top >= m_bounds.bottom)
+    {
+        return;
+    }
+
+    const u32 tiles_x = (state.width + tile_size - 1) / tile_size;
+    const u32 tiles_y = (state.height + tile_size - 1) / tile_size;
+    if (tiles_x != m_tiles_x || tiles_y != m_tiles_y)
+    {
+        m_tiles_x = tiles_x;
+        m_tiles_y = tiles_y;
+        m_bins.resize((size_t) tiles_x * tiles_y);
+        m_tile_covered.assign(m_bins.size(), 0);
+        m_tile_shaded.assign(m_bins.size(), 0);
+        m_costs.assign(m_bins.size(), 0);
+    }
+
+    for (std::vector<u32>& bin : m_bins)
+    {
+        bin.clear();
+    }
+    m_clipped.clear();
+    m_triangles.clear();
+
+    const u32 count = (u32) vertices.size();
+    for (u32 i = 0; i + 2 < (u32) indices.size(); i += 3)
+    {
+        ++m_frame.triangles;
+        if (indices[i] >= count || indices[i + 1] >= count || indices[i + 2] >= count)
+        {
+            ++m_frame.triangles_culled;
+            continue;
+        }
+        clip(state, vertices[indices[i]], vertices[indices[i + 1]], vertices[indices[i + 2]]);
+    }
+
+    if (m_triangles.empty())
+    {
+        return;
+    }
+
+    jobs::parallel_for(0, (u32) m_bins.size(), 1, [this, &state](u32 begin, u32 end) {
+        for (u32 tile = begin; tile < end; ++tile)
+        {
+            rasterize_tile(state, tile);
+        }
+    });
+
+    for (u32 tile = 0; tile < (u32) m_bins.size(); ++tile)
+    {
+        m_frame.pixels_covered += m_tile_covered[tile];
+        m_frame.pixels_shaded += m_tile_shaded[tile];
+        m_costs[tile] += m_tile_shaded[tile];
+        m_tile_covered[tile] = 0;
+        m_tile_shaded[tile]  = 0;
+    }
+}
+
+void tile_rasterizer::end_frame()
+{
+    m_previous = m_frame;
+    m_frame    = {};
+    m_previous_costs.swap(m_costs);
+    m_costs.assign(m_previous_costs.size(), 0);
+}
+
+void tile_rasterizer::clip(const raster_state& state, const shaded_vertex& v0, const shaded_vertex& v1,
+                           const shaded_vertex& v2)
+{
+    const math::vec4& p0 = v0.position;
+    const math::vec4& p1 = v1.position;
+    const math::vec4& p2 = v2.position;
+
+    // Entirely outside one side of the view, nothing to draw
+    if ((p0.x > p0.w && p1.x > p1.w && p2.x > p2.w) || (p0.x < -p0.w && p1.x < -p1.w && p2.x < -p2.w) ||
+        (p0.y > p0.w && p1.y > p1.w && p2.y > p2.w) || (p0.y < -p0.w && p1.y < -p1.w && p2.y < -p2.w))
+    {
+        ++m_frame.triangles_culled;
+        return;
+    }
+
+    // Near and far with depth clipping, otherwise only what is behind the eye. x and y are left to the bounds test
+    const u32 first_plane = state.depth_clip ? 0 : 2;
+    const u32 last_plane  = state.depth_clip ? 2 : 3;
+
+    bool inside = true;
+    for (u32 plane = first_plane; plane < last_plane; ++plane)
+    {
+        const f32 d0 = plane_distance(p0, plane);
+        const f32 d1 = plane_distance(p1, plane);
+        const f32 d2 = plane_distance(p2, plane);
+        if (d0 < 0.f && d1 < 0.f && d2 < 0.f)
+        {
+            ++m_frame.triangles_culled;
+            return;
+        }
+        inside = inside && d0 >= 0.f && d1 >= 0.f && d2 >= 0.f;
+    }
+
+    if (inside)
+    {
+        setup(state, v0, v1, v2);
+        return;
+    }
+
+    ++m_frame.triangles_clipped;
+
+    // Each plane adds at most one vertex
+    shaded_vertex polygon[2][6];
+    u32           count = 3;
+    polygon[0][0]       = v0;
+    polygon[0][1]       = v1;
+    polygon[0][2]       = v2;
+
+    u32 current = 0;
+    for (u32 plane = first_plane; plane < last_plane; ++plane)
+    {
+        const shaded_vertex* in  = polygon[current];
+        shaded_vertex*       out = polygon[current ^ 1];
+        u32                  kept{};
+
+        for (u32 i = 0; i < count; ++i)
+        {
+            const shaded_vertex& a  = in[i];
+            const shaded_vertex& b  = in[(i + 1) % count];
+            const f32            da = plane_distance(a.position, plane);
+            const f32            db = plane_distance(b.position, plane);
+
+            if (da >= 0.f)
+            {
+                out[kept++] = a;
+            }
+            if ((da >= 0.f) != (db >= 0.f))
+            {
+                out[kept++] = lerp(a, b, da / (da - db), state.varying_count);
+            }
+        }
+
+        count   = kept;
+        current ^= 1;
+        if (count < 3)
+        {
+            return;
+        }
+    }
+
+    for (u32 i = 1; i + 1 < count; ++i)
+    {
+        setup(state, polygon[current][0], polygon[current][i], polygon[current][i + 1]);
+    }
+}
+
+void tile_rasterizer::setup(const raster_state& state, const shaded_vertex& v0, const shaded_vertex& v1,
+                            const shaded_vertex& v2)
+{
+    const D3D11_VIEWPORT& vp  = state.viewport;
+    const shaded_vertex*  v[3]{ &v0, &v1, &v2 };
+
+    // Snapped to the subpixel grid, where every product below is exact in a double for vertices within 2^18 pixels
+    // of the target
+    triangle tri{};
+    f64      x[3];
+    f64      y[3];
+    for (u32 i = 0; i < 3; ++i)
+    {
+        const math::vec4& p = v[i]->position;
+        tri.inv_w[i]        = 1.f / p.w;
+        x[i]                = std::round((f64) ((p.x * tri.inv_w[i] + 1.f) * .5f * vp.Width + vp.TopLeftX) * subpixel_steps);
+        y[i]                = std::round((f64) ((1.f - p.y * tri.inv_w[i]) * .5f * vp.Height + vp.TopLeftY) * subpixel_steps);
+        x[i] /= subpixel_steps;
+        y[i] /= subpixel_steps;
+        tri.z[i] = vp.MinDepth + p.z * tri.inv_w[i] * (vp.MaxDepth - vp.MinDepth);
+    }
+
+    // Positive when the triangle is clockwise on screen, which is front facing unless FrontCounterClockwise is set
+    const f64 area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+    if (area == 0. || !std::isfinite(area))
+    {
+        ++m_frame.triangles_culled;
+        return;
+    }
+
+    const bool front = state.front_ccw ? area < 0. : area > 0.;
+    if ((state.cull == D3D11_CULL_BACK && !front) || (state.cull == D3D11_CULL_FRONT && front))
+    {
+        ++m_frame.triangles_culled;
+        return;
+    }
+
+    // Edge i is the one opposite vertex i, so its function over the area is that vertex's barycentric weight. The
+    // shared edge of two triangles gets exactly negated functions, a center on it is inside exactly one of them
+    const f64 sign = area > 0. ? 1. : -1.;
+    for (u32 i = 0; i < 3; ++i)
+    {
+        const u32 a = (i + 1) % 3;
+        const u32 b = (i + 2) % 3;
+        tri.a[i]    = (y[a] - y[b]) * sign;
+        tri.b[i]    = (x[b] - x[a]) * sign;
+        tri.c[i]    = -(tri.a[i] * x[a] + tri.b[i] * y[a]);
+        if (tri.a[i] > 0. || (tri.a[i] == 0. && tri.b[i] > 0.))
+        {
+            tri.top_left |= 1 << i;
+        }
+    }
+    tri.inv_area = 1. / (area * sign);
+
+    // Pixels whose centers can be inside, clamped to the draw's bounds
+    tri.min_x = (i32) std::max(std::floor(std::min({ x[0], x[1], x[2] })), (f64) m_bounds.left);
+    tri.min_y = (i32) std::max(std::floor(std::min({ y[0], y[1], y[2] })), (f64) m_bounds.top);
+    tri.max_x = (i32) std::min(std::ceil(std::max({ x[0], x[1], x[2] })), (f64) m_bounds.right - 1);
+    tri.max_y = (i32) std::min(std::ceil(std::max({ y[0], y[1], y[2] })), (f64) m_bounds.bottom - 1);
+    if (tri.min_x > tri.max_x || tri.min_y > tri.max_y)
+    {
+        ++m_frame.triangles_culled;
+        return;
+    }
+
+    for (u32 i = 0; i < 3; ++i)
+    {
+        tri.vertex[i] = (u32) m_clipped.size();
+        m_clipped.push_back(*v[i]);
+    }
+
+    m_triangles.push_back(tri);
+    bin((u32) m_triangles.size() - 1);
+}
+
+void tile_rasterizer::bin(u32 index)
+{
+    const triangle& tri = m_triangles[index];
+
+    for (u32 ty = (u32) tri.min_y / tile_size; ty <= (u32) tri.max_y / tile_size; ++ty)
+    {
+        for (u32 tx = (u32) tri.min_x / tile_size; tx <= (u32) tri.max_x / tile_size; ++tx)
+        {
+            // Skipped when some edge is negative at every pixel center of the tile, checked at its most inside corner
+            const f64 x0 = (f64) (tx * tile_size) + .5;
+            const f64 y0 = (f64) (ty * tile_size) + .5;
+            const f64 x1 = x0 + (f64) (tile_size - 1);
+            const f64 y1 = y0 + (f64) (tile_size - 1);
+
+            bool outside = false;
+            for (u32 e = 0; e < 3 && !outside; ++e)
+            {
+                const f64 x = tri.a[e] >= 0. ? x1 : x0;
+                const f64 y = tri.b[e] >= 0. ? y1 : y0;
+                outside     = tri.a[e] * x + tri.b[e] * y + tri.c[e] < 0.;
+            }
+
+            if (!outside)
+            {
+                m_bins[ty * m_tiles_x + tx].push_back(index);
+                ++m_frame.bin_entries;
+            }
+        }
+    }
+}
+
+void tile_rasterizer::rasterize_tile(const raster_state& state, u32 tile)
+{
+    const std::vector<u32>& bin = m_bins[tile];
+    if (bin.empty())
+    {
+        return;
+    }
+
+    const i32 tile_x0 = (i32) ((tile % m_tiles_x) * tile_size);
+    const i32 tile_y0 = (i32) ((tile / m_tiles_x) * tile_size);
+    const i32 tile_x1 = tile_x0 + (i32) tile_size - 1;
+    const i32 tile_y1 = tile_y0 + (i32) tile_size - 1;
+
+    // Two pixels per register, the edge functions are doubles
+    const __m128d lanes_lo = _mm_setr_pd(.5, 1.5);
+    const __m128d lanes_hi = _mm_setr_pd(2.5, 3.5);
+    const __m128d zero     = _mm_setzero_pd();
+    const __m128d all      = _mm_castsi128_pd(_mm_set1_epi32(-1));
+    const bool    depth    = state.depth && state.depth_enable;
+
+    u64 covered{};
+    u32 shaded{};
+
+    f32          varyings[max_varyings];
+    pixel_input  input{};
+    pixel_output output{};
+    input.varyings = varyings;
+
+    for (const u32 index : bin)
+    {
+        const triangle& tri     = m_triangles[index];
+        const i32       x_begin = std::max(tri.min_x, tile_x0);
+        const i32       x_end   = std::min(tri.max_x, tile_x1);
+        const i32       y_begin = std::max(tri.min_y, tile_y0);
+        const i32       y_end   = std::min(tri.max_y, tile_y1);
+
+        const shaded_vertex& v0 = m_clipped[tri.vertex[0]];
+        const shaded_vertex& v1 = m_clipped[tri.vertex[1]];
+        const shaded_vertex& v2 = m_clipped[tri.vertex[2]];
+
+        __m128d a[3];
+        __m128d top_left[3];
+        for (u32 e = 0; e < 3; ++e)
+        {
+            a[e]        = _mm_set1_pd(tri.a[e]);
+            top_left[e] = (tri.top_left & (1 << e)) ? all : zero;
+        }
+
+        for (i32 y = y_begin; y <= y_end; ++y)
+        {
+            const f64 py = (f64) y + .5;
+            __m128d   row[3];
+            for (u32 e = 0; e < 3; ++e)
+            {
+                row[e] = _mm_set1_pd(tri.b[e] * py + tri.c[e]);
+            }
+
+            for (i32 x = x_begin; x <= x_end; x += 4)
+            {
+                const __m128d px_lo = _mm_add_pd(_mm_set1_pd((f64) x), lanes_lo);
+                const __m128d px_hi = _mm_add_pd(_mm_set1_pd((f64) x), lanes_hi);
+
+                alignas(16) f64 edge[3][4];
+                __m128d         mask_lo = all;
+                __m128d         mask_hi = all;
+                for (u32 e = 0; e < 3; ++e)
+                {
+                    const __m128d lo = _mm_add_pd(_mm_mul_pd(a[e], px_lo), row[e]);
+                    const __m128d hi = _mm_add_pd(_mm_mul_pd(a[e], px_hi), row[e]);
+                    mask_lo          = _mm_and_pd(mask_lo, inside_edge(lo, top_left[e]));
+                    mask_hi          = _mm_and_pd(mask_hi, inside_edge(hi, top_left[e]));
+                    _mm_store_pd(edge[e], lo);
+                    _mm_store_pd(edge[e] + 2, hi);
+                }
+
+                u32 bits = (u32) (_mm_movemask_pd(mask_lo) | (_mm_movemask_pd(mask_hi) << 2));
+                if (x_end - x < 3)
+                {
+                    bits &= (1u << (x_end - x + 1)) - 1;
+                }
+
+                while (bits)
+                {
+                    const u32 lane = (u32) std::countr_zero(bits);
+                    bits &= bits - 1;
+                    ++covered;
+
+                    const u32 pixel_x = (u32) x + lane;
+                    const f32 b0      = (f32) (edge[0][lane] * tri.inv_area);
+                    const f32 b1      = (f32) (edge[1][lane] * tri.inv_area);
+                    const f32 b2      = (f32) (edge[2][lane] * tri.inv_area);
+
+                    f32 z = b0 * tri.z[0] + b1 * tri.z[1] + b2 * tri.z[2];
+                    if (!state.depth_clip)
+                    {
+                        z = std::clamp(z, state.viewport.MinDepth, state.viewport.MaxDepth);
+                    }
+
+                    f32* stored = depth ? state.depth + (size_t) y * state.depth_pitch + pixel_x : nullptr;
+                    if (stored && !depth_passes(state.depth_func, z, *stored))
+                    {
+                        continue;
+                    }
+
+                    // Attributes are interpolated over w so they stay correct under perspective
+                    const f32 w0  = b0 * tri.inv_w[0];
+                    const f32 w1  = b1 * tri.inv_w[1];
+                    const f32 w2  = b2 * tri.inv_w[2];
+                    const f32 inv = 1.f / (w0 + w1 + w2);
+                    for (u32 i = 0; i < state.varying_count; ++i)
+                    {
+                        varyings[i] = (w0 * v0.varyings[i] + w1 * v1.varyings[i] + w2 * v2.varyings[i]) * inv;
+                    }
+
+                    input.x        = (f32) pixel_x + .5f;
+                    input.y        = (f32) py;
+                    input.depth    = z;
+                    output.discard = false;
+                    state.program(state.context, input, output);
+                    if (output.discard)
+                    {
+                        continue;
+                    }
+
+                    if (stored && state.depth_write)
+                    {
+                        *stored = z;
+                    }
+
+                    ++shaded;
+                    output_pixel(state, pixel_x, (u32) y, output);
+                }
+            }
+        }
+    }
+
+    m_tile_covered[tile] = covered;
+    m_tile_shaded[tile]  = shaded;
+}
+
+} // namespace yae::gfx::software
@@ -0,0 +1,177 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: SoftwareRasterizer.h
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+
+#pragma once
+
+#include "D3D11Common.h"
+
+#include <span>
+#include <vector>
+
+namespace yae::gfx::software
+{
+
+constexpr u32 max_varyings = 24; // Floats passed from a vertex to a pixel program, enough for the G-buffer fill
+constexpr u32 max_targets  = 3;
+constexpr u32 tile_size    = 64; // Pixels per side, every tile is rasterized by one job
+
+// A vertex after the vertex program, position in clip space
+struct shaded_vertex
+{
+    math::vec4 position{};
+    f32        varyings[max_varyings]{};
+};
+
+struct pixel_input
+{
+    f32        x{}; // Pixel center, as SV_POSITION.xy
+    f32        y{};
+    f32        depth{};
+    const f32* varyings{};
+};
+
+struct pixel_output
+{
+    math::vec4 color[max_targets]{};
+    bool       discard{};
+};
+
+// Runs for every pixel that passes the depth test. Context is whatever the draw was given, usually the bound resources
+using pixel_program = void (*)(const void* context, const pixel_input& input, pixel_output& output);
+
+struct color_target
+{
+    u8*         memory{};
+    u32         row_pitch{};
+    DXGI_FORMAT format{}; // R32G32B32A32_FLOAT or R8G8B8A8_UNORM
+};
+
+// Everything a draw needs from the pipeline. Depth is stored as one float per texel of the depth texture
+struct raster_state
+{
+    u32 width{}; // Size of the bound targets, nothing outside is touched
+    u32 height{};
+
+    D3D11_VIEWPORT  viewport{};
+    D3D11_CULL_MODE cull{ D3D11_CULL_BACK };
+    bool            front_ccw{};
+    bool            depth_clip{ true };
+    bool            scissor_enable{};
+    D3D11_RECT      scissor{};
+
+    f32*                  depth{};
+    u32                   depth_pitch{}; // In floats
+    bool                  depth_enable{};
+    bool                  depth_write{};
+    D3D11_COMPARISON_FUNC depth_func{ D3D11_COMPARISON_LESS };
+
+    color_target                   targets[max_targets]{};
+    u32                            target_count{};
+    D3D11_RENDER_TARGET_BLEND_DESC blend{};
+    f32                            blend_factor[4]{};
+
+    pixel_program program{};
+    const void*   context{};
+    u32           varying_count{};
+};
+
+struct raster_stats
+{
+    u32 draws{};
+    u32 triangles{};         // Submitted
+    u32 triangles_culled{};  // Back facing, degenerate or outside the view
+    u32 triangles_clipped{}; // Split against the near or far plane
+    u32 bin_entries{};       // Triangle and tile pairs, more than one per triangle when it spans tiles
+    u64 pixels_covered{};
+    u64 pixels_shaded{};     // Passed the depth test and ran the pixel program
+};
+
+/**
+ * \brief Rasterizes triangle lists on the CPU. Each draw is clipped and set up on the calling thread, then binned into
+ * tiles of tile_size pixels. Tiles are rasterized in parallel through the job system, one job per tile, four pixels
+ * at a time with SSE edge functions. A tile only ever writes its own pixels and keeps its triangles in submission
+ * order, so the result does not depend on how the jobs were scheduled
+ */
+class tile_rasterizer
+{
+public:
+    /**
+     * \brief Draws a triangle list. Returns once every pixel has been written
+     * \param state Targets, fixed function state and the pixel program
+     * \param vertices Vertices in clip space
+     * \param indices Three per triangle, into vertices
+     */
+    void draw(const raster_state& state, std::span<const shaded_vertex> vertices, std::span<const u32> indices);
+
+    const raster_stats& current() const { return m_frame; }
+    const raster_stats& last_frame() const { return m_previous; }
+
+    // Pixels shaded per tile over the last finished frame, row by row, for finding where a frame's pixel cost goes
+    std::span<const u32> tile_costs() const { return m_previous_costs; }
+    u32                  tiles_x() const { return m_tiles_x; }
+    u32                  tiles_y() const { return m_tiles_y; }
+
+    void end_frame();
+
+private:
+    // Screen space edge functions of a triangle, positive inside. Vertices are snapped to subpixel_bits first, which
+    // makes every edge function exact in doubles, so triangles sharing an edge never both cover or both miss a pixel
+    struct triangle
+    {
+        f64 a[3]{};
+        f64 b[3]{};
+        f64 c[3]{};
+        u32 top_left{};  // Bit per edge, pixels exactly on a top or left edge belong to the triangle
+        f64 inv_area{};
+        f32 z[3]{};      // Viewport depth
+        f32 inv_w[3]{};
+        u32 vertex[3]{}; // Into m_clipped
+        i32 min_x{};
+        i32 min_y{};
+        i32 max_x{};     // Inclusive
+        i32 max_y{};
+    };
+
+    static constexpr f32 subpixel_steps = 256.f; // 8 bits of subpixel precision, as D3D11 rasterizes
+
+    void setup(const raster_state& state, const shaded_vertex& v0, const shaded_vertex& v1, const shaded_vertex& v2);
+    void clip(const raster_state& state, const shaded_vertex& v0, const shaded_vertex& v1, const shaded_vertex& v2);
+    void bin(u32 index);
+    void rasterize_tile(const raster_state& state, u32 tile);
+
+    std::vector<shaded_vertex>    m_clipped{};
+    std::vector<triangle>         m_triangles{};
+    std::vector<std::vector<u32>> m_bins{};
+    std::vector<u64>              m_tile_covered{};
+    std::vector<u32>              m_tile_shaded{};
+    std::vector<u32>              m_costs{};
+    std::vector<u32>              m_previous_costs{};
+    u32                           m_tiles_x{};
+    u32                           m_tiles_y{};
+    D3D11_RECT                    m_bounds{}; // Viewport, targets and scissor intersected
+
+    raster_stats m_frame{};
+    raster_stats m_previous{};
+};
+
+} // namespace yae::gfx::software
@@ -0,0 +1,577 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: StateCache.cpp
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+#include "StateCache.h"
+
+#include "D3D11Core.h"
+
+#include <mutex>
+
+namespace yae::gfx::state
+{
+
+namespace
+{
+
+constexpr u32 max_cbuffer_slots  = D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT;
+constexpr u32 max_srv_slots      = 32; // Higher slots are passed through untracked, as are higher vertex buffers
+constexpr u32 max_sampler_slots  = D3D11_COMMONSHADER_SAMPLER_SLOT_COUNT;
+constexpr u32 max_vertex_buffers = 4;
+
+u32 hash_bytes(const void* data, u32 size)
+{
+    const u8* bytes = (const u8*) data;
+    u32       hash  = 2166136261u;
+    for (u32 i = 0; i < size; ++i)
+    {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+// State objects keyed by their descriptor's bytes. Descriptors are normalized first so padding never splits a bucket
+template<typename Desc, typename State>
+class state_table
+{
+public:
+    template<typename Create>
+    State* get(const Desc& key, Create create)
+    {
+        // Recording threads and the simulation only use state objects fetched before, the tables aren't locked
+        assert(core::owns_backend());
+
+        const u32  hash  = hash_bytes(&key, sizeof(Desc));
+        const auto range = m_entries.equal_range(hash);
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            if (memcmp(it->second.bytes, &key, sizeof(Desc)) == 0)
+            {
+                return it->second.state;
+            }
+        }
+
+        State* state{};
+        if (FAILED(create(&key, &state)))
+        {
+            return nullptr;
+        }
+
+        entry e{};
+        memcpy(e.bytes, &key, sizeof(Desc));
+        e.state = state;
+        m_entries.emplace(hash, e);
+        return state;
+    }
+
+    void release()
+    {
+        for (auto& [hash, e] : m_entries)
+        {
+            core::release(e.state);
+        }
+        m_entries.clear();
+    }
+
+    u32 size() const { return (u32) m_entries.size(); }
+
+private:
+    struct entry
+    {
+        u8     bytes[sizeof(Desc)];
+        State* state;
+    };
+
+    std::unordered_multimap<u32, entry> m_entries{};
+};
+
+state_table<D3D11_SAMPLER_DESC, ID3D11SamplerState>            samplers{};
+state_table<D3D11_BLEND_DESC, ID3D11BlendState>                blends{};
+state_table<D3D11_DEPTH_STENCIL_DESC, ID3D11DepthStencilState> depth_stencils{};
+state_table<D3D11_RASTERIZER_DESC, ID3D11RasterizerState>      rasterizers{};
+
+// Bound state of one shader stage. A slot is only trusted while its known bit is set
+struct stage_state
+{
+    ID3D11Buffer*             cbuffers[max_cbuffer_slots]{};
+    u32                       first_constants[max_cbuffer_slots]{};
+    u32                       constant_counts[max_cbuffer_slots]{};
+    ID3D11ShaderResourceView* srvs[max_srv_slots]{};
+    ID3D11SamplerState*       samplers[max_sampler_slots]{};
+    u32                       known_cbuffers{};
+    u32                       known_srvs{};
+    u32                       known_samplers{};
+};
+
+struct context_state
+{
+    stage_state stages[(u32) shader_stage::count]{};
+
+    ID3D11InputLayout*       layout{};
+    ID3D11VertexShader*      vs{};
+    ID3D11HullShader*        hs{};
+    ID3D11DomainShader*      ds{};
+    ID3D11GeometryShader*    gs{};
+    ID3D11PixelShader*       ps{};
+    ID3D11Buffer*            vertex_buffers[max_vertex_buffers]{};
+    u32                      strides[max_vertex_buffers]{};
+    u32                      offsets[max_vertex_buffers]{};
+    ID3D11Buffer*            index_buffer{};
+    DXGI_FORMAT              index_format{};
+    D3D11_PRIMITIVE_TOPOLOGY topology{};
+    ID3D11BlendState*        blend{};
+    f32                      blend_factor[4]{};
+    ID3D11DepthStencilState* depth_stencil{};
+    u32                      stencil_ref{};
+    ID3D11RasterizerState*   rasterizer{};
+
+    bool known_layout{};
+    bool known_vs{};
+    bool known_hs{};
+    bool known_ds{};
+    bool known_gs{};
+    bool known_ps{};
+    u32  known_vertex_buffers{};
+    bool known_index_buffer{};
+    bool known_topology{};
+    bool known_blend{};
+    bool known_depth_stencil{};
+    bool known_rasterizer{};
+};
+
+context_state immediate{};
+state_stats   frame{};
+state_stats   previous{};
+std::mutex    frame_mutex{}; // Guards frame while recording threads merge their counters
+
+// What a thread recording a command list has bound, kept apart from the immediate context's
+struct recording
+{
+    render_backend* recorder{};
+    context_state   bound{};
+    state_stats     stats{};
+};
+
+thread_local recording thread_recording{};
+
+constexpr u32 bit(u32 slot)
+{
+    return 1u << slot;
+}
+
+context_state& bound_state()
+{
+    return thread_recording.recorder ? thread_recording.bound : immediate;
+}
+
+state_stats& stats()
+{
+    return thread_recording.recorder ? thread_recording.stats : frame;
+}
+
+// Counts the call, true if it would change nothing
+bool redundant(bool same)
+{
+    state_stats& counters = stats();
+    ++counters.calls;
+    if (same)
+    {
+        ++counters.redundant;
+    }
+    return same;
+}
+
+render_backend* ctx()
+{
+    return thread_recording.recorder ? thread_recording.recorder : core::backend();
+}
+
+} // anonymous namespace
+
+ID3D11SamplerState* sampler_state(const D3D11_SAMPLER_DESC& desc)
+{
+    return samplers.get(desc, [](const D3D11_SAMPLER_DESC* d, ID3D11SamplerState** s) {
+        return core::backend()->create_sampler_state(d, s);
+    });
+}
+
+ID3D11BlendState* blend_state(const D3D11_BLEND_DESC& desc)
+{
+    D3D11_BLEND_DESC key;
+    memset(&key, 0, sizeof(key));
+    key.AlphaToCoverageEnable  = desc.AlphaToCoverageEnable;
+    key.IndependentBlendEnable = desc.IndependentBlendEnable;
+    for (u32 i = 0; i < 8; ++i)
+    {
+        const D3D11_RENDER_TARGET_BLEND_DESC& src = desc.RenderTarget[i];
+        D3D11_RENDER_TARGET_BLEND_DESC&       dst = key.RenderTarget[i];
+
+        dst.BlendEnable           = src.BlendEnable;
+        dst.SrcBlend              = src.SrcBlend;
+        dst.DestBlend             = src.DestBlend;
+        dst.BlendOp               = src.BlendOp;
+        dst.SrcBlendAlpha         = src.SrcBlendAlpha;
+        dst.DestBlendAlpha        = src.DestBlendAlpha;
+        dst.BlendOpAlpha          = src.BlendOpAlpha;
+        dst.RenderTargetWriteMask = src.RenderTargetWriteMask;
+    }
+
+    return blends.get(key, [](const D3D11_BLEND_DESC* d, ID3D11BlendState** s) {
+        return core::backend()->create_blend_state(d, s);
+    });
+}
+
+ID3D11DepthStencilState* depth_stencil_state(const D3D11_DEPTH_STENCIL_DESC& desc)
+{
+    D3D11_DEPTH_STENCIL_DESC key;
+    memset(&key, 0, sizeof(key));
+    key.DepthEnable      = desc.DepthEnable;
+    key.DepthWriteMask   = desc.DepthWriteMask;
+    key.DepthFunc        = desc.DepthFunc;
+    key.StencilEnable    = desc.StencilEnable;
+    key.StencilReadMask  = desc.StencilReadMask;
+    key.StencilWriteMask = desc.StencilWriteMask;
+    key.FrontFace        = desc.FrontFace;
+    key.BackFace         = desc.BackFace;
+
+    return depth_stencils.get(key, [](const D3D11_DEPTH_STENCIL_DESC* d, ID3D11DepthStencilState** s) {
+        return core::backend()->create_depth_stencil_state(d, s);
+    });
+}
+
+ID3D11RasterizerState* rasterizer_state(const D3D11_RASTERIZER_DESC& desc)
+{
+    return rasterizers.get(desc, [](const D3D11_RASTERIZER_DESC* d, ID3D11RasterizerState** s) {
+        return core::backend()->create_rasterizer_state(d, s);
+    });
+}
+
+u32 cached_object_count()
+{
+    return samplers.size() + blends.size() + depth_stencils.size() + rasterizers.size();
+}
+
+void shutdown()
+{
+    invalidate();
+    samplers.release();
+    blends.release();
+    depth_stencils.release();
+    rasterizers.release();
+}
+
+void set_input_layout(ID3D11InputLayout* layout)
+{
+    context_state& bound = bound_state();
+    if (redundant(bound.known_layout && bound.layout == layout))
+    {
+        return;
+    }
+
+    bound.layout       = layout;
+    bound.known_layout = true;
+    ctx()->set_input_layout(layout);
+}
+
+void set_vertex_shader(ID3D11VertexShader* shader)
+{
+    context_state& bound = bound_state();
+    if (redundant(bound.known_vs && bound.vs == shader))
+    {
+        return;
+    }
+
+    bound.vs       = shader;
+    bound.known_vs = true;
+    ctx()->set_vertex_shader(shader);
+}
+
+void set_hull_shader(ID3D11HullShader* shader)
+{
+    context_state& bound = bound_state();
+    if (redundant(bound.known_hs && bound.hs == shader))
+    {
+        return;
+    }
+
+    bound.hs       = shader;
+    bound.known_hs = true;
+    ctx()->set_hull_shader(shader);
+}
+
+void set_domain_shader(ID3D11DomainShader* shader)
+{
+    context_state& bound = bound_state();
+    if (redundant(bound.known_ds && bound.ds == shader))
+    {
+        return;
+    }
+
+    bound.ds       = shader;
+    bound.known_ds = true;
+    ctx()->set_domain_shader(shader);
+}
+
+void set_geometry_shader(ID3D11GeometryShader* shader)
+{
+    context_state& bound = bound_state();
+    if (redundant(bound.known_gs && bound.gs == shader))
+    {
+        return;
+    }
+
+    bound.gs       = shader;
+    bound.known_gs = true;
+    ctx()->set_geometry_shader(shader);
+}
+
+void set_pixel_shader(ID3D11PixelShader* shader)
+{
+    context_state& bound = bound_state();
+    if (redundant(bound.known_ps && bound.ps == shader))
+    {
+        return;
+    }
+
+    bound.ps       = shader;
+    bound.known_ps = true;
+    ctx()->set_pixel_shader(shader);
+}
+
+void set_constant_buffer(shader_stage stage, u32 slot, ID3D11Buffer* buffer)
+{
+    stage_state& s = bound_state().stages[(u32) stage];
+    if (redundant((s.known_cbuffers & bit(slot)) && s.cbuffers[slot] == buffer && s.constant_counts[slot] == 0))
+    {
+        return;
+    }
+
+    s.cbuffers[slot]        = buffer;
+    s.first_constants[slot] = 0;
+    s.constant_counts[slot] = 0; // Whole buffer
+    s.known_cbuffers |= bit(slot);
+
+    ctx()->set_constant_buffers(stage, slot, 1, &buffer);
+}
+
+void set_constant_buffer(shader_stage stage, u32 slot, ID3D11Buffer* buffer, u32 first_constant, u32 constant_count)
+{
+    stage_state& s = bound_state().stages[(u32) stage];
+    if (redundant((s.known_cbuffers & bit(slot)) && s.cbuffers[slot] == buffer && s.first_constants[slot] == first_constant &&
+                  s.constant_counts[slot] == constant_count))
+    {
+        return;
+    }
+
+    s.cbuffers[slot]        = buffer;
+    s.first_constants[slot] = first_constant;
+    s.constant_counts[slot] = constant_count;
+    s.known_cbuffers |= bit(slot);
+
+    ctx()->set_constant_buffer_ranges(stage, slot, 1, &buffer, &first_constant, &constant_count);
+}
+
+void set_shader_resources(shader_stage stage, u32 first_slot, u32 count, ID3D11ShaderResourceView* const* srvs)
+{
+    stage_state& s = bound_state().stages[(u32) stage];
+    if (first_slot + count <= max_srv_slots)
+    {
+        bool same = true;
+        for (u32 i = 0; i < count && same; ++i)
+        {
+            same = (s.known_srvs & bit(first_slot + i)) && s.srvs[first_slot + i] == srvs[i];
+        }
+
+        if (redundant(same))
+        {
+            return;
+        }
+
+        for (u32 i = 0; i < count; ++i)
+        {
+            s.srvs[first_slot + i] = srvs[i];
+            s.known_srvs |= bit(first_slot + i);
+        }
+    } else
+    {
+        ++stats().calls;
+    }
+
+    ctx()->set_shader_resources(stage, first_slot, count, srvs);
+}
+
+void set_sampler(shader_stage stage, u32 slot, ID3D11SamplerState* sampler)
+{
+    stage_state& s = bound_state().stages[(u32) stage];
+    if (redundant((s.known_samplers & bit(slot)) && s.samplers[slot] == sampler))
+    {
+        return;
+    }
+
+    s.samplers[slot] = sampler;
+    s.known_samplers |= bit(slot);
+
+    ctx()->set_samplers(stage, slot, 1, &sampler);
+}
+
+void set_vertex_buffer(u32 slot, ID3D11Buffer* buffer, u32 stride, u32 offset)
+{
+    context_state& bound = bound_state();
+    if (slot < max_vertex_buffers)
+    {
+        if (redundant((bound.known_vertex_buffers & bit(slot)) && bound.vertex_buffers[slot] == buffer &&
+                      bound.strides[slot] == stride && bound.offsets[slot] == offset))
+        {
+            return;
+        }
+
+        bound.vertex_buffers[slot] = buffer;
+        bound.strides[slot]        = stride;
+        bound.offsets[slot]        = offset;
+        bound.known_vertex_buffers |= bit(slot);
+    } else
+    {
+        ++stats().calls;
+    }
+
+    ctx()->set_vertex_buffers(slot, 1, &buffer, &stride, &offset);
+}
+
+void set_index_buffer(ID3D11Buffer* buffer, DXGI_FORMAT format)
+{
+    context_state& bound = bound_state();
+    if (redundant(bound.known_index_buffer && bound.index_buffer == buffer && bound.index_format == format))
+    {
+        return;
+    }
+
+    bound.index_buffer       = buffer;
+    bound.index_format       = format;
+    bound.known_index_buffer = true;
+    ctx()->set_index_buffer(buffer, format, 0);
+}
+
+void set_topology(D3D11_PRIMITIVE_TOPOLOGY topology)
+{
+    context_state& bound = bound_state();
+    if (redundant(bound.known_topology && bound.topology == topology))
+    {
+        return;
+    }
+
+    bound.topology       = topology;
+    bound.known_topology = true;
+    ctx()->set_topology(topology);
+}
+
+void set_blend_state(ID3D11BlendState* blend, const f32 factor[4])
+{
+    context_state& bound = bound_state();
+    if (redundant(bound.known_blend && bound.blend == blend && memcmp(bound.blend_factor, factor, sizeof(f32) * 4) == 0))
+    {
+        return;
+    }
+
+    bound.blend = blend;
+    memcpy(bound.blend_factor, factor, sizeof(f32) * 4);
+    bound.known_blend = true;
+    ctx()->set_blend_state(blend, factor, 0xFFFFFFFF);
+}
+
+void set_depth_stencil_state(ID3D11DepthStencilState* depth_stencil, u32 stencil_ref)
+{
+    context_state& bound = bound_state();
+    if (redundant(bound.known_depth_stencil && bound.depth_stencil == depth_stencil && bound.stencil_ref == stencil_ref))
+    {
+        return;
+    }
+
+    bound.depth_stencil       = depth_stencil;
+    bound.stencil_ref         = stencil_ref;
+    bound.known_depth_stencil = true;
+    ctx()->set_depth_stencil_state(depth_stencil, stencil_ref);
+}
+
+void set_rasterizer_state(ID3D11RasterizerState* rasterizer)
+{
+    context_state& bound = bound_state();
+    if (redundant(bound.known_rasterizer && bound.rasterizer == rasterizer))
+    {
+        return;
+    }
+
+    bound.rasterizer       = rasterizer;
+    bound.known_rasterizer = true;
+    ctx()->set_rasterizer_state(rasterizer);
+}
+
+void forget_shader_resources()
+{
+    for (stage_state& s : bound_state().stages)
+    {
+        s.known_srvs = 0;
+    }
+}
+
+void invalidate()
+{
+    bound_state() = {};
+}
+
+void begin_recording(render_backend* recorder)
+{
+    thread_recording.recorder = recorder;
+    thread_recording.bound    = {};
+    thread_recording.stats    = {};
+}
+
+void end_recording()
+{
+    {
+        std::lock_guard lock{ frame_mutex };
+        frame.calls += thread_recording.stats.calls;
+        frame.redundant += thread_recording.stats.redundant;
+    }
+    thread_recording = {};
+}
+
+render_backend* target()
+{
+    return ctx();
+}
+
+const state_stats& current()
+{
+    return frame;
+}
+
+const state_stats& last_frame()
+{
+    return previous;
+}
+
+void end_frame()
+{
+    previous = frame;
+    frame    = {};
+}
+
+} // namespace yae::gfx::state
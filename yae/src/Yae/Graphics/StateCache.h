@@ -0,0 +1,113 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: StateCache.h
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+
+#pragma once
+
+#include "Backend.h"
+
+namespace yae::gfx
+{
+
+namespace state
+{
+
+struct state_stats
+{
+    u32 calls{};     // Every set_* call
+    u32 redundant{}; // Calls dropped because the context already had that state
+};
+
+/**
+ * \brief Returns a shared sampler state for the descriptor, creating it on first use. Identical descriptors always get
+ * the same object. The cache owns it, callers don't release it
+ * \param desc Sampler descriptor
+ * \return The state object, nullptr if it could not be created
+ */
+ID3D11SamplerState*      sampler_state(const D3D11_SAMPLER_DESC& desc);
+ID3D11BlendState*        blend_state(const D3D11_BLEND_DESC& desc);
+ID3D11DepthStencilState* depth_stencil_state(const D3D11_DEPTH_STENCIL_DESC& desc);
+ID3D11RasterizerState*   rasterizer_state(const D3D11_RASTERIZER_DESC& desc);
+
+// Number of distinct state objects created through the cache
+u32 cached_object_count();
+
+// Releases every cached state object, the context must not use them afterwards
+void shutdown();
+
+// The setters below remember what they bound and drop calls that would change nothing. Every draw stage, compute is
+// left to the caller. Anything set on the context directly has to be followed by invalidate()
+
+void set_input_layout(ID3D11InputLayout* layout);
+void set_vertex_shader(ID3D11VertexShader* shader);
+void set_hull_shader(ID3D11HullShader* shader);
+void set_domain_shader(ID3D11DomainShader* shader);
+void set_geometry_shader(ID3D11GeometryShader* shader);
+void set_pixel_shader(ID3D11PixelShader* shader);
+
+void set_constant_buffer(shader_stage stage, u32 slot, ID3D11Buffer* buffer);
+
+// Binds a range of a buffer, used by the constant ring. Needs render_backend::supports_constant_offsets()
+void set_constant_buffer(shader_stage stage, u32 slot, ID3D11Buffer* buffer, u32 first_constant, u32 constant_count);
+
+void set_shader_resources(shader_stage stage, u32 first_slot, u32 count, ID3D11ShaderResourceView* const* srvs);
+void set_sampler(shader_stage stage, u32 slot, ID3D11SamplerState* sampler);
+
+void set_vertex_buffer(u32 slot, ID3D11Buffer* buffer, u32 stride, u32 offset);
+void set_index_buffer(ID3D11Buffer* buffer, DXGI_FORMAT format);
+void set_topology(D3D11_PRIMITIVE_TOPOLOGY topology);
+
+void set_blend_state(ID3D11BlendState* blend, const f32 factor[4]);
+void set_depth_stencil_state(ID3D11DepthStencilState* depth_stencil, u32 stencil_ref);
+void set_rasterizer_state(ID3D11RasterizerState* rasterizer);
+
+// Binding a texture as a render target makes the runtime unbind its views, call after changing render targets
+void forget_shader_resources();
+
+// Forgets everything bound, the next call of every setter reaches the context
+void invalidate();
+
+/**
+ * \brief Sends this thread's calls to a recorder until end_recording, tracking them apart from the immediate context
+ * and other recording threads. State objects have to be fetched from the cache before, it is not thread safe
+ * \param recorder Made by render_backend::create_recorder, used by no other thread meanwhile
+ */
+void begin_recording(render_backend* recorder);
+
+// Back to the immediate context on this thread, the recording's counters are added to the frame's
+void end_recording();
+
+// The recorder this thread is recording into, core::backend() otherwise. For the calls the cache doesn't wrap
+render_backend* target();
+
+// Counters of the frame in progress
+const state_stats& current();
+
+// Counters of the last finished frame
+const state_stats& last_frame();
+
+// Called once the frame has been presented
+void end_frame();
+
+} // namespace state
+
+} // namespace yae::gfx
@@ -24,6 +24,7 @@
 
 
 #include "D3D11Core.h"
+#include "StateCache.h"
 #include "Yae/Core/System.h"
 
 namespace yae::gfx
@@ -36,6 +37,8 @@ texture::texture(const char* filename)
 
 bool texture::init(const char* filename)
 {
+    assert(core::owns_backend());
+
     if (!load_targa_32bit(filename))
     {
         return false;
@@ -54,11 +57,11 @@ bool texture::init(const char* filename)
     desc.CPUAccessFlags     = 0;
     desc.MiscFlags          = D3D11_RESOURCE_MISC_GENERATE_MIPS;
 
-    DX_CALL(core::get_device()->CreateTexture2D(&desc, nullptr, &m_texture));
+    DX_CALL(core::backend()->create_texture2d(&desc, nullptr, &m_texture));
 
     u32 row_pitch = m_width * 4 * (u32) sizeof(u8);
 
-    core::get_device_context()->UpdateSubresource(m_texture, 0, nullptr, m_data.data(), row_pitch, 0);
+    core::backend()->update_subresource(m_texture, 0, m_data.data(), row_pitch, 0);
 
     D3D11_SHADER_RESOURCE_VIEW_DESC srv{};
     srv.Format                    = desc.Format;
@@ -66,12 +69,12 @@ bool texture::init(const char* filename)
     srv.Texture2D.MostDetailedMip = 0;
     srv.Texture2D.MipLevels       = -1;
 
-    DX_CALL(core::get_device()->CreateShaderResourceView(m_texture, &srv, &m_texture_view));
+    DX_CALL(core::backend()->create_shader_resource_view(m_texture, &srv, &m_texture_view));
 
-    core::get_device_context()->GenerateMips(m_texture_view);
+    core::backend()->generate_mips(m_texture_view);
 
     // Sampler state
-    D3D11_SAMPLER_DESC sampler_desc;
+    D3D11_SAMPLER_DESC sampler_desc{};
     sampler_desc.Filter         = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
     sampler_desc.AddressU       = D3D11_TEXTURE_ADDRESS_WRAP;
     sampler_desc.AddressV       = D3D11_TEXTURE_ADDRESS_WRAP;
@@ -86,7 +89,12 @@ bool texture::init(const char* filename)
     sampler_desc.MinLOD         = 0.f;
     sampler_desc.MaxLOD         = D3D11_FLOAT32_MAX;
 
-    DX_CALL(core::get_device()->CreateSamplerState(&sampler_desc, &m_sampler_state));
+    // Every texture used to create its own copy of this sampler, the cache hands out one shared object
+    m_sampler_state = state::sampler_state(sampler_desc);
+    if (!m_sampler_state)
+    {
+        return false;
+    }
 
     return true;
 }
@@ -95,7 +103,7 @@ void texture::shutdown()
 {
     core::release(m_texture_view);
     core::release(m_texture);
-    core::release(m_sampler_state);
+    m_sampler_state = nullptr;
 }
 
 bool texture::load_targa_32bit(const char* filename)
@@ -22,6 +22,8 @@
 //  ------------------------------------------------------------------------------
 #include "Transform.h"
 
+#include "Yae/Scene/TransformHierarchy.h"
+
 namespace yae
 {
 
@@ -48,36 +50,72 @@ transform::transform()
     m_parent_transformation = XMMatrixIdentity();
 }
 
-void transform::set_position(const math::vec3& pos)
+transform::~transform()
+{
+    if (m_hierarchy)
+    {
+        m_hierarchy->detach(this);
+    }
+}
+
+void transform::mark_dirty()
 {
-    m_pos         = pos;
-    m_pos_vec     = XMLoadFloat3(&m_pos);
     m_recalculate = true;
+    if (m_hierarchy)
+    {
+        m_hierarchy->mark_dirty(m_node);
+    }
+}
+
+void transform::set_local_bounds(const math::aabb& bounds)
+{
+    m_local_bounds = bounds;
+    mark_dirty();
+}
+
+void transform::calculate_axes()
+{
+    m_rot_mat = XMMatrixRotationQuaternion(m_rot_quat);
+
+    m_right   = m_rot_mat.r[0];
+    m_up      = m_rot_mat.r[1];
+    m_forward = m_rot_mat.r[2];
+
+    m_left = -m_right;
+    m_back = -m_forward;
+    m_down = -m_up;
+}
+
+void transform::set_position(const math::vec3& pos)
+{
+    m_pos     = pos;
+    m_pos_vec = XMLoadFloat3(&m_pos);
+    mark_dirty();
 }
 void transform::set_position(const math::vector& pos)
 {
     m_pos_vec = pos;
     XMStoreFloat3(&m_pos, pos);
-    m_recalculate = true;
+    mark_dirty();
 }
 
 void transform::set_position(f32 x, f32 y, f32 z)
 {
-    m_pos         = { x, y, z };
-    m_pos_vec     = XMLoadFloat3(&m_pos);
-    m_recalculate = true;
+    m_pos     = { x, y, z };
+    m_pos_vec = XMLoadFloat3(&m_pos);
+    mark_dirty();
 }
 
 void transform::set_scale(const math::vec3& scale)
 {
-    m_scale       = scale;
-    m_recalculate = true;
+    m_scale = scale;
+    mark_dirty();
 }
 
 void transform::set_scale(f32 x, f32 y, f32 z)
 {
-    m_scale       = { x, y, z };
-    m_recalculate = true;
+    m_scale = { x, y, z };
+    mark_dirty();
 }
 
 void transform::set_scale(f32 scale)
@@ -105,7 +143,7 @@ void transform::rotate(f32 angle, axis axis, bool global)
         //m_rot_quat = XMQuaternionRotationAxis(z_axis, angle * math::deg2rad_multiplier);
         break;
     }
-    m_recalculate = true;
+    mark_dirty();
 }
 
 void transform::rotate(f32 angle, const math::vector& axis, bool global)
@@ -120,19 +158,19 @@ void transform::rotate(f32 angle, const math::vector& axis, bool global)
     {
         m_rot_quat = XMQuaternionMultiply(XMQuaternionRotationAxis(axis, angle * math::deg2rad_multiplier), m_rot_quat);
     }
-    m_recalculate = true;
+    mark_dirty();
 }
 
 void transform::rotate(const math::vector& quat)
 {
-    m_rot_quat    = XMQuaternionMultiply(quat, m_rot_quat);
-    m_recalculate = true;
+    m_rot_quat = XMQuaternionMultiply(quat, m_rot_quat);
+    mark_dirty();
 }
 
 void transform::set_rotation(f32 x, f32 y, f32 z)
 {
-    m_rot_quat    = XMQuaternionRotationRollPitchYaw(x, y, z);
-    m_recalculate = true;
+    m_rot_quat = XMQuaternionRotationRollPitchYaw(x, y, z);
+    mark_dirty();
 }
 
 void transform::calculate_transformation(const transform* parent)
@@ -142,25 +180,20 @@ void transform::calculate_transformation(const transform* parent)
         return;
     }
     m_recalculate = false;
+    ++m_version;
 
+    calculate_axes();
     const math::matrix m_scale_mat   = XMMatrixScaling(m_scale.x, m_scale.y, m_scale.z);
-    m_rot_mat                        = XMMatrixRotationQuaternion(m_rot_quat);
     const math::matrix m_translation = XMMatrixTranslation(m_pos.x, m_pos.y, m_pos.z);
 
-    m_right   = m_rot_mat.r[0];
-    m_up      = m_rot_mat.r[1];
-    m_forward = m_rot_mat.r[2];
-
     //m_right = XMVector3Cross(XMVector3Normalize(m_forward), {0.f, 1.f, 0.f});
     //m_right = XMVector3Cross(XMVector3Normalize(m_forward), XMVector3Normalize(m_up));
 
-    m_left = -m_right;
-    m_back = -m_forward;
-    m_down = -m_up;
-
     if (!parent)
     {
         m_transformation = XMMatrixMultiply(XMMatrixMultiply(m_scale_mat, m_rot_mat), m_translation);
+        // A root is a child of the identity, so becoming a child again can't match the parent it had before
+        m_parent_transformation = XMMatrixIdentity();
 
     } else
     {
@@ -24,14 +24,18 @@
 #pragma once
 
 #include "Yae/Common.h"
+#include "Yae/Util/Bounds.h"
 
 namespace yae
 {
+class transform_hierarchy;
+
 class transform
 {
 public:
     transform();
-    ~transform() = default;
+    ~transform();
+    DISABLE_COPY_AND_MOVE(transform);
 
     constexpr const math::vector& position_vector() const { return m_pos_vec; }
     constexpr const math::vec3&   position() const { return m_pos; }
@@ -65,9 +69,29 @@ public:
     // angles expected in degrees
     void set_rotation(f32 x, f32 y, f32 z);
 
+    /**
+     * \brief Recursive path: recomputes this transform against its parent. Only used by transforms that are not
+     * attached to a <code>transform_hierarchy</code>, hierarchy nodes are recalculated by its linear pass instead
+     * \param parent The parent transform or nullptr
+     */
     void calculate_transformation(const transform* parent);
 
+    constexpr u32                  version() const { return m_version; }
+    constexpr u32                  node() const { return m_node; }
+    constexpr transform_hierarchy* hierarchy() const { return m_hierarchy; }
+
+    // Object space bounds, kept in the spatial tree under proxy() once transformed
+    constexpr const math::aabb& local_bounds() const { return m_local_bounds; }
+    void                        set_local_bounds(const math::aabb& bounds);
+    constexpr u32               proxy() const { return m_proxy; }
+    void                        set_proxy(u32 proxy) { m_proxy = proxy; }
+
 private:
+    friend class transform_hierarchy;
+
+    void mark_dirty();
+    void calculate_axes();
+
     math::vector m_pos_vec{};
     math::vec3   m_pos{};
     math::vec3   m_scale{ 1.f, 1.f, 1.f };
@@ -87,5 +111,12 @@ private:
 
     bool         m_recalculate{ true };
     math::matrix m_parent_transformation{};
+
+    transform_hierarchy* m_hierarchy{};
+    u32                  m_node{ invalid_u32 };
+    u32                  m_version{};
+
+    math::aabb m_local_bounds{ { -1.f, -1.f, -1.f }, { 1.f, 1.f, 1.f } };
+    u32        m_proxy{ invalid_u32 };
 };
 } // namespace yae
\ No newline at end of file
@@ -0,0 +1,157 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: TransientPool.cpp
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+
+#include "TransientPool.h"
+
+#include "D3D11Core.h"
+
+namespace yae::gfx
+{
+namespace
+{
+
+// Depth textures are typeless so the lighting stage can sample them through a second view
+struct depth_formats
+{
+    DXGI_FORMAT texture{};
+    DXGI_FORMAT view{};
+};
+
+depth_formats typeless_depth(DXGI_FORMAT format)
+{
+    switch (format)
+    {
+    case DXGI_FORMAT_D32_FLOAT: return { DXGI_FORMAT_R32_TYPELESS, DXGI_FORMAT_R32_FLOAT };
+    case DXGI_FORMAT_D16_UNORM: return { DXGI_FORMAT_R16_TYPELESS, DXGI_FORMAT_R16_UNORM };
+    default: return { DXGI_FORMAT_R24G8_TYPELESS, DXGI_FORMAT_R24_UNORM_X8_TYPELESS };
+    }
+}
+
+} // anonymous namespace
+
+void transient_pool::begin_frame()
+{
+    ++m_frame;
+    for (auto& e : m_entries)
+    {
+        e.taken = false;
+    }
+}
+
+graph_views transient_pool::acquire(const transient_desc& desc)
+{
+    for (auto& e : m_entries)
+    {
+        if (!e.taken && e.desc == desc)
+        {
+            e.taken     = true;
+            e.last_used = m_frame;
+            return e.views;
+        }
+    }
+
+    entry e{ .desc = desc, .last_used = m_frame, .taken = true };
+    if (!create(e))
+    {
+        LOG_ERROR("Failed to create a {}x{} transient {} target", desc.width, desc.height, desc.depth ? "depth" : "color");
+        destroy(e);
+        return {};
+    }
+
+    m_entries.push_back(e);
+    return e.views;
+}
+
+void transient_pool::end_frame()
+{
+    std::erase_if(m_entries, [this](entry& e) {
+        if (m_frame - e.last_used <= max_idle_frames)
+        {
+            return false;
+        }
+
+        destroy(e);
+        return true;
+    });
+}
+
+void transient_pool::release()
+{
+    for (auto& e : m_entries)
+    {
+        destroy(e);
+    }
+
+    m_entries.clear();
+}
+
+bool transient_pool::create(entry& e)
+{
+    const depth_formats depth = typeless_depth(e.desc.format);
+
+    D3D11_TEXTURE2D_DESC desc{};
+    desc.Width            = e.desc.width;
+    desc.Height           = e.desc.height;
+    desc.MipLevels        = 1;
+    desc.ArraySize        = 1;
+    desc.Format           = e.desc.depth ? depth.texture : e.desc.format;
+    desc.SampleDesc.Count = 1;
+    desc.Usage            = D3D11_USAGE_DEFAULT;
+    desc.BindFlags        = D3D11_BIND_SHADER_RESOURCE;
+    desc.BindFlags       |= e.desc.depth ? D3D11_BIND_DEPTH_STENCIL : D3D11_BIND_RENDER_TARGET;
+
+    render_backend* backend = core::backend();
+    DX_CALL(backend->create_texture2d(&desc, nullptr, &e.texture));
+
+    D3D11_SHADER_RESOURCE_VIEW_DESC srv_desc{};
+    srv_desc.Format              = e.desc.depth ? depth.view : e.desc.format;
+    srv_desc.ViewDimension       = D3D11_SRV_DIMENSION_TEXTURE2D;
+    srv_desc.Texture2D.MipLevels = 1;
+    DX_CALL(backend->create_shader_resource_view(e.texture, &srv_desc, &e.views.srv));
+
+    if (e.desc.depth)
+    {
+        D3D11_DEPTH_STENCIL_VIEW_DESC dsv_desc{};
+        dsv_desc.Format        = e.desc.format;
+        dsv_desc.ViewDimension = D3D11_DSV_DIMENSION_TEXTURE2D;
+        DX_CALL(backend->create_depth_stencil_view(e.texture, &dsv_desc, &e.views.dsv));
+    } else
+    {
+        D3D11_RENDER_TARGET_VIEW_DESC rtv_desc{};
+        rtv_desc.Format        = e.desc.format;
+        rtv_desc.ViewDimension = D3D11_RTV_DIMENSION_TEXTURE2D;
+        DX_CALL(backend->create_render_target_view(e.texture, &rtv_desc, &e.views.rtv));
+    }
+
+    return true;
+}
+
+void transient_pool::destroy(entry& e)
+{
+    core::release(e.views.rtv);
+    core::release(e.views.dsv);
+    core::release(e.views.srv);
+    core::release(e.texture);
+}
+
+} // namespace yae::gfx
@@ -0,0 +1,75 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: TransientPool.h
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+
+#pragma once
+
+#include "FrameGraph.h"
+
+#include <vector>
+
+namespace yae::gfx
+{
+
+/**
+ * \brief Textures the frame graph's transient resources live in.\n\n
+ * acquire hands out an idle texture with the same description, or creates one. Textures nobody acquired for
+ * max_idle_frames frames are released, so a pass that is culled or switched off stops costing memory soon after.
+ */
+class transient_pool
+{
+public:
+    static constexpr u64 max_idle_frames = 60;
+
+    transient_pool() = default;
+    ~transient_pool() { release(); }
+    DISABLE_COPY_AND_MOVE(transient_pool);
+
+    void begin_frame();
+
+    // Null views if the texture couldn't be created
+    graph_views acquire(const transient_desc& desc);
+
+    // Releases the textures that have been idle too long
+    void end_frame();
+    void release();
+
+    u32 texture_count() const { return (u32) m_entries.size(); }
+
+private:
+    struct entry
+    {
+        transient_desc   desc{};
+        ID3D11Texture2D* texture{};
+        graph_views      views{};
+        u64              last_used{};
+        bool             taken{};
+    };
+
+    static bool create(entry& e);
+    static void destroy(entry& e);
+
+    std::vector<entry> m_entries{};
+    u64                m_frame{};
+};
+
+} // namespace yae::gfx
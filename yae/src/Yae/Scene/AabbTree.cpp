@@ -0,0 +1,542 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: AabbTree.cpp
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+#include "AabbTree.h"
+
+#include "TransformHierarchy.h"
+
+#include <queue>
+
+namespace yae
+{
+namespace
+{
+
+// Traversal stack that only touches the heap for absurdly deep trees
+class node_stack
+{
+public:
+    void push(u32 value)
+    {
+        if (m_count < capacity)
+        {
+            m_inline[m_count++] = value;
+        } else
+        {
+            m_overflow.push_back(value);
+        }
+    }
+
+    u32 pop()
+    {
+        if (!m_overflow.empty())
+        {
+            const u32 value = m_overflow.back();
+            m_overflow.pop_back();
+            return value;
+        }
+        return m_inline[--m_count];
+    }
+
+    bool empty() const { return m_count == 0 && m_overflow.empty(); }
+
+private:
+    static constexpr u32 capacity = 256;
+
+    u32              m_inline[capacity]{};
+    u32              m_count{};
+    std::vector<u32> m_overflow{};
+};
+
+math::aabb fatten(const math::aabb& box, f32 amount)
+{
+    return { { box.min.x - amount, box.min.y - amount, box.min.z - amount },
+             { box.max.x + amount, box.max.y + amount, box.max.z + amount } };
+}
+
+} // anonymous namespace
+
+aabb_tree::aabb_tree()
+{
+    m_nodes.reserve(64);
+}
+
+u32 aabb_tree::allocate_node()
+{
+    if (m_free == invalid_u32)
+    {
+        const u32 old_size = (u32) m_nodes.size();
+        const u32 new_size = std::max(16u, old_size * 2);
+        m_nodes.resize(new_size);
+        for (u32 i = old_size; i < new_size; ++i)
+        {
+            m_nodes[i].parent = i + 1 < new_size ? i + 1 : invalid_u32;
+            m_nodes[i].height = -1;
+        }
+        m_free = old_size;
+    }
+
+    const u32 index = m_free;
+    m_free          = m_nodes[index].parent;
+
+    node& n     = m_nodes[index];
+    n.parent    = invalid_u32;
+    n.child1    = invalid_u32;
+    n.child2    = invalid_u32;
+    n.height    = 0;
+    n.user_data = nullptr;
+    return index;
+}
+
+void aabb_tree::free_node(u32 index)
+{
+    m_nodes[index].parent = m_free;
+    m_nodes[index].height = -1;
+    m_free                = index;
+}
+
+u32 aabb_tree::create_proxy(const math::aabb& box, void* user_data)
+{
+    const u32 proxy          = allocate_node();
+    m_nodes[proxy].box       = fatten(box, margin);
+    m_nodes[proxy].center    = box.center();
+    m_nodes[proxy].user_data = user_data;
+    m_nodes[proxy].height    = 0;
+
+    insert_leaf(proxy);
+    ++m_proxy_count;
+    return proxy;
+}
+
+void aabb_tree::destroy_proxy(u32 proxy)
+{
+    assert(proxy < (u32) m_nodes.size() && m_nodes[proxy].is_leaf());
+    remove_leaf(proxy);
+    free_node(proxy);
+    --m_proxy_count;
+}
+
+bool aabb_tree::move_proxy(u32 proxy, const math::aabb& box)
+{
+    assert(proxy < (u32) m_nodes.size() && m_nodes[proxy].is_leaf());
+
+    const math::vec3 center = box.center();
+    const math::vec3 d      = { (center.x - m_nodes[proxy].center.x) * displacement_multiplier,
+                                (center.y - m_nodes[proxy].center.y) * displacement_multiplier,
+                                (center.z - m_nodes[proxy].center.z) * displacement_multiplier };
+    m_nodes[proxy].center   = center;
+
+    if (m_nodes[proxy].box.contains(box))
+    {
+        // Still reinsert if the fat box has become far bigger than needed, it would drag down every query
+        const math::aabb huge = fatten(box, 4.f * margin + std::max({ math::abs(d.x), math::abs(d.y), math::abs(d.z) }));
+        if (huge.contains(m_nodes[proxy].box))
+        {
+            return false;
+        }
+    }
+
+    remove_leaf(proxy);
+
+    math::aabb fat = fatten(box, margin);
+    (d.x < 0.f ? fat.min.x : fat.max.x) += d.x;
+    (d.y < 0.f ? fat.min.y : fat.max.y) += d.y;
+    (d.z < 0.f ? fat.min.z : fat.max.z) += d.z;
+    m_nodes[proxy].box = fat;
+
+    insert_leaf(proxy);
+    return true;
+}
+
+void aabb_tree::insert_leaf(u32 leaf)
+{
+    if (m_root == invalid_u32)
+    {
+        m_root               = leaf;
+        m_nodes[leaf].parent = invalid_u32;
+        return;
+    }
+
+    // Walk down towards the cheapest sibling
+    const math::aabb leaf_box = m_nodes[leaf].box;
+    u32              index    = m_root;
+    while (!m_nodes[index].is_leaf())
+    {
+        const node& n = m_nodes[index];
+
+        const f32 area          = n.box.surface_area();
+        const f32 combined_area = math::aabb::combine(n.box, leaf_box).surface_area();
+
+        // Cost of making a new parent for this node and the leaf, and the cost pushed down onto either child
+        const f32 cost        = 2.f * combined_area;
+        const f32 inheritance = 2.f * (combined_area - area);
+
+        const auto child_cost = [&](u32 child) {
+            const node& c        = m_nodes[child];
+            const f32   new_area = math::aabb::combine(leaf_box, c.box).surface_area();
+            return (c.is_leaf() ? new_area : new_area - c.box.surface_area()) + inheritance;
+        };
+
+        const f32 cost1 = child_cost(n.child1);
+        const f32 cost2 = child_cost(n.child2);
+
+        if (cost < cost1 && cost < cost2)
+        {
+            break;
+        }
+        index = cost1 < cost2 ? n.child1 : n.child2;
+    }
+
+    const u32 sibling    = index;
+    const u32 old_parent = m_nodes[sibling].parent;
+    const u32 new_parent = allocate_node();
+
+    m_nodes[new_parent].parent = old_parent;
+    m_nodes[new_parent].box    = math::aabb::combine(leaf_box, m_nodes[sibling].box);
+    m_nodes[new_parent].height = m_nodes[sibling].height + 1;
+    m_nodes[new_parent].child1 = sibling;
+    m_nodes[new_parent].child2 = leaf;
+    m_nodes[sibling].parent    = new_parent;
+    m_nodes[leaf].parent       = new_parent;
+
+    if (old_parent == invalid_u32)
+    {
+        m_root = new_parent;
+    } else if (m_nodes[old_parent].child1 == sibling)
+    {
+        m_nodes[old_parent].child1 = new_parent;
+    } else
+    {
+        m_nodes[old_parent].child2 = new_parent;
+    }
+
+    // Refit and rebalance on the way back up
+    index = m_nodes[leaf].parent;
+    while (index != invalid_u32)
+    {
+        index = balance(index);
+
+        node& n  = m_nodes[index];
+        n.height = 1 + std::max(m_nodes[n.child1].height, m_nodes[n.child2].height);
+        n.box    = math::aabb::combine(m_nodes[n.child1].box, m_nodes[n.child2].box);
+        index    = n.parent;
+    }
+}
+
+void aabb_tree::remove_leaf(u32 leaf)
+{
+    if (leaf == m_root)
+    {
+        m_root = invalid_u32;
+        return;
+    }
+
+    const u32 parent       = m_nodes[leaf].parent;
+    const u32 grand_parent = m_nodes[parent].parent;
+    const u32 sibling      = m_nodes[parent].child1 == leaf ? m_nodes[parent].child2 : m_nodes[parent].child1;
+
+    if (grand_parent == invalid_u32)
+    {
+        m_root                  = sibling;
+        m_nodes[sibling].parent = invalid_u32;
+        free_node(parent);
+        return;
+    }
+
+    // The sibling takes the parent's place
+    if (m_nodes[grand_parent].child1 == parent)
+    {
+        m_nodes[grand_parent].child1 = sibling;
+    } else
+    {
+        m_nodes[grand_parent].child2 = sibling;
+    }
+    m_nodes[sibling].parent = grand_parent;
+    free_node(parent);
+
+    u32 index = grand_parent;
+    while (index != invalid_u32)
+    {
+        index = balance(index);
+
+        node& n  = m_nodes[index];
+        n.height = 1 + std::max(m_nodes[n.child1].height, m_nodes[n.child2].height);
+        n.box    = math::aabb::combine(m_nodes[n.child1].box, m_nodes[n.child2].box);
+        index    = n.parent;
+    }
+}
+
+u32 aabb_tree::balance(u32 a_index)
+{
+    node& a = m_nodes[a_index];
+    if (a.is_leaf() || a.height < 2)
+    {
+        return a_index;
+    }
+
+    const u32 b_index = a.child1;
+    const u32 c_index = a.child2;
+    node&     b       = m_nodes[b_index];
+    node&     c       = m_nodes[c_index];
+
+    const i32 skew = c.height - b.height;
+
+    // Whichever child is too tall is rotated up into a's place
+    const auto replace_in_parent = [this, a_index](u32 replacement) {
+        const u32 parent = m_nodes[replacement].parent;
+        if (parent == invalid_u32)
+        {
+            m_root = replacement;
+        } else if (m_nodes[parent].child1 == a_index)
+        {
+            m_nodes[parent].child1 = replacement;
+        } else
+        {
+            m_nodes[parent].child2 = replacement;
+        }
+    };
+
+    if (skew > 1)
+    {
+        const u32 f_index = c.child1;
+        const u32 g_index = c.child2;
+        node&     f       = m_nodes[f_index];
+        node&     g       = m_nodes[g_index];
+
+        c.child1 = a_index;
+        c.parent = a.parent;
+        a.parent = c_index;
+        replace_in_parent(c_index);
+
+        if (f.height > g.height)
+        {
+            c.child2 = f_index;
+            a.child2 = g_index;
+            g.parent = a_index;
+            a.box    = math::aabb::combine(b.box, g.box);
+            c.box    = math::aabb::combine(a.box, f.box);
+            a.height = 1 + std::max(b.height, g.height);
+            c.height = 1 + std::max(a.height, f.height);
+        } else
+        {
+            c.child2 = g_index;
+            a.child2 = f_index;
+            f.parent = a_index;
+            a.box    = math::aabb::combine(b.box, f.box);
+            c.box    = math::aabb::combine(a.box, g.box);
+            a.height = 1 + std::max(b.height, f.height);
+            c.height = 1 + std::max(a.height, g.height);
+        }
+        return c_index;
+    }
+
+    if (skew < -1)
+    {
+        const u32 d_index = b.child1;
+        const u32 e_index = b.child2;
+        node&     d       = m_nodes[d_index];
+        node&     e       = m_nodes[e_index];
+
+        b.child1 = a_index;
+        b.parent = a.parent;
+        a.parent = b_index;
+        replace_in_parent(b_index);
+
+        if (d.height > e.height)
+        {
+            b.child2 = d_index;
+            a.child1 = e_index;
+            e.parent = a_index;
+            a.box    = math::aabb::combine(c.box, e.box);
+            b.box    = math::aabb::combine(a.box, d.box);
+            a.height = 1 + std::max(c.height, e.height);
+            b.height = 1 + std::max(a.height, d.height);
+        } else
+        {
+            b.child2 = e_index;
+            a.child1 = d_index;
+            d.parent = a_index;
+            a.box    = math::aabb::combine(c.box, d.box);
+            b.box    = math::aabb::combine(a.box, e.box);
+            a.height = 1 + std::max(c.height, d.height);
+            b.height = 1 + std::max(a.height, e.height);
+        }
+        return b_index;
+    }
+
+    return a_index;
+}
+
+void aabb_tree::query(const math::aabb& box, const query_callback& callback) const
+{
+    if (m_root == invalid_u32)
+    {
+        return;
+    }
+
+    node_stack stack{};
+    stack.push(m_root);
+    while (!stack.empty())
+    {
+        const node& n = m_nodes[stack.pop()];
+        if (!n.box.overlaps(box))
+        {
+            continue;
+        }
+
+        if (n.is_leaf())
+        {
+            if (!callback((u32) (&n - m_nodes.data())))
+            {
+                return;
+            }
+        } else
+        {
+            stack.push(n.child1);
+            stack.push(n.child2);
+        }
+    }
+}
+
+void aabb_tree::query(const math::frustum& frustum, const query_callback& callback) const
+{
+    if (m_root == invalid_u32)
+    {
+        return;
+    }
+
+    // Subtrees fully inside the frustum are reported without testing further planes
+    const auto report_all = [this, &callback](u32 root) {
+        node_stack stack{};
+        stack.push(root);
+        while (!stack.empty())
+        {
+            const u32   index = stack.pop();
+            const node& n     = m_nodes[index];
+            if (n.is_leaf())
+            {
+                if (!callback(index))
+                {
+                    return false;
+                }
+            } else
+            {
+                stack.push(n.child1);
+                stack.push(n.child2);
+            }
+        }
+        return true;
+    };
+
+    node_stack stack{};
+    stack.push(m_root);
+    while (!stack.empty())
+    {
+        const u32   index = stack.pop();
+        const node& n     = m_nodes[index];
+
+        const math::containment result = frustum.classify(n.box);
+        if (result == math::containment::outside)
+        {
+            continue;
+        }
+
+        if (result == math::containment::inside || n.is_leaf())
+        {
+            if (!report_all(index))
+            {
+                return;
+            }
+        } else
+        {
+            stack.push(n.child1);
+            stack.push(n.child2);
+        }
+    }
+}
+
+u32 aabb_tree::nearest(const math::vec3& point, f32 max_distance) const
+{
+    if (m_root == invalid_u32)
+    {
+        return invalid_u32;
+    }
+
+    // Best first, closest box on top
+    using entry = std::pair<f32, u32>;
+    std::priority_queue<entry, std::vector<entry>, std::greater<>> open{};
+
+    f32 best_distance = max_distance * max_distance;
+    u32 best          = invalid_u32;
+
+    open.emplace(m_nodes[m_root].box.distance_squared(point), m_root);
+    while (!open.empty())
+    {
+        const auto [distance, index] = open.top();
+        open.pop();
+
+        // Nothing left can beat what we have
+        if (distance > best_distance)
+        {
+            break;
+        }
+
+        const node& n = m_nodes[index];
+        if (n.is_leaf())
+        {
+            best_distance = distance;
+            best          = index;
+            continue;
+        }
+
+        open.emplace(m_nodes[n.child1].box.distance_squared(point), n.child1);
+        open.emplace(m_nodes[n.child2].box.distance_squared(point), n.child2);
+    }
+
+    return best;
+}
+
+namespace scene
+{
+aabb_tree& spatial()
+{
+    static aabb_tree tree{};
+    return tree;
+}
+
+void refit_bounds()
+{
+    const transform_hierarchy& hierarchy = transforms();
+    aabb_tree&                 tree      = spatial();
+
+    for (const u32 node : hierarchy.changed())
+    {
+        const transform* tfm = hierarchy.get(node);
+        if (tfm->proxy() != invalid_u32)
+        {
+            tree.move_proxy(tfm->proxy(), math::transform_aabb(tfm->local_bounds(), hierarchy.world(node)));
+        }
+    }
+}
+} // namespace scene
+
+} // namespace yae
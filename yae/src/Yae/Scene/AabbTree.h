@@ -0,0 +1,126 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: AabbTree.h
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+
+#pragma once
+
+#include "Yae/Common.h"
+#include "Yae/Util/Bounds.h"
+
+#include <functional>
+
+namespace yae
+{
+
+/**
+ * \brief Dynamic bounding volume hierarchy over fat AABBs.\n\n
+ * Leaves store a box grown by a margin (and stretched along the last displacement), so an object moving a little
+ * doesn't touch the tree at all. Inserting picks the sibling with the lowest surface area cost, and every change walks
+ * back up the tree rotating nodes to keep it balanced.
+ */
+class aabb_tree
+{
+public:
+    static constexpr f32 margin                  = 0.1f;
+    static constexpr f32 displacement_multiplier = 2.f;
+
+    // Return false from a query callback to stop the query
+    using query_callback = std::function<bool(u32 proxy)>;
+
+    aabb_tree();
+    ~aabb_tree() = default;
+    DISABLE_COPY_AND_MOVE(aabb_tree);
+
+    /**
+     * \brief Adds a leaf
+     * \param box Tight world space bounds
+     * \param user_data Handed back by user_data()
+     * \return The proxy id
+     */
+    u32  create_proxy(const math::aabb& box, void* user_data);
+    void destroy_proxy(u32 proxy);
+
+    /**
+     * \brief Updates a leaf's bounds, reinserting it only once it has left its fat box. The fat box is stretched in the
+     * direction the bounds moved since the last call, predicting the next move
+     * \param proxy The proxy to move
+     * \param box New tight world space bounds
+     * \return true if the leaf was reinserted
+     */
+    bool move_proxy(u32 proxy, const math::aabb& box);
+
+    void*             user_data(u32 proxy) const { return m_nodes[proxy].user_data; }
+    const math::aabb& fat_aabb(u32 proxy) const { return m_nodes[proxy].box; }
+
+    // Calls back every leaf whose fat box overlaps the given box
+    void query(const math::aabb& box, const query_callback& callback) const;
+
+    // Calls back every leaf whose fat box is at least partially inside the frustum
+    void query(const math::frustum& frustum, const query_callback& callback) const;
+
+    /**
+     * \brief Finds the leaf whose fat box is closest to a point
+     * \param point The point to search from
+     * \param max_distance Ignore anything further than this
+     * \return The proxy id, or invalid_u32 if nothing is in range
+     */
+    u32 nearest(const math::vec3& point, f32 max_distance = FLT_MAX) const;
+
+    u32 height() const { return m_root == invalid_u32 ? 0 : m_nodes[m_root].height; }
+    u32 proxy_count() const { return m_proxy_count; }
+
+private:
+    struct node
+    {
+        math::aabb box{};
+        math::vec3 center{}; // tight center at the last move, leaves only
+        void*      user_data{};
+        u32        parent{ invalid_u32 }; // next free node while on the free list
+        u32        child1{ invalid_u32 };
+        u32        child2{ invalid_u32 };
+        i32        height{ -1 };          // 0 for leaves, -1 when free
+
+        constexpr bool is_leaf() const { return child1 == invalid_u32; }
+    };
+
+    u32  allocate_node();
+    void free_node(u32 index);
+    void insert_leaf(u32 leaf);
+    void remove_leaf(u32 leaf);
+    u32  balance(u32 index);
+
+    std::vector<node> m_nodes{};
+    u32               m_root{ invalid_u32 };
+    u32               m_free{ invalid_u32 };
+    u32               m_proxy_count{};
+};
+
+namespace scene
+{
+// Bounds of every game_object, kept in sync with scene::transforms()
+aabb_tree& spatial();
+
+// Moves the proxy of every transform the last transforms().update() recalculated
+void refit_bounds();
+} // namespace scene
+
+} // namespace yae
@@ -33,7 +33,7 @@ camera_component::camera_component()
     m_view = XMMatrixIdentity();
 }
 
-void camera_component::update(f32 delta)
+void camera_component::post_update(f32 delta)
 {
     constexpr math::vector front{ 0.f, 0.f, 1.f, 0.f };
     math::vector           look = XMVector3Transform(front, m_owner->transformation().rotation_matrix());
@@ -33,7 +33,7 @@ public:
     camera_component();
     ~camera_component() override = default;
 
-    void update(f32 delta) override;
+    void post_update(f32 delta) override;
 
     void add_to_engine() override;
 
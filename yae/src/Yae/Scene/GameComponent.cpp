@@ -35,9 +35,43 @@ model_component::model_component(const std::string_view filename)
     m_model = assets::load_model(filename.data());
 }
 
+model_component::~model_component()
+{
+    gfx::culling::remove(m_cull);
+}
+
+void model_component::add_to_engine()
+{
+    if (!m_model)
+    {
+        return;
+    }
+
+    // The owner's spatial proxy follows the mesh instead of the default unit box
+    m_owner->set_bounds(m_model->bounds());
+
+    gfx::culling::remove(m_cull);
+    m_cull = gfx::culling::add(m_model->world_bounds(m_owner->world_transformation()));
+}
+
+void model_component::post_update(f32 delta)
+{
+    const u32 version = m_owner->transformation().version();
+    if (m_model && version != m_bounds_version)
+    {
+        m_bounds_version = version;
+        gfx::culling::update(m_cull, m_model->world_bounds(m_owner->world_transformation()));
+    }
+}
+
 bool model_component::render()
 {
-    gfx::render3d(m_model.get(), m_owner->world_transformation(), m_owner->material());
+    if (!gfx::culling::is_visible(m_cull))
+    {
+        return true;
+    }
+
+    gfx::render3d(m_model, m_owner->world_transformation(), m_owner->material());
     return true;
 }
 
@@ -55,7 +89,7 @@ bitmap_component::bitmap_component(u32 width, u32 height, const char* filename)
 
 bool bitmap_component::render()
 {
-    gfx::render2d(m_model.get(), m_texture.get(), m_owner->world_transformation());
+    gfx::render2d(m_model, m_texture, m_owner->world_transformation());
     return true;
 }
 
@@ -67,9 +101,33 @@ bool pointlight_component::render()
     return true;
 }
 
+pointlight_component::~pointlight_component()
+{
+    gfx::lights::remove(m_handle);
+}
+
 void pointlight_component::add_to_engine()
 {
-    gfx::add_pointlight(m_owner, this);
+    gfx::lights::remove(m_handle);
+    m_handle           = gfx::lights::add(world_position(), m_light_color, m_radius, m_intensity, m_falloff);
+    m_position_version = m_owner->transformation().version();
+}
+
+math::vec3 pointlight_component::world_position() const
+{
+    math::vec3 position;
+    XMStoreFloat3(&position, m_owner->world_transformation().r[3]);
+    return position;
+}
+
+void pointlight_component::post_update(f32 delta)
+{
+    const u32 version = m_owner->transformation().version();
+    if (version != m_position_version)
+    {
+        m_position_version = version;
+        gfx::lights::set_position(m_handle, world_position());
+    }
 }
 
 } // namespace yae
\ No newline at end of file
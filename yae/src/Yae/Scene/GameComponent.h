@@ -27,7 +27,9 @@
 #include "GameObject.h"
 #include "Yae/Graphics/Model.h"
 #include "Yae/Graphics/Texture.h"
+#include "Yae/Graphics/Culling.h"
 #include "Yae/Util/AssetManager.h"
+#include "Yae/Util/Handle.h"
 
 namespace yae
 {
@@ -37,13 +39,29 @@ class game_component
 public:
     game_component()          = default;
     virtual ~game_component() = default;
+    YAE_POOLED_ALLOCATION
 
     void                   set_owner(game_object* owner) { m_owner = owner; }
     constexpr game_object* owner() const { return m_owner; }
 
+    /**
+     * \brief Per frame logic, runs before transforms are propagated. Unless <code>thread_safe</code> is overridden
+     * to return false this runs on a worker thread, concurrently with the components of other objects, so it may
+     * only modify its own state and its owner
+     * \param delta Frame delta time
+     */
     virtual void update(f32 delta) {}
+
+    /**
+     * \brief Runs on the calling thread once every world transform is up to date for this frame
+     * \param delta Frame delta time
+     */
+    virtual void post_update(f32 delta) {}
     virtual bool render() { return true; }
 
+    // Components that touch shared state (input, window, other objects) return false to update on the calling thread
+    virtual bool thread_safe() const { return true; }
+
     virtual void add_to_engine() {}
 
 protected:
@@ -56,11 +74,20 @@ public:
     model_component(const std::string_view model);
     model_component(gfx::model* model) : m_model{ model } {}
     model_component(const ref<gfx::model>& model) : m_model{ model } {}
-    ~model_component() override = default;
+    ~model_component() override;
+
+    // Keeps the culling bounds in step with the owner's world transform
+    void post_update(f32 delta) override;
+
+    // Skipped when the last cull found the model off screen
     bool render() override;
 
+    void add_to_engine() override;
+
 private:
-    ref<gfx::model> m_model{};
+    ref<gfx::model>           m_model{};
+    gfx::culling::cull_handle m_cull{};
+    u32                       m_bounds_version{ invalid_u32 };
 };
 
 
@@ -82,7 +109,10 @@ public:
     pointlight_component(const math::vec3& light_color, f32 radius, f32 intensity, f32 falloff) :
         m_light_color(light_color), m_radius(radius), m_intensity(intensity), m_falloff(falloff)
     {}
-    ~pointlight_component() override = default;
+    ~pointlight_component() override;
+
+    // Pushes the world position to the light registry when the owner has moved
+    void post_update(f32 delta) override;
     bool render() override;
 
     void add_to_engine() override;
@@ -93,10 +123,16 @@ public:
     f32        falloff() const { return m_falloff; }
 
 private:
+    // Translation of the owner's world matrix, so lights on child objects follow their parents
+    math::vec3 world_position() const;
+
     math::vec3 m_light_color{};
     f32        m_radius{};
     f32        m_intensity{};
     f32        m_falloff{};
+
+    handle<pointlight_component> m_handle{};
+    u32                          m_position_version{ invalid_u32 };
 };
 
 } // namespace yae
\ No newline at end of file
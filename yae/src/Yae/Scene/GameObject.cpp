@@ -23,13 +23,62 @@
 #include "GameObject.h"
 
 #include "GameComponent.h"
+#include "AabbTree.h"
+#include "Registry.h"
+#include "TransformHierarchy.h"
+#include "Yae/Core/Jobs.h"
 
 using namespace DirectX;
 
 namespace yae
 {
+namespace
+{
+// Objects per job in the logic phase
+constexpr u32 update_batch_size = 64;
+
+std::vector<game_object*> update_list;
+
+// Every live game_object, so unmanaged references can be held as handles
+slot_map<game_object*, game_object>& objects()
+{
+    static slot_map<game_object*, game_object> table{};
+    return table;
+}
+} // anonymous namespace
+
+game_object::game_object()
+{
+    m_entity = scene::registry().create();
+    m_handle = objects().insert(this);
+    scene::transforms().attach(&m_transform);
+    m_transform.set_proxy(scene::spatial().create_proxy(m_transform.local_bounds(), this));
+}
+
 game_object::~game_object()
 {
+    // A parent only refers to unmanaged children by handle, which goes stale below
+    if (m_parent)
+    {
+        std::erase(m_parent->m_children, this);
+    }
+    objects().remove(m_handle);
+
+    // Unmanaged children outlive us, hand their transforms back to the hierarchy as roots
+    while (!m_children_unmanaged.empty())
+    {
+        if (game_object* child = find(m_children_unmanaged.back()))
+        {
+            remove(*child);
+        } else
+        {
+            m_children_unmanaged.pop_back();
+        }
+    }
+
+    scene::registry().destroy(m_entity);
+    scene::spatial().destroy_proxy(m_transform.proxy());
+
     while (!m_components.empty())
     {
         auto& comp = m_components.back();
@@ -38,18 +87,14 @@ game_object::~game_object()
         comp = nullptr;
     }
 
+    // Deleting the child detaches its transform subtree, no need to re-root it first
     while (!m_children.empty())
     {
-        auto& child = m_children.back();
-        remove(child);
+        game_object* child = m_children.back();
+        m_children.pop_back();
+        child->set_parent(nullptr);
         delete child;
-        child = nullptr;
     }
-
-    //while (!m_children_unmanaged.empty())
-    //{
-    //    remove(m_children_unmanaged.back());
-    //}
 }
 
 game_object* game_object::add(game_component* component)
@@ -71,13 +116,15 @@ game_object* game_object::add(game_object* child)
 {
     m_children.push_back(child);
     child->set_parent(this);
+    scene::transforms().attach(&child->m_transform, &m_transform);
     return this;
 }
 
 game_object* game_object::add(game_object& child)
 {
-    m_children_unmanaged.push_back(&child);
+    m_children_unmanaged.push_back(child.m_handle);
     child.set_parent(this);
+    scene::transforms().attach(&child.m_transform, &m_transform);
     return this;
 }
 
@@ -86,6 +133,18 @@ void game_object::remove(game_object* child)
     if (const auto it = std::ranges::find(m_children, child); it != m_children.end())
     {
         m_children.erase(it);
+        child->set_parent(nullptr);
+        scene::transforms().attach(&child->m_transform);
+    }
+}
+
+void game_object::remove(game_object& child)
+{
+    if (const auto it = std::ranges::find(m_children_unmanaged, child.m_handle); it != m_children_unmanaged.end())
+    {
+        m_children_unmanaged.erase(it);
+        child.set_parent(nullptr);
+        scene::transforms().attach(&child.m_transform);
     }
 }
 //void game_object::remove_unmanged(game_object* child)
@@ -98,6 +157,11 @@ void game_object::remove(game_object* child)
 
 bool game_object::render()
 {
+    if (!m_parent && !scene::registry().render())
+    {
+        return false;
+    }
+
     for (const auto comp : m_components)
     {
         if (!comp->render())
@@ -114,9 +178,10 @@ bool game_object::render()
         }
     }
 
-    for (const auto child : m_children_unmanaged)
+    for (const auto h : m_children_unmanaged)
     {
-        if (!child->render())
+        game_object* child = find(h);
+        if (child && !child->render())
         {
             return false;
         }
@@ -125,25 +190,95 @@ bool game_object::render()
     return true;
 }
 
+game_object* game_object::find(object_handle h)
+{
+    game_object* const* obj = objects().get(h);
+    return obj ? *obj : nullptr;
+}
+
+void game_object::collect(std::vector<game_object*>& list)
+{
+    list.push_back(this);
+    for (const auto child : m_children)
+    {
+        child->collect(list);
+    }
+
+    for (const auto h : m_children_unmanaged)
+    {
+        if (game_object* child = find(h))
+        {
+            child->collect(list);
+        }
+    }
+}
+
 void game_object::update(f32 delta)
 {
-    m_transform.calculate_transformation(m_parent ? &m_parent->transformation() : nullptr);
-    for (const auto comp : m_components)
+    update_list.clear();
+    collect(update_list);
+
+    for (const auto obj : update_list)
     {
-        comp->update(delta);
+        for (const auto comp : obj->m_components)
+        {
+            if (!comp->thread_safe())
+            {
+                comp->update(delta);
+            }
+        }
     }
 
-    for (const auto child : m_children)
+    jobs::parallel_for(0, (u32) update_list.size(), update_batch_size, [delta](u32 begin, u32 end) {
+        for (u32 i = begin; i < end; ++i)
+        {
+            for (const auto comp : update_list[i]->m_components)
+            {
+                if (comp->thread_safe())
+                {
+                    comp->update(delta);
+                }
+            }
+        }
+    });
+}
+
+void game_object::post_update(f32 delta)
+{
+    update_list.clear();
+    collect(update_list);
+
+    for (const auto obj : update_list)
     {
-        child->update(delta);
+        for (const auto comp : obj->m_components)
+        {
+            comp->post_update(delta);
+        }
     }
+}
 
-    for (const auto child : m_children_unmanaged)
+namespace scene
+{
+void tick(f32 delta, std::span<game_object* const> roots)
+{
+    // Phase 1, logic
+    for (game_object* root : roots)
     {
-        child->update(delta);
+        root->update(delta);
     }
+    registry().update(delta);
 
-    //m_transform.calculate_transformation(m_parent ? &m_parent->transformation() : nullptr);
+    // Phase 2, transforms and the bounds that follow them
+    transforms().update();
+    refit_bounds();
+
+    // Phase 3, post update
+    for (game_object* root : roots)
+    {
+        root->post_update(delta);
+    }
+    registry().post_update(delta);
 }
+} // namespace scene
 
 } // namespace yae
\ No newline at end of file
@@ -25,29 +25,78 @@
 
 #include "Yae/Common.h"
 #include "Yae/Graphics/Transform.h"
-#include "Yae/Graphics/Material.h"
+#include "Yae/Graphics/MaterialRegistry.h"
+#include "Registry.h"
+#include "Yae/Util/Memory.h"
+
+#include <span>
 
 namespace yae
 {
 
 class game_component;
+class game_object;
+
+using object_handle = handle<game_object>;
 
 class game_object
 {
 public:
-    game_object() = default;
+    game_object();
     virtual ~game_object();
+    YAE_POOLED_ALLOCATION
 
     game_object* add(game_component* component);
+
+    /**
+     * \brief Constructs a component in place in <code>scene::registry()</code> instead of on the heap. It is owned by
+     * the registry, destroyed along with this object and updated/rendered by type through the registry
+     * \tparam T A game_component type
+     * \param args Arguments forwarded to T's constructor
+     * \return this, for chaining
+     */
+    template<typename T, typename... Args>
+    game_object* add(Args&&... args)
+    {
+        T& component = scene::registry().emplace<T>(m_entity, std::forward<Args>(args)...);
+        component.set_owner(this);
+        component.add_to_engine();
+        return this;
+    }
+
+    // Component stored in the registry by add<T>, or nullptr
+    template<typename T>
+    T* get()
+    {
+        return scene::registry().get<T>(m_entity);
+    }
+
     void         remove(game_component* component);
     game_object* add(game_object* child);
     game_object* add(game_object& child);
     void         remove(game_object* child);
+    void         remove(game_object& child);
     //void         remove_unmanged(game_object* child);
 
     bool render();
+
+    /**
+     * \brief Runs the logic phase of this object's components and those of everything below it. Components that
+     * aren't <code>thread_safe</code> update first on the calling thread, in depth-first order. Then the remaining
+     * components update across the job system, in batches of objects. An object's components always update on the
+     * same thread in the order they were added, there is no ordering between objects.\n
+     * Transforms changed here are propagated by scene::tick, which calls this on every root
+     * \param delta Frame delta time
+     */
     void update(f32 delta);
 
+    /**
+     * \brief Runs <code>post_update</code> of this object's components and those of everything below it, on the
+     * calling thread in depth-first order. scene::tick calls this once world transforms are final
+     * \param delta Frame delta time
+     */
+    void post_update(f32 delta);
+
     void set_position(const math::vec3& pos) { m_transform.set_position(pos); }
     void set_position(const math::vector& pos) { m_transform.set_position(pos); }
     void set_position(f32 x, f32 y, f32 z) { m_transform.set_position(x, y, z); }
@@ -65,29 +114,60 @@ public:
     constexpr const math::vec3&   position() const { return m_transform.position(); }
     constexpr const math::vec3&   scale() const { return m_transform.scale(); }
 
+    // Object space bounds, used for the object's entry in scene::spatial()
+    void set_bounds(const math::aabb& bounds) { m_transform.set_local_bounds(bounds); }
+    constexpr const math::aabb& bounds() const { return m_transform.local_bounds(); }
+
     constexpr transform& transformation() { return m_transform; }
+    constexpr entity        id() const { return m_entity; }
+    constexpr object_handle handle() const { return m_handle; }
 
-    constexpr const gfx::material& material() const { return m_material; }
+    // The object a handle refers to, or nullptr once it has been destroyed
+    static game_object* find(object_handle h);
 
-    game_object* set_material(const gfx::material& mat)
+    constexpr gfx::material_id material() const { return m_material; }
+
+    game_object* set_material(gfx::material_id mat)
     {
         m_material = mat;
         return this;
     }
 
+    // Registers the description, equal descriptions share one material
+    game_object* set_material(const gfx::material& mat) { return set_material(gfx::materials::create(mat)); }
+
     //constexpr const math::vector& forward() const { return m_forward; }
 
 protected:
     void set_parent(game_object* parent) { m_parent = parent; }
+    void collect(std::vector<game_object*>& list);
 
 
     std::vector<game_object*>    m_children{};
-    std::vector<game_object*>    m_children_unmanaged{};
+    std::vector<object_handle>   m_children_unmanaged{}; // not owned, may die before us
     std::vector<game_component*> m_components{};
     game_object*                 m_parent{};
+    entity                       m_entity{ null_entity };
+    object_handle                m_handle{};
 
-    transform     m_transform{};
-    gfx::material m_material{};
+    transform        m_transform{};
+    gfx::material_id m_material{ gfx::default_material };
 };
 
+namespace scene
+{
+/**
+ * \brief Advances the scene by one frame in three phases, each finishing before the next starts:\n
+ * 1. Logic. game_object::update on every root, then the registry's components one type at a time.\n
+ * 2. Transforms. Every dirty transform in <code>scene::transforms()</code> is propagated in a single linear pass,
+ * then the <code>scene::spatial()</code> entries of the ones that changed are refit.\n
+ * 3. Post update. game_object::post_update on every root, then the registry's. Transform changes made here show up
+ * next frame.\n
+ * The registry, transforms and bounds are global, so call this once per frame with every root the game updates
+ * \param delta Frame delta time
+ * \param roots Objects without a parent, updated along with everything below them
+ */
+void tick(f32 delta, std::span<game_object* const> roots);
+} // namespace scene
+
 } // namespace yae
\ No newline at end of file
@@ -58,6 +58,9 @@ public:
 
     void update(f32 delta) override;
 
+    // Locks and recenters the cursor
+    bool thread_safe() const override { return false; }
+
 private:
     f32 m_sensitivity{};
 };
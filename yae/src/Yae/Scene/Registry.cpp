@@ -0,0 +1,99 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: Registry.cpp
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+#include "Registry.h"
+
+namespace yae
+{
+
+registry::~registry()
+{
+    // Pools destroy their remaining components
+    m_pools.clear();
+}
+
+entity registry::create()
+{
+    return m_entities.emplace();
+}
+
+void registry::destroy(entity e)
+{
+    if (!valid(e))
+    {
+        return;
+    }
+
+    for (const auto& pool : m_pools)
+    {
+        if (pool)
+        {
+            pool->remove(e);
+        }
+    }
+    m_entities.remove(e);
+}
+
+void registry::update(f32 delta)
+{
+    for (const auto& pool : m_pools)
+    {
+        if (pool)
+        {
+            pool->update(delta);
+        }
+    }
+}
+
+void registry::post_update(f32 delta)
+{
+    for (const auto& pool : m_pools)
+    {
+        if (pool)
+        {
+            pool->post_update(delta);
+        }
+    }
+}
+
+bool registry::render()
+{
+    for (const auto& pool : m_pools)
+    {
+        if (pool && !pool->render())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+namespace scene
+{
+yae::registry& registry()
+{
+    static yae::registry reg{};
+    return reg;
+}
+} // namespace scene
+
+} // namespace yae
@@ -0,0 +1,303 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: Registry.h
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+
+#pragma once
+
+#include "Yae/Common.h"
+#include "Yae/Core/Jobs.h"
+#include "Yae/Util/Handle.h"
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace yae
+{
+
+struct entity_tag;
+using entity                 = handle<entity_tag>;
+constexpr entity null_entity = {};
+
+namespace detail
+{
+inline u32 next_component_type()
+{
+    static u32 next{};
+    return next++;
+}
+} // namespace detail
+
+template<typename T>
+u32 component_type()
+{
+    static const u32 id = detail::next_component_type();
+    return id;
+}
+
+class component_pool_base
+{
+public:
+    component_pool_base()          = default;
+    virtual ~component_pool_base() = default;
+    DISABLE_COPY_AND_MOVE(component_pool_base);
+
+    virtual void remove(entity e)       = 0;
+    virtual void update(f32 delta)      = 0;
+    virtual void post_update(f32 delta) = 0;
+    virtual bool render()               = 0;
+};
+
+/**
+ * \brief Contiguous storage for every component of one type.\n\n
+ * Components live in fixed size pages, so growing the pool never moves them and a component's address stays valid
+ * until it is removed (game objects keep raw pointers to their components). Removed slots are reused by the next emplace.
+ * The type-erased update/render entry points call <code>T::update</code> etc. directly rather than through the vtable.
+ */
+template<typename T>
+class component_pool final : public component_pool_base
+{
+public:
+    static constexpr u32 page_size         = 1024;
+    static constexpr u32 update_batch_size = 256;
+
+    component_pool() = default;
+    ~component_pool() override
+    {
+        for (u32 slot = 0; slot < (u32) m_entities.size(); ++slot)
+        {
+            if (m_entities[slot] != null_entity)
+            {
+                at(slot)->~T();
+            }
+        }
+    }
+
+    template<typename... Args>
+    T& emplace(entity e, Args&&... args)
+    {
+        assert(!contains(e));
+        u32 slot;
+        if (!m_free.empty())
+        {
+            slot = m_free.back();
+            m_free.pop_back();
+        } else
+        {
+            slot = (u32) m_entities.size();
+            if (slot % page_size == 0)
+            {
+                m_pages.push_back(create_scope<page>());
+            }
+            m_entities.push_back(null_entity);
+        }
+
+        if (e.index >= (u32) m_sparse.size())
+        {
+            m_sparse.resize(e.index + 1, invalid_u32);
+        }
+
+        T* component      = ::new (at(slot)) T{ std::forward<Args>(args)... };
+        m_sparse[e.index] = slot;
+        m_entities[slot]  = e;
+        ++m_count;
+        return *component;
+    }
+
+    void remove(entity e) override
+    {
+        if (!contains(e))
+        {
+            return;
+        }
+
+        const u32 slot = m_sparse[e.index];
+        at(slot)->~T();
+        m_sparse[e.index] = invalid_u32;
+        m_entities[slot]  = null_entity;
+        m_free.push_back(slot);
+        --m_count;
+    }
+
+    // The slot remembers the full handle, so a stale generation fails here too
+    bool contains(entity e) const
+    {
+        return e.index < (u32) m_sparse.size() && m_sparse[e.index] != invalid_u32 && m_entities[m_sparse[e.index]] == e;
+    }
+
+    T* get(entity e) { return contains(e) ? at(m_sparse[e.index]) : nullptr; }
+
+    constexpr u32 size() const { return m_count; }
+
+    /**
+     * \brief Calls func(entity, T&) for every component, in slot order
+     */
+    template<typename Func>
+    void each(Func&& func)
+    {
+        each_in(0, (u32) m_entities.size(), func);
+    }
+
+    // Same as each, over the slot range [begin, end)
+    template<typename Func>
+    void each_in(u32 begin, u32 end, Func&& func)
+    {
+        for (u32 slot = begin; slot < end; ++slot)
+        {
+            if (m_entities[slot] != null_entity)
+            {
+                func(m_entities[slot], *at(slot));
+            }
+        }
+    }
+
+    constexpr u32 slot_count() const { return (u32) m_entities.size(); }
+
+    void update(f32 delta) override
+    {
+        // Every component of a type shares the answer, so ask the first one
+        bool thread_safe = true;
+        for (u32 slot = 0; slot < slot_count(); ++slot)
+        {
+            if (m_entities[slot] != null_entity)
+            {
+                thread_safe = at(slot)->T::thread_safe();
+                break;
+            }
+        }
+
+        const auto update_range = [this, delta](u32 begin, u32 end) {
+            each_in(begin, end, [delta](entity, T& c) { c.T::update(delta); });
+        };
+
+        if (thread_safe)
+        {
+            jobs::parallel_for(0, slot_count(), update_batch_size, update_range);
+        } else
+        {
+            update_range(0, slot_count());
+        }
+    }
+
+    void post_update(f32 delta) override
+    {
+        each([delta](entity, T& c) { c.T::post_update(delta); });
+    }
+    bool render() override
+    {
+        bool result = true;
+        each([&result](entity, T& c) { result &= c.T::render(); });
+        return result;
+    }
+
+private:
+    struct page
+    {
+        alignas(T) std::byte data[sizeof(T) * page_size];
+    };
+
+    T* at(u32 slot) { return reinterpret_cast<T*>(m_pages[slot / page_size]->data) + slot % page_size; }
+
+    std::vector<scope<page>> m_pages{};
+    std::vector<entity>      m_entities{}; // per slot, null_entity when free
+    std::vector<u32>         m_sparse{};   // per entity index, slot or invalid_u32
+    std::vector<u32>         m_free{};
+    u32                      m_count{};
+};
+
+class registry
+{
+public:
+    registry() = default;
+    ~registry();
+    DISABLE_COPY_AND_MOVE(registry);
+
+    entity create();
+
+    // Removes every component the entity has and recycles its index under a new generation
+    void destroy(entity e);
+
+    bool valid(entity e) const { return m_entities.contains(e); }
+
+    template<typename T, typename... Args>
+    T& emplace(entity e, Args&&... args)
+    {
+        return pool<T>().emplace(e, std::forward<Args>(args)...);
+    }
+
+    template<typename T>
+    void remove(entity e)
+    {
+        pool<T>().remove(e);
+    }
+
+    template<typename T>
+    T* get(entity e)
+    {
+        return pool<T>().get(e);
+    }
+
+    template<typename T>
+    bool has(entity e)
+    {
+        return pool<T>().contains(e);
+    }
+
+    template<typename T, typename Func>
+    void each(Func&& func)
+    {
+        pool<T>().each(std::forward<Func>(func));
+    }
+
+    template<typename T>
+    component_pool<T>& pool()
+    {
+        const u32 type = component_type<T>();
+        if (type >= (u32) m_pools.size())
+        {
+            m_pools.resize(type + 1);
+        }
+
+        if (!m_pools[type])
+        {
+            m_pools[type] = create_scope<component_pool<T>>();
+        }
+        return *static_cast<component_pool<T>*>(m_pools[type].get());
+    }
+
+    // Runs every pool's components, one type at a time
+    void update(f32 delta);
+    void post_update(f32 delta);
+    bool render();
+
+private:
+    std::vector<scope<component_pool_base>> m_pools{};
+    slot_map<u8, entity_tag>                m_entities{};
+};
+
+namespace scene
+{
+// The registry game_object::add<T> stores components in
+yae::registry& registry();
+} // namespace scene
+
+} // namespace yae
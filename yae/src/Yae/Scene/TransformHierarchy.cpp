@@ -0,0 +1,325 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: TransformHierarchy.cpp
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+#include "TransformHierarchy.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace yae
+{
+
+namespace
+{
+template<typename T>
+void erase_range(std::vector<T>& values, u32 first, u32 count)
+{
+    values.erase(values.begin() + first, values.begin() + first + count);
+}
+
+template<typename T>
+void rotate_range(std::vector<T>& values, u32 first, u32 middle, u32 last)
+{
+    std::rotate(values.begin() + first, values.begin() + middle, values.begin() + last);
+}
+} // anonymous namespace
+
+transform_hierarchy::~transform_hierarchy()
+{
+    for (transform* tfm : m_transforms)
+    {
+        tfm->m_hierarchy = nullptr;
+        tfm->m_node      = invalid_u32;
+    }
+}
+
+void transform_hierarchy::attach(transform* tfm, const transform* parent)
+{
+    assert(tfm && tfm != parent);
+    if (tfm->m_hierarchy && tfm->m_hierarchy != this)
+    {
+        tfm->m_hierarchy->detach(tfm);
+    }
+
+    if (tfm->m_hierarchy != this)
+    {
+        const u32 node = size();
+        resize(node + 1);
+        m_parents[node]       = invalid_u32;
+        m_subtree_sizes[node] = 1;
+        m_local[node]         = XMMatrixIdentity();
+        m_world[node]         = XMMatrixIdentity();
+        m_transforms[node]    = tfm;
+        tfm->m_hierarchy      = this;
+        tfm->m_node           = node;
+        mark_dirty(node);
+    }
+
+    if (parent && parent->m_hierarchy != this)
+    {
+        LOG_WARN("Attaching a transform to a parent outside of the hierarchy, the parent will be added as a root");
+        attach(const_cast<transform*>(parent));
+    }
+
+    const u32 first      = tfm->m_node;
+    const u32 count      = m_subtree_sizes[first];
+    const u32 old_parent = m_parents[first];
+    const u32 new_parent = parent ? parent->m_node : invalid_u32;
+
+    if (old_parent == new_parent)
+    {
+        return;
+    }
+
+    // Can't become a child of your own subtree
+    assert(new_parent == invalid_u32 || new_parent < first || new_parent >= first + count);
+
+    // New position is the end of the parent's subtree, or the end of the arrays for a root
+    const u32 dest = new_parent == invalid_u32 ? size() : new_parent + m_subtree_sizes[new_parent];
+
+    for (u32 a = old_parent; a != invalid_u32; a = m_parents[a])
+    {
+        m_subtree_sizes[a] -= count;
+    }
+
+    move_range(first, count, dest);
+
+    const u32 node  = tfm->m_node;
+    m_parents[node] = parent ? parent->m_node : invalid_u32;
+    for (u32 a = m_parents[node]; a != invalid_u32; a = m_parents[a])
+    {
+        m_subtree_sizes[a] += count;
+    }
+
+    mark_dirty(node);
+}
+
+void transform_hierarchy::detach(transform* tfm)
+{
+    if (!tfm || tfm->m_hierarchy != this)
+    {
+        return;
+    }
+
+    const u32 first = tfm->m_node;
+    const u32 count = m_subtree_sizes[first];
+    const u32 last  = first + count;
+
+    for (u32 a = m_parents[first]; a != invalid_u32; a = m_parents[a])
+    {
+        m_subtree_sizes[a] -= count;
+    }
+
+    for (u32 i = first; i < last; ++i)
+    {
+        m_transforms[i]->m_hierarchy = nullptr;
+        m_transforms[i]->m_node      = invalid_u32;
+    }
+
+    erase_range(m_parents, first, count);
+    erase_range(m_subtree_sizes, first, count);
+    erase_range(m_positions, first, count);
+    erase_range(m_rotations, first, count);
+    erase_range(m_scales, first, count);
+    erase_range(m_local, first, count);
+    erase_range(m_world, first, count);
+    erase_range(m_versions, first, count);
+    erase_range(m_dirty_flags, first, count);
+    erase_range(m_transforms, first, count);
+
+    // Nodes before the removed range can't reference anything after it, so only the tail needs fixing up
+    for (u32 i = first; i < size(); ++i)
+    {
+        if (m_parents[i] != invalid_u32 && m_parents[i] >= last)
+        {
+            m_parents[i] -= count;
+        }
+        m_transforms[i]->m_node = i;
+    }
+
+    const auto remap = [first, last, count](std::vector<u32>& nodes) {
+        std::erase_if(nodes, [first, last](u32 n) { return n >= first && n < last; });
+        for (u32& n : nodes)
+        {
+            if (n >= last)
+            {
+                n -= count;
+            }
+        }
+    };
+
+    remap(m_dirty);
+    remap(m_changed);
+}
+
+void transform_hierarchy::mark_dirty(u32 node)
+{
+    assert(node < size());
+
+    // Only whoever flips the flag queues the node, later setters in the same frame never touch the lock. Other
+    // threads write the flag too, so even the early out reads it atomically
+    std::atomic_ref flag{ m_dirty_flags[node] };
+    if (flag.load(std::memory_order_relaxed) == 0 && flag.exchange(1) == 0)
+    {
+        std::lock_guard lock{ m_dirty_mutex };
+        m_dirty.push_back(node);
+    }
+}
+
+void transform_hierarchy::update()
+{
+    m_changed.clear();
+    if (m_dirty.empty())
+    {
+        return;
+    }
+
+    std::ranges::sort(m_dirty);
+
+    u32 end{};
+    for (const u32 root : m_dirty)
+    {
+        // Already recalculated as part of a dirty ancestor's subtree
+        if (root < end)
+        {
+            continue;
+        }
+
+        end = root + m_subtree_sizes[root];
+        for (u32 i = root; i < end; ++i)
+        {
+            transform* tfm = m_transforms[i];
+            if (m_dirty_flags[i])
+            {
+                m_dirty_flags[i] = 0;
+                tfm->calculate_axes();
+                m_positions[i] = tfm->m_pos;
+                m_rotations[i] = tfm->m_rot_quat;
+                m_scales[i]    = tfm->m_scale;
+
+                const math::matrix scale       = XMMatrixScaling(m_scales[i].x, m_scales[i].y, m_scales[i].z);
+                const math::matrix translation = XMMatrixTranslation(m_positions[i].x, m_positions[i].y, m_positions[i].z);
+                m_local[i]                     = XMMatrixMultiply(XMMatrixMultiply(scale, tfm->m_rot_mat), translation);
+            }
+
+            const u32 parent = m_parents[i];
+            m_world[i]       = parent == invalid_u32 ? m_local[i] : XMMatrixMultiply(m_local[i], m_world[parent]);
+            ++m_versions[i];
+
+            tfm->m_transformation = m_world[i];
+            tfm->m_recalculate    = false;
+            ++tfm->m_version;
+
+            m_changed.push_back(i);
+        }
+    }
+
+    m_dirty.clear();
+}
+
+void transform_hierarchy::move_range(u32 first, u32 count, u32 dest)
+{
+    const u32 last = first + count;
+    if (dest == first || dest == last)
+    {
+        return;
+    }
+
+    // Everything that moves lives in [lo, hi), the range itself and whatever it hops over
+    u32 lo, hi;
+    if (dest > last)
+    {
+        lo = first;
+        hi = dest;
+    } else
+    {
+        lo = dest;
+        hi = last;
+    }
+
+    const u32  mid   = dest > last ? last : first;
+    const auto remap = [=](u32 node) -> u32 {
+        if (node == invalid_u32 || node < lo || node >= hi)
+        {
+            return node;
+        }
+
+        if (dest > last)
+        {
+            return node < last ? node + (dest - last) : node - count;
+        }
+        return node >= first ? node - (first - dest) : node + count;
+    };
+
+    rotate_range(m_parents, lo, mid, hi);
+    rotate_range(m_subtree_sizes, lo, mid, hi);
+    rotate_range(m_positions, lo, mid, hi);
+    rotate_range(m_rotations, lo, mid, hi);
+    rotate_range(m_scales, lo, mid, hi);
+    rotate_range(m_local, lo, mid, hi);
+    rotate_range(m_world, lo, mid, hi);
+    rotate_range(m_versions, lo, mid, hi);
+    rotate_range(m_dirty_flags, lo, mid, hi);
+    rotate_range(m_transforms, lo, mid, hi);
+
+    // Parents always come first, so nothing before lo can point into the moved window
+    for (u32 i = lo; i < size(); ++i)
+    {
+        m_parents[i] = remap(m_parents[i]);
+    }
+
+    for (u32 i = lo; i < hi; ++i)
+    {
+        m_transforms[i]->m_node = i;
+    }
+
+    for (u32& node : m_dirty)
+    {
+        node = remap(node);
+    }
+    m_changed.clear();
+}
+
+void transform_hierarchy::resize(u32 size)
+{
+    m_parents.resize(size);
+    m_subtree_sizes.resize(size);
+    m_positions.resize(size);
+    m_rotations.resize(size);
+    m_scales.resize(size);
+    m_local.resize(size);
+    m_world.resize(size);
+    m_versions.resize(size);
+    m_dirty_flags.resize(size);
+    m_transforms.resize(size);
+}
+
+namespace scene
+{
+transform_hierarchy& transforms()
+{
+    static transform_hierarchy hierarchy{};
+    return hierarchy;
+}
+} // namespace scene
+
+} // namespace yae
@@ -0,0 +1,111 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: TransformHierarchy.h
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+
+#pragma once
+
+#include "Yae/Common.h"
+#include "Yae/Graphics/Transform.h"
+
+#include <mutex>
+
+namespace yae
+{
+
+/**
+ * \brief Flat, depth-first ordered store of every attached <code>transform</code>.\n\n
+ * A node's subtree is always the contiguous range [node, node + subtree_size), and a parent is always stored before its
+ * children. Changing a transform only queues its node; <code>update</code> then walks the queued subtrees once, front to
+ * back, so the cost is proportional to what changed rather than to the size of the scene.\n\n
+ * Attaching and detaching reorders the arrays and is meant for load/spawn time, not per frame.
+ */
+class transform_hierarchy
+{
+public:
+    transform_hierarchy() = default;
+    ~transform_hierarchy();
+    DISABLE_COPY_AND_MOVE(transform_hierarchy);
+
+    /**
+     * \brief Attaches a transform (along with any subtree it already has) under a parent
+     * \param tfm The transform to attach. If it is already part of this hierarchy it is reparented
+     * \param parent The new parent, or nullptr to make it a root
+     */
+    void attach(transform* tfm, const transform* parent = nullptr);
+
+    /**
+     * \brief Removes a transform and its whole subtree from the hierarchy
+     * \param tfm The transform to remove
+     */
+    void detach(transform* tfm);
+
+    /**
+     * \brief Queues a node for the next update. Safe to call from several threads at once, as long as nothing is
+     * attaching, detaching or updating at the same time
+     * \param node The node whose local transform changed
+     */
+    void mark_dirty(u32 node);
+
+    /**
+     * \brief Recomputes the world matrix of every queued node and its subtree
+     */
+    void update();
+
+    constexpr u32 size() const { return (u32) m_transforms.size(); }
+
+    const math::matrix& world(u32 node) const { return m_world[node]; }
+    u32                 parent(u32 node) const { return m_parents[node]; }
+    u32                 subtree_size(u32 node) const { return m_subtree_sizes[node]; }
+    u32                 version(u32 node) const { return m_versions[node]; }
+    transform*          get(u32 node) const { return m_transforms[node]; }
+
+    // Nodes whose world matrix was recomputed by the last update, in depth-first order
+    constexpr const std::vector<u32>& changed() const { return m_changed; }
+
+private:
+    void move_range(u32 first, u32 count, u32 dest);
+    void resize(u32 size);
+
+    // Per node, depth-first order
+    std::vector<u32>          m_parents{};
+    std::vector<u32>          m_subtree_sizes{};
+    std::vector<math::vec3>   m_positions{};
+    std::vector<math::vector> m_rotations{};
+    std::vector<math::vec3>   m_scales{};
+    std::vector<math::matrix> m_local{};
+    std::vector<math::matrix> m_world{};
+    std::vector<u32>          m_versions{};
+    std::vector<u8>           m_dirty_flags{};
+    std::vector<transform*>   m_transforms{};
+
+    std::vector<u32> m_dirty{};
+    std::vector<u32> m_changed{};
+    std::mutex       m_dirty_mutex{};
+};
+
+namespace scene
+{
+// The hierarchy every game_object's transform lives in
+transform_hierarchy& transforms();
+} // namespace scene
+
+} // namespace yae
@@ -0,0 +1,303 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: Bounds.h
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+
+#pragma once
+
+#include "MathUtil.h"
+
+#include <algorithm>
+#include <cfloat>
+
+namespace yae::math
+{
+
+struct aabb
+{
+    vec3 min{ FLT_MAX, FLT_MAX, FLT_MAX };
+    vec3 max{ -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+    constexpr bool is_valid() const { return min.x <= max.x && min.y <= max.y && min.z <= max.z; }
+
+    constexpr vec3 center() const { return { (min.x + max.x) * .5f, (min.y + max.y) * .5f, (min.z + max.z) * .5f }; }
+    constexpr vec3 extents() const { return { (max.x - min.x) * .5f, (max.y - min.y) * .5f, (max.z - min.z) * .5f }; }
+
+    // Used as the insertion cost by the dynamic tree
+    constexpr f32 surface_area() const
+    {
+        const f32 dx = max.x - min.x;
+        const f32 dy = max.y - min.y;
+        const f32 dz = max.z - min.z;
+        return 2.f * (dx * dy + dy * dz + dz * dx);
+    }
+
+    constexpr bool contains(const aabb& other) const
+    {
+        return min.x <= other.min.x && min.y <= other.min.y && min.z <= other.min.z && other.max.x <= max.x &&
+               other.max.y <= max.y && other.max.z <= max.z;
+    }
+
+    constexpr bool overlaps(const aabb& other) const
+    {
+        return min.x <= other.max.x && other.min.x <= max.x && min.y <= other.max.y && other.min.y <= max.y &&
+               min.z <= other.max.z && other.min.z <= max.z;
+    }
+
+    // Squared distance from a point to the box, 0 when inside
+    constexpr f32 distance_squared(const vec3& p) const
+    {
+        const f32 dx = std::max({ min.x - p.x, 0.f, p.x - max.x });
+        const f32 dy = std::max({ min.y - p.y, 0.f, p.y - max.y });
+        const f32 dz = std::max({ min.z - p.z, 0.f, p.z - max.z });
+        return dx * dx + dy * dy + dz * dz;
+    }
+
+    static constexpr aabb combine(const aabb& a, const aabb& b)
+    {
+        return { { std::min(a.min.x, b.min.x), std::min(a.min.y, b.min.y), std::min(a.min.z, b.min.z) },
+                 { std::max(a.max.x, b.max.x), std::max(a.max.y, b.max.y), std::max(a.max.z, b.max.z) } };
+    }
+
+    static constexpr aabb from_center(const vec3& center, const vec3& extents)
+    {
+        return { { center.x - extents.x, center.y - extents.y, center.z - extents.z },
+                 { center.x + extents.x, center.y + extents.y, center.z + extents.z } };
+    }
+};
+
+struct sphere
+{
+    vec3 center{};
+    f32  radius{};
+};
+
+/**
+ * \brief Transforms a box and returns the box enclosing the result (center transformed, extents by the absolute matrix)
+ * \param box Local space box
+ * \param world Row-major world matrix
+ */
+inline aabb transform_aabb(const aabb& box, const matrix& world)
+{
+    const vec3 c = box.center();
+    const vec3 e = box.extents();
+
+    vec3 center{};
+    XMStoreFloat3(&center, XMVector3TransformCoord(XMLoadFloat3(&c), world));
+
+    vec3 extents{};
+    const vector abs_x = XMVectorAbs(world.r[0]);
+    const vector abs_y = XMVectorAbs(world.r[1]);
+    const vector abs_z = XMVectorAbs(world.r[2]);
+    XMStoreFloat3(&extents, XMVectorAdd(XMVectorAdd(XMVectorScale(abs_x, e.x), XMVectorScale(abs_y, e.y)),
+                                        XMVectorScale(abs_z, e.z)));
+
+    return aabb::from_center(center, extents);
+}
+
+/**
+ * \brief Sphere enclosing a transformed sphere, radius scaled by the largest axis scale
+ */
+inline sphere transform_sphere(const sphere& s, const matrix& world)
+{
+    sphere result{};
+    XMStoreFloat3(&result.center, XMVector3TransformCoord(XMLoadFloat3(&s.center), world));
+    const f32 scale_x = XMVectorGetX(XMVector3LengthSq(world.r[0]));
+    const f32 scale_y = XMVectorGetX(XMVector3LengthSq(world.r[1]));
+    const f32 scale_z = XMVectorGetX(XMVector3LengthSq(world.r[2]));
+    result.radius     = s.radius * sqrtf(std::max({ scale_x, scale_y, scale_z }));
+    return result;
+}
+
+/**
+ * \brief Where a volume lands on screen: a rectangle in NDC (y up) and the view space depth range it covers
+ */
+struct screen_bounds
+{
+    vec2 min{};
+    vec2 max{};
+    f32  near_z{};
+    f32  far_z{};
+};
+
+/**
+ * \brief Extent of a view space sphere's projection along one screen axis. The sphere's outline is bounded by the
+ * two tangent points in the (axis, z) plane, when one of them is behind the near plane the sphere's cross section
+ * with the near plane bounds that side instead
+ * \param u Center along the axis (view x or y)
+ * \param z Center depth
+ * \param radius Sphere radius
+ * \param near_z Near plane depth
+ * \param scale Projection scale for the axis
+ * \param lo Lower NDC bound
+ * \param hi Upper NDC bound
+ */
+inline void project_sphere_axis(f32 u, f32 z, f32 radius, f32 near_z, f32 scale, f32& lo, f32& hi)
+{
+    const f32 d_sq       = u * u + z * z;
+    const f32 tangent_sq = d_sq - radius * radius;
+    if (tangent_sq <= 0.f)
+    {
+        // Camera inside the sphere
+        lo = -FLT_MAX;
+        hi = FLT_MAX;
+        return;
+    }
+
+    lo = FLT_MAX;
+    hi = -FLT_MAX;
+
+    // Rotating the center by the tangent half angle, then scaling it from the center distance down to the tangent length.
+    // Both factors happen to be tangent / d
+    const f32 d     = sqrtf(d_sq);
+    const f32 cos_a = sqrtf(tangent_sq) / d;
+    const f32 sin_a = radius / d;
+    for (const f32 side : { -1.f, 1.f })
+    {
+        const f32 pu = (u * cos_a + side * z * sin_a) * cos_a;
+        const f32 pz = (z * cos_a - side * u * sin_a) * cos_a;
+        if (pz > near_z)
+        {
+            lo = std::min(lo, pu / pz * scale);
+            hi = std::max(hi, pu / pz * scale);
+        }
+    }
+
+    const f32 behind = z - near_z;
+    if (behind < radius)
+    {
+        const f32 cut = sqrtf(std::max(radius * radius - behind * behind, 0.f));
+        lo            = std::min(lo, (u - cut) / near_z * scale);
+        hi            = std::max(hi, (u + cut) / near_z * scale);
+    }
+}
+
+/**
+ * \brief Projects a view space sphere through a left handed perspective projection
+ * \param view_sphere Sphere in view space
+ * \param x_scale Horizontal projection scale (_11 of the projection matrix)
+ * \param y_scale Vertical projection scale (_22 of the projection matrix)
+ * \param near_z Near plane depth
+ * \param far_z Far plane depth
+ * \param bounds Screen rectangle clamped to [-1, 1] and depth range clamped to [near_z, far_z]
+ * \return false if the sphere is behind the camera, beyond the far plane or entirely off screen
+ */
+inline bool project_sphere(const sphere& view_sphere, f32 x_scale, f32 y_scale, f32 near_z, f32 far_z, screen_bounds& bounds)
+{
+    const vec3& c = view_sphere.center;
+    const f32   r = view_sphere.radius;
+    if (c.z + r < near_z || c.z - r > far_z)
+    {
+        return false;
+    }
+
+    project_sphere_axis(c.x, c.z, r, near_z, x_scale, bounds.min.x, bounds.max.x);
+    project_sphere_axis(c.y, c.z, r, near_z, y_scale, bounds.min.y, bounds.max.y);
+    if (bounds.min.x > 1.f || bounds.max.x < -1.f || bounds.min.y > 1.f || bounds.max.y < -1.f)
+    {
+        return false;
+    }
+
+    bounds.min.x  = std::max(bounds.min.x, -1.f);
+    bounds.min.y  = std::max(bounds.min.y, -1.f);
+    bounds.max.x  = std::min(bounds.max.x, 1.f);
+    bounds.max.y  = std::min(bounds.max.y, 1.f);
+    bounds.near_z = std::max(c.z - r, near_z);
+    bounds.far_z  = std::min(c.z + r, far_z);
+    return true;
+}
+
+enum class containment
+{
+    outside,
+    intersecting,
+    inside
+};
+
+/**
+ * \brief Six inward facing planes (xyz normal, w distance), left, right, bottom, top, near, far
+ */
+struct frustum
+{
+    vec4 planes[6]{};
+
+    /**
+     * \brief Extracts the planes from a combined view * projection matrix (left handed, depth 0 to 1)
+     */
+    static frustum from_matrix(const matrix& view_projection)
+    {
+        mat4 m{};
+        XMStoreFloat4x4(&m, view_projection);
+
+        frustum f{};
+        f.planes[0] = { m._14 + m._11, m._24 + m._21, m._34 + m._31, m._44 + m._41 };
+        f.planes[1] = { m._14 - m._11, m._24 - m._21, m._34 - m._31, m._44 - m._41 };
+        f.planes[2] = { m._14 + m._12, m._24 + m._22, m._34 + m._32, m._44 + m._42 };
+        f.planes[3] = { m._14 - m._12, m._24 - m._22, m._34 - m._32, m._44 - m._42 };
+        f.planes[4] = { m._13, m._23, m._33, m._43 };
+        f.planes[5] = { m._14 - m._13, m._24 - m._23, m._34 - m._33, m._44 - m._43 };
+
+        for (auto& plane : f.planes)
+        {
+            XMStoreFloat4(&plane, XMPlaneNormalize(XMLoadFloat4(&plane)));
+        }
+        return f;
+    }
+
+    containment classify(const aabb& box) const
+    {
+        containment result = containment::inside;
+        for (const auto& p : planes)
+        {
+            // Corner furthest along the plane normal, then the nearest one
+            const f32 far_d  = p.x * (p.x >= 0.f ? box.max.x : box.min.x) + p.y * (p.y >= 0.f ? box.max.y : box.min.y) +
+                               p.z * (p.z >= 0.f ? box.max.z : box.min.z) + p.w;
+            if (far_d < 0.f)
+            {
+                return containment::outside;
+            }
+
+            const f32 near_d = p.x * (p.x >= 0.f ? box.min.x : box.max.x) + p.y * (p.y >= 0.f ? box.min.y : box.max.y) +
+                               p.z * (p.z >= 0.f ? box.min.z : box.max.z) + p.w;
+            if (near_d < 0.f)
+            {
+                result = containment::intersecting;
+            }
+        }
+        return result;
+    }
+
+    bool intersects(const aabb& box) const { return classify(box) != containment::outside; }
+
+    bool intersects(const sphere& s) const
+    {
+        for (const auto& p : planes)
+        {
+            if (p.x * s.center.x + p.y * s.center.y + p.z * s.center.z + p.w < -s.radius)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+} // namespace yae::math
@@ -0,0 +1,166 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: Handle.h
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+
+#pragma once
+
+#include "Yae/Common.h"
+
+#include <vector>
+
+namespace yae
+{
+
+/**
+ * \brief Generational index. The generation is bumped every time a slot is freed, so a handle to something that has
+ * since been removed (and possibly replaced) fails validation instead of aliasing the new occupant.
+ * \tparam Tag Distinguishes handle types so a light handle can't be passed where an object handle is expected
+ */
+template<typename Tag>
+struct handle
+{
+    u32 index{ invalid_u32 };
+    u32 generation{};
+
+    constexpr bool is_valid() const { return index != invalid_u32; }
+    constexpr bool operator==(const handle&) const = default;
+};
+
+/**
+ * \brief Densely packed values addressed through generational handles.\n\n
+ * Values live contiguously and are swapped to fill holes on removal, so iterating is a plain array walk. Handles go
+ * through a slot table, so lookup and validation are O(1) and stay correct as values move around.
+ * \tparam T Stored value type
+ * \tparam Tag Handle tag, defaults to T
+ */
+template<typename T, typename Tag = T>
+class slot_map
+{
+public:
+    using handle_type = handle<Tag>;
+
+    slot_map()  = default;
+    ~slot_map() = default;
+
+    template<typename... Args>
+    handle_type emplace(Args&&... args)
+    {
+        u32 slot;
+        if (m_free != invalid_u32)
+        {
+            slot   = m_free;
+            m_free = m_slots[slot].index;
+        } else
+        {
+            slot = (u32) m_slots.size();
+            m_slots.push_back({});
+        }
+
+        m_slots[slot].index = (u32) m_values.size();
+        m_values.emplace_back(std::forward<Args>(args)...);
+        m_value_slots.push_back(slot);
+        return { slot, m_slots[slot].generation };
+    }
+
+    handle_type insert(const T& value) { return emplace(value); }
+
+    // Removes the value if the handle is still valid, returns false otherwise
+    bool remove(handle_type h)
+    {
+        if (!contains(h))
+        {
+            return false;
+        }
+
+        const u32 dense = m_slots[h.index].index;
+        const u32 last  = (u32) m_values.size() - 1;
+        if (dense != last)
+        {
+            m_values[dense]                     = std::move(m_values[last]);
+            m_value_slots[dense]                = m_value_slots[last];
+            m_slots[m_value_slots[dense]].index = dense;
+        }
+        m_values.pop_back();
+        m_value_slots.pop_back();
+
+        // Freed slots are chained through their index
+        ++m_slots[h.index].generation;
+        m_slots[h.index].index = m_free;
+        m_free                 = h.index;
+        return true;
+    }
+
+    constexpr bool contains(handle_type h) const
+    {
+        return h.index < (u32) m_slots.size() && m_slots[h.index].generation == h.generation &&
+               m_slots[h.index].index < (u32) m_values.size() && m_value_slots[m_slots[h.index].index] == h.index;
+    }
+
+    T*       get(handle_type h) { return contains(h) ? &m_values[m_slots[h.index].index] : nullptr; }
+    const T* get(handle_type h) const { return contains(h) ? &m_values[m_slots[h.index].index] : nullptr; }
+
+    // Index of a value in the dense array, invalid_u32 for a stale handle
+    u32 dense_index(handle_type h) const { return contains(h) ? m_slots[h.index].index : invalid_u32; }
+
+    // Handle of the value at a dense index
+    handle_type handle_at(u32 dense) const
+    {
+        const u32 slot = m_value_slots[dense];
+        return { slot, m_slots[slot].generation };
+    }
+
+    void clear()
+    {
+        while (!m_values.empty())
+        {
+            remove(handle_at((u32) m_values.size() - 1));
+        }
+    }
+
+    constexpr u32  size() const { return (u32) m_values.size(); }
+    constexpr bool empty() const { return m_values.empty(); }
+
+    T*       data() { return m_values.data(); }
+    const T* data() const { return m_values.data(); }
+
+    T&       operator[](u32 dense) { return m_values[dense]; }
+    const T& operator[](u32 dense) const { return m_values[dense]; }
+
+    auto begin() { return m_values.begin(); }
+    auto end() { return m_values.end(); }
+    auto begin() const { return m_values.begin(); }
+    auto end() const { return m_values.end(); }
+
+private:
+    struct slot
+    {
+        u32 index{};      // dense index when alive, next free slot when not
+        u32 generation{};
+    };
+
+    std::vector<T>    m_values{};
+    std::vector<u32>  m_value_slots{};
+    std::vector<slot> m_slots{};
+    u32               m_free{ invalid_u32 };
+};
+
+} // namespace yae
@@ -22,7 +22,11 @@
 //  ------------------------------------------------------------------------------
 #include "Logger.h"
 
-#include "Yae/Core/Win32Header.h"
+#ifdef _WIN32
+    #include "Yae/Core/Win32Header.h"
+#else
+    #include <cstdio>
+#endif
 
 namespace yae::logger::detail
 {
@@ -39,7 +43,11 @@ void output(const level lvl, std::string_view msg)
     case level::fatal: str = std::format("[ FATAL ]: {}\n", msg); break;
     }
 
+#ifdef _WIN32
     OutputDebugStringA(str.c_str());
+#else
+    fputs(str.c_str(), stderr);
+#endif
 }
 
 } // namespace yae::logger::detail
\ No newline at end of file
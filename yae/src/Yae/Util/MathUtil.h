@@ -68,7 +68,7 @@ inline bool are_matrices_equal(const matrix& matrix1, const matrix& matrix2)
     {
         for (int col = 0; col < 4; ++col)
         {
-            if (!near_equal(matrix1.r[row].m128_f32[col], matrix2.r[row].m128_f32[col]))
+            if (!near_equal(XMVectorGetByIndex(matrix1.r[row], col), XMVectorGetByIndex(matrix2.r[row], col)))
             {
                 return false;
             }
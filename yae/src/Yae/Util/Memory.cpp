@@ -0,0 +1,265 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: Memory.cpp
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+#include "Memory.h"
+
+#include <array>
+#include <atomic>
+
+namespace yae::memory
+{
+namespace
+{
+
+// Stored in front of every block from allocate() so deallocate knows where it came from
+struct alignas(default_alignment) block_header
+{
+    u32 origin;
+    u32 size;
+};
+
+constexpr u32 origin_heap  = invalid_u32 - 1;
+constexpr u32 origin_arena = invalid_u32;
+
+// Size classes are multiples of 16 bytes up to 1KiB, header included
+constexpr u64 size_class_step  = 16;
+constexpr u64 size_class_count = 64;
+constexpr u64 max_pooled_size  = size_class_step * size_class_count;
+
+struct counters
+{
+    std::atomic<u64> allocations{};
+    std::atomic<u64> frees{};
+    std::atomic<u64> pool_chunks{};
+    std::atomic<u64> arena_blocks{};
+    std::atomic<u64> heap_allocations{};
+    std::atomic<u64> bytes_in_use{};
+};
+
+counters& counter()
+{
+    static counters c{};
+    return c;
+}
+
+fixed_pool& size_class(u32 index)
+{
+    static std::array<scope<fixed_pool>, size_class_count> pools = [] {
+        std::array<scope<fixed_pool>, size_class_count> result{};
+        for (u32 i = 0; i < size_class_count; ++i)
+        {
+            const u64 block_size = (i + 1) * size_class_step;
+            result[i]            = create_scope<fixed_pool>(block_size, (u32) std::max<u64>(16, 64 * 1024 / block_size));
+        }
+        return result;
+    }();
+    return *pools[index];
+}
+
+thread_local arena* current_arena{};
+
+} // anonymous namespace
+
+allocation_stats stats()
+{
+    const counters&  c = counter();
+    allocation_stats result{};
+    result.allocations      = c.allocations.load();
+    result.frees            = c.frees.load();
+    result.pool_chunks      = c.pool_chunks.load();
+    result.arena_blocks     = c.arena_blocks.load();
+    result.heap_allocations = c.heap_allocations.load();
+    result.bytes_in_use     = c.bytes_in_use.load();
+    return result;
+}
+
+fixed_pool::fixed_pool(u64 block_size, u32 blocks_per_chunk) :
+    m_block_size{ std::max<u64>(block_size, sizeof(void*)) }, m_blocks_per_chunk{ blocks_per_chunk }
+{}
+
+fixed_pool::~fixed_pool()
+{
+    for (void* chunk : m_chunks)
+    {
+        ::operator delete(chunk, std::align_val_t{ default_alignment });
+    }
+}
+
+void* fixed_pool::allocate()
+{
+    std::lock_guard lock{ m_mutex };
+    if (!m_free)
+    {
+        grow();
+    }
+
+    void* block = m_free;
+    m_free      = *static_cast<void**>(block);
+    return block;
+}
+
+void fixed_pool::deallocate(void* block)
+{
+    std::lock_guard lock{ m_mutex };
+    *static_cast<void**>(block) = m_free;
+    m_free                      = block;
+}
+
+void fixed_pool::grow()
+{
+    u8* chunk = static_cast<u8*>(::operator new(m_block_size * m_blocks_per_chunk, std::align_val_t{ default_alignment }));
+    m_chunks.push_back(chunk);
+    counter().pool_chunks.fetch_add(1, std::memory_order_relaxed);
+
+    // Thread the new blocks onto the free list, first block on top
+    for (u32 i = m_blocks_per_chunk; i > 0; --i)
+    {
+        void* block                 = chunk + (i - 1) * m_block_size;
+        *static_cast<void**>(block) = m_free;
+        m_free                      = block;
+    }
+}
+
+arena::arena(u64 block_size) : m_block_size{ block_size } {}
+
+arena::~arena()
+{
+    reset();
+    for (const auto& b : m_blocks)
+    {
+        ::operator delete(b.data, std::align_val_t{ default_alignment });
+    }
+}
+
+void* arena::allocate(u64 size, u64 alignment)
+{
+    while (true)
+    {
+        if (m_current < (u32) m_blocks.size())
+        {
+            const block& b      = m_blocks[m_current];
+            const u64    offset = (m_offset + alignment - 1) & ~(alignment - 1);
+            if (offset + size <= b.size)
+            {
+                m_offset = offset + size;
+                m_used  += size;
+                return b.data + offset;
+            }
+
+            // Doesn't fit, move on to the next block we already own
+            if (m_current + 1 < (u32) m_blocks.size())
+            {
+                ++m_current;
+                m_offset = 0;
+                continue;
+            }
+        }
+
+        const u64 block_size = std::max(m_block_size, size + alignment);
+        m_blocks.push_back({ static_cast<u8*>(::operator new(block_size, std::align_val_t{ default_alignment })), block_size });
+        m_current   = (u32) m_blocks.size() - 1;
+        m_offset    = 0;
+        m_capacity += block_size;
+        counter().arena_blocks.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void arena::reset()
+{
+    for (destructor_node* node = m_destructors; node; node = node->next)
+    {
+        node->destroy(node->object);
+    }
+
+    m_destructors = nullptr;
+    m_current     = 0;
+    m_offset      = 0;
+    m_used        = 0;
+}
+
+arena_scope::arena_scope(arena& a) : m_previous{ current_arena }
+{
+    current_arena = &a;
+}
+
+arena_scope::~arena_scope()
+{
+    current_arena = m_previous;
+}
+
+void* allocate(u64 size)
+{
+    counters& c     = counter();
+    const u64 total = size + sizeof(block_header);
+    c.allocations.fetch_add(1, std::memory_order_relaxed);
+
+    block_header* header;
+    if (current_arena)
+    {
+        header         = static_cast<block_header*>(current_arena->allocate(total));
+        header->origin = origin_arena;
+    } else if (total <= max_pooled_size)
+    {
+        const u32 index = (u32) ((total + size_class_step - 1) / size_class_step - 1);
+        header          = static_cast<block_header*>(size_class(index).allocate());
+        header->origin  = index;
+        c.bytes_in_use.fetch_add(size, std::memory_order_relaxed);
+    } else
+    {
+        header         = static_cast<block_header*>(::operator new(total, std::align_val_t{ default_alignment }));
+        header->origin = origin_heap;
+        c.heap_allocations.fetch_add(1, std::memory_order_relaxed);
+        c.bytes_in_use.fetch_add(size, std::memory_order_relaxed);
+    }
+
+    header->size = (u32) size;
+    return header + 1;
+}
+
+void deallocate(void* ptr)
+{
+    if (!ptr)
+    {
+        return;
+    }
+
+    counters&     c      = counter();
+    block_header* header = static_cast<block_header*>(ptr) - 1;
+    c.frees.fetch_add(1, std::memory_order_relaxed);
+
+    // Arena memory goes back in bulk on reset
+    if (header->origin == origin_arena)
+    {
+        return;
+    }
+
+    c.bytes_in_use.fetch_sub(header->size, std::memory_order_relaxed);
+    if (header->origin == origin_heap)
+    {
+        ::operator delete(header, std::align_val_t{ default_alignment });
+    } else
+    {
+        size_class(header->origin).deallocate(header);
+    }
+}
+
+} // namespace yae::memory
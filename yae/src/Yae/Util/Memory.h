@@ -0,0 +1,203 @@
+﻿//  ------------------------------------------------------------------------------
+//
+//  yae
+//     Copyright 2023 Matthew Rogers
+//
+//     Licensed under the Apache License, Version 2.0 (the "License");
+//     you may not use this file except in compliance with the License.
+//     You may obtain a copy of the License at
+//
+//         http://www.apache.org/licenses/LICENSE-2.0
+//
+//     Unless required by applicable law or agreed to in writing, software
+//     distributed under the License is distributed on an "AS IS" BASIS,
+//     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//     See the License for the specific language governing permissions and
+//     limitations under the License.
+//
+//  File Name: Memory.h
+//  Date File Created: 10/18/2026
+//  Author: Matt
+//
+//  ------------------------------------------------------------------------------
+
+#pragma once
+
+#include "Yae/Common.h"
+
+#include <algorithm>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace yae::memory
+{
+
+// Every block handed out is aligned to at least this, enough for DirectXMath types
+constexpr u64 default_alignment = 16;
+
+struct allocation_stats
+{
+    u64 allocations{};       // allocate() calls
+    u64 frees{};             // deallocate() calls
+    u64 pool_chunks{};       // heap allocations made to grow a size class pool
+    u64 arena_blocks{};      // heap allocations made to grow an arena
+    u64 heap_allocations{};  // allocations too large for the pools, straight from the heap
+    u64 bytes_in_use{};      // bytes handed out and not yet freed, arenas excluded
+};
+
+// Snapshot of the counters. Anything but allocations/frees/bytes_in_use changing during gameplay is a heap hit
+allocation_stats stats();
+
+/**
+ * \brief Free list of equally sized blocks, grown a chunk at a time and never returned to the heap until destroyed
+ */
+class fixed_pool
+{
+public:
+    fixed_pool(u64 block_size, u32 blocks_per_chunk);
+    ~fixed_pool();
+    DISABLE_COPY_AND_MOVE(fixed_pool);
+
+    void* allocate();
+    void  deallocate(void* block);
+
+    constexpr u64 block_size() const { return m_block_size; }
+
+private:
+    void grow();
+
+    std::mutex         m_mutex{};
+    std::vector<void*> m_chunks{};
+    void*              m_free{};
+    u64                m_block_size{};
+    u32                m_blocks_per_chunk{};
+};
+
+/**
+ * \brief Pool of objects of a single type, for things spawned and despawned constantly (projectiles, debris)
+ */
+template<typename T>
+class object_pool
+{
+public:
+    explicit object_pool(u32 objects_per_chunk = 256) : m_pool{ block_size(), objects_per_chunk } {}
+    ~object_pool() = default;
+    DISABLE_COPY_AND_MOVE(object_pool);
+
+    template<typename... Args>
+    T* create(Args&&... args)
+    {
+        return ::new (m_pool.allocate()) T{ std::forward<Args>(args)... };
+    }
+
+    void destroy(T* object)
+    {
+        if (object)
+        {
+            object->~T();
+            m_pool.deallocate(object);
+        }
+    }
+
+private:
+    static constexpr u64 block_size()
+    {
+        return (std::max(sizeof(T), sizeof(void*)) + alignof(T) - 1) & ~(u64) (alignof(T) - 1);
+    }
+
+    fixed_pool m_pool;
+};
+
+/**
+ * \brief Bump allocator for everything that lives and dies with a scene.\n\n
+ * Memory comes from large blocks that are kept around and rewound by <code>reset</code>, so tearing a scene down costs
+ * nothing per object on the memory side. Objects made with <code>create</code> have their destructors run by
+ * <code>reset</code>, in reverse order, unless they are trivially destructible.
+ */
+class arena
+{
+public:
+    explicit arena(u64 block_size = 1024 * 1024);
+    ~arena();
+    DISABLE_COPY_AND_MOVE(arena);
+
+    void* allocate(u64 size, u64 alignment = default_alignment);
+
+    template<typename T, typename... Args>
+    T* create(Args&&... args)
+    {
+        T* object = ::new (allocate(sizeof(T), std::max<u64>(alignof(T), default_alignment))) T{ std::forward<Args>(args)... };
+        if constexpr (!std::is_trivially_destructible_v<T>)
+        {
+            auto* node = ::new (allocate(sizeof(destructor_node))) destructor_node{
+                [](void* p) { static_cast<T*>(p)->~T(); }, object, m_destructors };
+            m_destructors = node;
+        }
+        return object;
+    }
+
+    // Runs pending destructors and rewinds to the first block, keeping every block for reuse
+    void reset();
+
+    constexpr u64 used() const { return m_used; }
+    constexpr u64 capacity() const { return m_capacity; }
+
+private:
+    struct block
+    {
+        u8* data;
+        u64 size;
+    };
+
+    struct destructor_node
+    {
+        void (*destroy)(void*);
+        void*            object;
+        destructor_node* next;
+    };
+
+    std::vector<block> m_blocks{};
+    destructor_node*   m_destructors{};
+    u64                m_block_size{};
+    u32                m_current{};
+    u64                m_offset{};
+    u64                m_used{};
+    u64                m_capacity{};
+};
+
+/**
+ * \brief While alive, engine object allocations (game_object, game_component) made on this thread come from the
+ * given arena. Deleting such an object still runs its destructor, but the memory is only reclaimed by the arena's
+ * reset, so a scene is torn down by deleting its roots then resetting the arena
+ */
+class arena_scope
+{
+public:
+    explicit arena_scope(arena& a);
+    ~arena_scope();
+    DISABLE_COPY_AND_MOVE(arena_scope);
+
+private:
+    arena* m_previous{};
+};
+
+/**
+ * \brief General allocation for engine objects. While an arena_scope is active on the calling thread, every size
+ * comes from its arena. Otherwise small sizes come from size class pools and larger ones from the heap
+ * \param size Size in bytes
+ * \return Memory aligned to default_alignment
+ */
+void* allocate(u64 size);
+
+// Returns pool and heap blocks. Arena blocks are left in place, deleting an arena-backed object frees nothing until
+// the arena's reset
+void deallocate(void* ptr);
+
+} // namespace yae::memory
+
+// Class allocation operators routing a type through memory::allocate
+#define YAE_POOLED_ALLOCATION                                                                                                    \
+    static void* operator new(size_t size) { return yae::memory::allocate(size); }                                               \
+    static void  operator delete(void* ptr) { yae::memory::deallocate(ptr); }
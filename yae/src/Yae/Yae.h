@@ -31,10 +31,13 @@
 #include "Core/Game.h"
 #include "Core/Input.h"
 #include "Core/Event.h"
+#include "Core/Jobs.h"
 
 // Util
 #include "Util/PathUtil.h"
 #include "Util/AssetManager.h"
+#include "Util/Memory.h"
+#include "Util/Bounds.h"
 
 // Graphics
 #include "Graphics/D3D11Common.h"
@@ -49,6 +52,9 @@
 #include "Scene/GameObject.h"
 #include "Scene/GameComponent.h"
 #include "Scene/MoveComponent.h"
+#include "Scene/AabbTree.h"
+#include "Scene/Registry.h"
+#include "Scene/TransformHierarchy.h"
 
 namespace yae
 {